@@ -8,6 +8,22 @@ MKDIR=mkdir
 # Set ZEUS_OS for Zeus platform builds
 ZEUS_OS=1
 
+# Compile-time log threshold: LOG() below this level is compiled out
+# (0=TRACE 1=DEBUG 2=INFO 3=WARN 4=ERROR)
+ifndef LOG_MIN_LEVEL
+LOG_MIN_LEVEL=1
+endif
+
+# CRC-16 implementation (0=nibble reference 1=byte table 4/8=slicing-by-N)
+ifndef CRC16_SLICES
+CRC16_SLICES=8
+endif
+
+# Tracing spans (0 compiles TRACE_SPAN()/TRACE_INSTANT() out)
+ifndef TRACE
+TRACE=1
+endif
+
 # If no configuration is specified, "Release" will be used
 ifndef CFG
 CFG=Release
@@ -26,17 +42,29 @@ CFG_INC=-I. -Iinclude \
 CFG_LIB=-L/opt/fsl-imx-xwayland/5.4-zeus/sysroots/cortexa9t2hf-neon-poky-linux-gnueabi/usr/lib \
 	-ls7lite -lpthread
 CFG_OBJ=
-COMMON_OBJ=$(OUTDIR)/EventService.o \
+COMMON_OBJ=$(OUTDIR)/Logger.o \
+	$(OUTDIR)/Trace.o \
+	$(OUTDIR)/EventService.o \
 	$(OUTDIR)/Game.o \
 	$(OUTDIR)/Machine.o \
+	$(OUTDIR)/MeterStore.o \
+	$(OUTDIR)/GameMeters.o \
+	$(OUTDIR)/NvramStore.o \
 	$(OUTDIR)/CommChannel.o \
 	$(OUTDIR)/MachineCommPort.o \
+	$(OUTDIR)/NvramDevice.o \
 	$(OUTDIR)/SASConstants.o \
 	$(OUTDIR)/CRC16.o \
 	$(OUTDIR)/BCD.o \
 	$(OUTDIR)/SASCommands.o \
+	$(OUTDIR)/CommandTable.o \
+	$(OUTDIR)/SASFrameParser.o \
 	$(OUTDIR)/SASCommPort.o \
+	$(OUTDIR)/SASPortPool.o \
+	$(OUTDIR)/CommandMetrics.o \
 	$(OUTDIR)/SASDaemon.o \
+	$(OUTDIR)/TrafficCapture.o \
+	$(OUTDIR)/TrafficReplay.o \
 	$(OUTDIR)/MeterCommands.o \
 	$(OUTDIR)/EnableCommands.o \
 	$(OUTDIR)/ExceptionCommands.o \
@@ -49,6 +77,8 @@ COMMON_OBJ=$(OUTDIR)/EventService.o \
 	$(OUTDIR)/EGMConfig.o \
 	$(OUTDIR)/RapidJsonHelper.o \
 	$(OUTDIR)/MeterPersistence.o \
+	$(OUTDIR)/MeterSnapshot.o \
+	$(OUTDIR)/MeterJournal.o \
 	$(OUTDIR)/main.o
 
 # Platform-specific sources
@@ -56,7 +86,8 @@ ifdef ZEUS_OS
 	COMMON_OBJ += $(OUTDIR)/SASSerialPort.o \
 		$(OUTDIR)/ZeusPlatform.o
 else
-	COMMON_OBJ += $(OUTDIR)/SimulatedPlatform.o
+	COMMON_OBJ += $(OUTDIR)/SimulatedPlatform.o \
+		$(OUTDIR)/PtyCommChannel.o
 endif
 
 OBJ=$(COMMON_OBJ) $(CFG_OBJ)
@@ -64,9 +95,13 @@ ALL_OBJ=$(COMMON_OBJ) $(CFG_OBJ) \
 	/opt/fsl-imx-xwayland/5.4-zeus/sysroots/cortexa9t2hf-neon-poky-linux-gnueabi/usr/lib/libs7lite.so.1.0.15 \
 	-lpthread
 
-COMPILE=$(CXX) -c -D_EGMEMULATOR -DZEUS_OS -g -Wall ${CXXFLAGS} -O2 -std=c++11 -lstdc++ -Wall -Wno-unused-but-set-variable -Wno-unused-function -Wno-unused-parameter -Wno-unused-variable -Wextra -Wno-sign-compare -Wno-type-limits -o "$(OUTDIR)/$(*F).o" $(CFG_INC) $<
+COMPILE=$(CXX) -c -D_EGMEMULATOR -DZEUS_OS -DEGM_LOG_MIN_LEVEL=$(LOG_MIN_LEVEL) -DEGM_CRC16_SLICES=$(CRC16_SLICES) -DEGM_TRACE=$(TRACE) -g -Wall ${CXXFLAGS} -O2 -std=c++11 -lstdc++ -Wall -Wno-unused-but-set-variable -Wno-unused-function -Wno-unused-parameter -Wno-unused-variable -Wextra -Wno-sign-compare -Wno-type-limits -o "$(OUTDIR)/$(*F).o" $(CFG_INC) $<
 LINK=$(CXX) -g -Wall -Wno-psabi ${CXXFLAGS} -O2 -std=c++11 -lstdc++ -rdynamic -ldl -pthread -o "$(OUTFILE)" $(ALL_OBJ)
 
+# Pattern rules for utils directory
+$(OUTDIR)/%.o : src/utils/%.cpp
+	$(COMPILE)
+
 # Pattern rules for event directory
 $(OUTDIR)/%.o : src/event/%.cpp
 	$(COMPILE)
@@ -0,0 +1,106 @@
+#include "sas/SASCommands.h"
+#include "sas/commands/AFTCommands.h"
+#include "sas/commands/TITOCommands.h"
+#include "event/EventService.h"
+#include "simulator/Machine.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * AFT/ticket throughput with 1, 2, 4 ... N machines, one thread each
+ *
+ * AFT and ticket state live on each Machine, so machines share no lock on
+ * this path and the total rate should grow with the machine count up to
+ * the number of cores. Each round is an AFT transfer in (0x72), an
+ * interrogate (0x74), an AFT transfer out (0x72) and a ticket
+ * information read (0x7E).
+ *
+ * Usage: AFTScalingBenchmark [seconds per run] [max machines]
+ */
+
+using namespace sas;
+using namespace sas::commands;
+
+// 0x72 as the handler reads it: [transfer code][amount (5 BCD)][transaction ID (4)]...
+static MessageData transferRequest(uint8_t transferCode, uint32_t transactionNumber) {
+    MessageData data;
+    data.push_back(transferCode);
+    data.appendBCD(1, 5);                   // One cent
+    data.push_back(static_cast<uint8_t>(transactionNumber >> 24));
+    data.push_back(static_cast<uint8_t>(transactionNumber >> 16));
+    data.push_back(static_cast<uint8_t>(transactionNumber >> 8));
+    data.push_back(static_cast<uint8_t>(transactionNumber));
+    data.appendSpace(8);                    // Flags, asset number
+    return data;
+}
+
+static uint64_t runMachine(simulator::Machine* machine, const std::atomic<bool>& stop) {
+    MessageData lock;
+    lock.push_back(0x12);
+    lock.push_back(0x34);
+    AFTCommands::handleRegisterLock(machine, lock);
+
+    uint64_t rounds = 0;
+    uint32_t transactionNumber = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+        Message in = AFTCommands::handleTransferFunds(machine,
+            transferRequest(AFTCommands::TRANSFER_TO_GAMING_MACHINE, ++transactionNumber));
+        Message status = AFTCommands::handleInterrogateStatus(machine);
+        Message out = AFTCommands::handleTransferFunds(machine,
+            transferRequest(AFTCommands::TRANSFER_FROM_GAMING_MACHINE, ++transactionNumber));
+        Message ticket = TITOCommands::handleSendTicketInfo(machine);
+        if (in.data.empty() || status.data.empty() || out.data.empty() || ticket.data.empty()) {
+            std::fprintf(stderr, "Unexpected empty response\n");
+            std::exit(1);
+        }
+        rounds++;
+    }
+    return rounds;
+}
+
+int main(int argc, char* argv[]) {
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 2.0;
+    size_t maxMachines = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : 8;
+
+    auto eventService = std::make_shared<event::EventService>();
+    std::vector<std::unique_ptr<simulator::Machine>> machines;
+    for (size_t i = 0; i < maxMachines; i++) {
+        machines.push_back(std::unique_ptr<simulator::Machine>(new simulator::Machine(eventService, nullptr)));
+    }
+
+    std::printf("%u hardware threads, %.1f s per run\n", std::thread::hardware_concurrency(), seconds);
+    std::printf("%9s %14s %14s %9s\n", "machines", "rounds/s", "per machine", "scaling");
+
+    double single = 0;
+    for (size_t count = 1; count <= maxMachines; count *= 2) {
+        std::atomic<bool> stop(false);
+        std::vector<uint64_t> rounds(count, 0);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; i++) {
+            threads.push_back(std::thread([&, i] { rounds[i] = runMachine(machines[i].get(), stop); }));
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        stop = true;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        uint64_t total = 0;
+        for (uint64_t r : rounds) {
+            total += r;
+        }
+        double rate = total / elapsed;
+        if (count == 1) {
+            single = rate;
+        }
+        std::printf("%9zu %14.0f %14.0f %8.2fx\n", count, rate, rate / count, single > 0 ? rate / single : 0.0);
+    }
+    return 0;
+}
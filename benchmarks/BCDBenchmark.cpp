@@ -0,0 +1,74 @@
+#include "sas/BCD.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * BCD encode/decode cost per meter width
+ *
+ * Compares encodeTo() with the per-digit division loop it replaced, and
+ * times decode(), for the 4- and 5-byte meter widths and the 8-byte
+ * maximum used by a few SAS fields. Values are precomputed so the timed
+ * loops do no division of their own.
+ *
+ * Usage: BCDBenchmark [iterations per measurement]
+ */
+
+using sas::BCD;
+
+static const size_t VALUE_COUNT = 4096;     // Power of 2
+
+static volatile uint64_t sink;
+
+static void divisionEncode(uint64_t value, uint8_t* buffer, size_t numBytes) {
+    for (size_t i = numBytes; i > 0; i--) {
+        uint8_t low = static_cast<uint8_t>(value % 10);
+        value /= 10;
+        uint8_t high = static_cast<uint8_t>(value % 10);
+        value /= 10;
+        buffer[i - 1] = static_cast<uint8_t>((high << 4) | low);
+    }
+}
+
+// Nanoseconds per call of fn(index), cycling through VALUE_COUNT indexes
+template <typename Fn>
+static double measure(size_t iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        fn(i & (VALUE_COUNT - 1));
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    size_t iterations = (argc > 1) ? static_cast<size_t>(std::atol(argv[1])) : 20000000;
+
+    static uint64_t values[VALUE_COUNT];
+    static uint8_t encoded[VALUE_COUNT][10];
+
+    std::printf("%6s %12s %12s %12s   (ns per call)\n", "bytes", "encodeTo", "division", "decode");
+    for (size_t numBytes : {4, 5, 8}) {
+        uint64_t state = 12345;
+        for (size_t i = 0; i < VALUE_COUNT; i++) {
+            state = state * 2862933555777941757ULL + 3037000493ULL;
+            values[i] = state % (BCD::maxValue(numBytes) + 1);
+            BCD::encodeTo(values[i], encoded[i], numBytes);
+        }
+
+        uint8_t buffer[10];
+        double encode = measure(iterations, [&](size_t i) {
+            BCD::encodeTo(values[i], buffer, numBytes);
+            sink = buffer[0];
+        });
+        double division = measure(iterations, [&](size_t i) {
+            divisionEncode(values[i], buffer, numBytes);
+            sink = buffer[0];
+        });
+        double decode = measure(iterations, [&](size_t i) {
+            sink = BCD::decode(encoded[i], numBytes);
+        });
+        std::printf("%6zu %12.2f %12.2f %12.2f\n", numBytes, encode, division, decode);
+    }
+    return 0;
+}
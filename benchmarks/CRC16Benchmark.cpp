@@ -0,0 +1,95 @@
+#include "sas/CRC16.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * CRC-16 throughput per implementation and message size
+ *
+ * Sizes cover a short long poll, a typical meter response and the largest
+ * SAS message. The batch column runs calculateMany() over 16 buffers of
+ * the same size against 16 single calls.
+ *
+ * Usage: CRC16Benchmark [milliseconds per measurement]
+ */
+
+using sas::CRC16;
+
+typedef uint16_t (*CrcFunction)(const uint8_t*, size_t);
+
+static volatile uint16_t sink;
+
+// Nanoseconds per call of fn over buffers of this size
+template <typename Fn>
+static double measure(Fn fn, double milliseconds) {
+    // Calibrate a batch that takes a measurable time, then time batches
+    size_t iterations = 1;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            fn();
+        }
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed >= milliseconds) {
+            return elapsed * 1e6 / iterations;
+        }
+        iterations *= 2;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    double milliseconds = (argc > 1) ? std::atof(argv[1]) : 200.0;
+
+    struct Variant {
+        const char* name;
+        CrcFunction fn;
+    };
+    const Variant variants[] = {
+        {"nibble", CRC16::calculateNibble},
+        {"table", CRC16::calculateTable},
+        {"slice4", CRC16::calculateSliced4},
+        {"slice8", CRC16::calculateSliced8},
+    };
+    const size_t sizes[] = {4, 16, 64, 258};
+    const size_t BATCH = 16;
+
+    std::vector<uint8_t> data(BATCH * 258);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+
+    std::printf("%6s", "bytes");
+    for (const Variant& variant : variants) {
+        std::printf(" %10s", variant.name);
+    }
+    std::printf(" %10s %10s   (ns per buffer)\n", "single x16", "many x16");
+
+    for (size_t size : sizes) {
+        std::printf("%6zu", size);
+        for (const Variant& variant : variants) {
+            double ns = measure([&] { sink = variant.fn(data.data(), size); }, milliseconds);
+            std::printf(" %10.1f", ns);
+        }
+
+        const uint8_t* pointers[BATCH];
+        size_t lengths[BATCH];
+        uint16_t crcs[BATCH];
+        for (size_t i = 0; i < BATCH; i++) {
+            pointers[i] = data.data() + i * size;
+            lengths[i] = size;
+        }
+        double single = measure([&] {
+            for (size_t i = 0; i < BATCH; i++) {
+                crcs[i] = CRC16::calculate(pointers[i], lengths[i]);
+            }
+            sink = crcs[BATCH - 1];
+        }, milliseconds);
+        double many = measure([&] {
+            CRC16::calculateMany(pointers, lengths, BATCH, crcs);
+            sink = crcs[BATCH - 1];
+        }, milliseconds);
+        std::printf(" %10.1f %10.1f\n", single / BATCH, many / BATCH);
+    }
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "http/HTTPServer.h"
+#include "event/EventService.h"
+#include "simulator/Machine.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * HTTP requests/s and latency against an in-process HTTPServer
+ *
+ * Clients run on their own threads with blocking sockets. Keep-alive runs
+ * reuse one connection per client; the close run opens a connection per
+ * request (Connection: close), which adds accept and teardown.
+ *
+ * Usage: HTTPThroughputBenchmark [seconds per run] [server workers] [path] [port]
+ */
+
+namespace {
+
+struct ClientResult {
+    uint64_t requests;
+    uint64_t errors;
+    std::vector<uint32_t> latencyUs;
+};
+
+int connectTo(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Send one request and read the whole response; false on any error
+bool exchange(int fd, const std::string& request, std::string& buffer) {
+    if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+        return false;
+    }
+
+    buffer.clear();
+    size_t headerEnd = std::string::npos;
+    size_t total = 0;
+    char chunk[16384];
+    for (;;) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+
+        if (headerEnd == std::string::npos) {
+            headerEnd = buffer.find("\r\n\r\n");
+            if (headerEnd == std::string::npos) {
+                continue;
+            }
+            size_t length = 0;
+            size_t field = buffer.find("Content-Length:");
+            if (field != std::string::npos && field < headerEnd) {
+                length = static_cast<size_t>(std::strtoul(buffer.c_str() + field + 15, nullptr, 10));
+            }
+            total = headerEnd + 4 + length;
+        }
+        if (buffer.size() >= total) {
+            return buffer.compare(0, 12, "HTTP/1.1 200") == 0;
+        }
+    }
+}
+
+void runClient(int port, const std::string& path, bool keepAlive,
+               const std::atomic<bool>& stop, ClientResult& result) {
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n"
+                          + (keepAlive ? "" : "Connection: close\r\n") + "\r\n";
+    std::string buffer;
+    int fd = -1;
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        auto start = std::chrono::steady_clock::now();
+        if (fd < 0) {
+            fd = connectTo(port);
+        }
+        bool ok = fd >= 0 && exchange(fd, request, buffer);
+        if (!keepAlive || !ok) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            fd = -1;
+        }
+        if (!ok) {
+            result.errors++;
+            continue;
+        }
+        result.requests++;
+        result.latencyUs.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void runLoad(int port, const std::string& path, size_t clients, bool keepAlive, double seconds) {
+    std::atomic<bool> stop(false);
+    std::vector<ClientResult> results(clients, ClientResult{0, 0, std::vector<uint32_t>()});
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < clients; i++) {
+        threads.push_back(std::thread([&, i] { runClient(port, path, keepAlive, stop, results[i]); }));
+    }
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    std::vector<uint32_t> latencies;
+    for (const ClientResult& result : results) {
+        requests += result.requests;
+        errors += result.errors;
+        latencies.insert(latencies.end(), result.latencyUs.begin(), result.latencyUs.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) -> uint32_t {
+        return latencies.empty() ? 0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+
+    std::printf("%-10s %8zu %12.0f %9u %9u %9u %8llu\n", keepAlive ? "keep-alive" : "close", clients,
+                requests / elapsed, percentile(0.50), percentile(0.99), percentile(1.0),
+                static_cast<unsigned long long>(errors));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    double seconds = (argc > 1) ? std::atof(argv[1]) : 3.0;
+    size_t workers = (argc > 2) ? static_cast<size_t>(std::atoi(argv[2])) : 2;
+    std::string path = (argc > 3) ? argv[3] : "/api/meters";
+    int port = (argc > 4) ? std::atoi(argv[4]) : 18080;
+
+    auto eventService = std::make_shared<event::EventService>();
+    simulator::Machine machine(eventService, nullptr);
+    HTTPServer server(&machine, port, workers);
+    server.start();
+    if (!server.isRunning()) {
+        std::fprintf(stderr, "HTTP server did not start on port %d\n", port);
+        return 1;
+    }
+
+    std::printf("GET %s, %zu server workers, %.1f s per run\n", path.c_str(), workers, seconds);
+    std::printf("%-10s %8s %12s %9s %9s %9s %8s\n", "mode", "clients", "requests/s", "p50 us", "p99 us", "max us", "errors");
+    for (size_t clients : {1, 4, 16, 64}) {
+        runLoad(port, path, clients, true, seconds);
+    }
+    runLoad(port, path, 4, false, seconds);
+
+    server.stop();
+    return 0;
+}
@@ -76,6 +76,11 @@ private:
      * @return Pointer to value or nullptr if not found
      */
     static const rapidjson::Value* navigateToValue(const std::string& key);
+
+    /**
+     * Apply per-category log levels from the "logging" section
+     */
+    static void applyLoggingConfig();
 };
 
 } // namespace config
@@ -0,0 +1,157 @@
+#ifndef CONFIG_METERJOURNAL_H
+#define CONFIG_METERJOURNAL_H
+
+#include "simulator/Machine.h"
+#include <string>
+#include <vector>
+#include <bitset>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace config {
+
+/**
+ * MeterJournal - Append-only write-ahead log of meter changes
+ *
+ * Every write to a journaled meter, and every write to a per-game or
+ * per-denomination meter block (GameMeters), is appended as a fixed
+ * 24-byte record holding the meter's new value (not the increment), so
+ * replaying a record twice is harmless:
+ *
+ *   [0]  magic 0x4D4A ("MJ")   [2]  meter code      [4]  sequence
+ *   [12] value                 [20] block           [22] CRC16 of [0..21]
+ *
+ * (all little-endian). The block says whose meter it is: 0 for the machine
+ * totals, 1-9999 for a game number, DENOM_BLOCK_FLAG | code for a
+ * denomination. record() only queues the change in RAM; a writer
+ * thread appends everything queued and fdatasync()s once per sync
+ * interval (group commit), so a power loss costs at most one interval.
+ * A batch that fails to write or sync is cut back off the file and
+ * retried with the next commit.
+ *
+ * When the file grows past the compaction size the writer saves a
+ * snapshot through MeterPersistence (written to a temp file and renamed
+ * into place) stamped with the last sequence it covers, then truncates
+ * the journal. Replay skips records at or below the snapshot sequence
+ * and stops at the first torn or corrupt record.
+ */
+class MeterJournal {
+public:
+    static constexpr size_t RECORD_SIZE = 24;
+    static constexpr uint16_t RECORD_MAGIC = 0x4D4A;
+    static constexpr uint16_t DENOM_BLOCK_FLAG = 0x8000;
+
+    /**
+     * Constructor
+     * @param machine Machine whose meters are journaled
+     * @param address SAS address (selects the snapshot for compaction)
+     * @param path Journal file path
+     * @param syncIntervalMs Group commit interval
+     * @param compactBytes Journal size that triggers compaction (0 = never)
+     */
+    MeterJournal(simulator::Machine* machine, uint8_t address, const std::string& path,
+                 int syncIntervalMs, size_t compactBytes);
+
+    /**
+     * Destructor - stops the journal (final group commit)
+     */
+    ~MeterJournal();
+
+    /**
+     * Journal a meter code (before start(); all others are ignored)
+     */
+    void addMeter(int meterCode);
+
+    /**
+     * Open the journal for appending and start recording meter writes
+     * @param snapshotSequence Sequence stored in the snapshot loaded at startup
+     * @return true if the file could be opened
+     */
+    bool start(uint64_t snapshotSequence);
+
+    /**
+     * Stop recording, write and sync everything queued, close the file
+     */
+    void stop();
+
+    /**
+     * Write and sync everything queued now
+     * @return false on I/O error
+     */
+    bool sync();
+
+    /**
+     * Save a snapshot covering everything journaled so far, then empty the journal
+     * @return false if the snapshot could not be written (journal is kept)
+     */
+    bool compact();
+
+    bool isRunning() const { return running_; }
+
+    /**
+     * Queue one meter change (called by the MeterStore write observer)
+     */
+    void record(int meterCode, int64_t value);
+
+    /**
+     * Queue one game or denomination meter change (called by the GameMeters
+     * write observer)
+     */
+    void recordGame(simulator::GameMeters::BlockKind kind, int number, int meterCode, int64_t value);
+
+    /**
+     * Apply every valid record after snapshotSequence to machine
+     * Only the last value of each meter (and game/denomination meter) is
+     * written to the machine.
+     * @param path Journal file path
+     * @param machine Machine to update (nullptr only scans)
+     * @param snapshotSequence Records at or below this are skipped
+     * @param lastSequence Receives the highest valid sequence (or snapshotSequence)
+     * @param validLength Receives the length of the valid record prefix
+     * @return Number of records applied, -1 if the file could not be read
+     */
+    static long replay(const std::string& path, simulator::Machine* machine,
+                       uint64_t snapshotSequence, uint64_t& lastSequence, off_t& validLength);
+
+private:
+    struct Entry {
+        uint64_t sequence;
+        int64_t value;
+        uint16_t meterCode;
+        uint16_t block;
+    };
+
+    static bool isValidMeter(uint16_t block, int meterCode);
+    static void encodeRecord(const Entry& entry, uint8_t* record);
+
+    void enqueue(uint16_t block, int meterCode, int64_t value);
+    void writerThread();
+    bool writePending();                // ioMutex_ held
+    bool requeue(std::vector<Entry>& entries);  // ioMutex_ held; always false
+
+    simulator::Machine* machine_;
+    uint8_t address_;
+    std::string path_;
+    int syncIntervalMs_;
+    size_t compactBytes_;
+    std::bitset<simulator::MeterStore::CAPACITY> journaled_;
+
+    int fd_;
+    off_t fileSize_;                    // ioMutex_
+    std::vector<Entry> pending_;        // mutex_
+    uint64_t nextSequence_;             // mutex_
+    std::vector<uint8_t> writeBuffer_;  // ioMutex_
+    std::mutex mutex_;                  // Queue (taken inside MeterStore's write lock)
+    std::mutex ioMutex_;                // File writes, sync and compaction
+    std::condition_variable condition_;
+    std::thread writer_;
+    std::atomic<bool> running_;
+};
+
+} // namespace config
+
+#endif // CONFIG_METERJOURNAL_H
@@ -10,37 +10,119 @@ namespace config {
 /**
  * MeterPersistence - Saves and loads meter values to/from persistent storage
  *
- * Stores meters in /sdboot/meters.json for persistence across reboots
+ * Stores meters in /sdboot/meters.bin for persistence across reboots
  * Minimizes disk writes by:
  * - Loading meters once at startup
  * - Keeping meters in RAM during operation
- * - Saving only on explicit save() call (shutdown, reboot button, etc.)
+ * - Saving the full file only on explicit save() call (shutdown, reboot
+ *   button, etc.) or when the meter journal compacts
+ *
+ * meters.bin is a fixed-layout binary snapshot (see MeterSnapshot) that is
+ * mapped and CRC-checked at startup. Between saves, startJournal() records
+ * every meter change in meters.journal (see MeterJournal), which
+ * loadMeters() replays on top of the snapshot. Files are written to a temp
+ * file and renamed into place, so a power loss leaves either the old or
+ * the new file.
+ *
+ * meters.json is only an import/export format: exportMeters() writes it
+ * and loadMeters() imports it when there is no valid meters.bin.
  */
 class MeterPersistence {
 public:
     /**
      * Load meters from persistent storage into machine
-     * Tries /sdboot/meters.json first, falls back to local meters.json
+     * Tries /sdboot first, falls back to the local directory; uses
+     * meters.bin, or imports meters.json without one, then replays the journal
      * @param machine Machine to load meters into
+     * @param address SAS address of the machine (selects the file, see getMetersPath)
      * @return true if loaded successfully
      */
-    static bool loadMeters(simulator::Machine* machine);
+    static bool loadMeters(simulator::Machine* machine, uint8_t address = 1);
 
     /**
      * Save meters from machine to persistent storage
-     * Saves to /sdboot/meters.json (or local if /sdboot not available)
+     * Saves to /sdboot/meters.bin (or local if /sdboot not available)
      * @param machine Machine to save meters from
+     * @param address SAS address of the machine (selects the file, see getMetersPath)
      * @return true if saved successfully
      */
-    static bool saveMeters(simulator::Machine* machine);
+    static bool saveMeters(simulator::Machine* machine, uint8_t address = 1);
 
     /**
      * Get the path where meters are persisted
+     * Address 1 uses meters.json; other hosted EGMs use meters-<address>.json
+     * @param address SAS address of the machine
      * @return Path to meters.json file
      */
-    static std::string getMetersPath();
+    static std::string getMetersPath(uint8_t address = 1);
+
+    /**
+     * Get the path of the binary snapshot (meters.json -> meters.bin)
+     * @param address SAS address of the machine
+     */
+    static std::string getSnapshotPath(uint8_t address = 1);
+
+    /**
+     * Import meters from the JSON file (getMetersPath)
+     * @param machine Machine to load meters into
+     * @param address SAS address of the machine
+     * @param journalSequence Receives the journal sequence stored in the file (optional)
+     * @return true if the file was read
+     */
+    static bool importMeters(simulator::Machine* machine, uint8_t address = 1,
+                             uint64_t* journalSequence = nullptr);
+
+    /**
+     * Export meters to the JSON file (getMetersPath), e.g. for inspection
+     * @param machine Machine to save meters from
+     * @param address SAS address of the machine
+     * @return true if written
+     */
+    static bool exportMeters(simulator::Machine* machine, uint8_t address = 1);
+
+    /**
+     * Get the path of the meter journal (meters.json -> meters.journal)
+     * @param address SAS address of the machine
+     */
+    static std::string getJournalPath(uint8_t address = 1);
+
+    /**
+     * Start journaling meter changes for a machine (after loadMeters())
+     * @param machine Machine to journal
+     * @param address SAS address of the machine
+     * @param syncIntervalMs Group commit interval
+     * @param compactBytes Journal size that triggers a snapshot (0 = never)
+     * @return true if the journal is running
+     */
+    static bool startJournal(simulator::Machine* machine, uint8_t address,
+                             int syncIntervalMs, size_t compactBytes);
+
+    /**
+     * Stop the journal of a machine (final sync)
+     */
+    static void stopJournal(uint8_t address = 1);
+
+    /**
+     * Atomically write the binary snapshot
+     * @param machine Machine to save meters from
+     * @param address SAS address of the machine
+     * @param journalSequence Last journal record the snapshot includes
+     * @return true if the new file is in place and synced
+     */
+    static bool writeSnapshot(simulator::Machine* machine, uint8_t address, uint64_t journalSequence);
 
 private:
+    /**
+     * Read the journal sequence stored in the meters file (0 if none)
+     */
+    static uint64_t readSnapshotSequence(uint8_t address);
+
+    /**
+     * Apply meter journal records newer than journalSequence
+     * @return true if any record was applied
+     */
+    static bool replayJournal(simulator::Machine* machine, uint8_t address, uint64_t journalSequence);
+
     /**
      * Check if /sdboot is available for persistent storage
      * @return true if /sdboot exists and is writable
@@ -0,0 +1,142 @@
+#ifndef CONFIG_METERSNAPSHOT_H
+#define CONFIG_METERSNAPSHOT_H
+
+#include "simulator/Machine.h"
+#include "simulator/MeterStore.h"
+#include "simulator/GameMeters.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace config {
+
+/**
+ * MeterSnapshot - Fixed-layout binary meter file (meters.bin)
+ *
+ * Layout (little-endian, every section 8-byte aligned):
+ *
+ *   Header            64 bytes (see Header)
+ *   Present bitmap    METER_SLOTS / 8 bytes, bit n set if meter n is valid
+ *   Meter values      METER_SLOTS x int64, indexed by METER_* code
+ *   Game sections     gameCount x GameSection (game and denomination blocks)
+ *   CRC16             2 bytes over everything before it, then 6 bytes padding
+ *
+ * open() maps the file read-only and checks magic, version, sizes and the
+ * CRC before exposing anything, so a torn or foreign file is rejected as a
+ * whole. A valid file restores every meter with one Machine::setMeters().
+ *
+ * The format version is bumped whenever the layout changes; files with
+ * another version are rejected (JSON export/import covers migrations).
+ */
+class MeterSnapshot {
+public:
+    static constexpr uint32_t MAGIC = 0x534D4745;              // "EGMS"
+    static constexpr uint16_t FORMAT_VERSION = 2;
+    static constexpr int METER_SLOTS = simulator::MeterStore::CAPACITY;
+
+    struct Header {
+        uint32_t magic;
+        uint16_t formatVersion;
+        uint16_t headerSize;            // sizeof(Header)
+        uint32_t meterSlots;            // METER_SLOTS
+        uint32_t gameCount;
+        uint32_t gameSectionSize;       // sizeof(GameSection)
+        uint32_t reserved0;
+        uint64_t journalSequence;       // Last meter journal record included
+        int64_t savedAt;                // Unix time
+        uint64_t fileSize;
+        uint8_t reserved[16];
+    };
+
+    enum SectionKind : uint16_t {
+        SECTION_GAME = 0,               // Meters of one game number
+        SECTION_DENOMINATION = 1        // Meters of one denomination code
+    };
+
+    struct GameSection {
+        uint32_t gameNumber;            // SECTION_GAME
+        uint16_t denomCode;             // SECTION_DENOMINATION (first denomination for games)
+        uint16_t kind;                  // SectionKind
+        int64_t meters[simulator::GameMeters::FIELD_COUNT];    // In GameMeters::Field order
+        int64_t reserved;
+    };
+
+    MeterSnapshot();
+    ~MeterSnapshot();
+
+    MeterSnapshot(const MeterSnapshot&) = delete;
+    MeterSnapshot& operator=(const MeterSnapshot&) = delete;
+
+    /**
+     * Map and validate a snapshot file
+     * @param path File to open
+     * @return true if the file is a complete snapshot of this format version
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Validate a snapshot image held in memory (e.g. from encode()) and
+     * keep a copy of it
+     * @param image Snapshot file contents
+     * @return true if the image is a complete snapshot of this format version
+     */
+    bool load(const std::vector<uint8_t>& image);
+
+    /**
+     * Unmap the file (or drop the loaded image)
+     */
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+
+    const Header& getHeader() const { return *header_; }
+    uint64_t getJournalSequence() const { return header_->journalSequence; }
+
+    bool hasMeter(int meterCode) const;
+    int64_t getMeter(int meterCode) const;
+
+    size_t getGameCount() const { return header_->gameCount; }
+    const GameSection& getGame(size_t index) const { return games_[index]; }
+
+    /**
+     * Write every valid meter into the machine (one lock, one version step),
+     * then the game and denomination blocks
+     * @return Number of machine meters restored
+     */
+    size_t applyTo(simulator::Machine* machine) const;
+
+    /**
+     * Build a snapshot image of the machine's meters and games
+     * @param machine Machine to capture
+     * @param journalSequence Last journal record the meters include
+     * @return File contents
+     */
+    static std::vector<uint8_t> encode(const simulator::Machine& machine, uint64_t journalSequence);
+
+private:
+    static size_t fileSizeFor(size_t gameCount);
+
+    /**
+     * Check magic, layout, size and CRC of a snapshot image
+     * @return Problem description, or nullptr if the image is valid
+     */
+    static const char* validate(const uint8_t* bytes, size_t size);
+
+    /**
+     * Point the section pointers into data_
+     */
+    void expose();
+
+    void* data_;                        // Mapping, or copy_.data()
+    size_t size_;
+    const Header* header_;
+    const uint8_t* present_;
+    const int64_t* values_;
+    const GameSection* games_;
+    std::vector<int64_t> copy_;         // Image given to load(), 8-byte aligned
+};
+
+} // namespace config
+
+#endif // CONFIG_METERSNAPSHOT_H
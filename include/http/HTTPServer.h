@@ -6,16 +6,60 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <rapidjson/stringbuffer.h>
 
 // Forward declaration
 namespace simulator {
     class Machine;
 }
 
+namespace event {
+    class EventService;
+}
+
+namespace sas {
+    class SASCommPort;
+}
+
+/**
+ * HTTPServer - REST API and static files for the web console
+ *
+ * A fixed pool of worker threads waits on one epoll instance. Sockets are
+ * registered EPOLLONESHOT. The push thread may re-arm a connection whose
+ * event a worker already dequeued, so a worker first claims the connection
+ * (busy, under the connections lock) and drops the event if another worker
+ * owns it; the owner keeps it until it re-arms. Connections are HTTP/1.1
+ * keep-alive: bytes are accumulated until a full request (headers plus
+ * Content-Length body) is present, and pipelined requests are answered in
+ * order. Idle connections are closed after KEEPALIVE_TIMEOUT_MS.
+ *
+ * GET /api/events turns a connection into a Server-Sent Events stream for
+ * one machine: a full "meters" event, then only the meters that changed,
+ * coalesced per stream interval, plus an "exception" event for every
+ * exception a comm port queues. The push thread computes each machine's
+ * delta once and queues it on every stream; workers do the writes. A
+ * stream's opening snapshot can be older or newer than the last push, so
+ * its first push carries every meter unless nothing changed since it.
+ *
+ * The /api/meters body is rendered once per meter version and cached per
+ * machine. Its ETag is the version, so a scraper sending If-None-Match
+ * gets 304 Not Modified until a meter changes.
+ *
+ * GET /api/metrics exports the SAS ports' per-command counters and
+ * latency histograms in the Prometheus text format.
+ *
+ * POST /api/trace starts, stops or clears span tracing; GET /api/trace
+ * dumps the recorded spans as Chrome trace_event JSON.
+ */
 class HTTPServer {
 public:
-    HTTPServer(simulator::Machine* machine, int port = 8080);
+    HTTPServer(simulator::Machine* machine, int port = 8080, size_t workerCount = 2);
     ~HTTPServer();
 
     // Start/stop server
@@ -26,49 +70,158 @@ public:
     // Get server info
     std::string getIPAddress();
 
-private:
-    // Server thread function
-    void serverThread();
+    // Register a hosted EGM under /api/machines/{address}/...
+    // The machine passed to the constructor also serves the plain /api/... routes
+    // Its SAS port, when given, is exported by /api/metrics
+    void addMachine(uint8_t address, simulator::Machine* machine, sas::SASCommPort* sasPort = nullptr);
 
-    // Request handling
-    void handleClient(int clientSocket);
-    std::string handleRequest(const std::string& request);
+    // Minimum time between event stream pushes (before start())
+    void setStreamIntervalMs(int intervalMs);
 
+private:
     // HTTP parsing
     struct HTTPRequest {
         std::string method;      // GET, POST, etc.
         std::string path;        // /api/status
+        std::string version;     // HTTP/1.1
         std::string body;        // POST body
-        std::map<std::string, std::string> headers;
+        std::map<std::string, std::string> headers;     // Keys lower-case
+    };
+
+    struct HTTPResponse {
+        int statusCode;
+        std::string contentType;
+        std::string body;
+        simulator::Machine* stream;     // Non-null: connection becomes this machine's event stream
+        uint64_t streamVersion;         // Meters version of the stream's opening snapshot
+        std::string etag;               // Sent as ETag when non-empty
+    };
+
+    // One accepted socket; touched only by the worker that owns it
+    struct Connection {
+        int fd;
+        std::string input;          // Received bytes not yet parsed
+        std::string output;         // Response bytes not yet sent
+        size_t outputOffset;
+        bool closeAfterWrite;
+        bool busy;                  // Claimed by a worker, not yet re-armed
+        std::chrono::steady_clock::time_point lastActivity;
+        simulator::Machine* streamMachine;  // Set for /api/events connections
+        std::string streamPending;  // Events queued by the push thread
+        bool streamSynced;          // Client holds the shared delta baseline
+        uint64_t streamVersion;     // Meters version of the opening snapshot
+    };
+
+    // Per-machine event stream state (guarded by streamMutex_)
+    struct StreamState {
+        bool primed;                        // meters/version hold the last pushed values
+        uint64_t version;
+        std::vector<int64_t> meters;        // Indexed like the /api/meters key table
+        std::vector<uint8_t> exceptions;    // Queued since the last push
+    };
+
+    // Last rendered /api/meters body of one machine (guarded by metersCacheMutex_)
+    struct MetersCache {
+        bool valid;
+        uint64_t version;                   // Machine::getMetersVersion() of body
+        std::string body;
+        std::string etag;
+    };
+
+    // Event loop (worker threads)
+    void workerThread(size_t index);
+    void acceptConnections();
+    void serviceConnection(uint64_t id, uint32_t events);
+    bool readRequests(Connection& conn);
+    bool flushOutput(Connection& conn);
+    void releaseConnection(uint64_t id, Connection& conn);
+    void closeConnection(uint64_t id);
+    void closeIdleConnections();
+
+    // Event streams
+    void pushThread();
+    void pushStreamUpdates(bool heartbeat);
+    struct StreamPayload {
+        uint64_t version;       // Meters version the events reflect
+        std::string delta;      // For streams holding the previous push
+        std::string full;       // Every meter, for streams opened since (when asked)
     };
+    StreamPayload buildStreamEvents(simulator::Machine* machine, bool full);
+    void subscribeEvents(std::shared_ptr<event::EventService> eventService);
+
+    // Request handling
+    HTTPResponse handleRequest(const HTTPRequest& req);
 
     HTTPRequest parseRequest(const std::string& request);
-    std::string buildResponse(int statusCode, const std::string& contentType, const std::string& body);
+    HTTPResponse buildResponse(int statusCode, const std::string& contentType, const std::string& body);
+    std::string formatResponse(const HTTPResponse& response, bool keepAlive);
 
-    // API endpoint handlers
-    std::string handleGET_Status();
+    // API endpoint handlers (machine: the EGM addressed by the request)
+    std::string handleGET_Machines();
+    std::string handleGET_Status(simulator::Machine* machine);
     std::string handleGET_IP();
-    std::string handleGET_Denoms();
+    std::string handleGET_Denoms(simulator::Machine* machine);
     std::string handleGET_Exceptions();
-    std::string handleGET_Meters();
-    std::string handlePOST_Play(const std::string& body);
-    std::string handlePOST_Cashout(const std::string& body);
-    std::string handlePOST_Denom(const std::string& body);
+    HTTPResponse handleGET_Meters(simulator::Machine* machine, const HTTPRequest& req);
+    std::string handleGET_Logging();
+    std::string handleGET_Metrics();
+    std::string handleGET_Trace();
+    HTTPResponse handleGET_Events(simulator::Machine* machine);
+    std::string handlePOST_Play(simulator::Machine* machine, const std::string& body);
+    std::string handlePOST_Cashout(simulator::Machine* machine, const std::string& body);
+    std::string handlePOST_Denom(simulator::Machine* machine, const std::string& body);
     std::string handlePOST_Exception(const std::string& body);
-    std::string handlePOST_BillInsert(const std::string& body);
+    std::string handlePOST_BillInsert(simulator::Machine* machine, const std::string& body);
     std::string handlePOST_Reboot(const std::string& body);
+    std::string handlePOST_Logging(const std::string& body);
+    std::string handlePOST_Trace(const std::string& body);
 
     // Static file serving
-    std::string handleStaticFile(const std::string& path);
+    HTTPResponse handleStaticFile(const std::string& path);
     std::string getMimeType(const std::string& path);
 
     // Members
-    simulator::Machine* machine_;
+    simulator::Machine* machine_;                           // Primary machine (plain /api routes)
+    std::map<uint8_t, simulator::Machine*> machines_;       // Hosted machines by SAS address
+    std::map<uint8_t, sas::SASCommPort*> sasPorts_;         // Their SAS ports (/api/metrics)
     int port_;
     int serverSocket_;
-    std::thread serverThread_;
+    int epollFd_;
+    int wakeFd_;                                            // eventfd, signalled by stop()
+    size_t workerCount_;
+    std::vector<std::thread> workers_;
     std::atomic<bool> running_;
     std::recursive_mutex mutex_;
+
+    std::map<uint64_t, std::shared_ptr<Connection>> connections_;   // By epoll id
+    std::mutex connectionsMutex_;
+    uint64_t nextConnectionId_;
+
+    std::map<const simulator::Machine*, MetersCache> metersCache_;
+    rapidjson::StringBuffer metersBuffer_;                  // Reused for every render
+    std::mutex metersCacheMutex_;
+    std::string etagPrefix_;                                // Differs per process run
+
+    std::map<const simulator::Machine*, StreamState> streamStates_;
+    std::vector<std::pair<std::shared_ptr<event::EventService>, int>> eventSubscriptions_;
+    std::mutex streamMutex_;
+    std::condition_variable streamCondition_;               // Wakes the push thread
+    std::thread pushThread_;
+    std::atomic<size_t> streamCount_;                       // Open event streams
+    int streamIntervalMs_;
+
+    static constexpr uint64_t LISTEN_ID = 0;                // epoll ids below FIRST_CONNECTION_ID
+    static constexpr uint64_t WAKE_ID = 1;
+    static constexpr uint64_t FIRST_CONNECTION_ID = 2;
+    static constexpr int LISTEN_BACKLOG = 64;
+    static constexpr size_t MAX_CONNECTIONS = 256;
+    static constexpr size_t MAX_HEADER_SIZE = 8192;
+    static constexpr size_t MAX_BODY_SIZE = 1024 * 1024;
+    static constexpr int KEEPALIVE_TIMEOUT_MS = 30000;
+    static constexpr int IDLE_CHECK_INTERVAL_MS = 1000;
+    static constexpr int STREAM_HEARTBEAT_MS = 15000;
+    static constexpr size_t MAX_STREAM_BACKLOG = 256 * 1024;    // Unsent bytes before a slow stream is dropped
+    static constexpr size_t MAX_QUEUED_EXCEPTIONS = 64;
 };
 
 #endif // HTTP_HTTPSERVER_H
@@ -0,0 +1,115 @@
+#ifndef IO_BYTERING_H
+#define IO_BYTERING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+
+namespace io {
+
+/**
+ * ByteRing - Fixed-capacity receive ring buffer
+ *
+ * Reusable byte FIFO for the receive path. Storage is inline, so draining
+ * a channel into the ring never allocates. Not thread-safe: each ring is
+ * owned by the single thread that reads its channel.
+ *
+ * Channels can fill the ring in place with writePtr()/commitWrite(), which
+ * exposes the contiguous free space up to the wrap point.
+ */
+class ByteRing {
+public:
+    static constexpr size_t CAPACITY = 512;     // Bytes (power of 2)
+
+    ByteRing() : head_(0), tail_(0) {}
+
+    size_t size() const { return tail_ - head_; }
+    bool empty() const { return tail_ == head_; }
+    bool full() const { return size() == CAPACITY; }
+    size_t freeSpace() const { return CAPACITY - size(); }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+    void clear() {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    /**
+     * Byte at offset from the oldest byte (offset < size())
+     */
+    uint8_t operator[](size_t offset) const {
+        return bytes_[(head_ + offset) & MASK];
+    }
+
+    /**
+     * Append bytes
+     * @return Number of bytes appended (less than count if the ring fills)
+     */
+    size_t push(const uint8_t* data, size_t count) {
+        size_t toCopy = std::min(count, freeSpace());
+        for (size_t copied = 0; copied < toCopy; ) {
+            size_t contiguous = 0;
+            uint8_t* out = writePtr(contiguous);
+            size_t chunk = std::min(contiguous, toCopy - copied);
+            std::memcpy(out, data + copied, chunk);
+            commitWrite(chunk);
+            copied += chunk;
+        }
+        return toCopy;
+    }
+
+    /**
+     * Copy bytes out from the front without consuming them
+     * @return Number of bytes copied
+     */
+    size_t peek(uint8_t* out, size_t count) const {
+        size_t toCopy = std::min(count, size());
+        size_t start = head_ & MASK;
+        size_t first = std::min(toCopy, CAPACITY - start);
+        std::memcpy(out, bytes_ + start, first);
+        std::memcpy(out + first, bytes_, toCopy - first);
+        return toCopy;
+    }
+
+    /**
+     * Drop bytes from the front
+     */
+    void discard(size_t count) {
+        head_ += std::min(count, size());
+        if (head_ == tail_) {
+            clear();
+        }
+    }
+
+    /**
+     * Contiguous free region for in-place writes
+     * @param contiguous Set to the number of bytes writable at the returned pointer
+     */
+    uint8_t* writePtr(size_t& contiguous) {
+        size_t start = tail_ & MASK;
+        contiguous = std::min(freeSpace(), CAPACITY - start);
+        return bytes_ + start;
+    }
+
+    /**
+     * Publish count bytes written through writePtr()
+     */
+    void commitWrite(size_t count) {
+        tail_ += count;
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "ByteRing capacity must be a power of 2");
+
+    uint8_t bytes_[CAPACITY];
+    size_t head_;       // Monotonic read position
+    size_t tail_;       // Monotonic write position
+};
+
+} // namespace io
+
+
+#endif // IO_BYTERING_H
@@ -1,10 +1,14 @@
 #ifndef IO_COMMCHANNEL_H
 #define IO_COMMCHANNEL_H
 
+#include "io/ByteRing.h"
 #include <cstdint>
+#include <string>
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
 
 
 namespace io {
@@ -43,6 +47,24 @@ public:
     virtual int read(uint8_t* buffer, int maxBytes,
                     std::chrono::milliseconds timeout) = 0;
 
+    /**
+     * Event-driven receive: block until data arrives (or timeout), then
+     * drain every byte currently available into the ring in one call.
+     * The default implementation wraps read(); channels with a real wait
+     * primitive (file descriptor, condition variable) override it.
+     * @param ring Reusable receive ring to append to
+     * @param timeout Maximum time to wait for the first byte
+     * @return Number of bytes appended (0 on timeout or full ring, -1 on error)
+     */
+    virtual int receive(ByteRing& ring, std::chrono::milliseconds timeout);
+
+    /**
+     * File descriptor that becomes readable when receive() has data, so a
+     * shared worker can wait on many channels with a single poll().
+     * @return Readable fd, or -1 if the channel has no pollable descriptor
+     */
+    virtual int getReadFd() const { return -1; }
+
     /**
      * Write bytes to the channel
      * @param buffer Buffer to write from
@@ -76,6 +98,7 @@ public:
     bool isOpen() const override;
     int read(uint8_t* buffer, int maxBytes,
             std::chrono::milliseconds timeout) override;
+    int receive(ByteRing& ring, std::chrono::milliseconds timeout) override;
     int write(const uint8_t* buffer, int numBytes) override;
     void flush() override;
     std::string getName() const override;
@@ -89,6 +112,8 @@ private:
     std::string name_;
     bool isOpen_;
     std::vector<uint8_t> inputBuffer_;
+    std::mutex inputMutex_;                     // Guards inputBuffer_
+    std::condition_variable inputReady_;        // Signalled by the peer's write()
     std::shared_ptr<PipedCommChannel> connectedChannel_;
 };
 
@@ -0,0 +1,263 @@
+#ifndef IO_EXCEPTIONQUEUE_H
+#define IO_EXCEPTIONQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+
+namespace io {
+
+/**
+ * ExceptionQueue - Bounded lock-free exception queue with priorities
+ *
+ * Any thread may push(); only the thread answering general polls pops.
+ * Neither side ever takes a lock, so a general poll is never held up by
+ * a producer (and vice versa).
+ *
+ * Exceptions are kept in one ring per priority and popped highest
+ * priority first, FIFO within a priority:
+ *
+ *   HIGH     handpays, progressive wins, tilts and RAM/printer faults
+ *   NORMAL   doors, bills, tickets, option changes and anything not listed
+ *   LOW      game started/ended/selected (informational)
+ *
+ * A code that is already waiting is not queued again (coalesced), so a
+ * door bouncing between polls costs one slot. Exceptions that carry event
+ * data (real-time event reporting) are never coalesced: every game start
+ * or bill has its own data. When a ring is full the exception is dropped
+ * and counted as an overflow.
+ *
+ * Each ring is a bounded MPSC queue: producers claim a cell by advancing
+ * the tail with a CAS, then publish it through the cell's sequence
+ * number; the consumer checks that sequence before reading.
+ */
+class ExceptionQueue {
+public:
+    static constexpr size_t CAPACITY = 32;      // Per priority (power of 2, SAS asks for 20+)
+    static constexpr size_t MAX_DATA = 14;      // Event data bytes carried per exception
+
+    enum Priority {
+        PRIORITY_HIGH = 0,
+        PRIORITY_NORMAL,
+        PRIORITY_LOW,
+        PRIORITY_COUNT
+    };
+
+    enum PushResult {
+        QUEUED,
+        COALESCED,
+        OVERFLOWED
+    };
+
+    struct Statistics {
+        uint64_t queued = 0;            // Accepted into a ring
+        uint64_t coalesced = 0;         // Same code already waiting
+        uint64_t overflows = 0;         // Dropped, ring full
+        size_t pending = 0;
+    };
+
+    ExceptionQueue() : queued_(0), coalesced_(0), overflows_(0) {
+        for (int p = 0; p < PRIORITY_COUNT; p++) {
+            rings_[p].tail.store(0, std::memory_order_relaxed);
+            rings_[p].head.store(0, std::memory_order_relaxed);
+            for (size_t i = 0; i < CAPACITY; i++) {
+                rings_[p].cells[i].sequence.store(i, std::memory_order_relaxed);
+                rings_[p].cells[i].code = 0;
+                rings_[p].cells[i].length = 0;
+            }
+        }
+        for (int code = 0; code < 256; code++) {
+            waiting_[code].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    ExceptionQueue(const ExceptionQueue&) = delete;
+    ExceptionQueue& operator=(const ExceptionQueue&) = delete;
+
+    /**
+     * Priority an exception code is queued at
+     */
+    static Priority priorityOf(uint8_t code) {
+        switch (code) {
+            case 0x00:                  // Handpay pending (Exception::HANDPAY_PENDING)
+            case 0x01:                  // Progressive win
+            case 0x51:                  // Handpay is pending
+            case 0x52:                  // Handpay was reset
+            case 0x54:                  // Progressive win
+            case 0x56:                  // SAS progressive level hit
+            case 0x60:                  // Printer communication error
+            case 0x61:                  // Printer paper out
+                return PRIORITY_HIGH;
+            case 0x3C:                  // Operator changed options
+            case 0x3D:                  // Cash out ticket printed
+            case 0x3E:                  // Handpay validated
+                return PRIORITY_NORMAL;
+            case 0x7E:                  // Game has started
+            case 0x7F:                  // Game has ended
+            case 0x8C:                  // Game selected
+            case 0x90:                  // Game started (Exception::GAME_STARTED)
+                return PRIORITY_LOW;
+            default:
+                // General, coin and bill tilts, RAM/EEPROM errors, card cage access
+                return (code >= 0x20 && code <= 0x3F) ? PRIORITY_HIGH : PRIORITY_NORMAL;
+        }
+    }
+
+    /**
+     * Queue an exception (any thread, lock-free)
+     * @param code Exception code
+     * @param data Event data reported with the code (optional)
+     * @param length Event data length (at most MAX_DATA, the rest is cut)
+     */
+    PushResult push(uint8_t code, const uint8_t* data = nullptr, size_t length = 0) {
+        if (length > MAX_DATA) {
+            length = MAX_DATA;
+        }
+        bool coalesce = (length == 0);
+        if (coalesce && waiting_[code].exchange(true, std::memory_order_acq_rel)) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            return COALESCED;
+        }
+
+        Ring& ring = rings_[priorityOf(code)];
+        size_t position = ring.tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &ring.cells[position & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (ring.tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Consumer has not freed this cell yet: ring full
+                if (coalesce) {
+                    waiting_[code].store(false, std::memory_order_release);
+                }
+                overflows_.fetch_add(1, std::memory_order_relaxed);
+                return OVERFLOWED;
+            } else {
+                position = ring.tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->code = code;
+        cell->length = static_cast<uint8_t>(length);
+        if (length > 0) {
+            memcpy(cell->data, data, length);
+        }
+        cell->sequence.store(position + 1, std::memory_order_release);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+        return QUEUED;
+    }
+
+    /**
+     * Take the highest-priority exception (consumer thread only, wait-free)
+     * @param code Exception code
+     * @param data Receives the event data (MAX_DATA bytes)
+     * @param length Event data length (0 for a bare exception)
+     * @return false if nothing is waiting
+     */
+    bool pop(uint8_t& code, uint8_t* data, size_t& length) {
+        for (int p = 0; p < PRIORITY_COUNT; p++) {
+            Ring& ring = rings_[p];
+            size_t head = ring.head.load(std::memory_order_relaxed);
+            Cell& cell = ring.cells[head & MASK];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+                continue;               // Empty, or the next push is still being written
+            }
+            code = cell.code;
+            length = cell.length;
+            if (length > 0) {
+                memcpy(data, cell.data, length);
+            } else {
+                // A repeat from here on is a new occurrence and gets its own slot
+                waiting_[code].store(false, std::memory_order_release);
+            }
+            cell.sequence.store(head + CAPACITY, std::memory_order_release);
+            ring.head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Take the highest-priority exception, dropping its event data
+     * @return false if nothing is waiting
+     */
+    bool pop(uint8_t& code) {
+        uint8_t data[MAX_DATA];
+        size_t length;
+        return pop(code, data, length);
+    }
+
+    /**
+     * Check whether anything is waiting (a snapshot; producers may add more)
+     */
+    bool empty() const {
+        return pending() == 0;
+    }
+
+    /**
+     * Number of exceptions waiting (approximate while producers are active)
+     */
+    size_t pending() const {
+        size_t total = 0;
+        for (int p = 0; p < PRIORITY_COUNT; p++) {
+            size_t head = rings_[p].head.load(std::memory_order_acquire);
+            size_t tail = rings_[p].tail.load(std::memory_order_acquire);
+            total += (tail > head) ? tail - head : 0;
+        }
+        return total;
+    }
+
+    /**
+     * Drop everything waiting (consumer thread only)
+     */
+    void clear() {
+        uint8_t code;
+        while (pop(code)) {
+        }
+    }
+
+    Statistics getStatistics() const {
+        Statistics stats;
+        stats.queued = queued_.load(std::memory_order_relaxed);
+        stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+        stats.overflows = overflows_.load(std::memory_order_relaxed);
+        stats.pending = pending();
+        return stats;
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of 2");
+
+    struct Cell {
+        std::atomic<size_t> sequence;   // position: free, position + 1: holds a code
+        uint8_t code;
+        uint8_t length;                 // Event data length (0: bare, coalesced code)
+        uint8_t data[MAX_DATA];
+    };
+
+    struct Ring {
+        Cell cells[CAPACITY];
+        std::atomic<size_t> tail;               // Producers
+        uint8_t padding[64];                    // Keep tail and head on separate cache lines
+        std::atomic<size_t> head;               // Written by the consumer only
+    };
+
+    Ring rings_[PRIORITY_COUNT];
+    std::atomic<bool> waiting_[256];            // Code has a slot in a ring
+    std::atomic<uint64_t> queued_;
+    std::atomic<uint64_t> coalesced_;
+    std::atomic<uint64_t> overflows_;
+};
+
+} // namespace io
+
+
+#endif // IO_EXCEPTIONQUEUE_H
@@ -2,10 +2,8 @@
 #define IO_MACHINECOMMPORT_H
 
 #include "CommChannel.h"
+#include "ExceptionQueue.h"
 #include <memory>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
 
 
 
@@ -26,7 +24,7 @@ namespace io {
  * Each protocol port manages:
  * - A communication channel (serial port, network, etc.)
  * - Protocol-specific message framing
- * - Exception queue for event reporting
+ * - Exception queue for event reporting (lock-free, see ExceptionQueue)
  * - Command/response handling
  */
 class MachineCommPort {
@@ -77,13 +75,16 @@ public:
     virtual std::string getName() const = 0;
 
     /**
-     * Queue an exception for reporting
+     * Queue an exception for reporting (any thread, never blocks)
      * @param exceptionCode Protocol-specific exception code
+     * @param data Event data reported with the code (optional, at most
+     *             ExceptionQueue::MAX_DATA bytes; never coalesced)
+     * @param length Event data length
      */
-    virtual void queueException(uint8_t exceptionCode);
+    virtual void queueException(uint8_t exceptionCode, const uint8_t* data = nullptr, size_t length = 0);
 
     /**
-     * Clear all queued exceptions
+     * Clear all queued exceptions (polling thread only)
      */
     virtual void clearExceptions();
 
@@ -92,27 +93,27 @@ public:
      */
     virtual bool hasExceptions() const;
 
-protected:
     /**
-     * Exception queue entry
+     * Get exception queue counters (queued, coalesced, overflows, pending)
      */
-    struct Exception {
-        uint8_t code;
-        uint64_t timestamp;  // Milliseconds since epoch
+    ExceptionQueue::Statistics getExceptionStatistics() const { return exceptions_.getStatistics(); }
 
-        Exception(uint8_t c, uint64_t ts) : code(c), timestamp(ts) {}
-    };
+protected:
+    /**
+     * Take the next exception to report, highest priority first
+     * (polling thread only)
+     * @param exceptionCode Exception code
+     * @param data Receives the event data (ExceptionQueue::MAX_DATA bytes)
+     * @param length Event data length (0 for a bare exception)
+     * @return false if none is pending
+     */
+    bool popException(uint8_t& exceptionCode, uint8_t* data, size_t& length) {
+        return exceptions_.pop(exceptionCode, data, length);
+    }
 
     simulator::Machine* machine_;                   // Associated machine
     std::shared_ptr<CommChannel> channel_;          // Communication channel
-    std::queue<Exception> exceptionQueue_;          // Pending exceptions
-    mutable std::recursive_mutex exceptionMutex_;   // Exception queue mutex
-    std::condition_variable exceptionCondition_;    // Exception notification
-
-    /**
-     * Get current timestamp in milliseconds
-     */
-    static uint64_t getCurrentTimestamp();
+    ExceptionQueue exceptions_;                     // Pending exceptions
 };
 
 } // namespace io
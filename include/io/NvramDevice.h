@@ -0,0 +1,99 @@
+#ifndef IO_NVRAMDEVICE_H
+#define IO_NVRAMDEVICE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace io {
+
+/**
+ * NvramDevice - Non-volatile memory addressed by byte offset
+ *
+ * On the S7 Lite this is the battery-backed SRAM (see ZeusNvramDevice in
+ * ZeusPlatform.h); elsewhere FileNvramDevice stands in with a mapped file.
+ *
+ * Offsets and lengths must be even: the S7Lite SRAM API works in 16-bit
+ * words. write() returns once every block is durable. Blocks passed to one
+ * write() may land in any order, but separate write() calls are ordered,
+ * which is what NvramStore relies on to commit a bank header last.
+ */
+class NvramDevice {
+public:
+    struct Block {
+        size_t offset;
+        const uint8_t* data;
+        size_t length;
+    };
+
+    virtual ~NvramDevice() {}
+
+    /**
+     * Get the device size in bytes
+     */
+    virtual size_t getSize() const = 0;
+
+    /**
+     * Read a range
+     * @return true if successful
+     */
+    virtual bool read(size_t offset, uint8_t* buffer, size_t length) = 0;
+
+    /**
+     * Write several ranges and make them durable
+     * @param blocks Ranges to write
+     * @param count Number of ranges
+     * @return true if every range was written
+     */
+    virtual bool write(const Block* blocks, size_t count) = 0;
+
+    /**
+     * Get a description for log messages
+     */
+    virtual std::string getName() const = 0;
+};
+
+/**
+ * FileNvramDevice - NVRAM stand-in backed by a memory-mapped file
+ *
+ * Used on development hosts. The file is created (zero-filled) or grown
+ * to the requested size; write() copies into the mapping and msync()s the
+ * touched pages before returning.
+ */
+class FileNvramDevice : public NvramDevice {
+public:
+    /**
+     * Constructor
+     * @param path Backing file
+     * @param size Device size in bytes
+     */
+    FileNvramDevice(const std::string& path, size_t size);
+
+    /**
+     * Destructor - unmaps the file
+     */
+    ~FileNvramDevice() override;
+
+    FileNvramDevice(const FileNvramDevice&) = delete;
+    FileNvramDevice& operator=(const FileNvramDevice&) = delete;
+
+    /**
+     * Create or open the backing file and map it
+     * @return true if successful
+     */
+    bool open();
+
+    size_t getSize() const override { return size_; }
+    bool read(size_t offset, uint8_t* buffer, size_t length) override;
+    bool write(const Block* blocks, size_t count) override;
+    std::string getName() const override { return path_; }
+
+private:
+    std::string path_;
+    size_t size_;
+    uint8_t* data_;
+};
+
+} // namespace io
+
+#endif // IO_NVRAMDEVICE_H
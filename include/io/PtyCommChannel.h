@@ -0,0 +1,79 @@
+#ifndef IO_PTYCOMMCHANNEL_H
+#define IO_PTYCOMMCHANNEL_H
+
+#include "CommChannel.h"
+#include <string>
+
+
+namespace io {
+
+/**
+ * PtyCommChannel - Pseudo-terminal backed channel for the simulated build
+ *
+ * Opens the master side of a pty in raw mode. A SAS master (host emulator,
+ * socat, a test script) connects to the slave device reported by
+ * getSlaveName(), so the emulator can be polled on plain Linux without
+ * Zeus hardware.
+ *
+ * Receive is event-driven: the channel blocks in poll() on the master file
+ * descriptor and drains every available byte per wakeup, so it uses no CPU
+ * while idle.
+ *
+ * A pty has no 9th (wakeup) bit, so the master side writes polls in the
+ * same form the S7Lite API delivers them: address byte already stripped.
+ *
+ * Constructed with a device path, the channel instead opens that existing
+ * tty (e.g. another emulator's slave device) in raw mode, so a SAS master
+ * in this process (SASDaemon) can poll it.
+ */
+class PtyCommChannel : public CommChannel {
+public:
+    PtyCommChannel(const std::string& name);
+
+    /**
+     * Channel on an existing tty device instead of a new pty
+     * @param name Channel name
+     * @param devicePath Device to open (e.g. /dev/pts/3)
+     */
+    PtyCommChannel(const std::string& name, const std::string& devicePath);
+    ~PtyCommChannel() override;
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    int read(uint8_t* buffer, int maxBytes,
+             std::chrono::milliseconds timeout) override;
+    int receive(ByteRing& ring, std::chrono::milliseconds timeout) override;
+    int getReadFd() const override { return masterFd_; }
+    int write(const uint8_t* buffer, int numBytes) override;
+    void flush() override;
+    std::string getName() const override;
+
+    /**
+     * Get the slave device path (e.g. /dev/pts/3) for the master side to open
+     */
+    std::string getSlaveName() const;
+
+private:
+    /**
+     * Wait until the master fd is readable
+     * @return 1 if readable, 0 on timeout, -1 on error
+     */
+    int waitReadable(std::chrono::milliseconds timeout);
+
+    /**
+     * Open devicePath_ as the read/write descriptor
+     */
+    bool openDevice();
+
+    std::string name_;
+    std::string devicePath_;    // Existing device to open, empty for a new pty
+    std::string slaveName_;
+    int masterFd_;
+    int slaveFd_;       // Held open so the master never sees hangup between clients
+};
+
+} // namespace io
+
+
+#endif // IO_PTYCOMMCHANNEL_H
@@ -23,6 +23,7 @@ class SASSerialPortImpl;
  * - Simplified for slave mode (no polling delays needed)
  * - Focused on read/write operations
  * - No timing enforcement (slave responds when polled)
+ * - Delivers raw bytes; poll boundaries are found by sas::SASFrameParser
  */
 class SASSerialPort : public CommChannel {
 public:
@@ -36,13 +37,27 @@ public:
 
     int read(uint8_t* buffer, int maxBytes,
              std::chrono::milliseconds timeout) override;
+    int receive(ByteRing& ring, std::chrono::milliseconds timeout) override;
     int write(const uint8_t* buffer, int numBytes) override;
     void flush() override;
     std::string getName() const override;
 
 private:
+    static constexpr unsigned int RX_CHUNK_WORDS = 256;     // Max words per GetBuffer drain
+    static constexpr unsigned int TX_MAX_WORDS = 512;       // Max response size in words
+
+    /**
+     * Copy every byte the UART has buffered into out, waiting up to timeout
+     * for the first one
+     * @return Number of bytes copied (0 on timeout)
+     */
+    int drain(uint8_t* out, size_t capacity, std::chrono::milliseconds timeout);
+
     bool isOpen_;
     bool dllInitialized_;
+    uint64_t getBufferCalls_;               // GetBuffer calls (periodic TRACE output)
+
+    uint16_t rxWords_[RX_CHUNK_WORDS];      // Reusable 9-bit GetBuffer scratch
 
     // Platform-specific helpers (implemented in cpp)
     void GetBuffer(uint16_t *rBuffer, unsigned int bufferLen, unsigned int &lengthRead);
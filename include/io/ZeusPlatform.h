@@ -2,7 +2,9 @@
 #define ZEUSPLATFORM_H
 
 #include "ICardPlatform.h"
+#include "io/NvramDevice.h"
 #include <string>
+#include <memory>
 
 
 
@@ -86,6 +88,26 @@ public:
      */
     bool writeSRAM(uint32_t offset, const uint8_t* buffer, uint32_t length);
 
+    /**
+     * One range for writeSRAMBlocks() (offset and length in words)
+     */
+    struct SRAMBlock {
+        uint32_t offset;
+        const uint8_t* buffer;
+        uint32_t length;
+    };
+
+    // Blocks carried by one S7LITE_SRAM_Write() call
+    static constexpr size_t SRAM_WRITE_BLOCKS = 4;
+
+    /**
+     * Write several ranges to SRAM, SRAM_WRITE_BLOCKS per S7Lite call
+     * @param blocks Ranges to write (in words, 16-bit units)
+     * @param count Number of ranges
+     * @return true if every range was written
+     */
+    bool writeSRAMBlocks(const SRAMBlock* blocks, size_t count);
+
     /**
      * Get firmware version string
      * @return Firmware version (e.g., "PRODUCT.MAJOR.MINOR.BUILD")
@@ -141,6 +163,26 @@ private:
     bool querySRAMSize();
 };
 
+/**
+ * ZeusNvramDevice - NvramDevice over the S7 Lite battery-backed SRAM
+ *
+ * Converts byte ranges to the word units of the S7Lite API and hands
+ * write() batches to writeSRAMBlocks(), so up to four dirty ranges go
+ * out in a single S7LITE_SRAM_Write().
+ */
+class ZeusNvramDevice : public io::NvramDevice {
+public:
+    explicit ZeusNvramDevice(std::shared_ptr<ZeusPlatform> platform);
+
+    size_t getSize() const override;
+    bool read(size_t offset, uint8_t* buffer, size_t length) override;
+    bool write(const Block* blocks, size_t count) override;
+    std::string getName() const override { return "S7 Lite SRAM"; }
+
+private:
+    std::shared_ptr<ZeusPlatform> platform_;
+};
+
 
 
 #endif // ZEUSPLATFORM_H
@@ -22,6 +22,11 @@ namespace sas {
  * - High nibble = tens digit, low nibble = ones digit
  * - Multi-byte values are big-endian (most significant byte first)
  * - Maximum value for N bytes: 10^(2N) - 1
+ *
+ * encodeTo() splits the value into 8-digit chunks and each chunk into digit
+ * pairs with a multiply-and-shift, then maps each pair through a 100-entry
+ * table; no per-digit division. decode() uses a 256-entry table that also
+ * flags invalid bytes.
  */
 class BCD {
 public:
@@ -34,11 +39,11 @@ public:
     static std::vector<uint8_t> encode(uint64_t value, size_t numBytes);
 
     /**
-     * Encode to BCD and write to buffer
+     * Encode to BCD and write to buffer (preferred: no allocation)
      * @param value Binary value to encode
      * @param buffer Output buffer
      * @param numBytes Number of BCD bytes to write
-     * @return true if successful
+     * @return true if successful, false if value does not fit (buffer untouched)
      */
     static bool encodeTo(uint64_t value, uint8_t* buffer, size_t numBytes);
 
@@ -61,9 +66,11 @@ public:
     /**
      * Get maximum value for given number of BCD bytes
      * @param numBytes Number of BCD bytes
-     * @return Maximum value (10^(2*numBytes) - 1)
+     * @return Maximum value (10^(2*numBytes) - 1, UINT64_MAX from 10 bytes up)
      */
-    static uint64_t maxValue(size_t numBytes);
+    static constexpr uint64_t maxValue(size_t numBytes) {
+        return numBytes < MAX_VALUE_BYTES ? MAX_VALUES[numBytes] : UINT64_MAX;
+    }
 
     /**
      * Calculate minimum number of BCD bytes needed for value
@@ -91,6 +98,25 @@ private:
      * Check if a single nibble is valid BCD (0-9)
      */
     static bool isValidNibble(uint8_t nibble);
+
+    // maxValue() by byte count; 10 bytes (20 digits) hold any uint64_t
+    static constexpr size_t MAX_VALUE_BYTES = 11;
+    static constexpr uint64_t MAX_VALUES[MAX_VALUE_BYTES] = {
+        0ULL,
+        99ULL,
+        9999ULL,
+        999999ULL,
+        99999999ULL,
+        9999999999ULL,
+        999999999999ULL,
+        99999999999999ULL,
+        9999999999999999ULL,
+        999999999999999999ULL,
+        UINT64_MAX
+    };
+
+    // Binary 0-99 to packed BCD byte
+    static const uint8_t TO_BCD[100];
 };
 
 } // namespace sas
@@ -4,6 +4,18 @@
 #include <cstdint>
 #include <cstddef>
 
+/**
+ * Build-time CRC-16 implementation used by CRC16::calculate()
+ * 0 = nibble reference, 1 = 256-entry table, 4 = slicing-by-4, 8 = slicing-by-8
+ */
+#ifndef EGM_CRC16_SLICES
+#define EGM_CRC16_SLICES 8
+#endif
+
+#if EGM_CRC16_SLICES != 0 && EGM_CRC16_SLICES != 1 && EGM_CRC16_SLICES != 4 && EGM_CRC16_SLICES != 8
+#error "EGM_CRC16_SLICES must be 0, 1, 4 or 8"
+#endif
+
 
 namespace sas {
 
@@ -18,6 +30,10 @@ namespace sas {
  * - Initial value: 0x0000
  * - Algorithm: Nibble-based (processes 4 bits at a time, LSB first)
  * - Transmission: LSB first in SAS messages
+ *
+ * The nibble algorithm is kept as the reference. calculate() uses the
+ * variant selected by EGM_CRC16_SLICES; the table variants process one
+ * byte (or 4/8 bytes) per lookup step and return identical results.
  */
 class CRC16 {
 public:
@@ -29,6 +45,28 @@ public:
      */
     static uint16_t calculate(const uint8_t* data, size_t length);
 
+    /**
+     * Calculate CRC-16 for several independent buffers
+     *
+     * Buffers are processed four at a time with their byte loops interleaved,
+     * so the per-buffer dependency chains overlap (useful when many EGMs
+     * build responses together).
+     * @param data Array of count buffer pointers
+     * @param lengths Array of count buffer lengths
+     * @param count Number of buffers
+     * @param crcs Receives count CRC values
+     */
+    static void calculateMany(const uint8_t* const* data, const size_t* lengths,
+                              size_t count, uint16_t* crcs);
+
+    /**
+     * Individual implementations (all return the same value as calculate())
+     */
+    static uint16_t calculateNibble(const uint8_t* data, size_t length);
+    static uint16_t calculateTable(const uint8_t* data, size_t length);
+    static uint16_t calculateSliced4(const uint8_t* data, size_t length);
+    static uint16_t calculateSliced8(const uint8_t* data, size_t length);
+
     /**
      * Verify CRC-16 of received message
      * @param data Pointer to data buffer (including CRC bytes)
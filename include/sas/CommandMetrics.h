@@ -0,0 +1,106 @@
+#ifndef SAS_COMMANDMETRICS_H
+#define SAS_COMMANDMETRICS_H
+
+#include "utils/LatencyHistogram.h"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace sas {
+
+/**
+ * CommandMetrics - Per-command poll counters and latency histograms of one port
+ *
+ * For every command code (general polls under 0x80) a port counts the
+ * polls it handled, answered and dropped for a bad CRC, and records two
+ * latencies:
+ * - handle: poll complete in the receive ring to handler done
+ * - transmit: handler done to response written to the channel
+ *
+ * Only the thread servicing the port records (its receive thread, or the
+ * pool worker that owns it), so each port's metrics are that thread's own
+ * buckets: recording is relaxed atomic adds on cache lines no other
+ * thread writes, and scrapers read snapshots without locking. A command's
+ * slot is allocated the first time it is seen, so an idle command costs
+ * one pointer.
+ */
+class CommandMetrics {
+public:
+    /**
+     * Counters and histograms of one command code
+     */
+    struct Command {
+        std::atomic<uint64_t> polls;        // Polls handled
+        std::atomic<uint64_t> responses;    // Polls answered
+        std::atomic<uint64_t> crcErrors;    // Polls dropped for a bad CRC
+        utils::LatencyHistogram handle;     // Receive to handler done
+        utils::LatencyHistogram transmit;   // Handler done to response written
+
+        Command() : polls(0), responses(0), crcErrors(0) {}
+    };
+
+    /**
+     * One port's metrics, labelled with its SAS address (for writePrometheus)
+     */
+    struct Source {
+        uint8_t address;
+        const CommandMetrics* metrics;
+    };
+
+    CommandMetrics();
+    ~CommandMetrics();
+
+    CommandMetrics(const CommandMetrics&) = delete;
+    CommandMetrics& operator=(const CommandMetrics&) = delete;
+
+    /**
+     * Record a handled poll (servicing thread only)
+     * @param command Command code (0x80 for general polls)
+     * @param handleMicros Receive to handler done
+     * @param responded true if a response was written
+     * @param transmitMicros Handler done to response written (if responded)
+     */
+    void recordPoll(uint8_t command, uint64_t handleMicros, bool responded, uint64_t transmitMicros);
+
+    /**
+     * Record a poll dropped for a bad CRC (servicing thread only)
+     */
+    void recordCRCError(uint8_t command);
+
+    /**
+     * Metrics of one command, or nullptr if it was never seen
+     */
+    const Command* get(uint8_t command) const {
+        return commands_[command].load(std::memory_order_acquire);
+    }
+
+    /**
+     * Zero every counter and histogram (slots stay allocated)
+     */
+    void reset();
+
+    /**
+     * Write the metrics of several ports in the Prometheus text format
+     * (version 0.0.4): counters and histograms in seconds, labelled with
+     * address and command
+     * @param sources Ports to export
+     * @param out Output stream
+     */
+    static void writePrometheus(const std::vector<Source>& sources, std::ostream& out);
+
+private:
+    /**
+     * Slot of a command, allocated on first use
+     */
+    Command& slot(uint8_t command);
+
+    std::atomic<Command*> commands_[256];
+};
+
+} // namespace sas
+
+
+#endif // SAS_COMMANDMETRICS_H
@@ -0,0 +1,69 @@
+#ifndef SAS_COMMANDTABLE_H
+#define SAS_COMMANDTABLE_H
+
+#include "sas/SASCommands.h"
+#include <cstdint>
+
+
+// Forward declarations
+namespace simulator {
+    class Machine;
+}
+
+namespace sas {
+
+/**
+ * Uniform long poll handler signature used by the command table.
+ * Each entry adapts one of the commands::*Commands handlers to this shape.
+ *
+ * @param machine Pointer to machine simulator
+ * @param poll Received poll (address, command, data with CRC stripped)
+ * @return Response message (command == 0 means no response)
+ */
+typedef Message (*CommandHandler)(simulator::Machine* machine, const Message& poll);
+
+/**
+ * Command descriptor flags
+ */
+namespace CommandFlags {
+    constexpr uint8_t NONE = 0x00;
+    constexpr uint8_t HAS_CRC = 0x01;           // Poll carries a trailing CRC-16
+    constexpr uint8_t GENERAL_POLL = 0x02;      // General poll (exception reporting)
+}
+
+/**
+ * CommandDescriptor - Everything the emulator knows about one command code
+ *
+ * Poll lengths are counted after the S7Lite API strips the address byte,
+ * i.e. [cmd][data...][CRC]. A length of VARIABLE_LENGTH means the poll is
+ * framed as [cmd][length][data (length bytes)][CRC 2].
+ */
+struct CommandDescriptor {
+    CommandHandler handler;     // nullptr = unsupported (no response)
+    uint8_t pollLength;         // Fixed poll length, or VARIABLE_LENGTH
+    uint8_t flags;              // CommandFlags bit mask
+    const char* name;           // Human-readable command name
+
+    static constexpr uint8_t VARIABLE_LENGTH = 0;
+
+    constexpr bool isVariableLength() const { return pollLength == VARIABLE_LENGTH; }
+    constexpr bool hasCRC() const { return (flags & CommandFlags::HAS_CRC) != 0; }
+    constexpr bool isGeneralPoll() const { return (flags & CommandFlags::GENERAL_POLL) != 0; }
+};
+
+/**
+ * Look up the descriptor for a command code.
+ *
+ * Single source of truth for dispatch (SASCommPort), framing (SASSerialPort)
+ * and naming (getCommandName). Every one of the 256 codes has an entry, so
+ * the lookup is a plain array index.
+ *
+ * @param command Command code
+ * @return Descriptor for the command
+ */
+const CommandDescriptor& getCommandDescriptor(uint8_t command);
+
+} // namespace sas
+
+
+#endif // SAS_COMMANDTABLE_H
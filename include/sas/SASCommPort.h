@@ -3,6 +3,10 @@
 
 #include "io/MachineCommPort.h"
 #include "sas/SASCommands.h"
+#include "sas/SASFrameParser.h"
+#include "sas/CommandMetrics.h"
+#include "event/EventService.h"
+#include <chrono>
 #include <thread>
 #include <atomic>
 #include <vector>
@@ -19,14 +23,24 @@ namespace sas {
  * Features:
  * - General poll handling (0x80-0x9F)
  * - Long poll command processing (0x00-0x7F)
- * - Exception queue for real-time event reporting
- * - CRC-16 validation
+ * - Exception queue for event reporting
+ * - Real-time event reporting (long poll 0x0E): general polls answer
+ *   [FF][exception][data], with game start/end and bill accepted data
+ *   built from the machine's EventService events
+ * - CRC-16 validation: a long poll whose CRC does not check is counted
+ *   and ignored, as SAS requires
  * - Message framing with 9-bit addressing
+ * - Per-command counters and handle/transmit latency (CommandMetrics)
  *
  * Thread Model:
- * - Receive thread continuously monitors for incoming messages
+ * - start(): a dedicated receive thread continuously monitors for messages
+ * - attach(): no thread; a shared worker (SASPortPool) calls serviceOnce()
+ *   when the channel is readable, so many ports can share a few threads
  * - Messages are processed synchronously and responses sent immediately
  * - Exception queue is thread-safe for cross-thread access
+ *
+ * Every response is stamped with this port's address, so several ports
+ * (one per EGM) can run in the same process.
  */
 class SASCommPort : public io::MachineCommPort {
 public:
@@ -51,6 +65,31 @@ public:
     bool isRunning() const override;
     std::string getName() const override;
 
+    /**
+     * Open the channel and mark the port running without starting a
+     * receive thread. The owner must then call serviceOnce() whenever the
+     * channel has data (see SASPortPool). stop() detaches the port.
+     * @return true if the channel is open
+     */
+    bool attach();
+
+    /**
+     * Receive and answer every complete poll available within timeout.
+     * Always tries one receive, so a zero timeout drains what is already
+     * buffered without blocking. Must only be called from one thread at a
+     * time (the receive thread, or the pool worker owning this port).
+     * @param timeout Maximum time to wait for the first poll
+     * @return Number of polls handled
+     */
+    size_t serviceOnce(std::chrono::milliseconds timeout);
+
+    /**
+     * Drop a partially received poll, as an inter-byte gap on the line
+     * does. For callers sending polls faster than they were recorded
+     * (TrafficReplay); same threading rule as serviceOnce().
+     */
+    void resetFraming() { frameParser_.reset(); }
+
     /**
      * Get SAS address
      */
@@ -66,6 +105,11 @@ public:
      */
     void setAddress(uint8_t address);
 
+    /**
+     * Check whether the host enabled real-time event reporting (0x0E)
+     */
+    bool isRealTimeEventsEnabled() const { return realTimeEvents_; }
+
     /**
      * Send a SAS message
      * @param msg Message to send (CRC will be calculated automatically)
@@ -91,12 +135,24 @@ public:
     Statistics getStatistics() const;
     void resetStatistics();
 
+    /**
+     * Per-command poll counters and latency histograms
+     */
+    const CommandMetrics& getCommandMetrics() const { return metrics_; }
+
 protected:
     /**
      * Receive thread entry point
      */
     void receiveThread();
 
+    /**
+     * Log, count, process and answer one received poll
+     * @param msg Received message
+     * @param receivedAt When the poll was complete
+     */
+    void handleMessage(const Message& msg, std::chrono::steady_clock::time_point receivedAt);
+
     /**
      * Process a received SAS message
      * @param msg Received message
@@ -118,8 +174,17 @@ protected:
      */
     Message handleLongPoll(const Message& msg);
 
+    /**
+     * Handle Enable/Disable Real-Time Event Reporting (0x0E)
+     * @param msg Received long poll ([enable])
+     * @return ACK, or empty for a bad enable byte
+     */
+    Message handleEnableRealTimeEvents(const Message& msg);
+
     /**
      * Read a complete SAS message from channel
+     * Receives into the frame parser until it yields a complete poll.
+     * Polls with a bad CRC are counted and skipped.
      * @param timeout Read timeout
      * @return Received message (empty if timeout or error)
      */
@@ -134,13 +199,30 @@ protected:
     bool sendRaw(const uint8_t* buffer, size_t length);
 
 private:
+    /**
+     * Queue game start/end and bill accepted exceptions for this port's
+     * machine from its EventService events
+     */
+    void subscribeEvents();
+    void unsubscribeEvents();
+
     uint8_t address_;                       // SAS machine address (1-127)
     std::atomic<bool> running_;             // Port running flag
+    std::atomic<bool> realTimeEvents_;      // Real-time event reporting enabled by the host
+    std::shared_ptr<event::EventService> eventService_;  // Source of subscriptions_
+    std::vector<int> subscriptions_;
     std::thread receiveThread_;             // Receive thread
-    Statistics stats_;                      // Communication statistics
-    mutable std::recursive_mutex statsMutex_; // Statistics mutex
+    // Communication statistics (relaxed; written by the servicing thread)
+    std::atomic<uint64_t> messagesReceived_;
+    std::atomic<uint64_t> messagesSent_;
+    std::atomic<uint64_t> crcErrors_;
+    std::atomic<uint64_t> framingErrors_;
+    std::atomic<uint64_t> generalPolls_;
+    std::atomic<uint64_t> longPolls_;
+    CommandMetrics metrics_;
+    SASFrameParser frameParser_;            // Splits received bytes into polls (receive thread only)
+    std::chrono::steady_clock::time_point lastByteAt_;  // Last bytes received (receive thread only)
 
-    static constexpr size_t MAX_MESSAGE_SIZE = 256;
     static constexpr int READ_TIMEOUT_MS = 1000;  // 1 second - MCU can have long burst gaps (500ms+)
 };
 
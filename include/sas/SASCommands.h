@@ -1,7 +1,10 @@
 #ifndef SAS_SASCOMMANDS_H
 #define SAS_SASCOMMANDS_H
 
+#include "sas/BCD.h"
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <vector>
 #include <string>
 
@@ -83,8 +86,8 @@ constexpr uint8_t SEND_PROGRESSIVE_LEVELS = 0x85;   // Progressive level info (p
 constexpr uint8_t SEND_PROGRESSIVE_BROADCAST = 0x86; // Broadcast progressive values (placeholder)
 
 // --- Real-Time Event Reporting ---
-constexpr uint8_t ENABLE_REAL_TIME_EVENTS = 0x1D;   // Enable event reporting
-constexpr uint8_t SEND_REAL_TIME_EVENT = 0x50;      // Send pending events
+constexpr uint8_t ENABLE_REAL_TIME_EVENTS = 0x0E;   // Enable/disable real-time event reporting
+constexpr uint8_t SEND_REAL_TIME_EVENT = 0xFF;      // General poll reply in RTE mode: [FF][event][data]
 
 // --- ROM and EEPROM ---
 constexpr uint8_t SEND_ROM_SIGNATURE = 0x0F;        // ROM signature/checksum
@@ -135,6 +138,11 @@ namespace Exception {
     constexpr uint8_t POWER_OFF_CARD_CAGE = 0x70;       // Power failure detected
     constexpr uint8_t GAME_RECALLED = 0x80;             // Game in recall mode
     constexpr uint8_t GAME_STARTED = 0x90;              // Game started
+
+    // Exceptions carrying event data when real-time event reporting is on
+    constexpr uint8_t BILL_ACCEPTED = 0x4F;             // Bill accepted
+    constexpr uint8_t GAME_HAS_STARTED = 0x7E;          // Game has started (RTE only)
+    constexpr uint8_t GAME_HAS_ENDED = 0x7F;            // Game has ended (RTE only)
 }
 
 // ============================================================================
@@ -152,15 +160,135 @@ struct MessageHeader {
     MessageHeader(uint8_t addr, uint8_t cmd) : address(addr), command(cmd) {}
 };
 
+/**
+ * MessageData - Fixed-capacity inline byte buffer for message data
+ *
+ * Replaces std::vector<uint8_t> on the poll/response path so building a
+ * response never touches the heap. Provides the subset of the vector
+ * interface the handlers use, plus append-in-place BCD writers.
+ *
+ * Writes past CAPACITY are discarded and flagged (see overflowed()); a
+ * message whose data overflowed is never serialized.
+ */
+class MessageData {
+public:
+    static constexpr size_t CAPACITY = 256;     // SAS maximum message size
+
+    typedef uint8_t value_type;
+    typedef uint8_t* iterator;
+    typedef const uint8_t* const_iterator;
+
+    MessageData() : size_(0), overflow_(false) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool overflowed() const { return overflow_; }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+    uint8_t* data() { return bytes_; }
+    const uint8_t* data() const { return bytes_; }
+
+    uint8_t& operator[](size_t index) { return bytes_[index]; }
+    const uint8_t& operator[](size_t index) const { return bytes_[index]; }
+
+    iterator begin() { return bytes_; }
+    iterator end() { return bytes_ + size_; }
+    const_iterator begin() const { return bytes_; }
+    const_iterator end() const { return bytes_ + size_; }
+
+    void clear() {
+        size_ = 0;
+        overflow_ = false;
+    }
+
+    void push_back(uint8_t value) {
+        if (size_ < CAPACITY) {
+            bytes_[size_++] = value;
+        } else {
+            overflow_ = true;
+        }
+    }
+
+    /**
+     * Insert a range before pos (pos is normally end())
+     */
+    template <typename InputIt>
+    void insert(iterator pos, InputIt first, InputIt last) {
+        size_t offset = static_cast<size_t>(pos - bytes_);
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        if (offset > size_ || count > CAPACITY - size_) {
+            overflow_ = true;
+            return;
+        }
+        if (offset < size_) {
+            std::memmove(bytes_ + offset + count, bytes_ + offset, size_ - offset);
+        }
+        for (size_t i = 0; i < count; ++i, ++first) {
+            bytes_[offset + i] = static_cast<uint8_t>(*first);
+        }
+        size_ += count;
+    }
+
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        insert(end(), first, last);
+    }
+
+    /**
+     * Append raw bytes
+     */
+    void append(const uint8_t* bytes, size_t count) {
+        if (count > CAPACITY - size_) {
+            overflow_ = true;
+            return;
+        }
+        std::memcpy(bytes_ + size_, bytes, count);
+        size_ += count;
+    }
+
+    /**
+     * Reserve count bytes at the end and return a pointer to them
+     * @return Pointer to the new bytes (zeroed), or nullptr on overflow
+     */
+    uint8_t* appendSpace(size_t count) {
+        if (count > CAPACITY - size_) {
+            overflow_ = true;
+            return nullptr;
+        }
+        uint8_t* out = bytes_ + size_;
+        std::memset(out, 0, count);
+        size_ += count;
+        return out;
+    }
+
+    /**
+     * Append a BCD-encoded value in place (zeros if it does not fit numBytes)
+     */
+    void appendBCD(uint64_t value, size_t numBytes) {
+        uint8_t* out = appendSpace(numBytes);
+        if (out) {
+            BCD::encodeTo(value, out, numBytes);
+        }
+    }
+
+private:
+    uint8_t bytes_[CAPACITY];
+    size_t size_;
+    bool overflow_;
+};
+
 /**
  * Complete SAS message with CRC
  */
 struct Message {
     uint8_t address;                // Machine address
     uint8_t command;                // Command code
-    std::vector<uint8_t> data;      // Command data (variable length)
+    MessageData data;               // Command data (variable length, inline storage)
     uint16_t crc;                   // CRC-16 (calculated/verified separately)
 
+    static constexpr size_t MAX_SERIALIZED_SIZE = 1 + 1 + MessageData::CAPACITY + 2;
+
     Message() : address(0), command(0), crc(0) {}
 
     /**
@@ -170,6 +298,15 @@ struct Message {
         return 1 + 1 + data.size() + 2;  // addr + cmd + data + 2-byte CRC
     }
 
+    /**
+     * Serialize message (including CRC) into a caller-provided buffer
+     * @param buffer Output buffer
+     * @param capacity Size of output buffer (MAX_SERIALIZED_SIZE always fits)
+     * @return Number of bytes written, or 0 if the buffer is too small or
+     *         data overflowed (the response would be truncated)
+     */
+    size_t serializeTo(uint8_t* buffer, size_t capacity) const;
+
     /**
      * Serialize message to byte array (including CRC)
      */
@@ -2,7 +2,6 @@
 #define SAS_SASCONSTANTS_H
 
 #include <cstdint>
-#include <map>
 
 
 namespace sas {
@@ -232,7 +231,7 @@ public:
     // Runtime code must use ONLY METER_* codes (0x00-0xFF for SAS, 0x100+ for extended).
 
     /**
-     * Denomination mapping helper
+     * Denomination mapping helper (dollar view of simulator::denomination)
      */
     class Denominations {
     public:
@@ -251,10 +250,6 @@ public:
          * @return SAS denomination code, or -1 if not found
          */
         int getDenomCodeByDenomination(double denomination) const;
-
-    private:
-        std::map<int, double> codeToValue_;
-        std::map<double, int> valueToCode_;
     };
 
     static const Denominations DENOMINATIONS;
@@ -1,26 +1,54 @@
 #ifndef SAS_SASDAEMON_H
 #define SAS_SASDAEMON_H
 
-#include "sas/SASCommPort.h"
-#include "simulator/Machine.h"
+#include "io/CommChannel.h"
+#include "utils/LatencyHistogram.h"
 #include <thread>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <ostream>
 
 
 namespace sas {
 
 /**
- * SASDaemon - SAS Protocol Polling Daemon
+ * SASDaemon - SAS Protocol Polling Master
  *
- * Manages continuous polling of SAS protocol, alternating between:
- * - General polls (0x80) - Check for exceptions/events
- * - Long polls - Query meters, configuration, status
+ * Host side of a SAS line: writes polls to a channel connected to an EGM
+ * (the other end of a PipedCommChannel pair, or the slave device of an
+ * emulator's pty) and reads and checks its responses.
+ *
+ * Polls are written in the form the EGM side receives them (address byte
+ * stripped, see SASFrameParser), with the CRC over address and frame when
+ * the command carries one. A response is complete once it starts with
+ * the polled address and its CRC checks; a response whose CRC never
+ * checks within the poll timeout is counted as a CRC error. An EGM with
+ * nothing to report does not answer a general poll, so a silent general
+ * poll is idle, not a timeout.
  *
  * Operating Modes:
  * - Discovery: Initial connection, query machine capabilities
  * - Online: Normal operation with continuous polling
+ * - Load: Back-to-back polls from a weighted PollMix (load generator)
+ *
+ * Every answered poll's round trip (write of the poll to the last byte of
+ * the response) is recorded in a latency histogram per command; general
+ * polls are recorded under 0x80.
+ *
+ * Discovery and online polling run on poll slots at absolute deadlines
+ * (steady_clock, sleep_until), one general poll interval apart, so the
+ * time spent polling does not stretch the cadence. Online, a slot holds a
+ * general poll and, once per long poll interval, the long poll due first
+ * in a weighted queue: a long poll of weight w gets w of every W long
+ * poll slots, W being the total weight. Slow responses and timeouts widen
+ * the slot interval (doubling backoff, shrinking again on fast responses).
+ * How late each slot starts is recorded in a jitter histogram; a slot
+ * started a whole interval late is an overrun, and the schedule restarts
+ * from it instead of catching up with a burst of polls.
  */
 class SASDaemon {
 public:
@@ -30,9 +58,23 @@ public:
     enum class Mode {
         DISCOVERY,  // Initial discovery and configuration
         ONLINE,     // Normal operation
+        LOAD,       // Load generation from the poll mix
         OFFLINE     // Not connected
     };
 
+    /**
+     * Relative weights of the poll kinds sent in LOAD mode. Each step sends
+     * one general poll, one meter poll of the sweep, a storm of AFT
+     * transfers or a burst of 0x6F polls, in proportion to the weights.
+     */
+    struct PollMix {
+        unsigned generalPolls = 4;      // 0x80 + address
+        unsigned meterSweeps = 2;       // 0x10-0x1A single meter polls, in turn
+        unsigned aftTransfers = 1;      // burstLength x 0x72 transfer to the gaming machine
+        unsigned meterBursts = 1;       // burstLength x 0x6F selected meters for game 0
+        unsigned burstLength = 8;       // Polls per AFT storm or 0x6F burst
+    };
+
     /**
      * Daemon statistics
      */
@@ -40,22 +82,30 @@ public:
         uint64_t totalPolls;            // Total polls sent
         uint64_t generalPolls;          // General polls sent
         uint64_t longPolls;             // Long polls sent
+        uint64_t responses;             // Complete responses with a good CRC
+        uint64_t idlePolls;             // General polls not answered (nothing to report)
         uint64_t exceptionsReceived;    // Exceptions received
-        uint64_t timeouts;              // Poll timeouts
-        uint64_t errors;                // Communication errors
+        uint64_t timeouts;              // Long polls not answered
+        uint64_t crcErrors;             // Responses whose CRC never checked
+        uint64_t errors;                // Wrong address or command, channel errors
+        uint64_t slots;                 // Poll slots started (discovery and online)
+        uint64_t overruns;              // Slots started a whole interval late
+        uint64_t backoffs;              // Times the slot interval was widened
+        uint32_t backoffMs;             // Current widening of the slot interval
         std::chrono::steady_clock::time_point startTime;
 
-        Statistics() : totalPolls(0), generalPolls(0), longPolls(0),
-                      exceptionsReceived(0), timeouts(0), errors(0),
+        Statistics() : totalPolls(0), generalPolls(0), longPolls(0), responses(0),
+                      idlePolls(0), exceptionsReceived(0), timeouts(0), crcErrors(0),
+                      errors(0), slots(0), overruns(0), backoffs(0), backoffMs(0),
                       startTime(std::chrono::steady_clock::now()) {}
     };
 
     /**
      * Constructor
-     * @param machine Machine instance to poll
-     * @param port SAS communication port
+     * @param channel Host end of the line to the EGM
+     * @param address SAS address to poll (1-127)
      */
-    SASDaemon(simulator::Machine* machine, SASCommPort* port);
+    SASDaemon(std::shared_ptr<io::CommChannel> channel, uint8_t address = 1);
 
     /**
      * Destructor - stops polling thread
@@ -64,9 +114,10 @@ public:
 
     /**
      * Start polling daemon
+     * @param mode Mode to start in (DISCOVERY, or LOAD for load generation)
      * @return true if started successfully
      */
-    bool start();
+    bool start(Mode mode = Mode::DISCOVERY);
 
     /**
      * Stop polling daemon
@@ -91,6 +142,8 @@ public:
      */
     void setMode(Mode mode);
 
+    uint8_t getAddress() const { return address_; }
+
     /**
      * Get polling statistics
      * @return Statistics structure
@@ -98,10 +151,37 @@ public:
     Statistics getStatistics() const;
 
     /**
-     * Reset statistics
+     * Reset statistics and latency histograms
      */
     void resetStatistics();
 
+    /**
+     * Round-trip latency of one command (general polls: 0x80)
+     */
+    const utils::LatencyHistogram& getLatency(uint8_t command) const { return latency_[command]; }
+
+    /**
+     * How late poll slots started against their deadline (overruns excluded)
+     */
+    const utils::LatencyHistogram& getSlotJitter() const { return slotJitter_; }
+
+    /**
+     * Add a long poll to the online rotation (before start)
+     * @param command Long poll without data
+     * @param weight Share of the long poll slots relative to the other entries
+     */
+    void addLongPoll(uint8_t command, unsigned weight = 1);
+
+    /**
+     * Empty the online long poll rotation (before start)
+     */
+    void clearLongPolls();
+
+    /**
+     * Set the LOAD mode poll mix (before start)
+     */
+    void setPollMix(const PollMix& mix);
+
     /**
      * Set general poll interval
      * @param interval Time between general polls (default: 40ms)
@@ -120,7 +200,34 @@ public:
      */
     void setPollTimeout(std::chrono::milliseconds timeout);
 
+    /**
+     * Send general poll and process response (polling thread, or the
+     * caller while the daemon is stopped)
+     * @return true if exception received
+     */
+    bool doGeneralPoll();
+
+    /**
+     * Send a long poll command
+     * @param command Command code
+     * @param data Command data (for variable-length polls, starting with the length byte)
+     * @return true if response received
+     */
+    bool doLongPoll(uint8_t command, const std::vector<uint8_t>& data = {});
+
+    /**
+     * Print the combined statistics and per-command latency of several
+     * masters (load generator report)
+     * @param daemons Masters to combine
+     * @param seconds Duration of the run, for the poll rate
+     * @param out Output stream
+     */
+    static void printReport(const std::vector<std::shared_ptr<SASDaemon>>& daemons,
+                            double seconds, std::ostream& out);
+
 private:
+    static constexpr size_t MAX_RESPONSE_SIZE = 1 + 1 + 256 + 2;
+
     /**
      * Main polling thread function
      */
@@ -137,18 +244,55 @@ private:
     void runOnline();
 
     /**
-     * Send general poll and process response
-     * @return true if exception received
+     * Load mode - one step of the poll mix
      */
-    bool doGeneralPoll();
+    void runLoad();
 
     /**
-     * Send a long poll command
-     * @param command Command code
-     * @param data Optional command data
-     * @return true if response received
+     * Sleep until the next poll slot and schedule the one after it
      */
-    bool doLongPoll(uint8_t command, const std::vector<uint8_t>& data = {});
+    void waitForSlot();
+
+    /**
+     * Widen the slot interval after a slow or missing response, narrow it
+     * again after a fast one
+     * @param slow true if the response was slow or missing
+     */
+    void adaptBackoff(bool slow);
+
+    /**
+     * Time a general poll waits for an answer: an EGM with nothing to
+     * report stays silent, so at most half a slot
+     */
+    std::chrono::milliseconds generalPollTimeout() const;
+
+    /**
+     * Send the long poll due first, if its slot has come
+     */
+    void doScheduledLongPoll();
+
+    /**
+     * Write one poll and read its response
+     * @param poll Poll as written (address stripped, CRC included)
+     * @param length Poll length
+     * @param latencyCommand Histogram to record the round trip in
+     * @param timeout Time to wait for the response
+     * @param response Receives the response ([address][command][data][CRC])
+     * @return Response length (0 if there was no complete response)
+     */
+    size_t transact(const uint8_t* poll, size_t length, uint8_t latencyCommand,
+                    std::chrono::milliseconds timeout, uint8_t* response);
+
+    /**
+     * Build a poll: [command][data][CRC over address, command and data]
+     * @return Poll length
+     */
+    size_t buildPoll(uint8_t command, const uint8_t* data, size_t dataLength, uint8_t* poll) const;
+
+    /**
+     * Count a poll that got no response; too many in a row go offline
+     */
+    void noResponse();
 
     /**
      * Process exception received from general poll
@@ -156,6 +300,16 @@ private:
      */
     void processException(uint8_t exceptionCode);
 
+    /**
+     * Send a 0x72 transfer of one cent to the gaming machine
+     */
+    bool doAftTransfer();
+
+    /**
+     * Send a 0x6F selected meters poll for the machine (game 0)
+     */
+    bool doMeterBurstPoll();
+
     /**
      * Query game configuration (discovery)
      */
@@ -177,8 +331,8 @@ private:
     void checkConnection();
 
     // Member variables
-    simulator::Machine* machine_;
-    SASCommPort* port_;
+    std::shared_ptr<io::CommChannel> channel_;
+    uint8_t address_;
     std::unique_ptr<std::thread> pollingThread_;
     std::atomic<bool> running_;
     std::atomic<Mode> mode_;
@@ -191,10 +345,33 @@ private:
     // Statistics
     mutable std::recursive_mutex statsMutex_;
     Statistics stats_;
-
-    // Long poll cycle tracking
-    std::chrono::steady_clock::time_point lastLongPoll_;
-    uint8_t currentLongPollIndex_;
+    utils::LatencyHistogram latency_[256];          // Indexed by command
+
+    // Poll slot schedule (polling thread only)
+    struct ScheduledLongPoll {
+        std::chrono::steady_clock::time_point due;
+        uint64_t sequence;                          // Ties go to the earliest added or sent
+        uint8_t command;
+        unsigned weight;
+    };
+    struct DueLater {
+        bool operator()(const ScheduledLongPoll& a, const ScheduledLongPoll& b) const {
+            return a.due != b.due ? a.due > b.due : a.sequence > b.sequence;
+        }
+    };
+    std::chrono::steady_clock::time_point nextSlot_;        // Epoch: schedule restarts
+    std::chrono::steady_clock::time_point nextLongPoll_;
+    std::priority_queue<ScheduledLongPoll, std::vector<ScheduledLongPoll>, DueLater> longPolls_;
+    unsigned longPollWeight_;                       // Total weight of longPolls_
+    uint64_t longPollSequence_;
+    std::chrono::microseconds backoff_;
+    utils::LatencyHistogram slotJitter_;
+
+    // Load mode state (polling thread only)
+    PollMix mix_;
+    int mixCredit_[4];                              // Smooth weighted round robin
+    size_t sweepIndex_;
+    uint32_t transactionNumber_;
 
     // Connection state
     bool connected_;
@@ -205,6 +382,8 @@ private:
     static constexpr int DEFAULT_GENERAL_POLL_INTERVAL_MS = 40;   // 40ms between general polls
     static constexpr int DEFAULT_LONG_POLL_INTERVAL_MS = 1000;    // 1 second between long poll cycles
     static constexpr int DEFAULT_POLL_TIMEOUT_MS = 100;           // 100ms timeout for responses
+    static constexpr int BACKOFF_STEP_MS = 10;                    // First widening of the slot interval
+    static constexpr int MAX_BACKOFF_MS = 400;                    // Widest backoff
 };
 
 } // namespace sas
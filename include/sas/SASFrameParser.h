@@ -0,0 +1,159 @@
+#ifndef SAS_SASFRAMEPARSER_H
+#define SAS_SASFRAMEPARSER_H
+
+#include "io/ByteRing.h"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+
+namespace sas {
+
+/**
+ * SASFrameParser - Incremental SAS poll framer
+ *
+ * Splits a received byte stream into complete polls. Bytes can arrive in
+ * chunks of any size; complete frames are emitted as soon as their last
+ * byte is seen. Frame boundaries come from the command table:
+ * - Fixed-length polls: [cmd][data...][CRC] (CommandDescriptor::pollLength)
+ * - Variable-length polls: [cmd][length][data (length bytes)][CRC 2]
+ *
+ * Frames are counted without the address byte, as the S7Lite API delivers
+ * them. Without the wakeup bit there is no marker for the start of a poll,
+ * so the parser resyncs by skipping bytes as junk:
+ * - A 0x00 byte, which can never start a poll in that stream
+ * - A variable-length poll whose length byte no host sends (a corrupted
+ *   length would otherwise stall framing for up to 259 bytes)
+ * - With an address set, the first byte of a frame whose CRC does not
+ *   match; framing resumes at the next byte
+ * After skipping a bad length or CRC the parser is resyncing: only frames
+ * with a CRC can be told from the data bytes of the broken poll, so bytes
+ * that would start a CRC-less poll are junk until a frame passes its CRC.
+ * The reader calls reset() after INTER_BYTE_GAP_MS of silence with bytes
+ * pending, which also ends resyncing: the next byte starts a new poll.
+ *
+ * All state is per instance (no statics), so several ports can parse in
+ * the same process. Not thread-safe: one parser per receive thread.
+ */
+class SASFrameParser {
+public:
+    /**
+     * Frame callback
+     * @param frame Complete frame (valid only for the duration of the call)
+     * @param length Frame length in bytes
+     */
+    typedef std::function<void(const uint8_t* frame, size_t length)> FrameCallback;
+
+    /**
+     * Result of nextFrame() (FRAME_NONE is false in a condition)
+     */
+    enum FrameStatus {
+        FRAME_NONE = 0,     // Need more bytes
+        FRAME_OK,           // Complete frame, consumed
+        FRAME_BAD_CRC       // Frame failed its CRC; only its first byte was consumed
+    };
+
+    static constexpr size_t MAX_FRAME_SIZE = 1 + 1 + 255 + 2;   // cmd + length + data + CRC
+    static constexpr int INTER_BYTE_GAP_MS = 20;    // Silence that ends a poll (hosts send polls back to back)
+
+    SASFrameParser();
+    explicit SASFrameParser(FrameCallback callback);
+
+    /**
+     * Check the CRC of a frame. The host's CRC also covers the address
+     * byte the UART stripped.
+     * @param address SAS address the poll was sent to
+     * @param frame Complete frame
+     * @param length Frame length
+     * @return true if the command carries no CRC or the CRC matches
+     */
+    static bool checkCRC(uint8_t address, const uint8_t* frame, size_t length);
+
+    /**
+     * Check every frame's CRC against this address while framing
+     * (frames that fail are reported as FRAME_BAD_CRC and rescanned)
+     */
+    void setAddress(uint8_t address);
+
+    /**
+     * Set the callback used by feed()
+     */
+    void setCallback(FrameCallback callback) { callback_ = callback; }
+
+    /**
+     * Append bytes and emit every frame they complete through the callback
+     * (frames failing their CRC included)
+     * @param data Received bytes
+     * @param length Number of bytes
+     * @return Number of frames emitted
+     */
+    size_t feed(const uint8_t* data, size_t length);
+
+    /**
+     * Extract the next complete frame from bytes already buffered
+     * (pull-style alternative to feed() for callers that fill ring() directly)
+     * @param frame Set to the frame bytes (valid until the next call)
+     * @param length Set to the frame length
+     * @return FRAME_OK or FRAME_BAD_CRC with frame set, FRAME_NONE if more
+     *         bytes are needed
+     */
+    FrameStatus nextFrame(const uint8_t*& frame, size_t& length);
+
+    /**
+     * Receive ring, for channels that drain straight into the parser
+     * (see io::CommChannel::receive). Call nextFrame() afterwards.
+     */
+    io::ByteRing& ring() { return ring_; }
+
+    /**
+     * Drop buffered bytes (e.g. after an inter-byte gap that ends a poll);
+     * they count as junk
+     */
+    void reset();
+
+    /**
+     * Whether reset() after an inter-byte gap would change anything
+     */
+    bool needsReset() const { return !ring_.empty() || resyncing_; }
+
+    /**
+     * Number of bytes buffered but not yet framed
+     */
+    size_t pending() const { return ring_.size(); }
+
+    /**
+     * Total junk bytes skipped or dropped while resynchronizing
+     */
+    uint64_t getJunkBytes() const { return junkBytes_; }
+
+    /**
+     * Total frames extracted
+     */
+    uint64_t getFrameCount() const { return frameCount_; }
+
+private:
+    /**
+     * Length of the frame at the front of the ring
+     * @return Frame length, or 0 if more bytes are needed to know it
+     */
+    size_t frontFrameLength() const;
+
+    /**
+     * Whether a host sends this length byte for a variable-length poll
+     */
+    static bool isPlausibleLength(uint8_t command, uint8_t length);
+
+    io::ByteRing ring_;
+    uint8_t frame_[MAX_FRAME_SIZE];     // Contiguous copy of the frame being emitted
+    FrameCallback callback_;
+    uint8_t address_;                   // Address the CRC covers (see setAddress)
+    bool checkCRC_;
+    bool resyncing_;                    // Skipped a bad frame; accept only CRC-checked frames
+    uint64_t junkBytes_;
+    uint64_t frameCount_;
+};
+
+} // namespace sas
+
+
+#endif // SAS_SASFRAMEPARSER_H
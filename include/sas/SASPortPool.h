@@ -0,0 +1,87 @@
+#ifndef SAS_SASPORTPOOL_H
+#define SAS_SASPORTPOOL_H
+
+#include "sas/SASCommPort.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+
+
+namespace sas {
+
+/**
+ * SASPortPool - Services many SAS ports from a small set of worker threads
+ *
+ * Used when one process hosts several EGMs (one SASCommPort per address).
+ * Ports are attached (no thread of their own) and assigned round-robin to
+ * the workers. Each worker waits in a single poll() over the read fds of
+ * its channels and calls SASCommPort::serviceOnce() on the ones that
+ * became readable, so idle EGMs cost no CPU.
+ *
+ * Channels without a pollable fd (CommChannel::getReadFd() == -1) are
+ * serviced with a zero timeout on every worker wakeup, which then happens
+ * at least every UNPOLLABLE_INTERVAL_MS.
+ */
+class SASPortPool {
+public:
+    /**
+     * Constructor
+     * @param workerCount Number of worker threads (clamped to 1..port count)
+     */
+    explicit SASPortPool(size_t workerCount = 1);
+
+    /**
+     * Destructor - stops workers and ports
+     */
+    ~SASPortPool();
+
+    /**
+     * Add a port (before start())
+     */
+    void addPort(std::shared_ptr<SASCommPort> port);
+
+    /**
+     * Attach every port and start the workers
+     * @return true if at least one port was attached
+     */
+    bool start();
+
+    /**
+     * Stop the workers, then stop (detach and close) every port
+     */
+    void stop();
+
+    bool isRunning() const { return running_; }
+
+    /**
+     * Get number of worker threads actually running
+     */
+    size_t getWorkerCount() const { return workerCount_; }
+
+    /**
+     * Get the ports serviced by this pool
+     */
+    const std::vector<std::shared_ptr<SASCommPort>>& getPorts() const { return ports_; }
+
+private:
+    /**
+     * Worker thread entry point
+     * @param index Worker index; services ports where (port index % workers) == index
+     */
+    void workerThread(size_t index);
+
+    std::vector<std::shared_ptr<SASCommPort>> ports_;
+    std::vector<std::thread> workers_;
+    size_t requestedWorkers_;
+    size_t workerCount_;                // Set by start() before workers run
+    std::atomic<bool> running_;
+
+    static constexpr int POLL_TIMEOUT_MS = 100;         // Re-check running_ while idle
+    static constexpr int UNPOLLABLE_INTERVAL_MS = 5;    // Service interval for fd-less channels
+};
+
+} // namespace sas
+
+
+#endif // SAS_SASPORTPOOL_H
@@ -0,0 +1,193 @@
+#ifndef SAS_TRAFFICCAPTURE_H
+#define SAS_TRAFFICCAPTURE_H
+
+#include "io/CommChannel.h"
+#include "sas/SASFrameParser.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+
+
+namespace sas {
+
+/**
+ * TrafficCapture - Binary capture of the polls and responses on one port
+ *
+ * Layout (little-endian):
+ *
+ *   Header   32 bytes
+ *     [0]  magic "SASC"          [4]  format version     [6] header size
+ *     [8]  SAS address           [9]  reserved (3)       [12] state length
+ *     [16] start, Unix time (us) [24] reserved (8)
+ *   State    state length bytes (opaque, e.g. a meter snapshot image)
+ *   Records  until end of file:
+ *     [0]  time since start (us) [8]  direction          [9]  flags
+ *     [10] length                [12] bytes (as on the wire)
+ *
+ * Polls are recorded one frame per record, in the form the channel
+ * delivers them (address byte stripped, see SASFrameParser); responses
+ * are recorded one write() per record, address byte included.
+ *
+ * Record flags hold the 9th bit and the CRC status: the host sets the
+ * wakeup bit on the (stripped) address byte of every poll, and the EGM
+ * clears it on every byte it sends. Poll CRCs are checked over the
+ * address and the frame, as the host computed them.
+ *
+ * Records are buffered and written in batches, so recording adds no
+ * system call to the poll path; the buffer is written out when it fills,
+ * once a second, and on close(). A torn last record (power loss) is
+ * dropped by load().
+ */
+class TrafficCapture {
+public:
+    static constexpr uint32_t MAGIC = 0x43534153;               // "SASC"
+    static constexpr uint16_t FORMAT_VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 32;
+    static constexpr size_t RECORD_HEADER_SIZE = 12;
+
+    enum Direction : uint8_t {
+        POLL = 0,                       // Host to EGM
+        RESPONSE = 1                    // EGM to host
+    };
+
+    // Record flag bits
+    static constexpr uint8_t FLAG_WAKEUP = 0x01;        // 9th bit set on the first byte
+    static constexpr uint8_t FLAG_CRC_OK = 0x02;        // Frame carries a CRC and it matches
+    static constexpr uint8_t FLAG_CRC_BAD = 0x04;       // Frame carries a CRC and it does not match
+
+    struct Record {
+        uint64_t micros;                // Since the capture started
+        uint8_t direction;              // Direction
+        uint8_t flags;                  // FLAG_* bits
+        std::vector<uint8_t> bytes;
+    };
+
+    struct Info {
+        uint8_t address;
+        uint64_t startedAt;             // Unix time in microseconds
+        std::vector<uint8_t> state;     // Machine state when the capture started
+    };
+
+    TrafficCapture(const std::string& path, uint8_t address);
+    ~TrafficCapture();
+
+    TrafficCapture(const TrafficCapture&) = delete;
+    TrafficCapture& operator=(const TrafficCapture&) = delete;
+
+    /**
+     * Create (truncate) the capture file and write its header
+     * @param state Machine state to replay from (stored as is)
+     * @return true if the file was created
+     */
+    bool open(const std::vector<uint8_t>& state = std::vector<uint8_t>());
+
+    /**
+     * Write out buffered records and close the file
+     */
+    void close();
+
+    bool isOpen() const { return fd_ >= 0; }
+    const std::string& getPath() const { return path_; }
+    uint8_t getAddress() const { return address_; }
+
+    /**
+     * Record one poll frame as delivered by the channel (thread-safe)
+     */
+    void recordPoll(const uint8_t* frame, size_t length);
+
+    /**
+     * Record one response as written to the channel (thread-safe)
+     */
+    void recordResponse(const uint8_t* bytes, size_t length);
+
+    /**
+     * Write out buffered records now
+     */
+    void flush();
+
+    /**
+     * Number of records captured so far
+     */
+    uint64_t getRecordCount() const;
+
+    /**
+     * Flags of a poll frame (address byte stripped) sent to an address
+     */
+    static uint8_t pollFlags(uint8_t address, const uint8_t* frame, size_t length);
+
+    /**
+     * Flags of a response ([address][command][data][CRC])
+     */
+    static uint8_t responseFlags(const uint8_t* bytes, size_t length);
+
+    /**
+     * Read a capture file
+     * @param path File to read
+     * @param info Receives the header and the stored state
+     * @param records Receives every complete record
+     * @return false if the file is missing or is not a capture of this format version
+     */
+    static bool load(const std::string& path, Info& info, std::vector<Record>& records);
+
+private:
+    static constexpr size_t FLUSH_BYTES = 64 * 1024;
+    static constexpr int FLUSH_INTERVAL_MS = 1000;
+
+    void append(uint8_t direction, uint8_t flags, const uint8_t* bytes, size_t length);
+    bool writeBuffered();               // mutex_ held
+
+    std::string path_;
+    uint8_t address_;
+    int fd_;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point lastFlush_;
+    std::vector<uint8_t> buffer_;       // Records not yet written
+    uint64_t recordCount_;
+    mutable std::mutex mutex_;          // Receive and send paths may be different threads
+};
+
+/**
+ * RecordingChannel - CommChannel decorator feeding a TrafficCapture
+ *
+ * Forwards every call to the wrapped channel (including getReadFd(), so
+ * the port can still be served by SASPortPool). Received bytes are split
+ * into polls by a private SASFrameParser, independently of the port's own
+ * parser but with the same resync (CRC rescans, reset after an inter-byte
+ * gap); every write() is recorded as one response.
+ */
+class RecordingChannel : public io::CommChannel {
+public:
+    RecordingChannel(std::shared_ptr<io::CommChannel> channel,
+                     std::shared_ptr<TrafficCapture> capture);
+
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    int read(uint8_t* buffer, int maxBytes,
+             std::chrono::milliseconds timeout) override;
+    int receive(io::ByteRing& ring, std::chrono::milliseconds timeout) override;
+    int getReadFd() const override;
+    int write(const uint8_t* buffer, int numBytes) override;
+    void flush() override;
+    std::string getName() const override;
+
+    std::shared_ptr<io::CommChannel> getChannel() const { return channel_; }
+    std::shared_ptr<TrafficCapture> getCapture() const { return capture_; }
+
+private:
+    void recordReceived(const uint8_t* bytes, size_t length);
+
+    std::shared_ptr<io::CommChannel> channel_;
+    std::shared_ptr<TrafficCapture> capture_;
+    SASFrameParser parser_;             // Receiving thread only
+    std::chrono::steady_clock::time_point lastByteAt_;     // Receiving thread only
+};
+
+} // namespace sas
+
+
+#endif // SAS_TRAFFICCAPTURE_H
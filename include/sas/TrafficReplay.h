@@ -0,0 +1,92 @@
+#ifndef SAS_TRAFFICREPLAY_H
+#define SAS_TRAFFICREPLAY_H
+
+#include "sas/TrafficCapture.h"
+#include "simulator/Machine.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <ostream>
+
+
+namespace sas {
+
+/**
+ * TrafficReplay - Drive a SASCommPort from a TrafficCapture
+ *
+ * The port is attached to one end of a PipedCommChannel pair and served
+ * synchronously on the calling thread: each recorded poll is written to
+ * the other end, the port answers it with serviceOnce(), and whatever it
+ * wrote is compared byte for byte with the responses recorded after that
+ * poll. The machine should start from the capture's recorded state.
+ *
+ * Polls are sent either at their recorded offsets from the start of the
+ * capture (timing fidelity, for timing-sensitive behaviour such as
+ * exception queuing between polls) or back to back, as fast as the port
+ * can answer. Back to back, the port's framing is still reset wherever the
+ * recording has an inter-byte gap before a poll, so resync after a bad
+ * poll behaves as it did on the line.
+ *
+ * Response time is measured from the write of the poll to the read of the
+ * complete answer, so it is the port's processing time without the serial
+ * line, and is reported as percentiles next to the recorded line times.
+ */
+class TrafficReplay {
+public:
+    static constexpr size_t MAX_REPORTED_MISMATCHES = 20;
+
+    struct Mismatch {
+        size_t poll;                    // Index of the poll in the capture
+        uint64_t micros;                // Recorded time of the poll
+        std::vector<uint8_t> request;
+        std::vector<uint8_t> expected;  // Recorded responses
+        std::vector<uint8_t> actual;    // Replayed responses
+    };
+
+    struct Latency {
+        uint64_t p50 = 0;               // Microseconds
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+
+    struct Report {
+        size_t polls = 0;
+        size_t matched = 0;
+        size_t mismatched = 0;
+        size_t crcErrors = 0;           // Recorded polls whose CRC did not match
+        double elapsedSeconds = 0;
+        Latency replayed;               // Poll written to response read, in process
+        Latency recorded;               // Poll received to response written, on the line
+        std::vector<Mismatch> mismatches;   // First MAX_REPORTED_MISMATCHES
+    };
+
+    /**
+     * @param machine Machine to answer the polls (state restored by the caller)
+     * @param address SAS address the capture was recorded at
+     */
+    TrafficReplay(simulator::Machine* machine, uint8_t address);
+
+    /**
+     * Replay every poll of a capture
+     * @param records Capture records, in recorded order
+     * @param realTime Send polls at their recorded offsets instead of back to back
+     */
+    Report run(const std::vector<TrafficCapture::Record>& records, bool realTime);
+
+    /**
+     * Print a report (percentiles and the first mismatches as hex)
+     */
+    static void printReport(const Report& report, std::ostream& out);
+
+private:
+    static Latency percentiles(std::vector<uint64_t>& samples);
+
+    simulator::Machine* machine_;
+    uint8_t address_;
+};
+
+} // namespace sas
+
+
+#endif // SAS_TRAFFICREPLAY_H
@@ -3,6 +3,7 @@
 
 #include "sas/SASCommands.h"
 #include "simulator/Machine.h"
+#include <array>
 #include <vector>
 #include <cstdint>
 
@@ -30,7 +31,7 @@ public:
      * @return Response with lock status
      */
     static Message handleRegisterLock(simulator::Machine* machine,
-                                      const std::vector<uint8_t>& data);
+                                      const MessageData& data);
 
     /**
      * Handle "AFT Gaming Machine Lock and Status Request" (0x71)
@@ -40,7 +41,7 @@ public:
      * @return Response with current lock and transfer status
      */
     static Message handleLockStatus(simulator::Machine* machine,
-                                    const std::vector<uint8_t>& data);
+                                    const MessageData& data);
 
     /**
      * Handle "AFT Transfer Funds" (0x72)
@@ -50,7 +51,7 @@ public:
      * @return Response with transfer status
      */
     static Message handleTransferFunds(simulator::Machine* machine,
-                                       const std::vector<uint8_t>& data);
+                                       const MessageData& data);
 
     /**
      * Handle "AFT Register Gaming Machine Unlock" (0x73)
@@ -60,7 +61,7 @@ public:
      * @return Response with unlock status
      */
     static Message handleUnlock(simulator::Machine* machine,
-                                const std::vector<uint8_t>& data);
+                                const MessageData& data);
 
     /**
      * Handle "AFT Interrogate Current Transfer Status" (0x74)
@@ -123,13 +124,17 @@ public:
         LOCK_FORBIDDEN = 0xFF
     };
 
+    // Fixed-size AFT identifiers (kept inline, no heap storage)
+    typedef std::array<uint8_t, 2> LockCode;
+    typedef std::array<uint8_t, 4> TransactionID;
+
 private:
     /**
      * Validate lock code
      * @param lockCode Lock code from host (2 bytes)
      * @return true if valid
      */
-    static bool validateLockCode(const std::vector<uint8_t>& lockCode);
+    static bool validateLockCode(const LockCode& lockCode);
 
     /**
      * Build AFT status response
@@ -138,13 +143,15 @@ private:
      * @param transferStatus Current transfer status
      * @param amount Transfer amount (in cents)
      * @param transactionID Transaction ID
+     * @param transferType Transfer type of the last transfer
      * @return Response message
      */
     static Message buildStatusResponse(uint8_t address,
                                        uint8_t command,
                                        uint8_t transferStatus,
                                        uint64_t amount,
-                                       const std::vector<uint8_t>& transactionID);
+                                       const TransactionID& transactionID,
+                                       uint8_t transferType);
 
     /**
      * Execute transfer to gaming machine (credits in)
@@ -163,6 +170,36 @@ private:
     static bool executeTransferFromMachine(simulator::Machine* machine, uint64_t amount);
 };
 
+/**
+ * AFTState - AFT lock, transfer history and 0x74 status of one machine
+ *
+ * Owned by the machine (simulator::Machine::getAFTState()), so it lives
+ * and dies with it. Only the machine's SAS servicing thread uses it.
+ */
+struct AFTState {
+    bool aftRegistered = false;
+    AFTCommands::LockCode currentLockCode = {{0, 0}};
+    uint8_t currentLockStatus = AFTCommands::LOCK_AVAILABLE;
+    uint8_t currentTransferStatus = AFTCommands::TRANSFER_PENDING;
+    uint64_t lastTransferAmount = 0;
+    AFTCommands::TransactionID lastTransactionID = {{0, 0, 0, 0}};
+    uint8_t lastTransferType = 0;
+
+    // Additional AFT state for 0x74 response (loaded from egm-config.json)
+    uint64_t assetNumber = 0;                   // Machine asset number, else config: machineInfo.assetNumber
+    uint8_t gameLockStatus = 0xFF;              // 0xFF = Not locked (runtime state)
+    uint8_t availableTransfers = 0x00;          // Bitmask of available transfer types (runtime state)
+    uint8_t hostCashoutStatus = 0;              // Loaded from config: aft.hostCashoutStatus
+    uint8_t aftStatus = 0;                      // Loaded from config: aft.aftStatusFlags
+    uint8_t maxBufferIndex = 0;                 // Loaded from config: aft.maxBufferIndex
+    uint64_t currentRestrictedAmount = 0;       // Restricted promo credits (cents) - runtime state
+    uint64_t currentNonRestrictedAmount = 0;    // Non-restricted promo credits (cents) - runtime state
+    uint64_t gameTransferLimit = 0;             // Loaded from config: aft.transferLimit
+    uint32_t restrictedExpiration = 0;          // Expiration timestamp (0 = no expiration) - runtime state
+    uint16_t restrictedPoolID = 0;              // Loaded from config: aft.restrictedPoolID
+    bool configLoaded = false;                  // Track if config has been loaded
+};
+
 } // namespace commands
 } // namespace sas
 
@@ -13,6 +13,19 @@ namespace commands {
  */
 class ConfigCommands {
 public:
+    /**
+     * Handle Send Game Number (0x00)
+     *
+     * Response format:
+     * [Address][0x00][Game Number(1)][CRC]
+     *
+     * Reports the first configured game number, or 1 if no games are configured.
+     *
+     * @param machine Pointer to machine simulator
+     * @return Response message
+     */
+    static Message handleSendGameNumber(simulator::Machine* machine);
+
     /**
      * Handle Send Gaming Machine ID and Serial Number (0x54)
      *
@@ -65,7 +78,7 @@ public:
      * @param data Input data containing game number (2 BCD bytes)
      * @return Response message with game configuration
      */
-    static Message handleSendGameNConfiguration(simulator::Machine* machine, const std::vector<uint8_t>& data);
+    static Message handleSendGameNConfiguration(simulator::Machine* machine, const MessageData& data);
 
     /**
      * Handle Send Enabled Game Numbers (0x56)
@@ -116,7 +129,7 @@ public:
      * @param data Input data containing game number (2 BCD bytes)
      * @return Response message with gaming machine capabilities
      */
-    static Message handleEnableDisableGameN(simulator::Machine* machine, const std::vector<uint8_t>& data);
+    static Message handleEnableDisableGameN(simulator::Machine* machine, const MessageData& data);
 };
 
 } // namespace commands
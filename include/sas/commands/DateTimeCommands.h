@@ -33,15 +33,15 @@ public:
      * @return ACK response
      */
     static Message handleSetDateTime(simulator::Machine* machine,
-                                    const std::vector<uint8_t>& data);
+                                    const MessageData& data);
 
 private:
     /**
-     * Get current system time in SAS BCD format
+     * Append current system time in SAS BCD format
      * Format: MMDDYYYY HHMMSS (6 bytes date + 3 bytes time)
-     * @return Vector of BCD-encoded date/time bytes
+     * @param result Message data to append the BCD-encoded date/time bytes to
      */
-    static std::vector<uint8_t> getCurrentDateTimeBCD();
+    static void appendCurrentDateTimeBCD(MessageData& result);
 };
 
 } // namespace commands
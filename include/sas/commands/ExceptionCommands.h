@@ -87,6 +87,49 @@ public:
      */
     static void queueRAMError(io::MachineCommPort* port);
 
+    // --- Real-time event data (general poll reply [FF][event][data]) ---
+
+    /**
+     * Country code reported with accepted bills (SAS country code table)
+     */
+    static constexpr uint8_t BILL_COUNTRY_CODE = 0x00;
+
+    /**
+     * Encode game started (0x7E) event data:
+     * [credits wagered 2 BCD][coin in meter 4 BCD][wager type][progressive group]
+     * @param data Output buffer (at least 8 bytes)
+     * @return Data length
+     */
+    static size_t encodeGameStarted(uint8_t* data, uint64_t creditsWagered, uint64_t coinInMeter,
+                                    uint8_t wagerType, uint8_t progressiveGroup);
+
+    /**
+     * Encode game ended (0x7F) event data: [game win 4 BCD]
+     * @param data Output buffer (at least 4 bytes)
+     * @return Data length
+     */
+    static size_t encodeGameEnded(uint8_t* data, uint64_t gameWin);
+
+    /**
+     * Encode bill accepted (0x4F) event data:
+     * [country code BCD][denomination code BCD][bills of this type accepted 4 BCD]
+     * @param data Output buffer (at least 6 bytes)
+     * @return Data length
+     */
+    static size_t encodeBillAccepted(uint8_t* data, uint8_t countryCode, uint8_t denominationCode,
+                                     uint64_t billCount);
+
+    /**
+     * Build the general poll reply for an exception in real-time event mode
+     * @param address SAS address
+     * @param exceptionCode Exception code
+     * @param data Event data (may be empty)
+     * @param length Event data length
+     * @return [FF][exception][data] message
+     */
+    static Message buildRealTimeEventResponse(uint8_t address, uint8_t exceptionCode,
+                                              const uint8_t* data, size_t length);
+
 private:
     /**
      * Build exception response message
@@ -95,6 +138,11 @@ private:
      * @return Exception message
      */
     static Message buildExceptionResponse(uint8_t address, uint8_t exceptionCode);
+
+    /**
+     * Encode a meter as BCD, keeping the low digits when it has outgrown the field
+     */
+    static void encodeMeterBCD(uint64_t value, uint8_t* data, size_t numBytes);
 };
 
 } // namespace commands
@@ -229,21 +229,21 @@ public:
      * @param data Input data containing game number (2 BCD bytes)
      * @return Response with game-specific meters
      */
-    static Message handleSendSelectedGameMeters(simulator::Machine* machine, const std::vector<uint8_t>& data);
+    static Message handleSendSelectedGameMeters(simulator::Machine* machine, const MessageData& data);
 
     /**
      * Handle "Send Selected Meters for Game N" (0x2F)
-     * Send: [Addr][0x2F][Game Number (2 BCD)][Meter Code 1]...[Meter Code N][CRC]
+     * Send: [Addr][0x2F][Length][Game Number (2 BCD)][Meter Code 1]...[Meter Code N][CRC]
      * Response: [Addr][0x2F][Length][Game Number (2)][Code1][Value1(4 or 5)]...[CRC]
      *
      * Variable length response with requested meter codes and values
      * Most meters = 4 bytes BCD, some TITO meters = 5 bytes BCD
      *
      * @param machine Machine instance
-     * @param data Input data containing game number (2 BCD) and meter codes
+     * @param data Input data containing length, game number (2 BCD) and meter codes
      * @return Response with requested meters for specified game
      */
-    static Message handleSendSelectedMetersForGameN(simulator::Machine* machine, const std::vector<uint8_t>& data);
+    static Message handleSendSelectedMetersForGameN(simulator::Machine* machine, const MessageData& data);
 
     /**
      * Handle "Send Selected Game Number and Handpay Cancelled Credits" (0x2D)
@@ -255,7 +255,7 @@ public:
      * @param data Input data containing game number (2 BCD bytes)
      * @return Response with handpay cancelled credits
      */
-    static Message handleSendHandpayCancelledCredits(simulator::Machine* machine, const std::vector<uint8_t>& data);
+    static Message handleSendHandpayCancelledCredits(simulator::Machine* machine, const MessageData& data);
 
     /**
      * Handle "Send Selected Meters for Game N" (0x6F/0xAF)
@@ -273,7 +273,7 @@ public:
      */
     static Message handleSendSelectedMetersForGameNExtended(simulator::Machine* machine,
                                                             uint8_t command,
-                                                            const std::vector<uint8_t>& data);
+                                                            const MessageData& data);
 
 private:
     /**
@@ -290,11 +290,23 @@ private:
      * Build multi-meter response
      * @param address SAS address
      * @param command Command code
-     * @param meterValues List of meter values
+     * @param meterValues Array of meter values
+     * @param count Number of meter values
      * @return Complete message with all meters
      */
     static Message buildMultiMeterResponse(uint8_t address, uint8_t command,
-                                          const std::vector<uint64_t>& meterValues);
+                                          const uint64_t* meterValues, size_t count);
+
+    /**
+     * Read a meter of one game by SAS meter code (0x2F, 0x6F/AF)
+     * Game-level meters come from the game's block (machine totals for
+     * game 0); every other code is a machine-wide meter
+     * @param machine Machine instance
+     * @param gameNumber Game number, 0 for the whole machine
+     * @param meterCode SAS meter code
+     * @return Meter value (0 if the meter is not kept)
+     */
+    static uint64_t readSelectedMeter(simulator::Machine* machine, int gameNumber, int meterCode);
 };
 
 } // namespace commands
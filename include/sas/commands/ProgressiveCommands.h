@@ -40,7 +40,7 @@ public:
      * @return Response with progressive amount
      */
     static Message handleSendProgressiveAmount(simulator::Machine* machine,
-                                               const std::vector<uint8_t>& data);
+                                               const MessageData& data);
 
     /**
      * Handle "Send Progressive Win Amount" (0x52)
@@ -50,7 +50,7 @@ public:
      * @return Response with win information
      */
     static Message handleSendProgressiveWin(simulator::Machine* machine,
-                                           const std::vector<uint8_t>& data);
+                                           const MessageData& data);
 
     /**
      * Handle "Send Progressive Levels" (0x53)
@@ -5,6 +5,7 @@
 #include "simulator/Machine.h"
 #include <vector>
 #include <cstdint>
+#include <ctime>
 
 
 namespace sas {
@@ -46,7 +47,7 @@ public:
      * @return Response with redemption result
      */
     static Message handleRedeemTicket(simulator::Machine* machine,
-                                     const std::vector<uint8_t>& data);
+                                     const MessageData& data);
 
     /**
      * Handle "Send Ticket Information" (0x7E)
@@ -95,10 +96,26 @@ private:
     /**
      * Validate ticket redemption
      * Checks if validation number is valid and not expired
+     * @param machine Machine that printed the ticket
      * @param validationNumber Validation number to check
      * @return true if valid
      */
-    static bool validateTicketRedemption(const std::vector<uint8_t>& validationNumber);
+    static bool validateTicketRedemption(simulator::Machine* machine,
+                                         const std::vector<uint8_t>& validationNumber);
+};
+
+/**
+ * TicketState - Last ticket printed by one machine
+ *
+ * Owned by the machine (simulator::Machine::getTicketState()) and restored
+ * from its NVRAM on first use. Only the machine's SAS servicing thread
+ * uses it.
+ */
+struct TicketState {
+    std::vector<uint8_t> lastValidationNumber = std::vector<uint8_t>(8, 0);
+    uint64_t lastTicketAmount = 0;
+    time_t lastTicketTime = 0;
+    bool restored = false;              // NVRAM record read
 };
 
 } // namespace commands
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstdint>
+#include "Money.h"
 
 
 namespace simulator {
@@ -27,11 +28,10 @@ public:
     // Getters
     int getGameNumber() const { return gameNumber_; }
     int getDenomCode() const { return denomCode_; }
-    double getDenom() const;  // Returns denomination in dollars
+    Cents getDenom() const;  // Value of one credit
     int getMaxBet() const { return maxBet_; }
     std::string getGameName() const { return gameName_; }
     std::string getPaytable() const { return paytable_; }
-    double getCoinInMeter() const { return coinInMeter_; }
 
     // Setters
     void setMaxBet(int maxBet) { maxBet_ = maxBet; }
@@ -39,16 +39,11 @@ public:
     void setPaytable(const std::string& paytable) { paytable_ = paytable; }
 
     /**
-     * Place a bet and update coin-in meter
+     * Price a bet (the game's meters are kept by Machine, see GameMeters)
      * @param credits Number of credits to bet
-     * @return The dollar amount of the bet
+     * @return The amount of the bet
      */
-    double bet(int credits);
-
-    /**
-     * Reset the coin-in meter
-     */
-    void resetCoinInMeter();
+    Cents bet(Credits credits) const;
 
 private:
     int gameNumber_;
@@ -56,7 +51,6 @@ private:
     int maxBet_;
     std::string gameName_;
     std::string paytable_;
-    double coinInMeter_;  // Total wagered on this game in dollars
 };
 
 } // namespace simulator
@@ -0,0 +1,163 @@
+#ifndef SIMULATOR_GAMEMETERS_H
+#define SIMULATOR_GAMEMETERS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <vector>
+
+
+namespace simulator {
+
+/**
+ * GameMeters - Per-game and per-denomination meter blocks
+ *
+ * Game-level meters (coin in/out, jackpot, games played/won/lost) are kept
+ * once per game number and once per SAS denomination code, next to the
+ * machine totals in MeterStore. Storage is structure-of-arrays: one array
+ * per meter, indexed by game slot (or denomination code), so a game-N poll
+ * is a slot lookup plus one load per meter, and a pass over one meter for
+ * every game walks contiguous memory.
+ *
+ * Game numbers map to slots through a direct table (SAS game numbers are
+ * 2-byte BCD, 0001-9999). Games sharing a number (one game offered at
+ * several denominations) share a game block; each play is also counted in
+ * the block of the denomination it was played at.
+ *
+ * Same concurrency model as MeterStore: lock-free reads, writers serialized
+ * by a mutex and bracketed by a sequence counter, so getGame() returns a
+ * block in which no write is half-applied. An optional write observer (the
+ * meter journal or NVRAM) sees every changed game and denomination meter.
+ */
+class GameMeters {
+public:
+    static constexpr int MAX_GAMES = 64;            // Game blocks
+    static constexpr int MAX_GAME_NUMBER = 9999;    // 2-byte BCD
+    static constexpr int DENOM_CODES = 64;          // SAS denomination codes 0x00-0x3F
+
+    // Meters kept per game, in block order
+    enum Field {
+        COIN_IN = 0,
+        COIN_OUT,
+        JACKPOT,
+        GAMES_PLAYED,
+        GAMES_WON,
+        GAMES_LOST,
+        FIELD_COUNT
+    };
+
+    // Block a changed meter belongs to
+    enum BlockKind {
+        GAME_BLOCK,
+        DENOM_BLOCK
+    };
+
+    // Called with (kind, game number or denomination code, meter code, new
+    // value) while writers are still serialized
+    using WriteObserver = std::function<void(BlockKind, int, int, int64_t)>;
+
+    GameMeters();
+
+    GameMeters(const GameMeters&) = delete;
+    GameMeters& operator=(const GameMeters&) = delete;
+
+    /**
+     * Field holding a SAS meter code, or -1 if the meter is machine-wide only
+     */
+    static int fieldOf(int meterCode);
+
+    /**
+     * SAS meter code a field is reported as
+     */
+    static int meterCodeOf(int field);
+
+    /**
+     * Give a game number a block (idempotent)
+     * @return Slot, or -1 if the number is out of range or all blocks are taken
+     */
+    int addGame(int gameNumber);
+
+    /**
+     * Get the block of a game number (O(1))
+     * @return Slot, or -1 if the game is unknown
+     */
+    int slotOf(int gameNumber) const;
+
+    /**
+     * Get every game number that has a block, in slot order
+     */
+    std::vector<int> getGameNumbers() const;
+
+    /**
+     * Add to a game meter and to the same meter of the denomination it was
+     * played at. Codes that are not game-level meters are ignored.
+     */
+    void add(int gameNumber, int denomCode, int meterCode, int64_t amount);
+
+    /**
+     * Set a game's meter (restore), giving the game a block if it has none.
+     * Denomination blocks are not touched; restore them with setDenom().
+     */
+    void setGame(int gameNumber, int meterCode, int64_t value);
+
+    /**
+     * Set a denomination's meter (restore)
+     */
+    void setDenom(int denomCode, int meterCode, int64_t value);
+
+    /**
+     * Read several meters of one game as one consistent snapshot
+     * @param values Receives count values (0 for non game-level codes)
+     * @return false if the game is unknown
+     */
+    bool getGame(int gameNumber, const int* meterCodes, size_t count, int64_t* values) const;
+
+    /**
+     * Get one game meter (0 for unknown games or codes)
+     */
+    int64_t getGame(int gameNumber, int meterCode) const;
+
+    /**
+     * Get one denomination meter (0 for unknown codes)
+     */
+    int64_t getDenom(int denomCode, int meterCode) const;
+
+    /**
+     * Install (or clear, with an empty function) the write observer.
+     * The observer must not write meters itself.
+     */
+    void setWriteObserver(WriteObserver observer);
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+    template<typename Read>
+    void readConsistent(Read read) const {
+        for (;;) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;  // Write in progress
+            }
+            read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+    }
+
+    std::atomic<int64_t> games_[FIELD_COUNT][MAX_GAMES];       // [meter][slot]
+    std::atomic<int64_t> denoms_[FIELD_COUNT][DENOM_CODES];    // [meter][denomination code]
+    std::atomic<uint8_t> slots_[MAX_GAME_NUMBER + 1];          // Game number -> slot
+    int gameCount_;                                             // writeMutex_
+    std::atomic<uint64_t> sequence_;                            // Odd while a write is in progress
+    std::mutex writeMutex_;                                     // Serializes writers
+    WriteObserver observer_;                                    // Guarded by writeMutex_
+};
+
+} // namespace simulator
+
+
+#endif // SIMULATOR_GAMEMETERS_H
@@ -12,6 +12,9 @@
 #include <thread>
 #include <functional>
 #include "Game.h"
+#include "Money.h"
+#include "MeterStore.h"
+#include "GameMeters.h"
 #include "event/EventService.h"
 
 
@@ -23,17 +26,26 @@ namespace io {
 class MachineCommPort;
 }
 
+namespace sas {
+namespace commands {
+struct AFTState;
+struct TicketState;
+}
+}
+
 namespace simulator {
 
+class NvramStore;
+
 /**
  * LevelValue represents a progressive jackpot level
  */
 struct LevelValue {
     int levelId;
-    double value;  // Using double for BigDecimal equivalent (in dollars)
+    Cents value;
 
-    LevelValue() : levelId(0), value(0.0) {}
-    LevelValue(int id, double val) : levelId(id), value(val) {}
+    LevelValue() : levelId(0) {}
+    LevelValue(int id, Cents val) : levelId(id), value(val) {}
 };
 
 /**
@@ -41,7 +53,7 @@ struct LevelValue {
  */
 struct CreditVoucher {
     uint64_t validationNumber;
-    double amount;
+    Cents amount;
     int voucherType;  // 0 = cashable, 1 = restricted, etc.
 };
 
@@ -52,8 +64,7 @@ struct CreditVoucher {
 class Machine {
 public:
     // Constants
-    static constexpr double CENTS_IN_DOLLAR = 100.0;
-    static constexpr double DEFAULT_HANDPAY_LIMIT = 400.00;
+    static constexpr Cents DEFAULT_HANDPAY_LIMIT = Cents(40000);     // $400
 
     // Constructor/Destructor
     explicit Machine(std::shared_ptr<event::EventService> eventService,
@@ -66,62 +77,124 @@ public:
 
     // Game management
     void setCurrentGame(std::shared_ptr<Game> game);
-    void setCurrentGame(int gameNumber, double denomAmount);
-    std::shared_ptr<Game> getGame(int gameNumber, double denomAmount);
+    void setCurrentGame(int gameNumber, Cents denom);
+    std::shared_ptr<Game> getGame(int gameNumber, Cents denom);
     std::shared_ptr<Game> addGame(int gameNumber, int denomCode, int maxBet,
                                    const std::string& gameName, const std::string& paytable);
-    std::shared_ptr<Game> addGame(int gameNumber, double denom, int maxBet,
+    std::shared_ptr<Game> addGame(int gameNumber, Cents denom, int maxBet,
                                    const std::string& gameName, const std::string& paytable);
     std::shared_ptr<Game> getCurrentGame() const { return currentGame_; }
     const std::vector<std::shared_ptr<Game>>& getGames() const { return games_; }
     int getCurrentGameIndex() const;
 
-    // Meter management
+    // Meter management (lock-free reads, see MeterStore)
     bool hasMeter(int meterCode) const;
     int64_t getMeter(int meterCode) const;
     void setMeter(int meterCode, int64_t value);
     void incrementMeter(int meterCode, int64_t amount);
     int64_t getGamesPlayed() const;
 
-    const std::map<int, int64_t>& getMachineMeters() const { return machineMeters_; }
+    /**
+     * Read several meters as one consistent snapshot
+     * @param meterCodes METER_* codes to read
+     * @param count Number of codes
+     * @param values Receives count values, in the order of meterCodes
+     */
+    void getMeters(const int* meterCodes, size_t count, int64_t* values) const;
+
+    template<size_t N>
+    void getMeters(const int (&meterCodes)[N], int64_t (&values)[N]) const {
+        getMeters(meterCodes, N, values);
+    }
+
+    std::map<int, int64_t> getMachineMeters() const { return meters_.snapshot(); }
+
+    /**
+     * Write several meters at once (restoring persisted meters)
+     * @param meterCodes METER_* codes to write
+     * @param count Number of codes
+     * @param values New values, in the order of meterCodes
+     */
+    void setMeters(const int* meterCodes, size_t count, const int64_t* values);
+
+    /**
+     * Copy every meter slot as one snapshot (see MeterStore::getAll)
+     */
+    void getAllMeters(int64_t* values, bool* present) const { meters_.getAll(values, present); }
+
+    /**
+     * Read several meters of one game as one consistent snapshot. Game 0 is
+     * the machine as a whole; other games answer from their own block, with
+     * 0 for meters that are only kept machine-wide (see GameMeters).
+     * @return false if the game is unknown
+     */
+    bool getGameMeters(int gameNumber, const int* meterCodes, size_t count, int64_t* values) const;
+    bool hasGameMeters(int gameNumber) const;
+    std::vector<int> getMeteredGameNumbers() const { return gameMeters_.getGameNumbers(); }
+    int64_t getGameMeter(int gameNumber, int meterCode) const;
+    void setGameMeter(int gameNumber, int meterCode, int64_t value);
+
+    // Game-level meters per SAS denomination code
+    int64_t getDenomMeter(int denominationCode, int meterCode) const;
+    void setDenomMeter(int denominationCode, int meterCode, int64_t value);
+
+    // Changes whenever any meter is written (cheap "anything new?" check)
+    uint64_t getMetersVersion() const { return meters_.getVersion(); }
+
+    // Sees every meter write in order (config::MeterJournal or NvramStore)
+    void setMeterWriteObserver(MeterStore::WriteObserver observer) { meters_.setWriteObserver(observer); }
+    void setGameMeterWriteObserver(GameMeters::WriteObserver observer) { gameMeters_.setWriteObserver(observer); }
+
+    // NVRAM holding this machine's meters, AFT log and tickets (null if none).
+    // Set once before the SAS ports start.
+    void setNvramStore(std::shared_ptr<NvramStore> store) { nvram_ = store; }
+    std::shared_ptr<NvramStore> getNvramStore() const { return nvram_; }
+
+    // SAS AFT lock/transfer state and last printed ticket of this machine.
+    // Only the SAS thread servicing the machine uses them.
+    sas::commands::AFTState& getAFTState() { return *aftState_; }
+    sas::commands::TicketState& getTicketState() { return *ticketState_; }
 
     // Progressive management
     void addProgressive(int levelId);
-    void setProgressive(int levelId, float amount);
-    void setProgressiveValue(int levelId, double amount, bool updateTime = true);
-    double getProgressive(int levelId) const;
+    void setProgressive(int levelId, float dollars);
+    void setProgressiveValue(int levelId, Cents amount, bool updateTime = true);
+    Cents getProgressive(int levelId) const;
     std::vector<int> getProgressiveLevelIds() const;
     void progressiveHit(int levelId);
     LevelValue getOldestHit();
     bool isProgressiveLinkUp() const;
     void clearProgressiveValues();
 
-    // Credits management
+    // Credits management (int64_t: accounting denomination credits, as metered)
     int64_t getCredits() const;
-    double getCashableAmount() const;
+    Cents getCashableAmount() const;
     void addCredits(int64_t credits);
-    void addCredits(double dollarAmount);
+    void addCredits(Cents amount);
 
     int64_t getRestrictedCredits() const;
-    double getRestrictedAmount() const;
+    Cents getRestrictedAmount() const;
     void addRestrictedCredits(int64_t credits);
-    void addRestrictedCredits(double dollarAmount);
+    void addRestrictedCredits(Cents amount);
 
     int64_t getNonRestrictedCredits() const;
-    double getNonRestrictedAmount() const;
-    void addNonRestrictedCredits(int credits);
-    void addNonRestrictedCredits(double dollarAmount);
+    Cents getNonRestrictedAmount() const;
+    void addNonRestrictedCredits(int64_t credits);
+    void addNonRestrictedCredits(Cents amount);
 
     // Jackpot/Award management
-    void addJackpot(double award);
-    void addCoinOut(double coinOut);
+    void addJackpot(Cents award);
+    void addCoinOut(Cents coinOut);
+
+    // Bill acceptor (credits, bill meters and BillAcceptedEvent)
+    void billAccepted(Cents amount);
     void awardBonus(int64_t bonusUnits, bool aft);
 
     // Game play
     int64_t playGameCredit();
     void gameStart(int credits);
     void pokerGameStart(int credits, const std::string& dealtHand);
-    void gameEnd();
+    void gameEnd(int64_t winCredits = 0);
     void pokerGameEnd(const std::string& finalHand);
     void GameWon();
     void GameLost();
@@ -129,9 +202,9 @@ public:
     void betMax();
     void secondaryWager(int credits);
 
-    int64_t getCreditsByGameDenom() const;
-    int64_t getRestrictedCreditsByGameDenom() const;
-    int64_t getNonRestrictedCreditsByGameDenom() const;
+    Credits getCreditsByGameDenom() const;
+    Credits getRestrictedCreditsByGameDenom() const;
+    Credits getNonRestrictedCreditsByGameDenom() const;
 
     // Machine state
     void start();
@@ -151,8 +224,8 @@ public:
     bool isHopperLow() const { return hopperLow_; }
 
     // Handpay
-    double getHandpayLimit() const { return handpayLimit_; }
-    void setHandpayLimit(double limit) { handpayLimit_ = limit; }
+    Cents getHandpayLimit() const { return handpayLimit_; }
+    void setHandpayLimit(Cents limit) { handpayLimit_ = limit; }
     bool isHandpayPending() const;
     void handpayReset();
     void cashoutButtonTriggerHandpay();
@@ -171,15 +244,17 @@ public:
     void publishAftTransfer(int64_t cashableAmount, int64_t restrictedAmount,
                            int64_t nonRestrictedAmount);
     void publishAftLock(bool lock);
+    void publishGameStarted(int credits, Cents wager);
+    void publishGameEnded(int64_t winCredits);
     void publishEftTransfer();
     void publishGameDelay(int64_t delayMillis);
 
     // Denomination
     int getAccountingDenomCode() const { return accountingDenomCode_; }
     void setAccountingDenomCode(int code) { accountingDenomCode_ = code; }
-    double getAccountingDenom() const;
-    int64_t toAccountingDenom(double amount) const;
-    double fromAccountingDenom(int64_t amount) const;
+    Cents getAccountingDenom() const;
+    int64_t toAccountingDenom(Cents amount) const;      // Whole credits, remainder left out
+    Cents fromAccountingDenom(int64_t credits) const;
 
     std::vector<int> getEnabledDenomCodes() const;
     std::vector<int> getEnabledGames(int denominationCode) const;
@@ -192,14 +267,14 @@ public:
     std::string getBasePercentage(int themeId) const;
 
     // Meters
-    double getCoinInMeter() const;
-    double getCoinInMeter(int denomCode) const;
+    Cents getCoinInMeter() const;
+    Cents getCoinInMeter(int denomCode) const;
     int64_t getCoinOutMeter() const;
-    double getCoinOutMeterAsCurrency() const;
+    Cents getCoinOutMeterAsCurrency() const;
     int64_t getDropMeter() const;
-    double getDropMeterAsCurrency() const;
+    Cents getDropMeterAsCurrency() const;
     int64_t getJackpotMeter() const;
-    double getJackpotMeterAsCurrency() const;
+    Cents getJackpotMeterAsCurrency() const;
     int64_t getDenomMeter(int denominationCode) const;
 
     // Progressive group
@@ -263,13 +338,12 @@ public:
 private:
     // Private helper methods
     void initializeMeters();
-    int getDenomCode(double denom) const;
-    double convertDenomToBigDecimal(double denom) const;
     int64_t playRestrictedGameCredit();
     int64_t playNonRestrictedGameCredit();
-    void addPendingHandpay(double amount, int levelId);
+    void addPendingHandpay(Cents amount, int levelId);
     void gameStateException(const std::string& msg);
     void progressiveWatchdogTask();
+    void incrementGameMeter(int meterCode, int64_t amount);  // Total and current game/denomination
 
     // Member variables
     std::shared_ptr<event::EventService> eventService_;
@@ -279,7 +353,11 @@ private:
     std::vector<std::shared_ptr<Game>> games_;
     std::shared_ptr<Game> currentGame_;
 
-    std::map<int, int64_t> machineMeters_;
+    MeterStore meters_;
+    GameMeters gameMeters_;                 // Per game / denomination, beside the totals in meters_
+    std::shared_ptr<NvramStore> nvram_;
+    std::unique_ptr<sas::commands::AFTState> aftState_;
+    std::unique_ptr<sas::commands::TicketState> ticketState_;
     std::vector<LevelValue> progressives_;
     std::queue<LevelValue> progressiveHits_;
     std::queue<int64_t> pendingHandpayReset_;
@@ -291,7 +369,7 @@ private:
     int64_t assetNumber_;
     int64_t lastProgressiveSetTime_;
     int64_t delayMillis_;
-    double handpayLimit_;
+    Cents handpayLimit_;
     std::string basePercentage_;
     std::string pokerHand_;
 
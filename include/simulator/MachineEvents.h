@@ -4,6 +4,7 @@
 #include <cstdint>
 #include "simulator/Game.h"
 #include "simulator/Machine.h"
+#include "simulator/Money.h"
 
 
 namespace simulator {
@@ -28,10 +29,10 @@ struct LevelValueChangedEvent : public MachineEvent {
  * Event published when a bonus is awarded
  */
 struct BonusAwardedEvent : public MachineEvent {
-    double amount;
+    Cents amount;
     bool aft;
 
-    BonusAwardedEvent(double amt, bool isAft) : amount(amt), aft(isAft) {}
+    BonusAwardedEvent(Cents amt, bool isAft) : amount(amt), aft(isAft) {}
 };
 
 /**
@@ -56,11 +57,11 @@ struct AftLockedEvent : public MachineEvent {
  * Event published for AFT transfers
  */
 struct AftTransferEvent : public MachineEvent {
-    double cashableAmount;
-    double restrictedAmount;
-    double nonRestrictedAmount;
+    Cents cashableAmount;
+    Cents restrictedAmount;
+    Cents nonRestrictedAmount;
 
-    AftTransferEvent(double cashable, double restricted, double nonRestricted)
+    AftTransferEvent(Cents cashable, Cents restricted, Cents nonRestricted)
         : cashableAmount(cashable),
           restrictedAmount(restricted),
           nonRestrictedAmount(nonRestricted) {}
@@ -70,9 +71,9 @@ struct AftTransferEvent : public MachineEvent {
  * Event published when legacy bonus is credited
  */
 struct LegacyBonusCreditedEvent : public MachineEvent {
-    double amount;
+    Cents amount;
 
-    explicit LegacyBonusCreditedEvent(double amt) : amount(amt) {}
+    explicit LegacyBonusCreditedEvent(Cents amt) : amount(amt) {}
 };
 
 /**
@@ -94,14 +95,39 @@ struct GameChangedEvent : public MachineEvent {
 };
 
 /**
- * Event published when a game is played
+ * Event published when a game is played (game start)
  */
 struct GamePlayedEvent : public MachineEvent {
+    const Machine* machine;     // Machine the game was played on
     std::shared_ptr<Game> game;
-    double wager;
+    Cents wager;
+    int credits;                // Credits wagered
 
-    GamePlayedEvent(std::shared_ptr<Game> g, double w)
-        : game(g), wager(w) {}
+    GamePlayedEvent(const Machine* m, std::shared_ptr<Game> g, Cents w, int c)
+        : machine(m), game(g), wager(w), credits(c) {}
+};
+
+/**
+ * Event published when a game ends
+ */
+struct GameEndedEvent : public MachineEvent {
+    const Machine* machine;
+    int64_t winCredits;         // Game win (accounting denomination credits)
+
+    GameEndedEvent(const Machine* m, int64_t win)
+        : machine(m), winCredits(win) {}
+};
+
+/**
+ * Event published when the bill acceptor stacks a bill
+ */
+struct BillAcceptedEvent : public MachineEvent {
+    const Machine* machine;
+    uint8_t denominationCode;   // SAS bill denomination code ($1 = 0x00, $2 = 0x01, $5 = 0x02, ...)
+    int64_t billsAccepted;      // Bills of this denomination accepted so far (meter)
+
+    BillAcceptedEvent(const Machine* m, uint8_t denomCode, int64_t count)
+        : machine(m), denominationCode(denomCode), billsAccepted(count) {}
 };
 
 /**
@@ -109,9 +135,9 @@ struct GamePlayedEvent : public MachineEvent {
  */
 struct ProgressiveHitEvent : public MachineEvent {
     int levelId;
-    double win;
+    Cents win;
 
-    ProgressiveHitEvent(int level, double winAmount)
+    ProgressiveHitEvent(int level, Cents winAmount)
         : levelId(level), win(winAmount) {}
 };
 
@@ -126,6 +152,17 @@ struct GameDelayEvent : public MachineEvent {
     int64_t getDelayMillis() const { return delayMillis; }
 };
 
+/**
+ * Event published when a comm port queues an exception for its host
+ */
+struct ExceptionQueuedEvent : public MachineEvent {
+    const Machine* machine;     // Machine whose port queued the exception
+    uint8_t code;
+
+    ExceptionQueuedEvent(const Machine* m, uint8_t exceptionCode)
+        : machine(m), code(exceptionCode) {}
+};
+
 } // namespace simulator
 
 
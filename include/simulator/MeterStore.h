@@ -0,0 +1,135 @@
+#ifndef SIMULATOR_METERSTORE_H
+#define SIMULATOR_METERSTORE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <functional>
+
+
+namespace simulator {
+
+/**
+ * MeterStore - Flat meter storage indexed by SASConstants::METER_* code
+ *
+ * One 64-bit atomic cell per code: 0x00-0xFF for SAS meters and the
+ * extended 0x100+ range for persistence-only meters. Lookups are a direct
+ * array index and never lock.
+ *
+ * Writers are serialized by a mutex and bracket every change with a
+ * sequence counter (seqlock). getMany() uses it to return a snapshot in
+ * which no write is half-applied, again without locking.
+ *
+ * An optional write observer (the meter journal) sees every change in
+ * write order, after it is visible to readers.
+ */
+class MeterStore {
+public:
+    static constexpr int CAPACITY = 0x200;     // Codes 0x000-0x1FF
+
+    // Called with (code, new value) while writers are still serialized
+    using WriteObserver = std::function<void(int, int64_t)>;
+
+    MeterStore();
+
+    /**
+     * Check whether a code fits in the store
+     */
+    static bool isValidCode(int meterCode) {
+        return meterCode >= 0 && meterCode < CAPACITY;
+    }
+
+    /**
+     * Check whether a meter has been initialized or written
+     */
+    bool has(int meterCode) const;
+
+    /**
+     * Get a meter value (0 for unknown or out-of-range codes)
+     */
+    int64_t get(int meterCode) const;
+
+    /**
+     * Set a meter value (out-of-range codes are ignored)
+     */
+    void set(int meterCode, int64_t value);
+
+    /**
+     * Add to a meter value (out-of-range codes are ignored)
+     */
+    void add(int meterCode, int64_t amount);
+
+    /**
+     * Read several meters as one consistent snapshot
+     * @param meterCodes Codes to read
+     * @param count Number of codes
+     * @param values Receives count values, in the order of meterCodes
+     */
+    void getMany(const int* meterCodes, size_t count, int64_t* values) const;
+
+    /**
+     * Write several meters as one change (one lock, one version step)
+     * @param meterCodes Codes to write (out-of-range codes are ignored)
+     * @param count Number of codes
+     * @param values New values, in the order of meterCodes
+     */
+    void setMany(const int* meterCodes, size_t count, const int64_t* values);
+
+    /**
+     * Copy the whole store as one consistent snapshot
+     * @param values Receives CAPACITY values, indexed by code
+     * @param present Receives CAPACITY flags: meter initialized or written
+     */
+    void getAll(int64_t* values, bool* present) const;
+
+    /**
+     * Copy every initialized meter as one consistent snapshot
+     * @return Map of meter code to value
+     */
+    std::map<int, int64_t> snapshot() const;
+
+    /**
+     * Get the number of completed writes; changes whenever any meter changes
+     */
+    uint64_t getVersion() const {
+        return sequence_.load(std::memory_order_acquire) >> 1;
+    }
+
+    /**
+     * Install (or clear, with an empty function) the write observer.
+     * The observer must not write meters itself.
+     */
+    void setWriteObserver(WriteObserver observer);
+
+private:
+    /**
+     * Seqlock read side: run read() until no writer overlapped it
+     */
+    template<typename Read>
+    void readConsistent(Read read) const {
+        for (;;) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;  // Write in progress
+            }
+            read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+    }
+
+    std::atomic<int64_t> values_[CAPACITY];
+    std::atomic<bool> present_[CAPACITY];
+    std::atomic<uint64_t> sequence_;            // Odd while a write is in progress
+    std::mutex writeMutex_;                     // Serializes writers
+    WriteObserver observer_;                    // Guarded by writeMutex_
+};
+
+} // namespace simulator
+
+
+#endif // SIMULATOR_METERSTORE_H
@@ -0,0 +1,144 @@
+#ifndef SIMULATOR_MONEY_H
+#define SIMULATOR_MONEY_H
+
+#include <cstdint>
+#include <cmath>
+#include <ostream>
+
+
+namespace simulator {
+
+/**
+ * Cents - An amount of money in whole cents
+ *
+ * Money is never held in floating point: meters are integers on the wire,
+ * and a double that is divided and truncated on every play drifts over
+ * millions of games. Dollars only appear where a person types or reads an
+ * amount (configuration, HTTP, console): fromDollars() and operator<<.
+ */
+class Cents {
+public:
+    constexpr Cents() : value_(0) {}
+    constexpr explicit Cents(int64_t cents) : value_(cents) {}
+
+    /**
+     * Amount typed in dollars, rounded to the nearest cent
+     */
+    static Cents fromDollars(double dollars) {
+        return Cents(static_cast<int64_t>(std::llround(dollars * 100.0)));
+    }
+
+    constexpr int64_t value() const { return value_; }
+    double toDollars() const { return value_ / 100.0; }
+
+    constexpr Cents operator-() const { return Cents(-value_); }
+    constexpr Cents operator+(Cents other) const { return Cents(value_ + other.value_); }
+    constexpr Cents operator-(Cents other) const { return Cents(value_ - other.value_); }
+    constexpr Cents operator*(int64_t count) const { return Cents(value_ * count); }
+    constexpr Cents operator%(Cents other) const { return Cents(value_ % other.value_); }
+
+    Cents& operator+=(Cents other) { value_ += other.value_; return *this; }
+    Cents& operator-=(Cents other) { value_ -= other.value_; return *this; }
+
+    constexpr bool operator==(Cents other) const { return value_ == other.value_; }
+    constexpr bool operator!=(Cents other) const { return value_ != other.value_; }
+    constexpr bool operator<(Cents other) const { return value_ < other.value_; }
+    constexpr bool operator<=(Cents other) const { return value_ <= other.value_; }
+    constexpr bool operator>(Cents other) const { return value_ > other.value_; }
+    constexpr bool operator>=(Cents other) const { return value_ >= other.value_; }
+
+private:
+    int64_t value_;
+};
+
+/**
+ * Credits - A number of credits of some denomination
+ *
+ * Credits only become Cents through a denomination (see denomination::toCents).
+ */
+class Credits {
+public:
+    constexpr Credits() : count_(0) {}
+    constexpr explicit Credits(int64_t count) : count_(count) {}
+
+    constexpr int64_t count() const { return count_; }
+
+    constexpr Credits operator-() const { return Credits(-count_); }
+    constexpr Credits operator+(Credits other) const { return Credits(count_ + other.count_); }
+    constexpr Credits operator-(Credits other) const { return Credits(count_ - other.count_); }
+    constexpr Credits operator*(int64_t factor) const { return Credits(count_ * factor); }
+
+    Credits& operator+=(Credits other) { count_ += other.count_; return *this; }
+    Credits& operator-=(Credits other) { count_ -= other.count_; return *this; }
+
+    constexpr bool operator==(Credits other) const { return count_ == other.count_; }
+    constexpr bool operator!=(Credits other) const { return count_ != other.count_; }
+    constexpr bool operator<(Credits other) const { return count_ < other.count_; }
+    constexpr bool operator<=(Credits other) const { return count_ <= other.count_; }
+    constexpr bool operator>(Credits other) const { return count_ > other.count_; }
+    constexpr bool operator>=(Credits other) const { return count_ >= other.count_; }
+
+private:
+    int64_t count_;
+};
+
+/**
+ * Print as dollars with two decimals ("12.34"), exactly
+ */
+inline std::ostream& operator<<(std::ostream& out, Cents amount) {
+    int64_t cents = amount.value();
+    if (cents < 0) {
+        out << '-';
+        cents = -cents;
+    }
+    int64_t fraction = cents % 100;
+    return out << (cents / 100) << '.' << (fraction < 10 ? "0" : "") << fraction;
+}
+
+/**
+ * SAS denomination codes (SASConstants::DENOMINATIONS)
+ */
+namespace denomination {
+
+// Cents per credit, indexed by denomination code (0 = multi-denom, no value)
+constexpr int64_t CENTS[] = {
+    0, 1, 2, 5, 10, 25, 50, 100, 200, 500, 1000, 2000, 2500, 5000, 10000, 25000, 50000, 100000
+};
+constexpr int CODE_COUNT = sizeof(CENTS) / sizeof(CENTS[0]);
+
+/**
+ * Value of one credit; unknown codes count as a penny
+ */
+constexpr Cents valueOf(int code) {
+    return Cents((code >= 0 && code < CODE_COUNT) ? CENTS[code] : 1);
+}
+
+/**
+ * Code of a credit value, or -1 if no code has that value
+ */
+inline int codeOf(Cents value) {
+    for (int code = 0; code < CODE_COUNT; code++) {
+        if (CENTS[code] == value.value()) {
+            return code;
+        }
+    }
+    return -1;
+}
+
+constexpr Cents toCents(Credits credits, int code) {
+    return valueOf(code) * credits.count();
+}
+
+/**
+ * Whole credits an amount buys (the remainder is left out)
+ */
+constexpr Credits toCredits(Cents amount, int code) {
+    return Credits(valueOf(code).value() == 0 ? 0 : amount.value() / valueOf(code).value());
+}
+
+} // namespace denomination
+
+} // namespace simulator
+
+
+#endif // SIMULATOR_MONEY_H
@@ -0,0 +1,264 @@
+#ifndef SIMULATOR_NVRAMSTORE_H
+#define SIMULATOR_NVRAMSTORE_H
+
+#include "io/NvramDevice.h"
+#include "MeterStore.h"
+#include "GameMeters.h"
+#include <memory>
+#include <vector>
+#include <bitset>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace simulator {
+
+class Machine;
+
+/**
+ * NvramStore - Meters, game meter blocks, AFT transfer log and ticket records kept in NVRAM
+ *
+ * The store owns one region of an io::NvramDevice (battery-backed SRAM on
+ * the S7 Lite, a mapped file elsewhere) holding two banks:
+ *
+ *   Bank 0   BankHeader (64 bytes) + Image
+ *   Bank 1   BankHeader (64 bytes) + Image
+ *
+ * A commit writes the changed parts of the image into the bank that is
+ * not current, then that bank's header with the next sequence number and
+ * CRCs of the header and the image. The header goes out in a separate
+ * device write after the image, so a power loss mid-commit leaves either
+ * the old bank or the new one valid; open() takes the valid bank with the
+ * highest sequence.
+ *
+ * Changes are tracked per 64-byte line. The inactive bank is one commit
+ * behind, so a commit writes the lines changed since the last commit plus
+ * the ones the last commit wrote to the other bank, coalesced into
+ * contiguous ranges (the Zeus device sends four ranges per S7Lite call).
+ *
+ * Meter writes reach the store through the MeterStore and GameMeters write
+ * observers and are committed by a background thread; AFT transfers and tickets are
+ * committed before append returns, together with the meters they moved.
+ */
+class NvramStore {
+public:
+    static constexpr uint32_t MAGIC = 0x4D52564E;              // "NVRM"
+    static constexpr uint16_t LAYOUT_VERSION = 2;
+    static constexpr int METER_SLOTS = MeterStore::CAPACITY;
+    static constexpr int GAME_SLOTS = GameMeters::MAX_GAMES;
+    static constexpr int DENOM_SLOTS = GameMeters::DENOM_CODES;
+    static constexpr size_t AFT_LOG_ENTRIES = 32;
+    static constexpr size_t TICKET_LOG_ENTRIES = 32;
+    static constexpr size_t LINE_SIZE = 64;
+
+    /**
+     * Completed AFT transfer (64 bytes)
+     */
+    struct AftTransaction {
+        int64_t time;                   // Unix time
+        uint64_t cashableCents;
+        uint64_t restrictedCents;
+        uint64_t nonRestrictedCents;
+        uint8_t transferType;
+        uint8_t transferStatus;
+        uint8_t transactionIdLength;
+        uint8_t reserved[5];
+        uint8_t transactionId[24];
+    };
+
+    /**
+     * Issued ticket and its validation number (32 bytes)
+     */
+    struct TicketRecord {
+        uint8_t validationNumber[8];
+        uint64_t amountCents;
+        int64_t time;                   // Unix time
+        uint8_t ticketType;
+        uint8_t reserved[7];
+    };
+
+    /**
+     * Meters of one game number (64 bytes)
+     */
+    struct GameBlock {
+        uint32_t gameNumber;            // 0: slot unused
+        uint32_t reserved;
+        int64_t meters[GameMeters::FIELD_COUNT];    // In GameMeters::Field order
+        int64_t reserved2;
+    };
+
+    /**
+     * Bank header (64 bytes, written after the image)
+     */
+    struct BankHeader {
+        uint32_t magic;
+        uint16_t layoutVersion;
+        uint16_t headerSize;            // sizeof(BankHeader)
+        uint32_t imageSize;             // sizeof(Image)
+        uint16_t imageCrc;              // CRC16 of the image
+        uint16_t headerCrc;             // CRC16 of this header with headerCrc = 0
+        uint64_t sequence;              // Commit number, highest valid bank wins
+        int64_t committedAt;            // Unix time
+        uint8_t reserved[32];
+    };
+
+    /**
+     * Ring bookkeeping for a log section
+     */
+    struct LogHeader {
+        uint32_t next;                  // Slot the next record goes to
+        uint32_t count;                 // Valid records (up to the ring size)
+    };
+
+    /**
+     * Bank contents (every section 8-byte aligned)
+     */
+    struct Image {
+        uint8_t meterPresent[METER_SLOTS / 8];
+        int64_t meterValues[METER_SLOTS];
+        LogHeader aftHeader;
+        AftTransaction aft[AFT_LOG_ENTRIES];
+        LogHeader ticketHeader;
+        TicketRecord tickets[TICKET_LOG_ENTRIES];
+        GameBlock games[GAME_SLOTS];                                // Filled in first-write order
+        int64_t denomMeters[DENOM_SLOTS][GameMeters::FIELD_COUNT];  // By SAS denomination code
+    };
+
+    static constexpr size_t LINE_COUNT = (sizeof(Image) + LINE_SIZE - 1) / LINE_SIZE;
+    static constexpr size_t BANK_SIZE = (sizeof(BankHeader) + sizeof(Image) + LINE_SIZE - 1) / LINE_SIZE * LINE_SIZE;
+    static constexpr size_t REGION_SIZE = 2 * BANK_SIZE;
+
+    struct Statistics {
+        uint64_t commits = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t rangesWritten = 0;
+        uint64_t failures = 0;
+    };
+
+    /**
+     * Constructor
+     * @param device NVRAM device
+     * @param baseOffset Start of this store's REGION_SIZE bytes on the device
+     */
+    NvramStore(std::shared_ptr<io::NvramDevice> device, size_t baseOffset);
+
+    /**
+     * Destructor - stops the commit thread (final commit)
+     */
+    ~NvramStore();
+
+    NvramStore(const NvramStore&) = delete;
+    NvramStore& operator=(const NvramStore&) = delete;
+
+    /**
+     * Read both banks and load the newest valid one, or format the region
+     * @return false if the device is too small or cannot be read or written
+     */
+    bool open();
+
+    /**
+     * Check whether open() found a valid bank (false after formatting)
+     */
+    bool wasRecovered() const { return recovered_; }
+
+    uint64_t getSequence() const;
+
+    /**
+     * Write every meter held in NVRAM into the machine, game and
+     * denomination blocks included
+     * @return Number of machine meters restored
+     */
+    size_t applyMetersTo(Machine* machine) const;
+
+    /**
+     * Copy the machine's meters and game blocks in, then follow its meter
+     * writes and commit them every intervalMs
+     * @return true if the commit thread was started
+     */
+    bool start(Machine* machine, int intervalMs);
+
+    /**
+     * Stop following meter writes, commit what is left, stop the thread
+     */
+    void stop();
+
+    /**
+     * Record one meter value (called by the MeterStore write observer)
+     */
+    void setMeter(int meterCode, int64_t value);
+
+    /**
+     * Record one game meter value (called by the GameMeters write observer)
+     * Ignored once every game slot holds another game.
+     */
+    void setGameMeter(int gameNumber, int meterCode, int64_t value);
+
+    /**
+     * Record one denomination meter value (called by the GameMeters write observer)
+     */
+    void setDenomMeter(int denomCode, int meterCode, int64_t value);
+
+    /**
+     * Log a completed AFT transfer and commit it before returning
+     * @return true if the record (and every change before it) is in NVRAM
+     */
+    bool appendAftTransaction(const AftTransaction& record);
+
+    /**
+     * Log an issued ticket and commit it before returning
+     * @return true if the record (and every change before it) is in NVRAM
+     */
+    bool appendTicket(const TicketRecord& record);
+
+    /**
+     * Get the logged AFT transfers, oldest first
+     */
+    std::vector<AftTransaction> getAftTransactions() const;
+
+    /**
+     * Get the logged tickets, oldest first
+     */
+    std::vector<TicketRecord> getTickets() const;
+
+    /**
+     * Write everything changed since the last commit to the inactive bank
+     * and make it current
+     * @return false on device error (the changes stay pending)
+     */
+    bool commit();
+
+    Statistics getStatistics() const;
+
+private:
+    void markDirty(size_t offset, size_t length);       // mutex_ held
+    bool readBank(int bank, Image& image, uint64_t& sequence);
+    void commitThread();
+
+    std::shared_ptr<io::NvramDevice> device_;
+    size_t baseOffset_;
+    bool recovered_;
+    Machine* machine_;
+    int intervalMs_;
+
+    Image image_;                       // mutex_
+    std::bitset<LINE_COUNT> dirty_;     // mutex_: lines changed since the last commit
+    mutable std::mutex mutex_;          // Image (taken inside MeterStore's write lock)
+
+    Image staged_;                      // ioMutex_: image being committed
+    std::bitset<LINE_COUNT> behind_;    // ioMutex_: lines the inactive bank lacks
+    int currentBank_;                   // ioMutex_
+    uint64_t sequence_;                 // ioMutex_
+    Statistics stats_;                  // ioMutex_
+    mutable std::mutex ioMutex_;        // Device writes
+
+    std::condition_variable condition_;
+    std::thread committer_;
+    std::atomic<bool> running_;
+};
+
+} // namespace simulator
+
+#endif // SIMULATOR_NVRAMSTORE_H
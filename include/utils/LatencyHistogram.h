@@ -0,0 +1,157 @@
+#ifndef UTILS_LATENCYHISTOGRAM_H
+#define UTILS_LATENCYHISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace utils {
+
+/**
+ * LatencyHistogram - Lock-free log-linear histogram of durations in microseconds
+ *
+ * HDR-style layout: durations below SUB_BUCKETS us get a bucket each, every
+ * power of two above is split into SUB_BUCKETS equal buckets, so a bucket's
+ * width is at most 1/SUB_BUCKETS (12.5%) of its values. The last bucket
+ * holds everything from 2^(OCTAVES + SUB_BITS) us up (about 33 s).
+ * record() is a handful of relaxed atomic adds, so any thread can record
+ * on a hot path while another takes snapshots. A snapshot taken while
+ * records are in flight may be off by those records, never torn.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int OCTAVES = 22;
+    static constexpr int BUCKETS = SUB_BUCKETS + OCTAVES * SUB_BUCKETS;
+
+    struct Snapshot {
+        uint64_t counts[BUCKETS];
+        uint64_t count;
+        uint64_t sumMicros;
+        uint64_t maxMicros;
+
+        Snapshot() : count(0), sumMicros(0), maxMicros(0) {
+            for (int i = 0; i < BUCKETS; i++) {
+                counts[i] = 0;
+            }
+        }
+
+        /**
+         * Upper bound of the bucket holding a quantile (0.0-1.0), capped at
+         * the largest value recorded
+         */
+        uint64_t percentile(double quantile) const {
+            if (count == 0) {
+                return 0;
+            }
+            uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+            uint64_t seen = 0;
+            for (int i = 0; i < BUCKETS; i++) {
+                seen += counts[i];
+                if (seen >= rank) {
+                    uint64_t bound = upperBound(i);
+                    return bound < maxMicros ? bound : maxMicros;
+                }
+            }
+            return maxMicros;
+        }
+
+        uint64_t meanMicros() const {
+            return count ? sumMicros / count : 0;
+        }
+
+        Snapshot& operator+=(const Snapshot& other) {
+            for (int i = 0; i < BUCKETS; i++) {
+                counts[i] += other.counts[i];
+            }
+            count += other.count;
+            sumMicros += other.sumMicros;
+            maxMicros = maxMicros > other.maxMicros ? maxMicros : other.maxMicros;
+            return *this;
+        }
+    };
+
+    LatencyHistogram() {
+        reset();
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * Bucket a duration falls in
+     */
+    static int bucketOf(uint64_t micros) {
+        if (micros < static_cast<uint64_t>(SUB_BUCKETS)) {
+            return static_cast<int>(micros);
+        }
+        int octave = 63 - __builtin_clzll(micros) - SUB_BITS;
+        if (octave >= OCTAVES) {
+            return BUCKETS - 1;
+        }
+        int sub = static_cast<int>((micros >> octave) & (SUB_BUCKETS - 1));
+        return SUB_BUCKETS + octave * SUB_BUCKETS + sub;
+    }
+
+    /**
+     * Exclusive upper bound of a bucket in microseconds (the last bucket is
+     * open-ended and reports UINT64_MAX)
+     */
+    static uint64_t upperBound(int bucket) {
+        if (bucket >= BUCKETS - 1) {
+            return UINT64_MAX;
+        }
+        if (bucket < SUB_BUCKETS) {
+            return static_cast<uint64_t>(bucket) + 1;
+        }
+        int octave = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+        int sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+        return static_cast<uint64_t>(SUB_BUCKETS + sub + 1) << octave;
+    }
+
+    void record(uint64_t micros) {
+        counts_[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(micros, std::memory_order_relaxed);
+        uint64_t max = max_.load(std::memory_order_relaxed);
+        while (micros > max && !max_.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+        }
+    }
+
+    Snapshot snapshot() const {
+        Snapshot snap;
+        for (int i = 0; i < BUCKETS; i++) {
+            snap.counts[i] = counts_[i].load(std::memory_order_relaxed);
+            snap.count += snap.counts[i];
+        }
+        snap.sumMicros = sum_.load(std::memory_order_relaxed);
+        snap.maxMicros = max_.load(std::memory_order_relaxed);
+        return snap;
+    }
+
+    uint64_t count() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (int i = 0; i < BUCKETS; i++) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> counts_[BUCKETS];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace utils
+
+
+#endif // UTILS_LATENCYHISTOGRAM_H
@@ -1,62 +1,138 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
-#include <iostream>
+#include <string>
 #include <sstream>
+#include <ostream>
+#include <streambuf>
 #include <chrono>
-#include <iomanip>
 #include <vector>
+#include <atomic>
 #include <cstdint>
+#include <cstddef>
+
+/**
+ * Build-time log threshold. LOG() statements below this level are removed
+ * by the compiler (their arguments are never compiled into a call).
+ * 0=TRACE 1=DEBUG 2=INFO 3=WARN 4=ERROR
+ */
+#ifndef EGM_LOG_MIN_LEVEL
+#define EGM_LOG_MIN_LEVEL 1
+#endif
+
+/**
+ * LOG(category, level, stream-expression)
+ *
+ * Example: LOG(SAS, DEBUG, "cmd=0x" << std::hex << (int)cmd);
+ *
+ * The stream expression is only evaluated when the level passes both the
+ * build-time threshold and the category's runtime level. It is formatted
+ * into a fixed stack buffer (utils::LogStream), so logging allocates nothing.
+ */
+#define LOG(category, level, ...)                                                           \
+    do {                                                                                    \
+        if (utils::LogLevel::level >= EGM_LOG_MIN_LEVEL &&                                  \
+            utils::Logger::isEnabled(utils::LogCategory::category, utils::LogLevel::level)) { \
+            utils::LogStream logStream_;                                                    \
+            logStream_ << __VA_ARGS__;                                                      \
+            utils::Logger::log(logStream_);                                                 \
+        }                                                                                   \
+    } while (0)
+
+/**
+ * LOG_HEX(category, level, prefix, data, length)
+ *
+ * Hex dump variant of LOG(); bytes are formatted on the drain thread.
+ */
+#define LOG_HEX(category, level, prefix, data, length)                                      \
+    do {                                                                                    \
+        if (utils::LogLevel::level >= EGM_LOG_MIN_LEVEL &&                                  \
+            utils::Logger::isEnabled(utils::LogCategory::category, utils::LogLevel::level)) { \
+            utils::Logger::logHex((prefix), (data), (length));                              \
+        }                                                                                   \
+    } while (0)
+
+/**
+ * LOG_ENABLED(category, level) - guard for log output that needs extra work
+ * (loops, lookups) before the LOG() call itself
+ */
+#define LOG_ENABLED(category, level)                                                        \
+    (utils::LogLevel::level >= EGM_LOG_MIN_LEVEL &&                                         \
+     utils::Logger::isEnabled(utils::LogCategory::category, utils::LogLevel::level))
 
 namespace utils {
 
+class LogStream;
+
+/**
+ * Log levels
+ */
+namespace LogLevel {
+    constexpr int TRACE = 0;    // Per-byte / per-poll wire detail
+    constexpr int DEBUG = 1;    // Per-command decode detail
+    constexpr int INFO = 2;     // Normal operation
+    constexpr int WARN = 3;     // Recoverable problems
+    constexpr int ERROR = 4;    // Failures
+    constexpr int OFF = 5;      // Category disabled
+}
+
+/**
+ * Log categories (one per subsystem), each with its own runtime level
+ */
+enum class LogCategory : uint8_t {
+    SAS = 0,        // SASCommPort, Message serialization, general command handlers
+    UART,           // SASSerialPort framing and S7Lite I/O
+    METERS,         // Meter commands and meter persistence
+    AFT,            // AFT commands
+    CONFIG,         // Configuration commands and egm-config.json
+    COUNT
+};
+
 /**
  * Logger utility for consistent timestamped logging across the application
+ *
+ * Logging is asynchronous: callers format the message on the stack and copy
+ * it into a fixed-size binary record in a bounded lock-free ring
+ * (multi-producer, single consumer), then return immediately. A background thread formats timestamps/hex dumps and
+ * writes to stdout in batches, so the SAS response path never waits on the
+ * console.
+ *
+ * If the ring is full the message is dropped and counted (never blocks).
+ * The drain thread reports drops inline in the log output.
  */
 class Logger {
 public:
+    static constexpr size_t RING_CAPACITY = 512;       // Records (power of 2)
+    static constexpr size_t RECORD_PAYLOAD_SIZE = 496; // Bytes per record (text or prefix + raw hex)
+
     /**
      * Get timestamp string in milliseconds since epoch
      */
     static std::string getTimestamp() {
-        auto now = std::chrono::steady_clock::now();
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now.time_since_epoch()).count();
-        return "[" + std::to_string(ms) + "] ";
+        return "[" + std::to_string(nowMs()) + "] ";
     }
 
     /**
      * Log a message with timestamp
      */
-    static void log(const std::string& message) {
-        std::cout << getTimestamp() << message << std::endl;
-        std::cout << std::flush;
-    }
+    static void log(const std::string& message);
 
     /**
-     * Log without timestamp or newline (for building multi-part messages)
+     * Log a message formatted by LOG() (no heap allocation)
      */
-    static void logPart(const std::string& message) {
-        std::cout << message << std::endl;
-        std::cout << std::flush;
-    }
+    static void log(const LogStream& stream);
+
+    /**
+     * Log without timestamp (for building multi-part messages)
+     */
+    static void logPart(const std::string& message);
 
     /**
      * Log hex data with timestamp
+     * Raw bytes are queued; hex formatting happens on the drain thread.
      */
-    static void logHex(const std::string& prefix, const uint8_t* data, size_t length, size_t bytesPerLine = 16) {
-        std::string ts = getTimestamp();
-        std::cout << ts << prefix;
-
-        for (size_t i = 0; i < length; i++) {
-            printf("%02X ", data[i]);
-            if ((i + 1) % bytesPerLine == 0 && (i + 1) < length) {
-                std::cout << std::endl << ts << std::string(prefix.length(), ' ');
-            }
-        }
-        std::cout << std::endl;
-        std::cout << std::flush;
-    }
+    static void logHex(const std::string& prefix, const uint8_t* data, size_t length, size_t bytesPerLine = 16);
+    static void logHex(const char* prefix, const uint8_t* data, size_t length, size_t bytesPerLine = 16);
 
     /**
      * Log hex data from vector with timestamp
@@ -66,6 +142,103 @@ public:
             logHex(prefix, data.data(), data.size(), bytesPerLine);
         }
     }
+
+    /**
+     * Block until every record queued so far has been written to stdout
+     */
+    static void flush();
+
+    /**
+     * Drain the ring and stop the background thread.
+     * Later log calls are written synchronously. Call once at shutdown.
+     */
+    static void shutdown();
+
+    /**
+     * Get number of messages dropped because the ring was full
+     */
+    static uint64_t getDroppedCount();
+
+    /**
+     * Check whether a category logs at the given level (runtime check only)
+     */
+    static bool isEnabled(LogCategory category, int level) {
+        return level >= categoryLevels_[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the runtime level of a category
+     */
+    static void setCategoryLevel(LogCategory category, int level);
+
+    /**
+     * Set the runtime level of a category by name (e.g. "SAS", "debug")
+     * @return true if both the category and level names are valid
+     */
+    static bool setCategoryLevel(const std::string& categoryName, const std::string& levelName);
+
+    /**
+     * Get the runtime level of a category
+     */
+    static int getCategoryLevel(LogCategory category);
+
+    /**
+     * Get category name ("SAS", "UART", ...)
+     */
+    static const char* getCategoryName(LogCategory category);
+
+    /**
+     * Get level name ("TRACE" ... "OFF")
+     */
+    static const char* getLevelName(int level);
+
+private:
+    static std::atomic<int> categoryLevels_[static_cast<size_t>(LogCategory::COUNT)];
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * LogBuffer - streambuf over a record-sized array
+ *
+ * Text past RECORD_PAYLOAD_SIZE is dropped and the record is marked
+ * truncated, as for any over-long message.
+ */
+class LogBuffer : public std::streambuf {
+public:
+    LogBuffer() : truncated_(false) {
+        setp(text_, text_ + sizeof(text_));
+    }
+
+    const char* data() const { return text_; }
+    size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+    bool truncated() const { return truncated_; }
+
+protected:
+    int_type overflow(int_type) override {
+        truncated_ = true;
+        return traits_type::eof();
+    }
+
+private:
+    char text_[Logger::RECORD_PAYLOAD_SIZE];
+    bool truncated_;
+};
+
+/**
+ * LogStream - std::ostream formatting one LOG() message on the stack
+ * (the buffer is a base so it is built before the stream uses it)
+ */
+class LogStream : private LogBuffer, public std::ostream {
+public:
+    LogStream() : LogBuffer(), std::ostream(static_cast<LogBuffer*>(this)) {}
+
+    using LogBuffer::data;
+    using LogBuffer::size;
+    using LogBuffer::truncated;
 };
 
 } // namespace utils
@@ -0,0 +1,168 @@
+#ifndef UTILS_TRACE_H
+#define UTILS_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+
+/**
+ * Build-time switch for tracing spans. 0 compiles every TRACE_SPAN() and
+ * TRACE_INSTANT() out; TraceSpan objects used directly become empty.
+ */
+#ifndef EGM_TRACE
+#define EGM_TRACE 1
+#endif
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/**
+ * TRACE_SPAN(name) / TRACE_SPAN_ARG(name, arg)
+ *
+ * Record the rest of the enclosing scope as a span. name must be a string
+ * literal (only the pointer is stored). arg is shown as hex (e.g. the
+ * command code).
+ *
+ * Example: TRACE_SPAN_ARG("sas.handler", msg.command);
+ */
+#if EGM_TRACE
+#define TRACE_SPAN(name) utils::TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#define TRACE_SPAN_ARG(name, arg) utils::TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name, (arg))
+#define TRACE_INSTANT(name, arg)                                                            \
+    do {                                                                                    \
+        if (utils::Trace::isEnabled()) {                                                    \
+            utils::Trace::instant((name), (arg));                                           \
+        }                                                                                   \
+    } while (0)
+#else
+#define TRACE_SPAN(name) do {} while (0)
+#define TRACE_SPAN_ARG(name, arg) do {} while (0)
+#define TRACE_INSTANT(name, arg) do {} while (0)
+#endif
+
+namespace utils {
+
+/**
+ * Trace - Per-thread ring buffers of timed spans, exported as Chrome trace JSON
+ *
+ * Each thread that records while tracing is enabled gets its own ring of
+ * CAPACITY events, so recording takes no lock and shares no cache line:
+ * two steady_clock reads and a few relaxed stores. A ring keeps the last
+ * CAPACITY events; older ones are overwritten. A thread's ring is kept
+ * after the thread exits (so its events can still be dumped) and handed
+ * to the next new thread.
+ *
+ * While tracing is disabled a span costs one relaxed load and a branch
+ * that is never taken (the destructor only tests the span's own field).
+ *
+ * writeChromeTrace() copies every ring without stopping the writers and
+ * drops events that were overwritten during the copy. The output loads in
+ * chrome://tracing or Perfetto.
+ */
+class Trace {
+public:
+    static constexpr size_t CAPACITY = 8192;        // Events per thread (power of 2)
+    static constexpr uint32_t NO_ARG = 0xFFFFFFFF;
+
+    static bool isEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled);
+
+    /**
+     * Forget the events recorded so far
+     */
+    static void clear();
+
+    /**
+     * Name the calling thread in the trace (string literal)
+     */
+    static void setThreadName(const char* name);
+
+    /**
+     * Monotonic timestamp in nanoseconds (never 0)
+     */
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()) | 1;
+    }
+
+    /**
+     * Record a finished span on the calling thread's ring
+     */
+    static void record(const char* name, uint64_t beginNs, uint64_t endNs, uint32_t arg);
+
+    /**
+     * Record a point in time on the calling thread's ring
+     */
+    static void instant(const char* name, uint32_t arg);
+
+    /**
+     * Write every thread's events as Chrome trace_event JSON
+     * ({"traceEvents":[...]}, complete "X" and instant "i" events)
+     */
+    static void writeChromeTrace(std::ostream& out);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+#if EGM_TRACE
+
+/**
+ * TraceSpan - Records its lifetime as a span when tracing was enabled at
+ * construction
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, uint32_t arg = Trace::NO_ARG)
+        : name_(name),
+          arg_(arg),
+          begin_(Trace::isEnabled() ? Trace::now() : 0) {
+    }
+
+    ~TraceSpan() {
+        if (begin_ != 0) {
+            Trace::record(name_, begin_, Trace::now(), arg_);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * Set the argument shown with the span (e.g. once the command is known)
+     */
+    void setArg(uint32_t arg) { arg_ = arg; }
+
+    /**
+     * Do not record this span (nothing happened worth showing)
+     */
+    void cancel() { begin_ = 0; }
+
+private:
+    const char* name_;
+    uint32_t arg_;
+    uint64_t begin_;
+};
+
+#else
+
+class TraceSpan {
+public:
+    explicit TraceSpan(const char*, uint32_t = Trace::NO_ARG) {}
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    void setArg(uint32_t) {}
+    void cancel() {}
+};
+
+#endif
+
+} // namespace utils
+
+
+#endif // UTILS_TRACE_H
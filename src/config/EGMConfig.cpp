@@ -28,11 +28,11 @@ bool EGMConfig::load(const std::string& configPath) {
         pathToTry = configPath;
     }
 
-    utils::Logger::log("[Config] Attempting to load: " + pathToTry);
+    LOG(CONFIG, DEBUG, "[Config] Attempting to load: " << pathToTry);
 
     FILE* fp = fopen(pathToTry.c_str(), "rb");
     if (!fp) {
-        utils::Logger::log("[Config] ERROR: Could not open config file: " + pathToTry);
+        LOG(CONFIG, ERROR, "[Config] ERROR: Could not open config file: " << pathToTry);
         return false;
     }
 
@@ -45,22 +45,39 @@ bool EGMConfig::load(const std::string& configPath) {
     fclose(fp);
 
     if (document_.HasParseError()) {
-        utils::Logger::log("[Config] ERROR: JSON parse error at offset " +
-                          std::to_string(document_.GetErrorOffset()) +
-                          ": " + std::to_string(document_.GetParseError()));
+        LOG(CONFIG, ERROR, "[Config] ERROR: JSON parse error at offset "
+            << document_.GetErrorOffset()
+            << ": " << document_.GetParseError());
         return false;
     }
 
     if (!document_.IsObject()) {
-        utils::Logger::log("[Config] ERROR: Root element is not an object");
+        LOG(CONFIG, ERROR, "[Config] ERROR: Root element is not an object");
         return false;
     }
 
     loaded_ = true;
-    utils::Logger::log("[Config] Successfully loaded configuration from: " + pathToTry);
+    LOG(CONFIG, INFO, "[Config] Successfully loaded configuration from: " << pathToTry);
+
+    applyLoggingConfig();
     return true;
 }
 
+void EGMConfig::applyLoggingConfig() {
+    // "logging": { "SAS": "INFO", "UART": "WARN", ... }
+    const rapidjson::Value* logging = getObject("logging");
+    if (!logging || !logging->IsObject()) {
+        return;
+    }
+
+    for (auto it = logging->MemberBegin(); it != logging->MemberEnd(); ++it) {
+        if (!it->value.IsString() ||
+            !utils::Logger::setCategoryLevel(it->name.GetString(), it->value.GetString())) {
+            LOG(CONFIG, WARN, "[Config] WARNING: Ignoring invalid logging entry: " << it->name.GetString());
+        }
+    }
+}
+
 const rapidjson::Document* EGMConfig::getDocument() {
     return loaded_ ? &document_ : nullptr;
 }
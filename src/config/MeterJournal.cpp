@@ -0,0 +1,371 @@
+#include "config/MeterJournal.h"
+#include "config/MeterPersistence.h"
+#include "sas/CRC16.h"
+#include "utils/Logger.h"
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace config {
+
+constexpr size_t MeterJournal::RECORD_SIZE;
+constexpr uint16_t MeterJournal::RECORD_MAGIC;
+constexpr uint16_t MeterJournal::DENOM_BLOCK_FLAG;
+
+static void putLE(uint8_t* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint64_t getLE(const uint8_t* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+MeterJournal::MeterJournal(simulator::Machine* machine, uint8_t address, const std::string& path,
+                           int syncIntervalMs, size_t compactBytes)
+    : machine_(machine),
+      address_(address),
+      path_(path),
+      syncIntervalMs_(syncIntervalMs > 0 ? syncIntervalMs : 1),
+      compactBytes_(compactBytes),
+      fd_(-1),
+      fileSize_(0),
+      nextSequence_(1),
+      running_(false) {
+}
+
+MeterJournal::~MeterJournal() {
+    stop();
+}
+
+void MeterJournal::addMeter(int meterCode) {
+    if (!running_ && simulator::MeterStore::isValidCode(meterCode)) {
+        journaled_.set(meterCode);
+    }
+}
+
+bool MeterJournal::isValidMeter(uint16_t block, int meterCode) {
+    if (block == 0) {
+        return simulator::MeterStore::isValidCode(meterCode);
+    }
+    if (simulator::GameMeters::fieldOf(meterCode) < 0) {
+        return false;
+    }
+    if (block & DENOM_BLOCK_FLAG) {
+        return (block & ~DENOM_BLOCK_FLAG) < simulator::GameMeters::DENOM_CODES;
+    }
+    return block <= simulator::GameMeters::MAX_GAME_NUMBER;
+}
+
+void MeterJournal::encodeRecord(const Entry& entry, uint8_t* record) {
+    putLE(record + 0, RECORD_MAGIC, 2);
+    putLE(record + 2, entry.meterCode, 2);
+    putLE(record + 4, entry.sequence, 8);
+    putLE(record + 12, static_cast<uint64_t>(entry.value), 8);
+    putLE(record + 20, entry.block, 2);
+    putLE(record + 22, sas::CRC16::calculate(record, RECORD_SIZE - 2), 2);
+}
+
+long MeterJournal::replay(const std::string& path, simulator::Machine* machine,
+                          uint64_t snapshotSequence, uint64_t& lastSequence, off_t& validLength) {
+    lastSequence = snapshotSequence;
+    validLength = 0;
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+
+    // Last value per meter; only those are written to the machine
+    std::vector<int64_t> values(simulator::MeterStore::CAPACITY, 0);
+    std::bitset<simulator::MeterStore::CAPACITY> seen;
+    std::map<std::pair<uint16_t, int>, int64_t> blockValues;   // (block, meter code)
+    long applied = 0;
+    uint64_t previous = 0;
+    bool torn = false;
+
+    std::vector<uint8_t> buffer(RECORD_SIZE * 4096);
+    size_t buffered = 0;
+    for (;;) {
+        ssize_t got = read(fd, buffer.data() + buffered, buffer.size() - buffered);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            torn = buffered > 0 || got < 0;
+            break;
+        }
+        buffered += static_cast<size_t>(got);
+
+        size_t offset = 0;
+        for (; offset + RECORD_SIZE <= buffered; offset += RECORD_SIZE) {
+            const uint8_t* record = buffer.data() + offset;
+            uint64_t sequence = getLE(record + 4, 8);
+            int meterCode = static_cast<int>(getLE(record + 2, 2));
+            uint16_t block = static_cast<uint16_t>(getLE(record + 20, 2));
+            if (getLE(record, 2) != RECORD_MAGIC
+                || getLE(record + 22, 2) != sas::CRC16::calculate(record, RECORD_SIZE - 2)
+                || sequence <= previous
+                || !isValidMeter(block, meterCode)) {
+                torn = true;
+                break;
+            }
+
+            previous = sequence;
+            validLength += RECORD_SIZE;
+            if (sequence > snapshotSequence) {
+                int64_t value = static_cast<int64_t>(getLE(record + 12, 8));
+                if (block == 0) {
+                    values[meterCode] = value;
+                    seen.set(meterCode);
+                } else {
+                    blockValues[std::make_pair(block, meterCode)] = value;
+                }
+                lastSequence = sequence;
+                applied++;
+            }
+        }
+        if (torn) {
+            break;
+        }
+
+        buffered -= offset;
+        memmove(buffer.data(), buffer.data() + offset, buffered);
+    }
+    close(fd);
+
+    if (torn) {
+        LOG(METERS, WARN, "[Meters] Journal " << path << " ends in a torn or corrupt record at byte "
+            << validLength << "; ignoring the rest");
+    }
+
+    if (machine && seen.any()) {
+        std::vector<int> codes;
+        std::vector<int64_t> latest;
+        for (int code = 0; code < simulator::MeterStore::CAPACITY; code++) {
+            if (seen.test(code)) {
+                codes.push_back(code);
+                latest.push_back(values[code]);
+            }
+        }
+        machine->setMeters(codes.data(), codes.size(), latest.data());
+    }
+    if (machine) {
+        for (const auto& entry : blockValues) {
+            uint16_t block = entry.first.first;
+            if (block & DENOM_BLOCK_FLAG) {
+                machine->setDenomMeter(block & ~DENOM_BLOCK_FLAG, entry.first.second, entry.second);
+            } else {
+                machine->setGameMeter(block, entry.first.second, entry.second);
+            }
+        }
+    }
+    return applied;
+}
+
+bool MeterJournal::start(uint64_t snapshotSequence) {
+    if (running_) {
+        return true;
+    }
+
+    // Cut off a torn tail so new records follow the last valid one
+    uint64_t lastSequence = 0;
+    off_t validLength = 0;
+    if (replay(path_, nullptr, snapshotSequence, lastSequence, validLength) < 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not read meter journal: " << path_);
+        return false;
+    }
+
+    fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not open meter journal: " << path_
+            << " (" << strerror(errno) << ")");
+        return false;
+    }
+    if (ftruncate(fd_, validLength) != 0) {
+        LOG(METERS, WARN, "[Meters] Could not truncate meter journal: " << strerror(errno));
+    }
+    fileSize_ = validLength;
+    nextSequence_ = lastSequence + 1;
+
+    running_ = true;
+    writer_ = std::thread(&MeterJournal::writerThread, this);
+    machine_->setMeterWriteObserver([this](int meterCode, int64_t value) {
+        record(meterCode, value);
+    });
+    machine_->setGameMeterWriteObserver(
+        [this](simulator::GameMeters::BlockKind kind, int number, int meterCode, int64_t value) {
+            recordGame(kind, number, meterCode, value);
+        });
+
+    LOG(METERS, INFO, "[Meters] Journaling meters to " << path_ << " (sync every "
+        << syncIntervalMs_ << " ms, next sequence " << nextSequence_ << ")");
+    return true;
+}
+
+void MeterJournal::stop() {
+    if (!running_) {
+        return;
+    }
+
+    machine_->setMeterWriteObserver(simulator::MeterStore::WriteObserver());
+    machine_->setGameMeterWriteObserver(simulator::GameMeters::WriteObserver());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        condition_.notify_all();
+    }
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+
+    sync();
+    close(fd_);
+    fd_ = -1;
+}
+
+void MeterJournal::record(int meterCode, int64_t value) {
+    if (!simulator::MeterStore::isValidCode(meterCode) || !journaled_.test(meterCode)) {
+        return;
+    }
+
+    enqueue(0, meterCode, value);
+}
+
+void MeterJournal::recordGame(simulator::GameMeters::BlockKind kind, int number, int meterCode, int64_t value) {
+    // Every game-level meter is persisted per game and per denomination
+    if (kind == simulator::GameMeters::GAME_BLOCK) {
+        if (number > 0 && number <= simulator::GameMeters::MAX_GAME_NUMBER) {
+            enqueue(static_cast<uint16_t>(number), meterCode, value);
+        }
+    } else if (number >= 0 && number < simulator::GameMeters::DENOM_CODES) {
+        enqueue(static_cast<uint16_t>(DENOM_BLOCK_FLAG | number), meterCode, value);
+    }
+}
+
+void MeterJournal::enqueue(uint16_t block, int meterCode, int64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry;
+    entry.sequence = nextSequence_++;
+    entry.value = value;
+    entry.meterCode = static_cast<uint16_t>(meterCode);
+    entry.block = block;
+    pending_.push_back(entry);
+}
+
+bool MeterJournal::writePending() {
+    std::vector<Entry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries.swap(pending_);
+    }
+    if (entries.empty()) {
+        return true;
+    }
+
+    writeBuffer_.resize(entries.size() * RECORD_SIZE);
+    for (size_t i = 0; i < entries.size(); i++) {
+        encodeRecord(entries[i], writeBuffer_.data() + i * RECORD_SIZE);
+    }
+
+    size_t written = 0;
+    while (written < writeBuffer_.size()) {
+        ssize_t n = write(fd_, writeBuffer_.data() + written, writeBuffer_.size() - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            LOG(METERS, ERROR, "[Meters] ERROR: Meter journal write failed: " << strerror(errno));
+            return requeue(entries);
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    // One sync for every change queued since the last commit
+    if (fdatasync(fd_) != 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Meter journal sync failed: " << strerror(errno));
+        return requeue(entries);
+    }
+    fileSize_ += static_cast<off_t>(written);
+    return true;
+}
+
+bool MeterJournal::requeue(std::vector<Entry>& entries) {
+    // Cut off whatever part of the batch reached the file, so a torn record
+    // cannot hide the retry from replay, and retry the batch on the next commit
+    if (ftruncate(fd_, fileSize_) != 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not truncate meter journal: " << strerror(errno));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.insert(pending_.begin(), entries.begin(), entries.end());
+    return false;
+}
+
+bool MeterJournal::sync() {
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    if (fd_ < 0) {
+        return false;
+    }
+    return writePending();
+}
+
+bool MeterJournal::compact() {
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    // Every queued record is already in the machine, so the snapshot taken
+    // below covers it; writes racing this get later sequences and are kept
+    uint64_t covered;
+    {
+        std::lock_guard<std::mutex> queueLock(mutex_);
+        covered = nextSequence_ - 1;
+        pending_.clear();
+    }
+
+    if (!MeterPersistence::writeSnapshot(machine_, address_, covered)) {
+        return false;
+    }
+
+    // A crash before this leaves records the snapshot already covers;
+    // replay skips them by sequence
+    if (ftruncate(fd_, 0) != 0 || fdatasync(fd_) != 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not truncate meter journal: " << strerror(errno));
+        return false;
+    }
+    fileSize_ = 0;
+
+    LOG(METERS, DEBUG, "[Meters] Compacted meter journal at sequence " << covered);
+    return true;
+}
+
+void MeterJournal::writerThread() {
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait_for(lock, std::chrono::milliseconds(syncIntervalMs_));
+        }
+
+        bool compactDue;
+        {
+            std::lock_guard<std::mutex> lock(ioMutex_);
+            writePending();
+            compactDue = compactBytes_ > 0 && static_cast<size_t>(fileSize_) >= compactBytes_;
+        }
+        if (compactDue) {
+            compact();
+        }
+    }
+}
+
+} // namespace config
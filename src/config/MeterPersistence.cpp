@@ -1,18 +1,177 @@
 #include "config/MeterPersistence.h"
+#include "config/MeterJournal.h"
+#include "config/MeterSnapshot.h"
 #include "config/RapidJsonHelper.h"
 #include "utils/Logger.h"
 #include "sas/SASConstants.h"
 #include <rapidjson/document.h>
 #include <rapidjson/filereadstream.h>
-#include <rapidjson/filewritestream.h>
+#include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
 #include <fstream>
 #include <cstdio>
+#include <cstring>
+#include <cerrno>
 #include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace config {
 
+/**
+ * Main meters persisted under "mainMeters", keyed by JSON name
+ */
+struct PersistedMeter {
+    const char* key;
+    int meterCode;
+};
+
+static const PersistedMeter MAIN_METERS[] = {
+    // Machine meters - Doors (use extended METER_* codes 0x100+)
+    { "coinDrop", sas::SASConstants::METER_COIN_DROP },
+    { "slotDoor", sas::SASConstants::METER_SLOT_DOOR },
+    { "dropDoor", sas::SASConstants::METER_DROP_DOOR },
+    { "logicDoor", sas::SASConstants::METER_LOGIC_DOOR },
+    { "cashDoor", sas::SASConstants::METER_CASH_DOOR },
+    { "auxFillDoor", sas::SASConstants::METER_AUX_FILL_DOOR },
+    { "actualSlotDoor", sas::SASConstants::METER_ACTUAL_SLOT_DOOR },
+    { "chassisDoor", sas::SASConstants::METER_CHASSIS_DOOR },
+
+    // Machine meters - Bill denoms (use SAS METER_* codes)
+    { "billsIn1", sas::SASConstants::METER_1_BILLS_ACCEPTED },
+    { "billsIn2", sas::SASConstants::METER_2_BILLS_ACCEPTED },
+    { "billsIn5", sas::SASConstants::METER_5_BILLS_ACCEPTED },
+    { "billsIn10", sas::SASConstants::METER_10_BILLS_ACCEPTED },
+    { "billsIn20", sas::SASConstants::METER_20_BILLS_ACCEPTED },
+    { "billsIn50", sas::SASConstants::METER_50_BILLS_ACCEPTED },
+    { "billsIn100", sas::SASConstants::METER_100_BILLS_ACCEPTED },
+    { "billsIn200", sas::SASConstants::METER_200_BILLS_ACCEPTED },
+    { "billsIn500", sas::SASConstants::METER_500_BILLS_ACCEPTED },
+    { "billsIn1000", sas::SASConstants::METER_1000_BILLS_ACCEPTED },
+
+    // Machine meters - Credits and coins (use SAS or extended METER_* codes)
+    { "credits", sas::SASConstants::METER_CURRENT_CRD },
+    { "trueCoinIn", sas::SASConstants::METER_TRUE_COIN_IN },
+    { "trueCoinOut", sas::SASConstants::METER_TRUE_COIN_OUT },
+    { "billDrop", sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR },
+    { "totalHandPay", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD },
+    { "actualCoinDrop", sas::SASConstants::METER_ACTUAL_COIN_DROP },
+    { "handPaidCancelledCredits", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD },
+    { "physicalCoinInValue", sas::SASConstants::METER_PHYS_COIN_IN_DOLLAR_VALUE },
+    { "physicalCoinOutValue", sas::SASConstants::METER_PHYS_COIN_OUT_DOLLAR_VALUE },
+    { "totalDrop", sas::SASConstants::METER_TOT_DROP },
+    { "voucherTicketDrop", sas::SASConstants::METER_VOUCHER_TICKET_DROP },
+    { "ncepCredits", sas::SASConstants::METER_NCEP_CREDITS },
+
+    // Machine meters - AFT (use SAS METER_* codes)
+    { "aftCashableToGame", sas::SASConstants::METER_AFT_CASHABLE_IN },
+    { "aftRestrictedToGame", sas::SASConstants::METER_AFT_REST_IN },
+    { "aftNonRestrictedToGame", sas::SASConstants::METER_AFT_IN },
+    { "aftCashableToHost", sas::SASConstants::METER_AFT_CASHABLE_OUT },
+    { "aftRestrictedToHost", sas::SASConstants::METER_AFT_REST_OUT },
+    { "aftNonRestrictedToHost", sas::SASConstants::METER_AFT_OUT },
+    { "aftDebitToGame", sas::SASConstants::METER_AFT_DEBIT_XFER_TO_GAME_VALUE },
+
+    // Machine meters - Bonus and Progressive (use SAS METER_* codes)
+    { "bonusMachinePayout", sas::SASConstants::METER_MACH_PAID_EXT_BONUS },
+    { "bonusAttendantPayout", sas::SASConstants::METER_ATT_PAID_EXT_BONUS },
+    { "progressiveAttendantPayout", sas::SASConstants::METER_ATT_PAID_PROG },
+    { "progressiveMachinePayout", sas::SASConstants::METER_MACH_PAID_PROG },
+
+    // Machine meters - Special (use SAS or extended METER_* codes)
+    { "restrictedPlayed", sas::SASConstants::METER_TOTAL_REST_PLAYED },
+    { "unrestrictedPlayed", sas::SASConstants::METER_TOTAL_NONREST_PLAYED },
+    { "gameWeightedTheoretical", sas::SASConstants::METER_WTPP },
+
+    // Game meters (base game - use SAS or extended METER_* codes)
+    { "coinIn", sas::SASConstants::METER_COIN_IN },
+    { "coinOut", sas::SASConstants::METER_COIN_OUT },
+    { "gamesPlayed", sas::SASConstants::METER_GAMES_PLAYED },
+    { "gamesWon", sas::SASConstants::METER_GAMES_WON },
+    { "maxCoinBet", sas::SASConstants::METER_MAX_COIN_BET },
+    { "cancelledCredits", sas::SASConstants::METER_CANCELLED_CRD },
+    { "bonusWon", sas::SASConstants::METER_BONUS_WON },
+    { "jackpot", sas::SASConstants::METER_JACKPOT },
+    { "progressiveCoinIn", sas::SASConstants::METER_PROGRESSIVE_COIN_IN }
+};
+
+static const size_t MAIN_METER_COUNT = sizeof(MAIN_METERS) / sizeof(MAIN_METERS[0]);
+
+/**
+ * Game-level meters persisted per game and per denomination (see GameMeters)
+ */
+static const PersistedMeter GAME_METERS[] = {
+    { "coinIn", sas::SASConstants::METER_COIN_IN },
+    { "coinOut", sas::SASConstants::METER_COIN_OUT },
+    { "jackpot", sas::SASConstants::METER_JACKPOT },
+    { "gamesPlayed", sas::SASConstants::METER_GAMES_PLAYED },
+    { "gamesWon", sas::SASConstants::METER_GAMES_WON },
+    { "gamesLost", sas::SASConstants::METER_GAMES_LOST }
+};
+
+static const size_t GAME_METER_COUNT = sizeof(GAME_METERS) / sizeof(GAME_METERS[0]);
+
+// Running journals by SAS address
+static std::map<uint8_t, std::shared_ptr<MeterJournal>> journals;
+static std::mutex journalsMutex;
+
+static std::shared_ptr<MeterJournal> findJournal(uint8_t address) {
+    std::lock_guard<std::mutex> lock(journalsMutex);
+    auto it = journals.find(address);
+    return it != journals.end() ? it->second : std::shared_ptr<MeterJournal>();
+}
+
+// Make a rename durable (fsync the containing directory)
+static void syncDirectoryOf(const std::string& path) {
+    size_t slash = path.rfind('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+// Replace a file so a power loss leaves either the old or the new contents:
+// write a temp file, sync it, rename it over the old one, sync the directory
+static bool writeFileAtomically(const std::string& path, const void* data, size_t size) {
+    std::string tempPath = path + ".tmp";
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not open meters file for writing: " << tempPath);
+        return false;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(fd, bytes + written, size - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    bool ok = written == size && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not write meters file: " << path
+            << " (" << strerror(errno) << ")");
+        unlink(tempPath.c_str());
+        return false;
+    }
+    syncDirectoryOf(path);
+    return true;
+}
+
 bool MeterPersistence::isSdbootAvailable() {
     struct stat info;
     if (stat("/sdboot", &info) != 0) {
@@ -21,11 +180,24 @@ bool MeterPersistence::isSdbootAvailable() {
     return (info.st_mode & S_IFDIR) != 0;  // Check if it's a directory
 }
 
-std::string MeterPersistence::getMetersPath() {
+std::string MeterPersistence::getMetersPath(uint8_t address) {
+    std::string fileName = (address == 1)
+        ? "meters.json"
+        : "meters-" + std::to_string(address) + ".json";
     if (isSdbootAvailable()) {
-        return "/sdboot/meters.json";
+        return "/sdboot/" + fileName;
     }
-    return "meters.json";
+    return fileName;
+}
+
+std::string MeterPersistence::getSnapshotPath(uint8_t address) {
+    std::string path = getMetersPath(address);
+    return path.substr(0, path.size() - 5) + ".bin";  // Strip ".json"
+}
+
+std::string MeterPersistence::getJournalPath(uint8_t address) {
+    std::string path = getMetersPath(address);
+    return path.substr(0, path.size() - 5) + ".journal";
 }
 
 std::string MeterPersistence::getCurrentTimestamp() {
@@ -35,20 +207,47 @@ std::string MeterPersistence::getCurrentTimestamp() {
     return std::string(buf);
 }
 
-bool MeterPersistence::loadMeters(simulator::Machine* machine) {
+bool MeterPersistence::loadMeters(simulator::Machine* machine, uint8_t address) {
     if (!machine) {
-        utils::Logger::log("[Meters] ERROR: Machine pointer is null");
+        LOG(METERS, ERROR, "[Meters] ERROR: Machine pointer is null");
         return false;
     }
 
-    std::string metersPath = getMetersPath();
-    utils::Logger::log("[Meters] Loading meters from: " + metersPath);
+    std::string snapshotPath = getSnapshotPath(address);
+    LOG(METERS, INFO, "[Meters] Loading meters from: " << snapshotPath);
+
+    bool loaded = false;
+    uint64_t journalSequence = 0;
+    MeterSnapshot snapshot;
+    if (snapshot.open(snapshotPath)) {
+        size_t count = snapshot.applyTo(machine);
+        journalSequence = snapshot.getJournalSequence();
+        loaded = true;
+        LOG(METERS, INFO, "[Meters] Loaded " << count << " meters (journal sequence " << journalSequence << ")");
+    } else if (importMeters(machine, address, &journalSequence)) {
+        // No usable binary snapshot (first run after upgrade, or damaged)
+        loaded = true;
+    } else {
+        LOG(METERS, INFO, "[Meters] No existing meters file found (this is normal for first boot)");
+    }
 
-    FILE* fp = fopen(metersPath.c_str(), "rb");
+    // Changes made after the snapshot
+    return replayJournal(machine, address, journalSequence) || loaded;
+}
+
+bool MeterPersistence::importMeters(simulator::Machine* machine, uint8_t address,
+                                    uint64_t* journalSequence) {
+    if (!machine) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Machine pointer is null");
+        return false;
+    }
+
+    std::string path = getMetersPath(address);
+    FILE* fp = fopen(path.c_str(), "rb");
     if (!fp) {
-        utils::Logger::log("[Meters] No existing meters file found (this is normal for first boot)");
         return false;
     }
+    LOG(METERS, INFO, "[Meters] Importing meters from: " << path);
 
     // Read and parse JSON
     char readBuffer[65536];
@@ -58,12 +257,12 @@ bool MeterPersistence::loadMeters(simulator::Machine* machine) {
     fclose(fp);
 
     if (doc.HasParseError()) {
-        utils::Logger::log("[Meters] ERROR: JSON parse error in meters file");
+        LOG(METERS, ERROR, "[Meters] ERROR: JSON parse error in meters file");
         return false;
     }
 
     if (!doc.IsObject()) {
-        utils::Logger::log("[Meters] ERROR: Meters file root is not an object");
+        LOG(METERS, ERROR, "[Meters] ERROR: Meters file root is not an object");
         return false;
     }
 
@@ -71,90 +270,26 @@ bool MeterPersistence::loadMeters(simulator::Machine* machine) {
     if (doc.HasMember("mainMeters") && doc["mainMeters"].IsObject()) {
         const rapidjson::Value& mainMeters = doc["mainMeters"];
 
-        // Load each meter using METER_* codes directly (no more persistence code mapping!)
-        auto loadMeter = [&](const char* key, int meterCode) {
+        // Load each meter using METER_* codes directly, all in one write
+        int meterCodes[MAIN_METER_COUNT];
+        int64_t meterValues[MAIN_METER_COUNT];
+        size_t count = 0;
+        for (size_t i = 0; i < MAIN_METER_COUNT; i++) {
+            const char* key = MAIN_METERS[i].key;
             if (mainMeters.HasMember(key) && mainMeters[key].IsInt64()) {
-                int64_t value = mainMeters[key].GetInt64();
-                machine->setMeter(meterCode, value);
-                utils::Logger::log("[Meters]   " + std::string(key) + ": " + std::to_string(value) +
-                                   " (METER_* code: 0x" + std::to_string(meterCode) + ")");
+                meterCodes[count] = MAIN_METERS[i].meterCode;
+                meterValues[count] = mainMeters[key].GetInt64();
+                count++;
             }
-        };
-
-        utils::Logger::log("[Meters] Loading main meters:");
-
-        // Machine meters - Doors (use extended METER_* codes 0x100+)
-        loadMeter("coinDrop", sas::SASConstants::METER_COIN_DROP);
-        loadMeter("slotDoor", sas::SASConstants::METER_SLOT_DOOR);
-        loadMeter("dropDoor", sas::SASConstants::METER_DROP_DOOR);
-        loadMeter("logicDoor", sas::SASConstants::METER_LOGIC_DOOR);
-        loadMeter("cashDoor", sas::SASConstants::METER_CASH_DOOR);
-        loadMeter("auxFillDoor", sas::SASConstants::METER_AUX_FILL_DOOR);
-        loadMeter("actualSlotDoor", sas::SASConstants::METER_ACTUAL_SLOT_DOOR);
-        loadMeter("chassisDoor", sas::SASConstants::METER_CHASSIS_DOOR);
-
-        // Machine meters - Bill denoms (use SAS METER_* codes)
-        loadMeter("billsIn1", sas::SASConstants::METER_1_BILLS_ACCEPTED);
-        loadMeter("billsIn2", sas::SASConstants::METER_2_BILLS_ACCEPTED);
-        loadMeter("billsIn5", sas::SASConstants::METER_5_BILLS_ACCEPTED);
-        loadMeter("billsIn10", sas::SASConstants::METER_10_BILLS_ACCEPTED);
-        loadMeter("billsIn20", sas::SASConstants::METER_20_BILLS_ACCEPTED);
-        loadMeter("billsIn50", sas::SASConstants::METER_50_BILLS_ACCEPTED);
-        loadMeter("billsIn100", sas::SASConstants::METER_100_BILLS_ACCEPTED);
-        loadMeter("billsIn200", sas::SASConstants::METER_200_BILLS_ACCEPTED);
-        loadMeter("billsIn500", sas::SASConstants::METER_500_BILLS_ACCEPTED);
-        loadMeter("billsIn1000", sas::SASConstants::METER_1000_BILLS_ACCEPTED);
-
-        // Machine meters - Credits and coins (use SAS or extended METER_* codes)
-        loadMeter("credits", sas::SASConstants::METER_CURRENT_CRD);
-        loadMeter("trueCoinIn", sas::SASConstants::METER_TRUE_COIN_IN);
-        loadMeter("trueCoinOut", sas::SASConstants::METER_TRUE_COIN_OUT);
-        loadMeter("billDrop", sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR);
-        loadMeter("totalHandPay", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD);
-        loadMeter("actualCoinDrop", sas::SASConstants::METER_ACTUAL_COIN_DROP);
-        loadMeter("handPaidCancelledCredits", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD);
-        loadMeter("physicalCoinInValue", sas::SASConstants::METER_PHYS_COIN_IN_DOLLAR_VALUE);
-        loadMeter("physicalCoinOutValue", sas::SASConstants::METER_PHYS_COIN_OUT_DOLLAR_VALUE);
-        loadMeter("totalDrop", sas::SASConstants::METER_TOT_DROP);
-        loadMeter("voucherTicketDrop", sas::SASConstants::METER_VOUCHER_TICKET_DROP);
-        loadMeter("ncepCredits", sas::SASConstants::METER_NCEP_CREDITS);
-
-        // Machine meters - AFT (use SAS METER_* codes)
-        loadMeter("aftCashableToGame", sas::SASConstants::METER_AFT_CASHABLE_IN);
-        loadMeter("aftRestrictedToGame", sas::SASConstants::METER_AFT_REST_IN);
-        loadMeter("aftNonRestrictedToGame", sas::SASConstants::METER_AFT_IN);
-        loadMeter("aftCashableToHost", sas::SASConstants::METER_AFT_CASHABLE_OUT);
-        loadMeter("aftRestrictedToHost", sas::SASConstants::METER_AFT_REST_OUT);
-        loadMeter("aftNonRestrictedToHost", sas::SASConstants::METER_AFT_OUT);
-        loadMeter("aftDebitToGame", sas::SASConstants::METER_AFT_DEBIT_XFER_TO_GAME_VALUE);
-
-        // Machine meters - Bonus and Progressive (use SAS METER_* codes)
-        loadMeter("bonusMachinePayout", sas::SASConstants::METER_MACH_PAID_EXT_BONUS);
-        loadMeter("bonusAttendantPayout", sas::SASConstants::METER_ATT_PAID_EXT_BONUS);
-        loadMeter("progressiveAttendantPayout", sas::SASConstants::METER_ATT_PAID_PROG);
-        loadMeter("progressiveMachinePayout", sas::SASConstants::METER_MACH_PAID_PROG);
-
-        // Machine meters - Special (use SAS or extended METER_* codes)
-        loadMeter("restrictedPlayed", sas::SASConstants::METER_TOTAL_REST_PLAYED);
-        loadMeter("unrestrictedPlayed", sas::SASConstants::METER_TOTAL_NONREST_PLAYED);
-        loadMeter("gameWeightedTheoretical", sas::SASConstants::METER_WTPP);
-
-        // Game meters (base game - use SAS or extended METER_* codes)
-        loadMeter("coinIn", sas::SASConstants::METER_COIN_IN);
-        loadMeter("coinOut", sas::SASConstants::METER_COIN_OUT);
-        loadMeter("gamesPlayed", sas::SASConstants::METER_GAMES_PLAYED);
-        loadMeter("gamesWon", sas::SASConstants::METER_GAMES_WON);
-        loadMeter("maxCoinBet", sas::SASConstants::METER_MAX_COIN_BET);
-        loadMeter("cancelledCredits", sas::SASConstants::METER_CANCELLED_CRD);
-        loadMeter("bonusWon", sas::SASConstants::METER_BONUS_WON);
-        loadMeter("jackpot", sas::SASConstants::METER_JACKPOT);
-        loadMeter("progressiveCoinIn", sas::SASConstants::METER_PROGRESSIVE_COIN_IN);
+        }
+        machine->setMeters(meterCodes, count, meterValues);
+        LOG(METERS, DEBUG, "[Meters] Loaded " << count << " main meters");
     }
 
     // Load game-specific meters
     if (doc.HasMember("games") && doc["games"].IsArray()) {
         const rapidjson::Value& gamesArray = doc["games"];
-        utils::Logger::log("[Meters] Loading game meters for " + std::to_string(gamesArray.Size()) + " games");
+        LOG(METERS, DEBUG, "[Meters] Loading game meters for " << gamesArray.Size() << " games");
 
         for (rapidjson::SizeType i = 0; i < gamesArray.Size(); i++) {
             const rapidjson::Value& gameData = gamesArray[i];
@@ -163,127 +298,211 @@ bool MeterPersistence::loadMeters(simulator::Machine* machine) {
             int gameNumber = RapidJsonHelper::GetInt(gameData, "gameNumber", -1);
             if (gameNumber < 0) continue;
 
-            utils::Logger::log("[Meters]   Game " + std::to_string(gameNumber) + ":");
+            LOG(METERS, DEBUG, "[Meters]   Game " << gameNumber << ":");
 
             // Get game meters if they exist
             if (gameData.HasMember("meters") && gameData["meters"].IsObject()) {
                 const rapidjson::Value& gameMeters = gameData["meters"];
+                for (size_t m = 0; m < GAME_METER_COUNT; m++) {
+                    const char* key = GAME_METERS[m].key;
+                    if (gameMeters.HasMember(key) && gameMeters[key].IsInt64()) {
+                        machine->setGameMeter(gameNumber, GAME_METERS[m].meterCode, gameMeters[key].GetInt64());
+                    }
+                }
+                LOG(METERS, DEBUG, "[Meters]     Found " << gameMeters.MemberCount() << " meters");
+            }
+        }
+    }
 
-                // Load game-specific meters
-                // TODO: Implement game-specific meter loading when Game class supports it
-                // For now, just log that we found them
-                utils::Logger::log("[Meters]     Found " + std::to_string(gameMeters.MemberCount()) + " meters");
+    // Load per-denomination meters
+    if (doc.HasMember("denominations") && doc["denominations"].IsArray()) {
+        const rapidjson::Value& denomArray = doc["denominations"];
+        for (rapidjson::SizeType i = 0; i < denomArray.Size(); i++) {
+            const rapidjson::Value& denomData = denomArray[i];
+            if (!denomData.IsObject() || !denomData.HasMember("meters") || !denomData["meters"].IsObject()) continue;
+
+            int denomCode = RapidJsonHelper::GetInt(denomData, "denomCode", -1);
+            if (denomCode < 0) continue;
+
+            const rapidjson::Value& denomMeters = denomData["meters"];
+            for (size_t m = 0; m < GAME_METER_COUNT; m++) {
+                const char* key = GAME_METERS[m].key;
+                if (denomMeters.HasMember(key) && denomMeters[key].IsInt64()) {
+                    machine->setDenomMeter(denomCode, GAME_METERS[m].meterCode, denomMeters[key].GetInt64());
+                }
             }
         }
     }
 
     // Log last saved timestamp
     if (doc.HasMember("lastSaved") && doc["lastSaved"].IsString()) {
-        utils::Logger::log("[Meters] Last saved: " + std::string(doc["lastSaved"].GetString()));
+        LOG(METERS, DEBUG, "[Meters] Last saved: " << std::string(doc["lastSaved"].GetString()));
     }
 
-    utils::Logger::log("[Meters] Meters loaded successfully");
+    if (journalSequence) {
+        *journalSequence = 0;
+        if (doc.HasMember("journalSequence") && doc["journalSequence"].IsUint64()) {
+            *journalSequence = doc["journalSequence"].GetUint64();
+        }
+    }
+
+    LOG(METERS, INFO, "[Meters] Meters imported successfully");
     return true;
 }
 
-bool MeterPersistence::saveMeters(simulator::Machine* machine) {
-    if (!machine) {
-        utils::Logger::log("[Meters] ERROR: Machine pointer is null");
+bool MeterPersistence::replayJournal(simulator::Machine* machine, uint8_t address, uint64_t journalSequence) {
+    std::string journalPath = getJournalPath(address);
+    uint64_t lastSequence = 0;
+    off_t validLength = 0;
+    long applied = MeterJournal::replay(journalPath, machine, journalSequence, lastSequence, validLength);
+    if (applied < 0) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Could not read meter journal: " << journalPath);
         return false;
     }
+    if (applied > 0) {
+        LOG(METERS, INFO, "[Meters] Replayed " << applied << " journaled meter changes (through sequence "
+            << lastSequence << ")");
+    }
+    return applied > 0;
+}
 
-    std::string metersPath = getMetersPath();
-    utils::Logger::log("[Meters] Saving meters to: " + metersPath);
+uint64_t MeterPersistence::readSnapshotSequence(uint8_t address) {
+    MeterSnapshot snapshot;
+    if (snapshot.open(getSnapshotPath(address))) {
+        return snapshot.getJournalSequence();
+    }
 
-    FILE* fp = fopen(metersPath.c_str(), "wb");
+    // Same fallback as loadMeters()
+    FILE* fp = fopen(getMetersPath(address).c_str(), "rb");
     if (!fp) {
-        utils::Logger::log("[Meters] ERROR: Could not open meters file for writing: " + metersPath);
+        return 0;
+    }
+
+    char readBuffer[65536];
+    rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    rapidjson::Document doc;
+    doc.ParseStream(is);
+    fclose(fp);
+
+    if (doc.HasParseError() || !doc.IsObject()
+        || !doc.HasMember("journalSequence") || !doc["journalSequence"].IsUint64()) {
+        return 0;
+    }
+    return doc["journalSequence"].GetUint64();
+}
+
+bool MeterPersistence::startJournal(simulator::Machine* machine, uint8_t address,
+                                    int syncIntervalMs, size_t compactBytes) {
+    if (!machine || findJournal(address)) {
         return false;
     }
 
-    // Create JSON document using RapidJSON Writer
-    char writeBuffer[65536];
-    rapidjson::FileWriteStream os(fp, writeBuffer, sizeof(writeBuffer));
-    rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
+    std::shared_ptr<MeterJournal> journal = std::make_shared<MeterJournal>(
+        machine, address, getJournalPath(address), syncIntervalMs, compactBytes);
+    // Everything meters.bin stores
+    for (int code = 0; code < MeterSnapshot::METER_SLOTS; code++) {
+        journal->addMeter(code);
+    }
+    if (!journal->start(readSnapshotSequence(address))) {
+        return false;
+    }
 
-    writer.StartObject();
+    std::lock_guard<std::mutex> lock(journalsMutex);
+    journals[address] = journal;
+    return true;
+}
 
-    // Write main machine meters
-    writer.Key("mainMeters");
-    writer.StartObject();
+void MeterPersistence::stopJournal(uint8_t address) {
+    std::shared_ptr<MeterJournal> journal;
+    {
+        std::lock_guard<std::mutex> lock(journalsMutex);
+        auto it = journals.find(address);
+        if (it == journals.end()) {
+            return;
+        }
+        journal = it->second;
+        journals.erase(it);
+    }
+    journal->stop();
+}
 
-    // Save meters using METER_* codes directly (no more persistence code mapping!)
-    auto writeMeter = [&](const char* key, int meterCode) {
-        writer.Key(key);
-        writer.Int64(machine->getMeter(meterCode));
-    };
+bool MeterPersistence::saveMeters(simulator::Machine* machine, uint8_t address) {
+    if (!machine) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Machine pointer is null");
+        return false;
+    }
 
-    // Machine meters - Doors (use extended METER_* codes 0x100+)
-    writeMeter("coinDrop", sas::SASConstants::METER_COIN_DROP);
-    writeMeter("slotDoor", sas::SASConstants::METER_SLOT_DOOR);
-    writeMeter("dropDoor", sas::SASConstants::METER_DROP_DOOR);
-    writeMeter("logicDoor", sas::SASConstants::METER_LOGIC_DOOR);
-    writeMeter("cashDoor", sas::SASConstants::METER_CASH_DOOR);
-    writeMeter("auxFillDoor", sas::SASConstants::METER_AUX_FILL_DOOR);
-    writeMeter("actualSlotDoor", sas::SASConstants::METER_ACTUAL_SLOT_DOOR);
-    writeMeter("chassisDoor", sas::SASConstants::METER_CHASSIS_DOOR);
+    LOG(METERS, INFO, "[Meters] Saving meters to: " << getSnapshotPath(address));
 
-    // Machine meters - Bill denoms (use SAS METER_* codes)
-    writeMeter("billsIn1", sas::SASConstants::METER_1_BILLS_ACCEPTED);
-    writeMeter("billsIn2", sas::SASConstants::METER_2_BILLS_ACCEPTED);
-    writeMeter("billsIn5", sas::SASConstants::METER_5_BILLS_ACCEPTED);
-    writeMeter("billsIn10", sas::SASConstants::METER_10_BILLS_ACCEPTED);
-    writeMeter("billsIn20", sas::SASConstants::METER_20_BILLS_ACCEPTED);
-    writeMeter("billsIn50", sas::SASConstants::METER_50_BILLS_ACCEPTED);
-    writeMeter("billsIn100", sas::SASConstants::METER_100_BILLS_ACCEPTED);
-    writeMeter("billsIn200", sas::SASConstants::METER_200_BILLS_ACCEPTED);
-    writeMeter("billsIn500", sas::SASConstants::METER_500_BILLS_ACCEPTED);
-    writeMeter("billsIn1000", sas::SASConstants::METER_1000_BILLS_ACCEPTED);
+    // A running journal saves and truncates itself in one step
+    std::shared_ptr<MeterJournal> journal = findJournal(address);
+    if (journal) {
+        return journal->compact();
+    }
 
-    // Machine meters - Credits and coins (use SAS or extended METER_* codes)
-    writeMeter("credits", sas::SASConstants::METER_CURRENT_CRD);
-    writeMeter("trueCoinIn", sas::SASConstants::METER_TRUE_COIN_IN);
-    writeMeter("trueCoinOut", sas::SASConstants::METER_TRUE_COIN_OUT);
-    writeMeter("billDrop", sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR);
-    writeMeter("totalHandPay", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD);
-    writeMeter("actualCoinDrop", sas::SASConstants::METER_ACTUAL_COIN_DROP);
-    writeMeter("handPaidCancelledCredits", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD);
-    writeMeter("physicalCoinInValue", sas::SASConstants::METER_PHYS_COIN_IN_DOLLAR_VALUE);
-    writeMeter("physicalCoinOutValue", sas::SASConstants::METER_PHYS_COIN_OUT_DOLLAR_VALUE);
-    writeMeter("totalDrop", sas::SASConstants::METER_TOT_DROP);
-    writeMeter("voucherTicketDrop", sas::SASConstants::METER_VOUCHER_TICKET_DROP);
-    writeMeter("ncepCredits", sas::SASConstants::METER_NCEP_CREDITS);
+    // Without one, the snapshot must still cover any journal left on disk
+    std::string journalPath = getJournalPath(address);
+    uint64_t lastSequence = 0;
+    off_t validLength = 0;
+    MeterJournal::replay(journalPath, nullptr, 0, lastSequence, validLength);
+    if (!writeSnapshot(machine, address, lastSequence)) {
+        return false;
+    }
+    unlink(journalPath.c_str());
+    return true;
+}
 
-    // Machine meters - AFT (use SAS METER_* codes)
-    writeMeter("aftCashableToGame", sas::SASConstants::METER_AFT_CASHABLE_IN);
-    writeMeter("aftRestrictedToGame", sas::SASConstants::METER_AFT_REST_IN);
-    writeMeter("aftNonRestrictedToGame", sas::SASConstants::METER_AFT_IN);
-    writeMeter("aftCashableToHost", sas::SASConstants::METER_AFT_CASHABLE_OUT);
-    writeMeter("aftRestrictedToHost", sas::SASConstants::METER_AFT_REST_OUT);
-    writeMeter("aftNonRestrictedToHost", sas::SASConstants::METER_AFT_OUT);
-    writeMeter("aftDebitToGame", sas::SASConstants::METER_AFT_DEBIT_XFER_TO_GAME_VALUE);
+bool MeterPersistence::writeSnapshot(simulator::Machine* machine, uint8_t address, uint64_t journalSequence) {
+    std::vector<uint8_t> image = MeterSnapshot::encode(*machine, journalSequence);
+    if (!writeFileAtomically(getSnapshotPath(address), image.data(), image.size())) {
+        return false;
+    }
 
-    // Machine meters - Bonus and Progressive (use SAS METER_* codes)
-    writeMeter("bonusMachinePayout", sas::SASConstants::METER_MACH_PAID_EXT_BONUS);
-    writeMeter("bonusAttendantPayout", sas::SASConstants::METER_ATT_PAID_EXT_BONUS);
-    writeMeter("progressiveAttendantPayout", sas::SASConstants::METER_ATT_PAID_PROG);
-    writeMeter("progressiveMachinePayout", sas::SASConstants::METER_MACH_PAID_PROG);
+    LOG(METERS, INFO, "[Meters] Meters saved successfully");
+    LOG(METERS, DEBUG, "[Meters]   Coin In: " << machine->getMeter(sas::SASConstants::METER_COIN_IN));
+    LOG(METERS, DEBUG, "[Meters]   Coin Out: " << machine->getMeter(sas::SASConstants::METER_COIN_OUT));
+    LOG(METERS, DEBUG, "[Meters]   Credits: " << machine->getMeter(sas::SASConstants::METER_CURRENT_CRD));
 
-    // Machine meters - Special (use SAS or extended METER_* codes)
-    writeMeter("restrictedPlayed", sas::SASConstants::METER_TOTAL_REST_PLAYED);
-    writeMeter("unrestrictedPlayed", sas::SASConstants::METER_TOTAL_NONREST_PLAYED);
-    writeMeter("gameWeightedTheoretical", sas::SASConstants::METER_WTPP);
+    return true;
+}
 
-    // Game meters (base game - use SAS or extended METER_* codes)
-    writeMeter("coinIn", sas::SASConstants::METER_COIN_IN);
-    writeMeter("coinOut", sas::SASConstants::METER_COIN_OUT);
-    writeMeter("gamesPlayed", sas::SASConstants::METER_GAMES_PLAYED);
-    writeMeter("gamesWon", sas::SASConstants::METER_GAMES_WON);
-    writeMeter("maxCoinBet", sas::SASConstants::METER_MAX_COIN_BET);
-    writeMeter("cancelledCredits", sas::SASConstants::METER_CANCELLED_CRD);
-    writeMeter("bonusWon", sas::SASConstants::METER_BONUS_WON);
-    writeMeter("jackpot", sas::SASConstants::METER_JACKPOT);
-    writeMeter("progressiveCoinIn", sas::SASConstants::METER_PROGRESSIVE_COIN_IN);
+bool MeterPersistence::exportMeters(simulator::Machine* machine, uint8_t address) {
+    if (!machine) {
+        LOG(METERS, ERROR, "[Meters] ERROR: Machine pointer is null");
+        return false;
+    }
+
+    // Pair the export with the binary snapshot's journal position, so an
+    // import after losing meters.bin replays the right journal records
+    uint64_t journalSequence = 0;
+    MeterSnapshot snapshot;
+    if (snapshot.open(getSnapshotPath(address))) {
+        journalSequence = snapshot.getJournalSequence();
+    }
+
+    // Create JSON document using RapidJSON Writer
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+
+    // Write main machine meters
+    writer.Key("mainMeters");
+    writer.StartObject();
+
+    // Save meters using METER_* codes directly (no more persistence code mapping!)
+    // Read them as one snapshot so related meters are consistent with each other
+    int meterCodes[MAIN_METER_COUNT];
+    int64_t meterValues[MAIN_METER_COUNT];
+    for (size_t i = 0; i < MAIN_METER_COUNT; i++) {
+        meterCodes[i] = MAIN_METERS[i].meterCode;
+    }
+    machine->getMeters(meterCodes, meterValues);
+
+    for (size_t i = 0; i < MAIN_METER_COUNT; i++) {
+        writer.Key(MAIN_METERS[i].key);
+        writer.Int64(meterValues[i]);
+    }
 
     writer.EndObject();
 
@@ -291,8 +510,20 @@ bool MeterPersistence::saveMeters(simulator::Machine* machine) {
     writer.Key("games");
     writer.StartArray();
 
+    int gameMeterCodes[GAME_METER_COUNT];
+    for (size_t m = 0; m < GAME_METER_COUNT; m++) {
+        gameMeterCodes[m] = GAME_METERS[m].meterCode;
+    }
+
+    std::set<int> gameNumbers;
+    std::set<int> denomCodes;
     auto games = machine->getGames();
     for (const auto& game : games) {
+        denomCodes.insert(game->getDenomCode());
+        if (!gameNumbers.insert(game->getGameNumber()).second) {
+            continue;  // Same game at another denomination shares the block
+        }
+
         writer.StartObject();
 
         writer.Key("gameNumber");
@@ -300,7 +531,36 @@ bool MeterPersistence::saveMeters(simulator::Machine* machine) {
 
         writer.Key("meters");
         writer.StartObject();
-        // TODO: Add game-specific meters when Game class supports them
+        int64_t gameValues[GAME_METER_COUNT];
+        if (machine->getGameMeters(game->getGameNumber(), gameMeterCodes, GAME_METER_COUNT, gameValues)) {
+            for (size_t m = 0; m < GAME_METER_COUNT; m++) {
+                writer.Key(GAME_METERS[m].key);
+                writer.Int64(gameValues[m]);
+            }
+        }
+        writer.EndObject();
+
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+
+    // Write per-denomination meters
+    writer.Key("denominations");
+    writer.StartArray();
+
+    for (int denomCode : denomCodes) {
+        writer.StartObject();
+
+        writer.Key("denomCode");
+        writer.Int(denomCode);
+
+        writer.Key("meters");
+        writer.StartObject();
+        for (size_t m = 0; m < GAME_METER_COUNT; m++) {
+            writer.Key(GAME_METERS[m].key);
+            writer.Int64(machine->getDenomMeter(denomCode, GAME_METERS[m].meterCode));
+        }
         writer.EndObject();
 
         writer.EndObject();
@@ -312,15 +572,17 @@ bool MeterPersistence::saveMeters(simulator::Machine* machine) {
     writer.Key("lastSaved");
     writer.String(getCurrentTimestamp().c_str());
 
-    writer.EndObject();
-
-    fclose(fp);
+    // Journal records up to here are already in the meters
+    writer.Key("journalSequence");
+    writer.Uint64(journalSequence);
 
-    utils::Logger::log("[Meters] Meters saved successfully");
-    utils::Logger::log("[Meters]   Coin In: " + std::to_string(machine->getMeter(sas::SASConstants::METER_COIN_IN)));
-    utils::Logger::log("[Meters]   Coin Out: " + std::to_string(machine->getMeter(sas::SASConstants::METER_COIN_OUT)));
-    utils::Logger::log("[Meters]   Credits: " + std::to_string(machine->getMeter(sas::SASConstants::METER_CURRENT_CRD)));
+    writer.EndObject();
 
+    std::string metersPath = getMetersPath(address);
+    if (!writeFileAtomically(metersPath, buffer.GetString(), buffer.GetSize())) {
+        return false;
+    }
+    LOG(METERS, INFO, "[Meters] Meters exported to: " << metersPath);
     return true;
 }
 
@@ -0,0 +1,261 @@
+#include "config/MeterSnapshot.h"
+#include "simulator/Game.h"
+#include "sas/CRC16.h"
+#include "utils/Logger.h"
+#include <cstring>
+#include <set>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "MeterSnapshot maps the file directly and assumes a little-endian target"
+#endif
+
+namespace config {
+
+static_assert(sizeof(MeterSnapshot::Header) == 64, "Header layout is part of the file format");
+static_assert(sizeof(MeterSnapshot::GameSection) == 64, "GameSection layout is part of the file format");
+static_assert(MeterSnapshot::METER_SLOTS % 64 == 0, "Present bitmap must keep values 8-byte aligned");
+
+constexpr uint32_t MeterSnapshot::MAGIC;
+constexpr uint16_t MeterSnapshot::FORMAT_VERSION;
+constexpr int MeterSnapshot::METER_SLOTS;
+
+static const size_t PRESENT_OFFSET = sizeof(MeterSnapshot::Header);
+static const size_t VALUES_OFFSET = PRESENT_OFFSET + MeterSnapshot::METER_SLOTS / 8;
+static const size_t GAMES_OFFSET = VALUES_OFFSET + MeterSnapshot::METER_SLOTS * sizeof(int64_t);
+static const size_t TRAILER_SIZE = 8;      // CRC16 + padding
+
+MeterSnapshot::MeterSnapshot()
+    : data_(nullptr),
+      size_(0),
+      header_(nullptr),
+      present_(nullptr),
+      values_(nullptr),
+      games_(nullptr) {
+}
+
+MeterSnapshot::~MeterSnapshot() {
+    close();
+}
+
+size_t MeterSnapshot::fileSizeFor(size_t gameCount) {
+    return GAMES_OFFSET + gameCount * sizeof(GameSection) + TRAILER_SIZE;
+}
+
+bool MeterSnapshot::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < fileSizeFor(0)) {
+        ::close(fd);
+        LOG(METERS, WARN, "[Meters] " << path << " is too short to be a meter snapshot");
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        LOG(METERS, WARN, "[Meters] Could not map " << path << ": " << strerror(errno));
+        return false;
+    }
+
+    const char* problem = validate(static_cast<const uint8_t*>(data), size);
+    if (problem) {
+        munmap(data, size);
+        LOG(METERS, WARN, "[Meters] Rejecting meter snapshot " << path << ": " << problem);
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    expose();
+    return true;
+}
+
+bool MeterSnapshot::load(const std::vector<uint8_t>& image) {
+    close();
+
+    const char* problem = (image.size() < fileSizeFor(0)) ? "too short" : nullptr;
+    if (!problem) {
+        // Copy into 8-byte aligned storage, as a mapping would be
+        copy_.resize((image.size() + sizeof(int64_t) - 1) / sizeof(int64_t));
+        memcpy(copy_.data(), image.data(), image.size());
+        problem = validate(reinterpret_cast<const uint8_t*>(copy_.data()), image.size());
+    }
+    if (problem) {
+        copy_.clear();
+        LOG(METERS, WARN, "[Meters] Rejecting meter snapshot image: " << problem);
+        return false;
+    }
+
+    data_ = copy_.data();
+    size_ = image.size();
+    expose();
+    return true;
+}
+
+const char* MeterSnapshot::validate(const uint8_t* bytes, size_t size) {
+    const Header* header = reinterpret_cast<const Header*>(bytes);
+    if (header->magic != MAGIC) {
+        return "bad magic";
+    }
+    if (header->formatVersion != FORMAT_VERSION || header->headerSize != sizeof(Header)
+        || header->meterSlots != METER_SLOTS || header->gameSectionSize != sizeof(GameSection)) {
+        return "unsupported format version or layout";
+    }
+    if (header->fileSize != size || fileSizeFor(header->gameCount) != size) {
+        return "size mismatch (truncated?)";
+    }
+    size_t crcOffset = size - TRAILER_SIZE;
+    uint16_t stored = static_cast<uint16_t>(bytes[crcOffset] | (bytes[crcOffset + 1] << 8));
+    if (stored != sas::CRC16::calculate(bytes, crcOffset)) {
+        return "CRC mismatch";
+    }
+    return nullptr;
+}
+
+void MeterSnapshot::expose() {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data_);
+    header_ = reinterpret_cast<const Header*>(bytes);
+    present_ = bytes + PRESENT_OFFSET;
+    values_ = reinterpret_cast<const int64_t*>(bytes + VALUES_OFFSET);
+    games_ = reinterpret_cast<const GameSection*>(bytes + GAMES_OFFSET);
+}
+
+void MeterSnapshot::close() {
+    if (data_ && copy_.empty()) {
+        munmap(data_, size_);
+    }
+    copy_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    header_ = nullptr;
+    present_ = nullptr;
+    values_ = nullptr;
+    games_ = nullptr;
+}
+
+bool MeterSnapshot::hasMeter(int meterCode) const {
+    return data_ && meterCode >= 0 && meterCode < METER_SLOTS
+        && (present_[meterCode >> 3] & (1 << (meterCode & 7))) != 0;
+}
+
+int64_t MeterSnapshot::getMeter(int meterCode) const {
+    return hasMeter(meterCode) ? values_[meterCode] : 0;
+}
+
+size_t MeterSnapshot::applyTo(simulator::Machine* machine) const {
+    if (!data_ || !machine) {
+        return 0;
+    }
+
+    int codes[METER_SLOTS];
+    int64_t values[METER_SLOTS];
+    size_t count = 0;
+    for (int code = 0; code < METER_SLOTS; code++) {
+        if (hasMeter(code)) {
+            codes[count] = code;
+            values[count] = values_[code];
+            count++;
+        }
+    }
+    machine->setMeters(codes, count, values);
+
+    for (size_t i = 0; i < header_->gameCount; i++) {
+        const GameSection& section = games_[i];
+        for (int field = 0; field < simulator::GameMeters::FIELD_COUNT; field++) {
+            int meterCode = simulator::GameMeters::meterCodeOf(field);
+            if (section.kind == SECTION_GAME) {
+                machine->setGameMeter(static_cast<int>(section.gameNumber), meterCode, section.meters[field]);
+            } else if (section.kind == SECTION_DENOMINATION) {
+                machine->setDenomMeter(section.denomCode, meterCode, section.meters[field]);
+            }
+        }
+    }
+    return count;
+}
+
+std::vector<uint8_t> MeterSnapshot::encode(const simulator::Machine& machine, uint64_t journalSequence) {
+    // One section per game number, then one per denomination in use
+    std::vector<GameSection> sections;
+    std::set<int> gameNumbers;
+    std::set<int> denomCodes;
+    for (const auto& game : machine.getGames()) {
+        denomCodes.insert(game->getDenomCode());
+        if (!gameNumbers.insert(game->getGameNumber()).second) {
+            continue;
+        }
+        GameSection section = GameSection();
+        section.gameNumber = static_cast<uint32_t>(game->getGameNumber());
+        section.denomCode = static_cast<uint16_t>(game->getDenomCode());
+        section.kind = SECTION_GAME;
+        for (int field = 0; field < simulator::GameMeters::FIELD_COUNT; field++) {
+            section.meters[field] = machine.getGameMeter(game->getGameNumber(),
+                                                         simulator::GameMeters::meterCodeOf(field));
+        }
+        sections.push_back(section);
+    }
+    for (int code = 0; code < simulator::GameMeters::DENOM_CODES; code++) {
+        GameSection section = GameSection();
+        section.denomCode = static_cast<uint16_t>(code);
+        section.kind = SECTION_DENOMINATION;
+        bool used = denomCodes.count(code) > 0;
+        for (int field = 0; field < simulator::GameMeters::FIELD_COUNT; field++) {
+            section.meters[field] = machine.getDenomMeter(code, simulator::GameMeters::meterCodeOf(field));
+            used = used || section.meters[field] != 0;
+        }
+        if (used) {
+            sections.push_back(section);
+        }
+    }
+
+    size_t size = fileSizeFor(sections.size());
+    std::vector<uint8_t> image(size, 0);
+
+    Header* header = reinterpret_cast<Header*>(image.data());
+    header->magic = MAGIC;
+    header->formatVersion = FORMAT_VERSION;
+    header->headerSize = sizeof(Header);
+    header->meterSlots = METER_SLOTS;
+    header->gameCount = static_cast<uint32_t>(sections.size());
+    header->gameSectionSize = sizeof(GameSection);
+    header->journalSequence = journalSequence;
+    header->savedAt = static_cast<int64_t>(std::time(nullptr));
+    header->fileSize = size;
+
+    // One consistent read of every slot
+    int64_t values[METER_SLOTS];
+    bool present[METER_SLOTS];
+    machine.getAllMeters(values, present);
+
+    uint8_t* presentBits = image.data() + PRESENT_OFFSET;
+    for (int code = 0; code < METER_SLOTS; code++) {
+        if (present[code]) {
+            presentBits[code >> 3] |= static_cast<uint8_t>(1 << (code & 7));
+        }
+    }
+    memcpy(image.data() + VALUES_OFFSET, values, sizeof(values));
+
+    if (!sections.empty()) {
+        memcpy(image.data() + GAMES_OFFSET, sections.data(), sections.size() * sizeof(GameSection));
+    }
+
+    size_t crcOffset = size - TRAILER_SIZE;
+    uint16_t crc = sas::CRC16::calculate(image.data(), crcOffset);
+    image[crcOffset] = static_cast<uint8_t>(crc);
+    image[crcOffset + 1] = static_cast<uint8_t>(crc >> 8);
+    return image;
+}
+
+} // namespace config
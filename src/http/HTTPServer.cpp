@@ -1,10 +1,22 @@
 #include "simulator/Machine.h"
+#include "simulator/MachineEvents.h"
 #include "simulator/Game.h"
+#include "io/MachineCommPort.h"
+#include "event/EventService.h"
 #include "sas/SASConstants.h"
+#include "sas/SASCommPort.h"
+#include "sas/CommandMetrics.h"
 #include "http/HTTPServer.h"
 #include "config/MeterPersistence.h"
+#include "utils/Logger.h"
+#include "utils/Trace.h"
+#include <rapidjson/writer.h>
 #include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -12,6 +24,9 @@
 #include <netdb.h>
 #include <cstring>
 #include <cstdlib>
+#include <cctype>
+#include <cerrno>
+#include <ctime>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -39,18 +54,75 @@ static std::string jsonEscape(const std::string& str) {
     return result;
 }
 
-HTTPServer::HTTPServer(simulator::Machine* machine, int port)
+// Simple JSON helper: extract "key":"value" string from a flat JSON body
+static std::string jsonStringValue(const std::string& body, const std::string& key) {
+    size_t pos = body.find("\"" + key + "\"");
+    if (pos == std::string::npos) return "";
+    pos = body.find(':', pos + key.length() + 2);
+    if (pos == std::string::npos) return "";
+    size_t start = body.find('"', pos + 1);
+    if (start == std::string::npos) return "";
+    size_t end = body.find('"', start + 1);
+    if (end == std::string::npos) return "";
+    return body.substr(start + 1, end - start - 1);
+}
+
+constexpr uint64_t HTTPServer::LISTEN_ID;
+constexpr uint64_t HTTPServer::WAKE_ID;
+constexpr uint64_t HTTPServer::FIRST_CONNECTION_ID;
+constexpr int HTTPServer::LISTEN_BACKLOG;
+constexpr size_t HTTPServer::MAX_CONNECTIONS;
+constexpr size_t HTTPServer::MAX_HEADER_SIZE;
+constexpr size_t HTTPServer::MAX_BODY_SIZE;
+constexpr int HTTPServer::KEEPALIVE_TIMEOUT_MS;
+constexpr int HTTPServer::IDLE_CHECK_INTERVAL_MS;
+constexpr int HTTPServer::STREAM_HEARTBEAT_MS;
+constexpr size_t HTTPServer::MAX_STREAM_BACKLOG;
+constexpr size_t HTTPServer::MAX_QUEUED_EXCEPTIONS;
+
+static std::string toLower(std::string str) {
+    for (char& c : str) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return str;
+}
+
+HTTPServer::HTTPServer(simulator::Machine* machine, int port, size_t workerCount)
     : machine_(machine)
     , port_(port)
     , serverSocket_(-1)
+    , epollFd_(-1)
+    , wakeFd_(-1)
+    , workerCount_(workerCount > 0 ? workerCount : 1)
     , running_(false)
+    , nextConnectionId_(FIRST_CONNECTION_ID)
+    , streamCount_(0)
+    , streamIntervalMs_(50)
 {
+    // Versions restart at 0 with the process; keep old ETags from matching
+    std::ostringstream prefix;
+    prefix << std::hex << static_cast<uint64_t>(time(nullptr)) << "-";
+    etagPrefix_ = prefix.str();
 }
 
 HTTPServer::~HTTPServer() {
     stop();
 }
 
+void HTTPServer::addMachine(uint8_t address, simulator::Machine* machine, sas::SASCommPort* sasPort) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    machines_[address] = machine;
+    if (sasPort) {
+        sasPorts_[address] = sasPort;
+    }
+}
+
+void HTTPServer::setStreamIntervalMs(int intervalMs) {
+    if (!running_) {
+        streamIntervalMs_ = intervalMs > 0 ? intervalMs : 1;
+    }
+}
+
 void HTTPServer::start() {
     if (running_) {
         return;
@@ -58,8 +130,8 @@ void HTTPServer::start() {
 
     std::cout << "Starting HTTP server on port " << port_ << "..." << std::endl;
 
-    // Create server socket
-    serverSocket_ = socket(AF_INET, SOCK_STREAM, 0);
+    // Create server socket (non-blocking: workers accept until EAGAIN)
+    serverSocket_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
     if (serverSocket_ < 0) {
         std::cerr << "Failed to create server socket" << std::endl;
         return;
@@ -70,6 +142,7 @@ void HTTPServer::start() {
     if (setsockopt(serverSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
         std::cerr << "Failed to set SO_REUSEADDR" << std::endl;
         close(serverSocket_);
+        serverSocket_ = -1;
         return;
     }
 
@@ -82,21 +155,58 @@ void HTTPServer::start() {
     if (bind(serverSocket_, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
         std::cerr << "Failed to bind to port " << port_ << std::endl;
         close(serverSocket_);
+        serverSocket_ = -1;
         return;
     }
 
     // Listen
-    if (listen(serverSocket_, 5) < 0) {
+    if (listen(serverSocket_, LISTEN_BACKLOG) < 0) {
         std::cerr << "Failed to listen on socket" << std::endl;
         close(serverSocket_);
+        serverSocket_ = -1;
         return;
     }
 
-    std::cout << "HTTP server listening on port " << port_ << std::endl;
+    // Event loop: listening socket (one-shot, re-armed after each accept
+    // batch) and the stop eventfd (level-triggered, wakes every worker)
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        std::cerr << "Failed to create HTTP event loop: " << strerror(errno) << std::endl;
+        if (epollFd_ >= 0) close(epollFd_);
+        if (wakeFd_ >= 0) close(wakeFd_);
+        close(serverSocket_);
+        epollFd_ = wakeFd_ = serverSocket_ = -1;
+        return;
+    }
+
+    struct epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN | EPOLLONESHOT;
+    listenEvent.data.u64 = LISTEN_ID;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, serverSocket_, &listenEvent);
+
+    struct epoll_event wakeEvent{};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.u64 = WAKE_ID;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &wakeEvent);
+
+    std::cout << "HTTP server listening on port " << port_
+              << " (" << workerCount_ << " worker threads)" << std::endl;
     std::cout << "GUI URL: http://localhost:" << port_ << "/index.html" << std::endl;
 
+    // Exceptions for /api/events (hosted machines normally share one service)
+    if (machine_) {
+        subscribeEvents(machine_->getEventService());
+    }
+    for (const auto& entry : machines_) {
+        subscribeEvents(entry.second->getEventService());
+    }
+
     running_ = true;
-    serverThread_ = std::thread(&HTTPServer::serverThread, this);
+    for (size_t i = 0; i < workerCount_; i++) {
+        workers_.push_back(std::thread(&HTTPServer::workerThread, this, i));
+    }
+    pushThread_ = std::thread(&HTTPServer::pushThread, this);
 }
 
 void HTTPServer::stop() {
@@ -107,67 +217,459 @@ void HTTPServer::stop() {
     std::cout << "Stopping HTTP server..." << std::endl;
     running_ = false;
 
-    if (serverSocket_ >= 0) {
-        close(serverSocket_);
-        serverSocket_ = -1;
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        std::cerr << "Failed to wake HTTP workers" << std::endl;
+    }
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
     }
+    workers_.clear();
 
-    if (serverThread_.joinable()) {
-        serverThread_.join();
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        streamCondition_.notify_all();
+    }
+    if (pushThread_.joinable()) {
+        pushThread_.join();
+    }
+    for (auto& subscription : eventSubscriptions_) {
+        subscription.first->unsubscribe(subscription.second);
     }
+    eventSubscriptions_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (auto& entry : connections_) {
+            close(entry.second->fd);
+        }
+        connections_.clear();
+        streamCount_ = 0;
+    }
+
+    close(epollFd_);
+    close(wakeFd_);
+    close(serverSocket_);
+    epollFd_ = wakeFd_ = serverSocket_ = -1;
 
     std::cout << "HTTP server stopped" << std::endl;
 }
 
-void HTTPServer::serverThread() {
+void HTTPServer::workerThread(size_t index) {
+    const int MAX_EVENTS = 16;
+    struct epoll_event events[MAX_EVENTS];
+    auto lastIdleCheck = std::chrono::steady_clock::now();
+
     while (running_) {
-        fd_set readSet;
-        FD_ZERO(&readSet);
-        FD_SET(serverSocket_, &readSet);
+        int count = epoll_wait(epollFd_, events, MAX_EVENTS, IDLE_CHECK_INTERVAL_MS);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (running_) {
+                std::cerr << "HTTP epoll_wait error: " << strerror(errno) << std::endl;
+            }
+            break;
+        }
 
-        struct timeval timeout{};
-        timeout.tv_sec = 1;
-        timeout.tv_usec = 0;
+        for (int i = 0; i < count && running_; i++) {
+            uint64_t id = events[i].data.u64;
+            if (id == WAKE_ID) {
+                continue;  // stop() - loop condition exits
+            } else if (id == LISTEN_ID) {
+                acceptConnections();
+            } else {
+                serviceConnection(id, events[i].events);
+            }
+        }
 
-        int result = select(serverSocket_ + 1, &readSet, nullptr, nullptr, &timeout);
+        // One worker closes keep-alive connections that went quiet
+        auto now = std::chrono::steady_clock::now();
+        if (index == 0 && now - lastIdleCheck >= std::chrono::milliseconds(IDLE_CHECK_INTERVAL_MS)) {
+            lastIdleCheck = now;
+            closeIdleConnections();
+        }
+    }
+}
 
-        if (result < 0) {
-            if (running_) {
-                std::cerr << "Select error" << std::endl;
+void HTTPServer::acceptConnections() {
+    for (;;) {
+        int clientSocket = accept4(serverSocket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientSocket < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "HTTP accept error: " << strerror(errno) << std::endl;
             }
             break;
-        } else if (result == 0) {
-            // Timeout, continue loop
+        }
+
+        // Small JSON responses on a kept-alive socket: don't wait for Nagle
+        int noDelay = 1;
+        setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        if (connections_.size() >= MAX_CONNECTIONS) {
+            close(clientSocket);
             continue;
         }
 
-        if (FD_ISSET(serverSocket_, &readSet)) {
-            struct sockaddr_in clientAddr{};
-            socklen_t clientLen = sizeof(clientAddr);
+        std::shared_ptr<Connection> conn = std::make_shared<Connection>();
+        conn->fd = clientSocket;
+        conn->outputOffset = 0;
+        conn->closeAfterWrite = false;
+        conn->busy = false;
+        conn->lastActivity = std::chrono::steady_clock::now();
+        conn->streamMachine = nullptr;
+        conn->streamSynced = false;
+        conn->streamVersion = 0;
+
+        uint64_t id = nextConnectionId_++;
+        connections_[id] = conn;
+
+        struct epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.u64 = id;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, clientSocket, &event) < 0) {
+            connections_.erase(id);
+            close(clientSocket);
+        }
+    }
 
-            int clientSocket = accept(serverSocket_, (struct sockaddr*)&clientAddr, &clientLen);
-            if (clientSocket >= 0) {
-                // Handle client in a separate thread (or could use thread pool)
-                std::thread clientThread(&HTTPServer::handleClient, this, clientSocket);
-                clientThread.detach();
-            }
+    // Re-arm the listening socket
+    struct epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN | EPOLLONESHOT;
+    listenEvent.data.u64 = LISTEN_ID;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, serverSocket_, &listenEvent);
+}
+
+void HTTPServer::serviceConnection(uint64_t id, uint32_t events) {
+    std::shared_ptr<Connection> conn;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        auto it = connections_.find(id);
+        if (it == connections_.end()) {
+            return;  // Closed while the event was queued
+        }
+        conn = it->second;
+        if (conn->busy) {
+            // The push thread re-armed it while another worker held its
+            // event; that worker re-arms again on release, so drop this one
+            return;
         }
+        conn->busy = true;
+        conn->output += conn->streamPending;
+        conn->streamPending.clear();
+    }
+
+    bool open = (events & EPOLLERR) == 0;
+    if (open && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) {
+        open = readRequests(*conn);
+    }
+    if (open) {
+        open = flushOutput(*conn);
+    }
+
+    if (!open || (conn->closeAfterWrite && conn->outputOffset >= conn->output.size())) {
+        closeConnection(id);
+        return;
     }
+    releaseConnection(id, *conn);
 }
 
-void HTTPServer::handleClient(int clientSocket) {
+void HTTPServer::releaseConnection(uint64_t id, Connection& conn) {
+    // Hand the connection back to epoll; hold the lock so the idle sweep and
+    // the push thread never see it between clearing busy and re-arming
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    conn.busy = false;
+    conn.lastActivity = std::chrono::steady_clock::now();
+
+    bool pending = conn.outputOffset < conn.output.size() || !conn.streamPending.empty();
+
+    struct epoll_event event{};
+    event.events = (pending ? EPOLLOUT : EPOLLIN) | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.u64 = id;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, conn.fd, &event);
+}
+
+bool HTTPServer::readRequests(Connection& conn) {
+    // Drain the socket (edge of a one-shot event: read until EAGAIN)
+    bool peerClosed = false;
     char buffer[4096];
-    ssize_t bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+    for (;;) {
+        ssize_t bytesRead = recv(conn.fd, buffer, sizeof(buffer), 0);
+        if (bytesRead > 0) {
+            conn.input.append(buffer, static_cast<size_t>(bytesRead));
+            if (conn.input.size() > MAX_HEADER_SIZE + MAX_BODY_SIZE) {
+                break;  // Rejected below
+            }
+        } else if (bytesRead == 0) {
+            peerClosed = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    // Event streams only send; anything the client writes is ignored
+    if (conn.streamMachine) {
+        conn.input.clear();
+        if (peerClosed) {
+            conn.closeAfterWrite = true;
+        }
+        return true;
+    }
+
+    // Answer every complete request in the buffer (pipelining)
+    while (!conn.closeAfterWrite && !conn.input.empty()) {
+        size_t headerEnd = conn.input.find("\r\n\r\n");
+        if (headerEnd == std::string::npos) {
+            if (conn.input.size() > MAX_HEADER_SIZE) {
+                conn.output += formatResponse(buildResponse(431, "text/plain", "Request Header Fields Too Large"), false);
+                conn.closeAfterWrite = true;
+            }
+            break;
+        }
+
+        HTTPRequest req = parseRequest(conn.input.substr(0, headerEnd + 4));
+
+        size_t bodyLength = 0;
+        auto lengthHeader = req.headers.find("content-length");
+        if (lengthHeader != req.headers.end()) {
+            bodyLength = std::strtoul(lengthHeader->second.c_str(), nullptr, 10);
+        }
+        if (bodyLength > MAX_BODY_SIZE) {
+            conn.output += formatResponse(buildResponse(413, "text/plain", "Payload Too Large"), false);
+            conn.closeAfterWrite = true;
+            break;
+        }
+
+        size_t requestLength = headerEnd + 4 + bodyLength;
+        if (conn.input.size() < requestLength) {
+            break;  // Body still arriving
+        }
+
+        req.body = conn.input.substr(headerEnd + 4, bodyLength);
+        conn.input.erase(0, requestLength);
+
+        // HTTP/1.1 defaults to keep-alive, HTTP/1.0 to close
+        std::string connection;
+        auto connectionHeader = req.headers.find("connection");
+        if (connectionHeader != req.headers.end()) {
+            connection = toLower(connectionHeader->second);
+        }
+        bool keepAlive = (req.version == "HTTP/1.0")
+            ? connection == "keep-alive"
+            : connection != "close";
+
+        HTTPResponse response = handleRequest(req);
+        conn.output += formatResponse(response, keepAlive);
+        if (!keepAlive) {
+            conn.closeAfterWrite = true;
+        } else if (response.stream) {
+            {
+                std::lock_guard<std::mutex> lock(connectionsMutex_);
+                conn.streamMachine = response.stream;
+                conn.streamVersion = response.streamVersion;
+                streamCount_++;
+            }
+            {
+                std::lock_guard<std::mutex> lock(streamMutex_);
+                streamCondition_.notify_one();
+            }
+            conn.input.clear();
+            break;
+        }
+    }
+
+    if (peerClosed) {
+        conn.closeAfterWrite = true;
+    }
+    return true;
+}
+
+bool HTTPServer::flushOutput(Connection& conn) {
+    while (conn.outputOffset < conn.output.size()) {
+        ssize_t sent = send(conn.fd, conn.output.data() + conn.outputOffset,
+                            conn.output.size() - conn.outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn.outputOffset += static_cast<size_t>(sent);
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;  // Wait for EPOLLOUT
+        } else {
+            return false;
+        }
+    }
+
+    conn.output.clear();
+    conn.outputOffset = 0;
+    return true;
+}
+
+void HTTPServer::closeConnection(uint64_t id) {
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    auto it = connections_.find(id);
+    if (it == connections_.end()) {
+        return;
+    }
+    if (it->second->streamMachine) {
+        streamCount_--;
+    }
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    close(it->second->fd);
+    connections_.erase(it);
+}
+
+void HTTPServer::closeIdleConnections() {
+    auto cutoff = std::chrono::steady_clock::now() - std::chrono::milliseconds(KEEPALIVE_TIMEOUT_MS);
+
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    for (auto it = connections_.begin(); it != connections_.end(); ) {
+        Connection& conn = *it->second;
+        if (!conn.busy && !conn.streamMachine && conn.lastActivity < cutoff) {
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, conn.fd, nullptr);
+            close(conn.fd);
+            it = connections_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HTTPServer::subscribeEvents(std::shared_ptr<event::EventService> eventService) {
+    if (!eventService) {
+        return;
+    }
+    for (const auto& subscription : eventSubscriptions_) {
+        if (subscription.first == eventService) {
+            return;
+        }
+    }
+
+    int id = eventService->subscribe<simulator::ExceptionQueuedEvent>(
+        [this](const simulator::ExceptionQueuedEvent& e) {
+            if (streamCount_ == 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(streamMutex_);
+            std::vector<uint8_t>& queued = streamStates_[e.machine].exceptions;
+            if (queued.size() >= MAX_QUEUED_EXCEPTIONS) {
+                queued.erase(queued.begin());  // Drop the oldest
+            }
+            queued.push_back(e.code);
+        });
+    eventSubscriptions_.push_back(std::make_pair(eventService, id));
+}
+
+void HTTPServer::pushThread() {
+    auto lastHeartbeat = std::chrono::steady_clock::now();
+
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(streamMutex_);
+            if (streamCount_ == 0) {
+                // Nothing to push: sleep until a stream opens or stop()
+                streamCondition_.wait(lock, [this] { return !running_ || streamCount_ > 0; });
+                lastHeartbeat = std::chrono::steady_clock::now();
+                continue;
+            }
+            streamCondition_.wait_for(lock, std::chrono::milliseconds(streamIntervalMs_));
+        }
+        if (!running_) {
+            break;
+        }
 
-    if (bytesRead > 0) {
-        buffer[bytesRead] = '\0';
-        std::string request(buffer);
-        std::string response = handleRequest(request);
+        auto now = std::chrono::steady_clock::now();
+        bool heartbeat = now - lastHeartbeat >= std::chrono::milliseconds(STREAM_HEARTBEAT_MS);
+        if (heartbeat) {
+            lastHeartbeat = now;
+        }
+        pushStreamUpdates(heartbeat);
+    }
+}
 
-        send(clientSocket, response.c_str(), response.length(), 0);
+void HTTPServer::pushStreamUpdates(bool heartbeat) {
+    // Machines with a stream, and whether one of them is new since the last push
+    std::map<simulator::Machine*, bool> machines;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        for (const auto& entry : connections_) {
+            const Connection& conn = *entry.second;
+            if (conn.streamMachine) {
+                machines[conn.streamMachine] |= !conn.streamSynced;
+            }
+        }
     }
 
-    close(clientSocket);
+    // One delta per machine, shared by all of its streams
+    std::map<const simulator::Machine*, StreamPayload> payloads;
+    for (const auto& entry : machines) {
+        StreamPayload payload = buildStreamEvents(entry.first, entry.second);
+        if (heartbeat) {
+            // Comment line keeps proxies from timing out
+            if (payload.delta.empty()) payload.delta = ": ping\n\n";
+            if (payload.full.empty()) payload.full = ": ping\n\n";
+        }
+        payloads[entry.first] = payload;
+    }
+
+    // Queue on each stream; workers write it on the next EPOLLOUT
+    std::lock_guard<std::mutex> lock(connectionsMutex_);
+    for (auto it = connections_.begin(); it != connections_.end(); ) {
+        Connection& conn = *it->second;
+        auto payload = conn.streamMachine ? payloads.find(conn.streamMachine) : payloads.end();
+        if (payload == payloads.end()) {
+            ++it;
+            continue;
+        }
+
+        // A new stream's snapshot is only the delta baseline when no meter
+        // changed since it; otherwise it needs every meter once
+        const StreamPayload& events = payload->second;
+        if (conn.streamSynced || conn.streamVersion == events.version) {
+            conn.streamPending += events.delta;
+        } else if (!events.full.empty()) {
+            conn.streamPending += events.full;
+        } else {
+            ++it;  // Opened after this push was built
+            continue;
+        }
+        conn.streamSynced = true;
+        if (conn.streamPending.empty()) {
+            ++it;
+            continue;
+        }
+        if (conn.busy) {
+            ++it;  // The worker picks it up when it re-arms
+            continue;
+        }
+
+        size_t backlog = conn.streamPending.size() + conn.output.size() - conn.outputOffset;
+        if (backlog > MAX_STREAM_BACKLOG) {
+            // Client stopped reading
+            streamCount_--;
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, conn.fd, nullptr);
+            close(conn.fd);
+            it = connections_.erase(it);
+            continue;
+        }
+
+        struct epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.u64 = it->first;
+        epoll_ctl(epollFd_, EPOLL_CTL_MOD, conn.fd, &event);
+        ++it;
+    }
 }
 
 HTTPServer::HTTPRequest HTTPServer::parseRequest(const std::string& request) {
@@ -178,15 +680,16 @@ HTTPServer::HTTPRequest HTTPServer::parseRequest(const std::string& request) {
     // Parse request line
     if (std::getline(stream, line)) {
         std::istringstream lineStream(line);
-        lineStream >> req.method >> req.path;
+        lineStream >> req.method >> req.path >> req.version;
     }
 
-    // Parse headers
+    // Parse headers (names are case-insensitive; stored lower-case)
     while (std::getline(stream, line) && line != "\r") {
         size_t colon = line.find(':');
         if (colon != std::string::npos) {
-            std::string key = line.substr(0, colon);
-            std::string value = line.substr(colon + 2);
+            std::string key = toLower(line.substr(0, colon));
+            size_t valueStart = line.find_first_not_of(' ', colon + 1);
+            std::string value = (valueStart == std::string::npos) ? "" : line.substr(valueStart);
             if (!value.empty() && value[value.length()-1] == '\r') {
                 value = value.substr(0, value.length()-1);
             }
@@ -194,76 +697,153 @@ HTTPServer::HTTPRequest HTTPServer::parseRequest(const std::string& request) {
         }
     }
 
-    // Parse body
-    std::string body;
-    while (std::getline(stream, line)) {
-        body += line;
+    // Body follows the blank line
+    size_t headerEnd = request.find("\r\n\r\n");
+    if (headerEnd != std::string::npos) {
+        req.body = request.substr(headerEnd + 4);
     }
-    req.body = body;
 
     return req;
 }
 
-std::string HTTPServer::buildResponse(int statusCode, const std::string& contentType, const std::string& body) {
-    std::ostringstream response;
+HTTPServer::HTTPResponse HTTPServer::buildResponse(int statusCode, const std::string& contentType, const std::string& body) {
+    HTTPResponse response;
+    response.statusCode = statusCode;
+    response.contentType = contentType;
+    response.body = body;
+    response.stream = nullptr;
+    response.streamVersion = 0;
+    return response;
+}
 
-    std::string statusText;
-    switch (statusCode) {
+std::string HTTPServer::formatResponse(const HTTPResponse& response, bool keepAlive) {
+    const char* statusText;
+    switch (response.statusCode) {
         case 200: statusText = "OK"; break;
+        case 304: statusText = "Not Modified"; break;
         case 404: statusText = "Not Found"; break;
+        case 413: statusText = "Payload Too Large"; break;
+        case 431: statusText = "Request Header Fields Too Large"; break;
         case 500: statusText = "Internal Server Error"; break;
         default: statusText = "Unknown";
     }
 
-    response << "HTTP/1.1 " << statusCode << " " << statusText << "\r\n";
-    response << "Content-Type: " << contentType << "\r\n";
-    response << "Content-Length: " << body.length() << "\r\n";
-    response << "Access-Control-Allow-Origin: *\r\n";
-    response << "Connection: close\r\n";
-    response << "\r\n";
-    response << body;
+    std::string out;
+    out.reserve(192 + response.body.size());
+    out += "HTTP/1.1 ";
+    out += std::to_string(response.statusCode);
+    out += " ";
+    out += statusText;
+    out += "\r\n";
+    if (response.statusCode != 304) {
+        out += "Content-Type: ";
+        out += response.contentType;
+        out += "\r\n";
+    }
+    if (response.stream && keepAlive) {
+        out += "Cache-Control: no-cache\r\n";  // Open-ended body: no Content-Length
+    } else if (response.statusCode != 304) {
+        out += "Content-Length: ";
+        out += std::to_string(response.body.length());
+        out += "\r\n";
+    }
+    if (!response.etag.empty()) {
+        out += "ETag: ";
+        out += response.etag;
+        out += "\r\nCache-Control: no-cache\r\n";  // Revalidate on every scrape
+    }
+    out += "Access-Control-Allow-Origin: *\r\n";
+    out += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    out += "\r\n";
+    out += response.body;
 
-    return response.str();
+    return out;
 }
 
-std::string HTTPServer::handleRequest(const std::string& request) {
-    HTTPRequest req = parseRequest(request);
+HTTPServer::HTTPResponse HTTPServer::handleRequest(const HTTPRequest& req) {
 
     // Logging disabled to reduce console noise
     // std::cout << req.method << " " << req.path << std::endl;
 
+    // Per-EGM routes: /api/machines/{address}/<endpoint> is /api/<endpoint>
+    // for that machine; plain /api/<endpoint> addresses the primary machine
+    simulator::Machine* machine = machine_;
+    std::string path = req.path;
+    const std::string machinesPrefix = "/api/machines/";
+    if (path.compare(0, machinesPrefix.length(), machinesPrefix) == 0) {
+        size_t slash = path.find('/', machinesPrefix.length());
+        std::string addressStr = path.substr(machinesPrefix.length(),
+            slash == std::string::npos ? std::string::npos : slash - machinesPrefix.length());
+        int address = std::atoi(addressStr.c_str());
+
+        machine = nullptr;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            auto it = machines_.find(address);
+            if (it != machines_.end()) {
+                machine = it->second;
+            }
+        }
+        if (!machine || slash == std::string::npos) {
+            return buildResponse(404, "application/json",
+                                 "{\"error\":\"Unknown machine " + jsonEscape(addressStr) + "\"}");
+        }
+        path = "/api" + path.substr(slash);
+    }
+
     // API endpoints
-    if (req.method == "GET" && req.path == "/api/status") {
-        return buildResponse(200, "application/json", handleGET_Status());
+    if (req.method == "GET" && path == "/api/machines") {
+        return buildResponse(200, "application/json", handleGET_Machines());
     }
-    else if (req.method == "GET" && req.path == "/api/ip") {
+    else if (req.method == "GET" && path == "/api/status") {
+        return buildResponse(200, "application/json", handleGET_Status(machine));
+    }
+    else if (req.method == "GET" && path == "/api/ip") {
         return buildResponse(200, "application/json", handleGET_IP());
     }
-    else if (req.method == "GET" && req.path == "/api/denoms") {
-        return buildResponse(200, "application/json", handleGET_Denoms());
+    else if (req.method == "GET" && path == "/api/denoms") {
+        return buildResponse(200, "application/json", handleGET_Denoms(machine));
     }
-    else if (req.method == "GET" && req.path == "/api/exceptions") {
+    else if (req.method == "GET" && path == "/api/exceptions") {
         return buildResponse(200, "application/json", handleGET_Exceptions());
     }
-    else if (req.method == "GET" && req.path == "/api/meters") {
-        return buildResponse(200, "application/json", handleGET_Meters());
+    else if (req.method == "GET" && path == "/api/meters") {
+        return handleGET_Meters(machine, req);
+    }
+    else if (req.method == "GET" && path == "/api/logging") {
+        return buildResponse(200, "application/json", handleGET_Logging());
+    }
+    else if (req.method == "GET" && path == "/api/metrics") {
+        return buildResponse(200, "text/plain; version=0.0.4", handleGET_Metrics());
+    }
+    else if (req.method == "GET" && path == "/api/trace") {
+        return buildResponse(200, "application/json", handleGET_Trace());
     }
-    else if (req.method == "POST" && req.path == "/api/play") {
-        return buildResponse(200, "application/json", handlePOST_Play(req.body));
+    else if (req.method == "GET" && path == "/api/events") {
+        return handleGET_Events(machine);
     }
-    else if (req.method == "POST" && req.path == "/api/cashout") {
-        return buildResponse(200, "application/json", handlePOST_Cashout(req.body));
+    else if (req.method == "POST" && path == "/api/play") {
+        return buildResponse(200, "application/json", handlePOST_Play(machine, req.body));
     }
-    else if (req.method == "POST" && req.path == "/api/denom") {
-        return buildResponse(200, "application/json", handlePOST_Denom(req.body));
+    else if (req.method == "POST" && path == "/api/cashout") {
+        return buildResponse(200, "application/json", handlePOST_Cashout(machine, req.body));
     }
-    else if (req.method == "POST" && req.path == "/api/exception") {
+    else if (req.method == "POST" && path == "/api/denom") {
+        return buildResponse(200, "application/json", handlePOST_Denom(machine, req.body));
+    }
+    else if (req.method == "POST" && path == "/api/exception") {
         return buildResponse(200, "application/json", handlePOST_Exception(req.body));
     }
-    else if (req.method == "POST" && req.path == "/api/billinsert") {
-        return buildResponse(200, "application/json", handlePOST_BillInsert(req.body));
+    else if (req.method == "POST" && path == "/api/billinsert") {
+        return buildResponse(200, "application/json", handlePOST_BillInsert(machine, req.body));
+    }
+    else if (req.method == "POST" && path == "/api/logging") {
+        return buildResponse(200, "application/json", handlePOST_Logging(req.body));
     }
-    else if (req.method == "POST" && req.path == "/api/reboot") {
+    else if (req.method == "POST" && path == "/api/trace") {
+        return buildResponse(200, "application/json", handlePOST_Trace(req.body));
+    }
+    else if (req.method == "POST" && path == "/api/reboot") {
         return buildResponse(200, "application/json", handlePOST_Reboot(req.body));
     }
     // Static files
@@ -275,15 +855,15 @@ std::string HTTPServer::handleRequest(const std::string& request) {
     return buildResponse(404, "text/plain", "Not Found");
 }
 
-std::string HTTPServer::handleGET_Status() {
+std::string HTTPServer::handleGET_Status(simulator::Machine* machine) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-    auto game = machine_->getCurrentGame();
+    auto game = machine->getCurrentGame();
     std::ostringstream json;
     json << "{"
-         << "\"credits\":" << (machine_->getCredits() / 100.0) << ","
+         << "\"credits\":" << machine->getCashableAmount() << ","
          << "\"winAmount\":0.00,"
-         << "\"denom\":" << (game ? game->getDenom() : 0.01) << ","
+         << "\"denom\":" << (game ? game->getDenom() : simulator::Cents(1)) << ","
          << "\"gameName\":\"" << (game ? jsonEscape(game->getGameName()) : "No Game") << "\","
          << "\"isPlaying\":false,"
          << "\"status\":\"Ready\""
@@ -292,17 +872,75 @@ std::string HTTPServer::handleGET_Status() {
     return json.str();
 }
 
+std::string HTTPServer::handleGET_Machines() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    // Process-wide resource use, so hosting cost per EGM can be read off
+    // directly when scaling the number of machines
+    long pageSize = sysconf(_SC_PAGESIZE);
+    long rssPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    long totalPages = 0;
+    statm >> totalPages >> rssPages;
+    double rssKB = (rssPages * pageSize) / 1024.0;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    double cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                        usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+
+    size_t count = machines_.size();
+    std::ostringstream json;
+    json << "{\"machines\":[";
+    bool first = true;
+    for (const auto& entry : machines_) {
+        simulator::Machine* machine = entry.second;
+
+        // Exception queue health summed over the machine's ports
+        io::ExceptionQueue::Statistics exceptions;
+        for (const auto& port : machine->getPorts()) {
+            io::ExceptionQueue::Statistics portStats = port->getExceptionStatistics();
+            exceptions.queued += portStats.queued;
+            exceptions.coalesced += portStats.coalesced;
+            exceptions.overflows += portStats.overflows;
+            exceptions.pending += portStats.pending;
+        }
+
+        if (!first) json << ",";
+        json << "{"
+             << "\"address\":" << static_cast<int>(entry.first) << ","
+             << "\"assetNumber\":" << machine->getAssetNumber() << ","
+             << "\"credits\":" << machine->getCashableAmount() << ","
+             << "\"gamesPlayed\":" << machine->getGamesPlayed() << ","
+             << "\"exceptionsPending\":" << exceptions.pending << ","
+             << "\"exceptionsQueued\":" << exceptions.queued << ","
+             << "\"exceptionsCoalesced\":" << exceptions.coalesced << ","
+             << "\"exceptionOverflows\":" << exceptions.overflows
+             << "}";
+        first = false;
+    }
+    json << "],"
+         << "\"count\":" << count << ","
+         << "\"rssKB\":" << rssKB << ","
+         << "\"cpuSeconds\":" << cpuSeconds << ","
+         << "\"rssKBPerMachine\":" << (count ? rssKB / count : 0.0) << ","
+         << "\"cpuSecondsPerMachine\":" << (count ? cpuSeconds / count : 0.0)
+         << "}";
+
+    return json.str();
+}
+
 std::string HTTPServer::handleGET_IP() {
     std::string ip = getIPAddress();
     return "{\"ip\":\"" + jsonEscape(ip) + "\"}";
 }
 
-std::string HTTPServer::handleGET_Denoms() {
+std::string HTTPServer::handleGET_Denoms(simulator::Machine* machine) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
     // Get all unique denominations from available games
-    std::set<double> denomSet;
-    auto games = machine_->getGames();
+    std::set<simulator::Cents> denomSet;
+    auto games = machine->getGames();
     for (const auto& game : games) {
         denomSet.insert(game->getDenom());
     }
@@ -311,7 +949,7 @@ std::string HTTPServer::handleGET_Denoms() {
     std::ostringstream json;
     json << "{\"denoms\":[";
     bool first = true;
-    for (double denom : denomSet) {
+    for (simulator::Cents denom : denomSet) {
         if (!first) json << ",";
         json << denom;
         first = false;
@@ -344,100 +982,321 @@ std::string HTTPServer::handleGET_Exceptions() {
     return json.str();
 }
 
-std::string HTTPServer::handleGET_Meters() {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-
-    std::ostringstream json;
-    json << "{";
-    json << "\"mainMeters\":{";
-
-    // Return live METER_* values ONLY (never use mD*/gCI* persistence codes in runtime)
-    // All meters now use METER_* codes from the 0x00-0xFF (SAS spec) or 0x100+ (extended) ranges
+// Keys of the /api/meters "mainMeters" object, in output order
+// Code -1 reports 0 (meter not tracked)
+struct MeterKey {
+    const char* key;
+    int meterCode;
+};
 
+static const MeterKey MAIN_METER_KEYS[] = {
     // Machine meters - Doors (use extended METER_* codes in 0x100+ range)
-    json << "\"coinDrop\":" << machine_->getMeter(sas::SASConstants::METER_COIN_DROP) << ",";
-    json << "\"slotDoor\":" << machine_->getMeter(sas::SASConstants::METER_SLOT_DOOR) << ",";
-    json << "\"dropDoor\":" << machine_->getMeter(sas::SASConstants::METER_DROP_DOOR) << ",";
-    json << "\"logicDoor\":" << machine_->getMeter(sas::SASConstants::METER_LOGIC_DOOR) << ",";
-    json << "\"cashDoor\":" << machine_->getMeter(sas::SASConstants::METER_CASH_DOOR) << ",";
-    json << "\"auxFillDoor\":" << machine_->getMeter(sas::SASConstants::METER_AUX_FILL_DOOR) << ",";
-    json << "\"actualSlotDoor\":" << machine_->getMeter(sas::SASConstants::METER_ACTUAL_SLOT_DOOR) << ",";
-    json << "\"chassisDoor\":" << machine_->getMeter(sas::SASConstants::METER_CHASSIS_DOOR) << ",";
+    { "coinDrop", sas::SASConstants::METER_COIN_DROP },
+    { "slotDoor", sas::SASConstants::METER_SLOT_DOOR },
+    { "dropDoor", sas::SASConstants::METER_DROP_DOOR },
+    { "logicDoor", sas::SASConstants::METER_LOGIC_DOOR },
+    { "cashDoor", sas::SASConstants::METER_CASH_DOOR },
+    { "auxFillDoor", sas::SASConstants::METER_AUX_FILL_DOOR },
+    { "actualSlotDoor", sas::SASConstants::METER_ACTUAL_SLOT_DOOR },
+    { "chassisDoor", sas::SASConstants::METER_CHASSIS_DOOR },
 
     // Machine meters - Bill denoms (use live METER_* codes)
-    json << "\"billsIn1\":" << machine_->getMeter(sas::SASConstants::METER_1_BILLS_ACCEPTED) << ",";
-    json << "\"billsIn2\":0,";  // No METER_2_BILLS_ACCEPTED in SAS protocol
-    json << "\"billsIn5\":" << machine_->getMeter(sas::SASConstants::METER_5_BILLS_ACCEPTED) << ",";
-    json << "\"billsIn10\":" << machine_->getMeter(sas::SASConstants::METER_10_BILLS_ACCEPTED) << ",";
-    json << "\"billsIn20\":" << machine_->getMeter(sas::SASConstants::METER_20_BILLS_ACCEPTED) << ",";
-    json << "\"billsIn50\":" << machine_->getMeter(sas::SASConstants::METER_50_BILLS_ACCEPTED) << ",";
-    json << "\"billsIn100\":" << machine_->getMeter(sas::SASConstants::METER_100_BILLS_ACCEPTED) << ",";
-    json << "\"billsIn200\":0,";  // No METER_200_BILLS_ACCEPTED in SAS protocol
-    json << "\"billsIn500\":0,";  // No METER_500_BILLS_ACCEPTED in SAS protocol
-    json << "\"billsIn1000\":0,"; // No METER_1000_BILLS_ACCEPTED in SAS protocol
+    { "billsIn1", sas::SASConstants::METER_1_BILLS_ACCEPTED },
+    { "billsIn2", -1 },  // No METER_2_BILLS_ACCEPTED in SAS protocol
+    { "billsIn5", sas::SASConstants::METER_5_BILLS_ACCEPTED },
+    { "billsIn10", sas::SASConstants::METER_10_BILLS_ACCEPTED },
+    { "billsIn20", sas::SASConstants::METER_20_BILLS_ACCEPTED },
+    { "billsIn50", sas::SASConstants::METER_50_BILLS_ACCEPTED },
+    { "billsIn100", sas::SASConstants::METER_100_BILLS_ACCEPTED },
+    { "billsIn200", -1 },  // No METER_200_BILLS_ACCEPTED in SAS protocol
+    { "billsIn500", -1 },  // No METER_500_BILLS_ACCEPTED in SAS protocol
+    { "billsIn1000", -1 },  // No METER_1000_BILLS_ACCEPTED in SAS protocol
 
     // Machine meters - Credits and coins (use METER_* codes: SAS or extended)
-    json << "\"credits\":" << machine_->getMeter(sas::SASConstants::METER_CURRENT_CRD) << ",";
-    json << "\"trueCoinIn\":" << machine_->getMeter(sas::SASConstants::METER_TRUE_COIN_IN) << ",";
-    json << "\"trueCoinOut\":" << machine_->getMeter(sas::SASConstants::METER_TRUE_COIN_OUT) << ",";
-    json << "\"billDrop\":" << machine_->getMeter(sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR) << ",";
-    json << "\"totalHandPay\":" << machine_->getMeter(sas::SASConstants::METER_HANDPAID_CANCELLED_CRD) << ",";
-    json << "\"actualCoinDrop\":" << machine_->getMeter(sas::SASConstants::METER_ACTUAL_COIN_DROP) << ",";
-    json << "\"handPaidCancelledCredits\":" << machine_->getMeter(sas::SASConstants::METER_HANDPAID_CANCELLED_CRD) << ",";
-    json << "\"physicalCoinInValue\":" << machine_->getMeter(sas::SASConstants::METER_PHYS_COIN_IN_DOLLAR_VALUE) << ",";
-    json << "\"physicalCoinOutValue\":" << machine_->getMeter(sas::SASConstants::METER_PHYS_COIN_OUT_DOLLAR_VALUE) << ",";
-    json << "\"totalDrop\":" << machine_->getMeter(sas::SASConstants::METER_TOT_DROP) << ",";
-    json << "\"voucherTicketDrop\":" << machine_->getMeter(sas::SASConstants::METER_VOUCHER_TICKET_DROP) << ",";
-    json << "\"ncepCredits\":" << machine_->getMeter(sas::SASConstants::METER_NCEP_CREDITS) << ",";
+    { "credits", sas::SASConstants::METER_CURRENT_CRD },
+    { "trueCoinIn", sas::SASConstants::METER_TRUE_COIN_IN },
+    { "trueCoinOut", sas::SASConstants::METER_TRUE_COIN_OUT },
+    { "billDrop", sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR },
+    { "totalHandPay", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD },
+    { "actualCoinDrop", sas::SASConstants::METER_ACTUAL_COIN_DROP },
+    { "handPaidCancelledCredits", sas::SASConstants::METER_HANDPAID_CANCELLED_CRD },
+    { "physicalCoinInValue", sas::SASConstants::METER_PHYS_COIN_IN_DOLLAR_VALUE },
+    { "physicalCoinOutValue", sas::SASConstants::METER_PHYS_COIN_OUT_DOLLAR_VALUE },
+    { "totalDrop", sas::SASConstants::METER_TOT_DROP },
+    { "voucherTicketDrop", sas::SASConstants::METER_VOUCHER_TICKET_DROP },
+    { "ncepCredits", sas::SASConstants::METER_NCEP_CREDITS },
 
     // Machine meters - AFT (use SAS METER_* codes)
-    json << "\"aftCashableToGame\":" << machine_->getMeter(sas::SASConstants::METER_AFT_CASHABLE_IN) << ",";
-    json << "\"aftRestrictedToGame\":" << machine_->getMeter(sas::SASConstants::METER_AFT_REST_IN) << ",";
-    json << "\"aftNonRestrictedToGame\":" << machine_->getMeter(sas::SASConstants::METER_AFT_IN) << ",";
-    json << "\"aftCashableToHost\":" << machine_->getMeter(sas::SASConstants::METER_AFT_CASHABLE_OUT) << ",";
-    json << "\"aftRestrictedToHost\":" << machine_->getMeter(sas::SASConstants::METER_AFT_REST_OUT) << ",";
-    json << "\"aftNonRestrictedToHost\":" << machine_->getMeter(sas::SASConstants::METER_AFT_OUT) << ",";
-    json << "\"aftDebitToGame\":" << machine_->getMeter(sas::SASConstants::METER_AFT_DEBIT_XFER_TO_GAME_VALUE) << ",";
+    { "aftCashableToGame", sas::SASConstants::METER_AFT_CASHABLE_IN },
+    { "aftRestrictedToGame", sas::SASConstants::METER_AFT_REST_IN },
+    { "aftNonRestrictedToGame", sas::SASConstants::METER_AFT_IN },
+    { "aftCashableToHost", sas::SASConstants::METER_AFT_CASHABLE_OUT },
+    { "aftRestrictedToHost", sas::SASConstants::METER_AFT_REST_OUT },
+    { "aftNonRestrictedToHost", sas::SASConstants::METER_AFT_OUT },
+    { "aftDebitToGame", sas::SASConstants::METER_AFT_DEBIT_XFER_TO_GAME_VALUE },
 
     // Machine meters - Bonus and Progressive (use SAS METER_* codes)
-    json << "\"bonusMachinePayout\":" << machine_->getMeter(sas::SASConstants::METER_MACH_PAID_EXT_BONUS) << ",";
-    json << "\"bonusAttendantPayout\":" << machine_->getMeter(sas::SASConstants::METER_ATT_PAID_EXT_BONUS) << ",";
-    json << "\"progressiveAttendantPayout\":" << machine_->getMeter(sas::SASConstants::METER_ATT_PAID_PROG) << ",";
-    json << "\"progressiveMachinePayout\":" << machine_->getMeter(sas::SASConstants::METER_MACH_PAID_PROG) << ",";
+    { "bonusMachinePayout", sas::SASConstants::METER_MACH_PAID_EXT_BONUS },
+    { "bonusAttendantPayout", sas::SASConstants::METER_ATT_PAID_EXT_BONUS },
+    { "progressiveAttendantPayout", sas::SASConstants::METER_ATT_PAID_PROG },
+    { "progressiveMachinePayout", sas::SASConstants::METER_MACH_PAID_PROG },
 
     // Machine meters - Special (use SAS or extended METER_* codes)
-    json << "\"restrictedPlayed\":" << machine_->getMeter(sas::SASConstants::METER_TOTAL_REST_PLAYED) << ",";
-    json << "\"unrestrictedPlayed\":" << machine_->getMeter(sas::SASConstants::METER_TOTAL_NONREST_PLAYED) << ",";
-    json << "\"gameWeightedTheoretical\":" << machine_->getMeter(sas::SASConstants::METER_WTPP) << ",";
+    { "restrictedPlayed", sas::SASConstants::METER_TOTAL_REST_PLAYED },
+    { "unrestrictedPlayed", sas::SASConstants::METER_TOTAL_NONREST_PLAYED },
+    { "gameWeightedTheoretical", sas::SASConstants::METER_WTPP },
 
     // Game meters (base game - use SAS METER_* codes)
-    json << "\"coinIn\":" << machine_->getMeter(sas::SASConstants::METER_COIN_IN) << ",";
-    json << "\"coinOut\":" << machine_->getMeter(sas::SASConstants::METER_COIN_OUT) << ",";
-    json << "\"gamesPlayed\":" << machine_->getMeter(sas::SASConstants::METER_GAMES_PLAYED) << ",";
-    json << "\"gamesWon\":" << machine_->getMeter(sas::SASConstants::METER_GAMES_WON) << ",";
-    json << "\"maxCoinBet\":" << machine_->getMeter(sas::SASConstants::METER_MAX_COIN_BET) << ",";
-    json << "\"cancelledCredits\":" << machine_->getMeter(sas::SASConstants::METER_CANCELLED_CRD) << ",";
-    json << "\"bonusWon\":" << machine_->getMeter(sas::SASConstants::METER_BONUS_WON) << ",";
-    json << "\"jackpot\":" << machine_->getMeter(sas::SASConstants::METER_JACKPOT) << ",";
-    json << "\"progressiveCoinIn\":" << machine_->getMeter(sas::SASConstants::METER_PROGRESSIVE_COIN_IN);
-
-    json << "}";
-    json << "}";
+    { "coinIn", sas::SASConstants::METER_COIN_IN },
+    { "coinOut", sas::SASConstants::METER_COIN_OUT },
+    { "gamesPlayed", sas::SASConstants::METER_GAMES_PLAYED },
+    { "gamesWon", sas::SASConstants::METER_GAMES_WON },
+    { "maxCoinBet", sas::SASConstants::METER_MAX_COIN_BET },
+    { "cancelledCredits", sas::SASConstants::METER_CANCELLED_CRD },
+    { "bonusWon", sas::SASConstants::METER_BONUS_WON },
+    { "jackpot", sas::SASConstants::METER_JACKPOT },
+    { "progressiveCoinIn", sas::SASConstants::METER_PROGRESSIVE_COIN_IN }
+};
+
+static const size_t MAIN_METER_KEY_COUNT = sizeof(MAIN_METER_KEYS) / sizeof(MAIN_METER_KEYS[0]);
+
+// Read every MAIN_METER_KEYS meter as one snapshot, so a response never
+// mixes before/after values of a game
+static void readMainMeters(simulator::Machine* machine, int64_t* values) {
+    int meterCodes[MAIN_METER_KEY_COUNT];
+    for (size_t i = 0; i < MAIN_METER_KEY_COUNT; i++) {
+        meterCodes[i] = MAIN_METER_KEYS[i].meterCode;
+    }
+    machine->getMeters(meterCodes, MAIN_METER_KEY_COUNT, values);
+}
+
+// "meters" event carrying every MAIN_METER_KEYS value
+static void writeAllMeters(std::ostream& events, const int64_t* values) {
+    events << "event: meters\ndata: {";
+    for (size_t i = 0; i < MAIN_METER_KEY_COUNT; i++) {
+        if (i > 0) events << ",";
+        events << "\"" << MAIN_METER_KEYS[i].key << "\":" << values[i];
+    }
+    events << "}\n\n";
+}
 
+HTTPServer::HTTPResponse HTTPServer::handleGET_Meters(simulator::Machine* machine, const HTTPRequest& req) {
+    // Version first: a write racing the render leaves the cache stale, not wrong
+    uint64_t version = machine->getMetersVersion();
+
+    std::lock_guard<std::mutex> lock(metersCacheMutex_);
+    MetersCache& cache = metersCache_[machine];
+    if (!cache.valid || cache.version != version) {
+        // Return live METER_* values ONLY (never use mD*/gCI* persistence codes in runtime)
+        int64_t meterValues[MAIN_METER_KEY_COUNT];
+        readMainMeters(machine, meterValues);
+
+        metersBuffer_.Clear();
+        rapidjson::Writer<rapidjson::StringBuffer> writer(metersBuffer_);
+        writer.StartObject();
+        writer.Key("mainMeters");
+        writer.StartObject();
+        for (size_t i = 0; i < MAIN_METER_KEY_COUNT; i++) {
+            writer.Key(MAIN_METER_KEYS[i].key);
+            writer.Int64(meterValues[i]);
+        }
+        writer.EndObject();
+        writer.EndObject();
+
+        cache.valid = true;
+        cache.version = version;
+        cache.body.assign(metersBuffer_.GetString(), metersBuffer_.GetSize());
+        cache.etag = "\"" + etagPrefix_ + std::to_string(version) + "\"";
+    }
+
+    auto match = req.headers.find("if-none-match");
+    if (match != req.headers.end() && match->second == cache.etag) {
+        HTTPResponse response = buildResponse(304, "application/json", "");
+        response.etag = cache.etag;
+        return response;
+    }
+
+    HTTPResponse response = buildResponse(200, "application/json", cache.body);
+    response.etag = cache.etag;
+    return response;
+}
+
+HTTPServer::HTTPResponse HTTPServer::handleGET_Events(simulator::Machine* machine) {
+    // Version first: a write racing the snapshot then shows up as a change
+    uint64_t version = machine->getMetersVersion();
+    std::vector<int64_t> values(MAIN_METER_KEY_COUNT);
+    readMainMeters(machine, values.data());
+
+    std::ostringstream events;
+    writeAllMeters(events, values.data());
+
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        StreamState& state = streamStates_[machine];
+        if (!state.primed) {
+            state.primed = true;
+            state.version = version;
+            state.meters.swap(values);
+        }
+    }
+
+    HTTPResponse response = buildResponse(200, "text/event-stream", events.str());
+    response.stream = machine;
+    response.streamVersion = version;
+    return response;
+}
+
+HTTPServer::StreamPayload HTTPServer::buildStreamEvents(simulator::Machine* machine, bool full) {
+    StreamPayload payload;
+    payload.version = machine->getMetersVersion();
+    std::vector<uint8_t> exceptions;
+    bool metersChanged;
+    {
+        std::lock_guard<std::mutex> lock(streamMutex_);
+        StreamState& state = streamStates_[machine];
+        metersChanged = !state.primed || state.version != payload.version;
+        exceptions.swap(state.exceptions);
+    }
+
+    std::ostringstream events;
+    std::ostringstream fullEvents;
+    if (metersChanged || full) {
+        std::vector<int64_t> values(MAIN_METER_KEY_COUNT);
+        readMainMeters(machine, values.data());
+        if (full) {
+            writeAllMeters(fullEvents, values.data());
+        }
+
+        // Only keys that differ from the last push: valid for the streams
+        // that received it, not for ones opened since
+        std::ostringstream data;
+        if (metersChanged) {
+            std::lock_guard<std::mutex> lock(streamMutex_);
+            StreamState& state = streamStates_[machine];
+            bool first = true;
+            for (size_t i = 0; i < MAIN_METER_KEY_COUNT; i++) {
+                if (state.primed && state.meters[i] == values[i]) {
+                    continue;
+                }
+                if (!first) data << ",";
+                data << "\"" << MAIN_METER_KEYS[i].key << "\":" << values[i];
+                first = false;
+            }
+            state.primed = true;
+            state.version = payload.version;
+            state.meters.swap(values);
+        }
+
+        std::string changed = data.str();
+        if (!changed.empty()) {
+            events << "event: meters\ndata: {" << changed << "}\n\n";
+        }
+    }
+
+    for (uint8_t code : exceptions) {
+        events << "event: exception\ndata: {\"code\":" << (int)code << "}\n\n";
+        fullEvents << "event: exception\ndata: {\"code\":" << (int)code << "}\n\n";
+    }
+
+    payload.delta = events.str();
+    payload.full = fullEvents.str();
+    return payload;
+}
+
+std::string HTTPServer::handleGET_Metrics() {
+    std::vector<sas::CommandMetrics::Source> sources;
+    std::vector<std::pair<uint8_t, sas::SASCommPort::Statistics>> portStats;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        for (const auto& entry : sasPorts_) {
+            sas::CommandMetrics::Source source;
+            source.address = entry.first;
+            source.metrics = &entry.second->getCommandMetrics();
+            sources.push_back(source);
+            portStats.push_back(std::make_pair(entry.first, entry.second->getStatistics()));
+        }
+    }
+
+    // Framing errors have no command to count them under
+    std::ostringstream text;
+    text << "# HELP sas_framing_errors_total Received bytes skipped to resynchronize on a poll\n"
+         << "# TYPE sas_framing_errors_total counter\n";
+    for (const auto& entry : portStats) {
+        text << "sas_framing_errors_total{address=\"" << static_cast<int>(entry.first) << "\"} "
+             << entry.second.framingErrors << "\n";
+    }
+    sas::CommandMetrics::writePrometheus(sources, text);
+    return text.str();
+}
+
+std::string HTTPServer::handleGET_Trace() {
+    std::ostringstream json;
+    utils::Trace::writeChromeTrace(json);
+    return json.str();
+}
+
+std::string HTTPServer::handleGET_Logging() {
+    std::ostringstream json;
+    json << "{\"categories\":{";
+    for (size_t i = 0; i < static_cast<size_t>(utils::LogCategory::COUNT); i++) {
+        utils::LogCategory category = static_cast<utils::LogCategory>(i);
+        if (i > 0) json << ",";
+        json << "\"" << utils::Logger::getCategoryName(category) << "\":\""
+             << utils::Logger::getLevelName(utils::Logger::getCategoryLevel(category)) << "\"";
+    }
+    json << "},"
+         << "\"buildMinLevel\":\"" << utils::Logger::getLevelName(EGM_LOG_MIN_LEVEL) << "\","
+         << "\"dropped\":" << utils::Logger::getDroppedCount()
+         << "}";
     return json.str();
 }
 
-std::string HTTPServer::handlePOST_Play(const std::string& body) {
+std::string HTTPServer::handlePOST_Logging(const std::string& body) {
+    // Body: {"category":"SAS","level":"DEBUG"}
+    std::string category = jsonStringValue(body, "category");
+    std::string level = jsonStringValue(body, "level");
+
+    if (!utils::Logger::setCategoryLevel(category, level)) {
+        return "{\"success\":false,\"error\":\"Invalid category or level\"}";
+    }
+
+    return "{\"success\":true,\"category\":\"" + jsonEscape(category) +
+           "\",\"level\":\"" + jsonEscape(level) + "\"}";
+}
+
+std::string HTTPServer::handlePOST_Trace(const std::string& body) {
+    // Body: {"action":"start"} (also "stop", "clear")
+    std::string action = jsonStringValue(body, "action");
+
+    if (EGM_TRACE == 0) {
+        return "{\"success\":false,\"error\":\"Tracing compiled out (EGM_TRACE=0)\"}";
+    }
+    if (action == "start") {
+        utils::Trace::setEnabled(true);
+    } else if (action == "stop") {
+        utils::Trace::setEnabled(false);
+    } else if (action == "clear") {
+        utils::Trace::clear();
+    } else {
+        return "{\"success\":false,\"error\":\"Invalid action\"}";
+    }
+
+    LOG(CONFIG, INFO, "[HTTP] Trace " << action);
+    return std::string("{\"success\":true,\"enabled\":") +
+           (utils::Trace::isEnabled() ? "true" : "false") + "}";
+}
+
+std::string HTTPServer::handlePOST_Play(simulator::Machine* machine, const std::string& body) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
     // Play the game (deducts bet and updates COIN_IN meter)
-    int64_t playResult = machine_->playGameCredit();
+    int64_t playResult = machine->playGameCredit();
 
     if (playResult == 0) {
         // Insufficient credits
         std::ostringstream json;
         json << "{"
-             << "\"credits\":" << (machine_->getCredits() / 100.0) << ","
+             << "\"credits\":" << machine->getCashableAmount() << ","
              << "\"winAmount\":0.00,"
              << "\"success\":false,"
              << "\"error\":\"Insufficient credits\""
@@ -445,68 +1304,71 @@ std::string HTTPServer::handlePOST_Play(const std::string& body) {
         return json.str();
     }
 
+    // Game start/end go to SAS hosts as real-time events 0x7E/0x7F
+    auto game = machine->getCurrentGame();
+    simulator::Cents betAmount = game ? game->getDenom() : simulator::Cents(1);
+    machine->publishGameStarted(1, betAmount);
+
     // Simulate game outcome (60% lose, 40% win)
     // Win amounts range from 2x to 10x the bet
-    int64_t winAmount = 0;
+    simulator::Cents winAmount;
     int outcome = rand() % 100;
 
     if (outcome < 40) {  // 40% chance to win
         // Win between 2x and 10x the bet
-        auto game = machine_->getCurrentGame();
-        double betAmount = game ? game->getDenom() : 0.01;
         int multiplier = 2 + (rand() % 9);  // 2x to 10x
-        double winDollars = betAmount * multiplier;
+        winAmount = betAmount * multiplier;
 
         // Add winnings using addCoinOut() - this updates both credits and COIN_OUT meter
-        machine_->addCoinOut(winDollars);
-        winAmount = static_cast<int64_t>(winDollars * 100);  // Convert to cents for display
+        machine->addCoinOut(winAmount);
 
-        machine_->GameWon();
+        machine->GameWon();
     } else {
         // Lost - no winnings
-        machine_->GameLost();
+        machine->GameLost();
     }
+    machine->publishGameEnded(machine->toAccountingDenom(winAmount));
 
     std::ostringstream json;
     json << "{"
-         << "\"credits\":" << (machine_->getCredits() / 100.0) << ","
-         << "\"winAmount\":" << (winAmount / 100.0) << ","
+         << "\"credits\":" << machine->getCashableAmount() << ","
+         << "\"winAmount\":" << winAmount << ","
          << "\"success\":true"
          << "}";
     return json.str();
 }
 
-std::string HTTPServer::handlePOST_Cashout(const std::string& body) {
+std::string HTTPServer::handlePOST_Cashout(simulator::Machine* machine, const std::string& body) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-    int64_t amount = machine_->getCredits();
-    machine_->cashoutButton();  // Use machine's cashout method
+    simulator::Cents amount = machine->getCashableAmount();
+    machine->cashoutButton();  // Use machine's cashout method
 
     std::ostringstream json;
     json << "{"
-         << "\"amount\":" << (amount / 100.0) << ","
-         << "\"credits\":" << (machine_->getCredits() / 100.0) << ","
+         << "\"amount\":" << amount << ","
+         << "\"credits\":" << machine->getCashableAmount() << ","
          << "\"success\":true"
          << "}";
     return json.str();
 }
 
-std::string HTTPServer::handlePOST_Denom(const std::string& body) {
+std::string HTTPServer::handlePOST_Denom(simulator::Machine* machine, const std::string& body) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
     // Parse JSON body for denom value
     // Simple parsing: look for "denom":value
     size_t pos = body.find("\"denom\":");
     if (pos != std::string::npos) {
-        double denom = std::stod(body.substr(pos + 8));
+        simulator::Cents denom = simulator::Cents::fromDollars(std::stod(body.substr(pos + 8)));
         // Try to switch to a game with this denomination
-        machine_->setCurrentGame(1, denom);  // Game number 1
+        machine->setCurrentGame(1, denom);  // Game number 1
     }
 
-    auto game = machine_->getCurrentGame();
+    auto game = machine->getCurrentGame();
     std::ostringstream json;
     json << "{"
-         << "\"denom\":" << (game ? game->getDenom() : 0.01) << ","
+         << "\"denom\":" << (game ? game->getDenom() : simulator::Cents(1)) << ","
          << "\"success\":true"
          << "}";
     return json.str();
@@ -524,49 +1386,21 @@ std::string HTTPServer::handlePOST_Exception(const std::string& body) {
     return "{\"success\":true}";
 }
 
-std::string HTTPServer::handlePOST_BillInsert(const std::string& body) {
+std::string HTTPServer::handlePOST_BillInsert(simulator::Machine* machine, const std::string& body) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
     // Parse amount
     size_t pos = body.find("\"amount\":");
     if (pos != std::string::npos) {
-        double amount = std::stod(body.substr(pos + 9));
-
-        // Add credits from bill
-        machine_->addCredits(amount);
-
-        // Update bill acceptor meters based on denomination
-        // Use METER_* live runtime codes for runtime operations
-        int billValue = static_cast<int>(amount);
-        switch (billValue) {
-            case 1:
-                machine_->incrementMeter(sas::SASConstants::METER_1_BILLS_ACCEPTED, 1);
-                break;
-            case 5:
-                machine_->incrementMeter(sas::SASConstants::METER_5_BILLS_ACCEPTED, 1);
-                break;
-            case 10:
-                machine_->incrementMeter(sas::SASConstants::METER_10_BILLS_ACCEPTED, 1);
-                break;
-            case 20:
-                machine_->incrementMeter(sas::SASConstants::METER_20_BILLS_ACCEPTED, 1);
-                break;
-            case 50:
-                machine_->incrementMeter(sas::SASConstants::METER_50_BILLS_ACCEPTED, 1);
-                break;
-            case 100:
-                machine_->incrementMeter(sas::SASConstants::METER_100_BILLS_ACCEPTED, 1);
-                break;
-        }
+        simulator::Cents amount = simulator::Cents::fromDollars(std::stod(body.substr(pos + 9)));
 
-        // Update credits from bill acceptor meter
-        int64_t creditAmount = static_cast<int64_t>(amount / machine_->getAccountingDenom());
-        machine_->incrementMeter(sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR, creditAmount);
+        // Credits, bill meters and the bill accepted event (SAS exception 0x4F)
+        machine->billAccepted(amount);
     }
 
     std::ostringstream json;
     json << "{"
-         << "\"credits\":" << (machine_->getCredits() / 100.0) << ","
+         << "\"credits\":" << machine->getCashableAmount() << ","
          << "\"success\":true"
          << "}";
     return json.str();
@@ -577,7 +1411,12 @@ std::string HTTPServer::handlePOST_Reboot(const std::string& body) {
 
     // Save meters before reboot
     std::cout << "[HTTP] Reboot requested - saving meters..." << std::endl;
-    config::MeterPersistence::saveMeters(machine_);
+    if (machines_.empty()) {
+        config::MeterPersistence::saveMeters(machine_);
+    }
+    for (const auto& entry : machines_) {
+        config::MeterPersistence::saveMeters(entry.second, entry.first);
+    }
 
     // Return success response
     std::ostringstream json;
@@ -602,7 +1441,7 @@ std::string HTTPServer::handlePOST_Reboot(const std::string& body) {
     return json.str();
 }
 
-std::string HTTPServer::handleStaticFile(const std::string& path) {
+HTTPServer::HTTPResponse HTTPServer::handleStaticFile(const std::string& path) {
     std::string filePath = "/opt/ncompass/media";
 
     if (path == "/" || path == "/index.html") {
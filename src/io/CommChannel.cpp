@@ -1,10 +1,23 @@
 #include "io/CommChannel.h"
 #include <algorithm>
-#include <thread>
 
 
 namespace io {
 
+int CommChannel::receive(ByteRing& ring, std::chrono::milliseconds timeout) {
+    size_t contiguous = 0;
+    uint8_t* out = ring.writePtr(contiguous);
+    if (contiguous == 0) {
+        return 0;  // Ring full - caller must consume first
+    }
+
+    int bytesRead = read(out, static_cast<int>(contiguous), timeout);
+    if (bytesRead > 0) {
+        ring.commitWrite(static_cast<size_t>(bytesRead));
+    }
+    return bytesRead;
+}
+
 PipedCommChannel::PipedCommChannel(const std::string& name)
     : name_(name),
       isOpen_(false),
@@ -22,6 +35,7 @@ bool PipedCommChannel::open() {
 
 void PipedCommChannel::close() {
     isOpen_ = false;
+    std::lock_guard<std::mutex> lock(inputMutex_);
     inputBuffer_.clear();
 }
 
@@ -35,16 +49,10 @@ int PipedCommChannel::read(uint8_t* buffer, int maxBytes,
         return -1;
     }
 
-    auto start = std::chrono::steady_clock::now();
-    while (inputBuffer_.empty()) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
-
-        if (elapsed >= timeout) {
-            return 0;  // Timeout
-        }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // Wait for the peer's write() instead of polling
+    std::unique_lock<std::mutex> lock(inputMutex_);
+    if (!inputReady_.wait_for(lock, timeout, [this] { return !inputBuffer_.empty(); })) {
+        return 0;  // Timeout
     }
 
     int bytesToRead = std::min(static_cast<int>(inputBuffer_.size()), maxBytes);
@@ -54,6 +62,23 @@ int PipedCommChannel::read(uint8_t* buffer, int maxBytes,
     return bytesToRead;
 }
 
+int PipedCommChannel::receive(ByteRing& ring, std::chrono::milliseconds timeout) {
+    if (!isOpen_) {
+        return -1;
+    }
+
+    std::unique_lock<std::mutex> lock(inputMutex_);
+    if (!inputReady_.wait_for(lock, timeout, [this] { return !inputBuffer_.empty(); })) {
+        return 0;  // Timeout
+    }
+
+    // Drain everything queued so far in one call
+    size_t pushed = ring.push(inputBuffer_.data(), inputBuffer_.size());
+    inputBuffer_.erase(inputBuffer_.begin(), inputBuffer_.begin() + pushed);
+
+    return static_cast<int>(pushed);
+}
+
 int PipedCommChannel::write(const uint8_t* buffer, int numBytes) {
     if (!isOpen_) {
         return -1;
@@ -61,11 +86,15 @@ int PipedCommChannel::write(const uint8_t* buffer, int numBytes) {
 
     // If connected to another channel, write to its input buffer
     if (connectedChannel_) {
-        connectedChannel_->inputBuffer_.insert(
-            connectedChannel_->inputBuffer_.end(),
-            buffer,
-            buffer + numBytes
-        );
+        {
+            std::lock_guard<std::mutex> lock(connectedChannel_->inputMutex_);
+            connectedChannel_->inputBuffer_.insert(
+                connectedChannel_->inputBuffer_.end(),
+                buffer,
+                buffer + numBytes
+            );
+        }
+        connectedChannel_->inputReady_.notify_one();
     }
 
     return numBytes;
@@ -1,5 +1,7 @@
 #include "io/MachineCommPort.h"
-#include <chrono>
+#include "simulator/Machine.h"
+#include "simulator/MachineEvents.h"
+#include "utils/Logger.h"
 
 
 namespace io {
@@ -11,28 +13,25 @@ MachineCommPort::MachineCommPort(simulator::Machine* machine, std::shared_ptr<Co
 MachineCommPort::~MachineCommPort() {
 }
 
-void MachineCommPort::queueException(uint8_t exceptionCode) {
-    std::lock_guard<std::recursive_mutex> lock(exceptionMutex_);
-    exceptionQueue_.push(Exception(exceptionCode, getCurrentTimestamp()));
-    exceptionCondition_.notify_one();
-}
+void MachineCommPort::queueException(uint8_t exceptionCode, const uint8_t* data, size_t length) {
+    if (exceptions_.push(exceptionCode, data, length) == ExceptionQueue::OVERFLOWED) {
+        LOG(SAS, WARN, "[SAS] Exception queue full, dropped exception 0x" << std::hex
+            << static_cast<int>(exceptionCode) << std::dec << " (" << exceptions_.getStatistics().overflows
+            << " dropped so far)");
+    }
 
-void MachineCommPort::clearExceptions() {
-    std::lock_guard<std::recursive_mutex> lock(exceptionMutex_);
-    while (!exceptionQueue_.empty()) {
-        exceptionQueue_.pop();
+    // Let observers (e.g. the HTTP event stream) see every occurrence
+    if (machine_ && machine_->getEventService()) {
+        machine_->getEventService()->publish(simulator::ExceptionQueuedEvent(machine_, exceptionCode));
     }
 }
 
-bool MachineCommPort::hasExceptions() const {
-    std::lock_guard<std::recursive_mutex> lock(exceptionMutex_);
-    return !exceptionQueue_.empty();
+void MachineCommPort::clearExceptions() {
+    exceptions_.clear();
 }
 
-uint64_t MachineCommPort::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+bool MachineCommPort::hasExceptions() const {
+    return !exceptions_.empty();
 }
 
 } // namespace io
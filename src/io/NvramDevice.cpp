@@ -0,0 +1,85 @@
+#include "io/NvramDevice.h"
+#include "utils/Logger.h"
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace io {
+
+FileNvramDevice::FileNvramDevice(const std::string& path, size_t size)
+    : path_(path),
+      size_(size),
+      data_(nullptr) {
+}
+
+FileNvramDevice::~FileNvramDevice() {
+    if (data_) {
+        munmap(data_, size_);
+    }
+}
+
+bool FileNvramDevice::open() {
+    if (data_) {
+        return true;
+    }
+
+    int fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG(METERS, ERROR, "[NVRAM] ERROR: Could not open " << path_ << ": " << strerror(errno));
+        return false;
+    }
+
+    // Grow (never shrink) so a smaller configuration keeps existing banks
+    struct stat info;
+    if (fstat(fd, &info) != 0
+        || (static_cast<size_t>(info.st_size) < size_ && ftruncate(fd, static_cast<off_t>(size_)) != 0)) {
+        LOG(METERS, ERROR, "[NVRAM] ERROR: Could not size " << path_ << ": " << strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        LOG(METERS, ERROR, "[NVRAM] ERROR: Could not map " << path_ << ": " << strerror(errno));
+        return false;
+    }
+
+    data_ = static_cast<uint8_t*>(data);
+    return true;
+}
+
+bool FileNvramDevice::read(size_t offset, uint8_t* buffer, size_t length) {
+    if (!data_ || offset + length > size_) {
+        return false;
+    }
+    memcpy(buffer, data_ + offset, length);
+    return true;
+}
+
+bool FileNvramDevice::write(const Block* blocks, size_t count) {
+    if (!data_) {
+        return false;
+    }
+
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < count; i++) {
+        const Block& block = blocks[i];
+        if (block.offset + block.length > size_) {
+            return false;
+        }
+        memcpy(data_ + block.offset, block.data, block.length);
+
+        size_t start = block.offset & ~(pageSize - 1);
+        if (msync(data_ + start, block.offset + block.length - start, MS_SYNC) != 0) {
+            LOG(METERS, ERROR, "[NVRAM] ERROR: msync failed on " << path_ << ": " << strerror(errno));
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace io
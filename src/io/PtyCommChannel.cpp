@@ -0,0 +1,246 @@
+#include "io/PtyCommChannel.h"
+#include "utils/Logger.h"
+#include "utils/Trace.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+
+namespace io {
+
+PtyCommChannel::PtyCommChannel(const std::string& name)
+    : name_(name),
+      masterFd_(-1),
+      slaveFd_(-1) {
+}
+
+PtyCommChannel::PtyCommChannel(const std::string& name, const std::string& devicePath)
+    : name_(name),
+      devicePath_(devicePath),
+      masterFd_(-1),
+      slaveFd_(-1) {
+}
+
+PtyCommChannel::~PtyCommChannel() {
+    close();
+}
+
+bool PtyCommChannel::open() {
+    if (masterFd_ >= 0) {
+        return true;
+    }
+
+    if (!devicePath_.empty()) {
+        return openDevice();
+    }
+
+    masterFd_ = posix_openpt(O_RDWR | O_NOCTTY);
+    if (masterFd_ < 0) {
+        LOG(UART, ERROR, "[PTY] posix_openpt failed: " << strerror(errno));
+        return false;
+    }
+
+    if (grantpt(masterFd_) != 0 || unlockpt(masterFd_) != 0) {
+        LOG(UART, ERROR, "[PTY] grantpt/unlockpt failed: " << strerror(errno));
+        close();
+        return false;
+    }
+
+    char slavePath[128];
+    if (ptsname_r(masterFd_, slavePath, sizeof(slavePath)) != 0) {
+        LOG(UART, ERROR, "[PTY] ptsname_r failed: " << strerror(errno));
+        close();
+        return false;
+    }
+    slaveName_ = slavePath;
+
+    // Keep our own handle on the slave so poll() does not report POLLHUP
+    // while no client is attached
+    slaveFd_ = ::open(slavePath, O_RDWR | O_NOCTTY);
+    if (slaveFd_ < 0) {
+        LOG(UART, ERROR, "[PTY] Cannot open " << slaveName_ << ": " << strerror(errno));
+        close();
+        return false;
+    }
+
+    // Raw 8-bit line, no echo or line editing (shared by both sides of the pty)
+    struct termios tio;
+    if (tcgetattr(slaveFd_, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(slaveFd_, TCSANOW, &tio);
+    }
+
+    // Non-blocking master: waits happen in poll(), reads just drain
+    int flags = fcntl(masterFd_, F_GETFL, 0);
+    fcntl(masterFd_, F_SETFL, flags | O_NONBLOCK);
+
+    LOG(UART, INFO, "[PTY] " << name_ << " ready - connect SAS master to " << slaveName_);
+    return true;
+}
+
+bool PtyCommChannel::openDevice() {
+    masterFd_ = ::open(devicePath_.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (masterFd_ < 0) {
+        LOG(UART, ERROR, "[PTY] Cannot open " << devicePath_ << ": " << strerror(errno));
+        return false;
+    }
+    slaveName_ = devicePath_;
+
+    struct termios tio;
+    if (tcgetattr(masterFd_, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(masterFd_, TCSANOW, &tio);
+    }
+
+    LOG(UART, INFO, "[PTY] " << name_ << " connected to " << devicePath_);
+    return true;
+}
+
+void PtyCommChannel::close() {
+    if (slaveFd_ >= 0) {
+        ::close(slaveFd_);
+        slaveFd_ = -1;
+    }
+    if (masterFd_ >= 0) {
+        ::close(masterFd_);
+        masterFd_ = -1;
+    }
+}
+
+bool PtyCommChannel::isOpen() const {
+    return masterFd_ >= 0;
+}
+
+int PtyCommChannel::waitReadable(std::chrono::milliseconds timeout) {
+    struct pollfd pfd;
+    pfd.fd = masterFd_;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int result;
+    do {
+        result = poll(&pfd, 1, static_cast<int>(timeout.count()));
+    } while (result < 0 && errno == EINTR);
+
+    if (result < 0) {
+        LOG(UART, ERROR, "[PTY] poll failed: " << strerror(errno));
+        return -1;
+    }
+    if (result == 0) {
+        return 0;  // Timeout
+    }
+    return (pfd.revents & POLLIN) ? 1 : -1;
+}
+
+int PtyCommChannel::read(uint8_t* buffer, int maxBytes,
+                         std::chrono::milliseconds timeout) {
+    if (masterFd_ < 0 || !buffer || maxBytes <= 0) {
+        return -1;
+    }
+
+    int ready = waitReadable(timeout);
+    if (ready <= 0) {
+        return ready;
+    }
+
+    ssize_t n = ::read(masterFd_, buffer, static_cast<size_t>(maxBytes));
+    if (n < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+    if (n > 0) {
+        TRACE_INSTANT("uart.rx", static_cast<uint32_t>(n));
+    }
+    return static_cast<int>(n);
+}
+
+int PtyCommChannel::receive(ByteRing& ring, std::chrono::milliseconds timeout) {
+    if (masterFd_ < 0) {
+        return -1;
+    }
+
+    if (ring.full()) {
+        return 0;
+    }
+
+    int ready = waitReadable(timeout);
+    if (ready <= 0) {
+        return ready;
+    }
+
+    // Drain everything the kernel has buffered, straight into the ring
+    int total = 0;
+    while (!ring.full()) {
+        size_t contiguous = 0;
+        uint8_t* out = ring.writePtr(contiguous);
+        ssize_t n = ::read(masterFd_, out, contiguous);
+        if (n > 0) {
+            ring.commitWrite(static_cast<size_t>(n));
+            total += static_cast<int>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        break;  // EAGAIN (drained) or error
+    }
+
+    if (total > 0) {
+        TRACE_INSTANT("uart.rx", static_cast<uint32_t>(total));
+    }
+    LOG(UART, TRACE, "[PTY RX] Drained " << total << " bytes, ring now " << ring.size());
+    return total;
+}
+
+int PtyCommChannel::write(const uint8_t* buffer, int numBytes) {
+    if (masterFd_ < 0 || !buffer || numBytes <= 0) {
+        return -1;
+    }
+
+    TRACE_SPAN_ARG("uart.write", static_cast<uint32_t>(numBytes));
+
+    int written = 0;
+    while (written < numBytes) {
+        ssize_t n = ::write(masterFd_, buffer + written, static_cast<size_t>(numBytes - written));
+        if (n > 0) {
+            written += static_cast<int>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Output buffer full - wait for the master to read
+            struct pollfd pfd;
+            pfd.fd = masterFd_;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, 100) > 0) {
+                continue;
+            }
+        }
+        LOG(UART, ERROR, "[PTY] write failed after " << written << " of " << numBytes << " bytes");
+        return -1;
+    }
+
+    return written;
+}
+
+void PtyCommChannel::flush() {
+    if (masterFd_ >= 0) {
+        tcdrain(masterFd_);
+    }
+}
+
+std::string PtyCommChannel::getName() const {
+    return name_ + " (pty " + slaveName_ + ")";
+}
+
+std::string PtyCommChannel::getSlaveName() const {
+    return slaveName_;
+}
+
+} // namespace io
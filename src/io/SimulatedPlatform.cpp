@@ -1,5 +1,5 @@
 #include "ICardPlatform.h"
-#include "io/CommChannel.h"
+#include "io/PtyCommChannel.h"
 #include <sstream>
 
 
@@ -11,7 +11,7 @@ SimulatedPlatform::SimulatedPlatform()
 std::shared_ptr<io::CommChannel> SimulatedPlatform::createSASPort() {
     std::ostringstream oss;
     oss << "SAS_PORT_" << portCounter_++;
-    return std::make_shared<io::PipedCommChannel>(oss.str());
+    return std::make_shared<io::PtyCommChannel>(oss.str());
 }
 
 void SimulatedPlatform::setLED(int ledId, bool state) {
@@ -2,6 +2,7 @@
 #include "io/SASSerialPort.h"
 #include <cstring>
 #include <sstream>
+#include <vector>
 
 // Include Zeus OS / Axiomtek S7Lite API header
 #ifdef ZEUS_OS
@@ -71,6 +72,9 @@ inline S7_Result S7LITE_RemoteLCD_SetBacklightPWM(UINT brightness) {
 
 
 
+static_assert(ZeusPlatform::SRAM_WRITE_BLOCKS == SRAM_ACCESS_BOLCKS, "S7LITE_SRAMACCESS block count");
+constexpr size_t ZeusPlatform::SRAM_WRITE_BLOCKS;
+
 ZeusPlatform::ZeusPlatform(bool enableWatchdog, uint32_t watchdogTimeout)
     : initialized_(false),
       watchdogEnabled_(enableWatchdog),
@@ -234,31 +238,53 @@ bool ZeusPlatform::readSRAM(uint32_t offset, uint8_t* buffer, uint32_t length) {
 }
 
 bool ZeusPlatform::writeSRAM(uint32_t offset, const uint8_t* buffer, uint32_t length) {
-    if (!initialized_ || buffer == nullptr || length == 0) {
+    if (buffer == nullptr || length == 0) {
         return false;
     }
 
-    // Check bounds
-    if ((offset + length) * sizeof(USHORT) > sramSize_) {
+    SRAMBlock block = {offset, buffer, length};
+    return writeSRAMBlocks(&block, 1);
+}
+
+bool ZeusPlatform::writeSRAMBlocks(const SRAMBlock* blocks, size_t count) {
+    if (!initialized_ || blocks == nullptr) {
         return false;
     }
 
-    // Zeus API requires non-const buffer pointer
-    uint8_t* nonConstBuffer = const_cast<uint8_t*>(buffer);
-
-    // Prepare S7Lite SRAM access structure
-    S7LITE_SRAMACCESS access;
-    memset(&access, 0, sizeof(access));
-
-    // Fill first block (Zeus API supports up to 4 blocks)
-    access.block[0].buffer = nonConstBuffer;
-    access.block[0].offset = offset;  // In WORD units
-    access.block[0].length = length;  // In WORD units
+    // Check bounds
+    for (size_t i = 0; i < count; i++) {
+        if (blocks[i].buffer == nullptr
+            || (static_cast<uint64_t>(blocks[i].offset) + blocks[i].length) * sizeof(USHORT) > sramSize_) {
+            return false;
+        }
+    }
 
-    // Call Zeus API
-    S7_Result result = S7LITE_SRAM_Write(access, nullptr, nullptr);
+    for (size_t first = 0; first < count; first += SRAM_WRITE_BLOCKS) {
+        // Prepare S7Lite SRAM access structure (unused blocks stay zero-length)
+        S7LITE_SRAMACCESS access;
+        memset(&access, 0, sizeof(access));
+
+        size_t used = 0;
+        for (size_t i = first; i < count && used < SRAM_WRITE_BLOCKS; i++) {
+            if (blocks[i].length == 0) {
+                continue;
+            }
+            // Zeus API requires non-const buffer pointer
+            access.block[used].buffer = const_cast<uint8_t*>(blocks[i].buffer);
+            access.block[used].offset = blocks[i].offset;  // In WORD units
+            access.block[used].length = blocks[i].length;  // In WORD units
+            used++;
+        }
+        if (used == 0) {
+            continue;
+        }
 
-    return (result == S7DLL_STATUS_OK);
+        // Call Zeus API
+        if (S7LITE_SRAM_Write(access, nullptr, nullptr) != S7DLL_STATUS_OK) {
+            return false;
+        }
+    }
+    return true;
 }
 
 std::string ZeusPlatform::getFirmwareVersion() const {
@@ -366,4 +392,30 @@ bool ZeusPlatform::querySRAMSize() {
     return true;
 }
 
+ZeusNvramDevice::ZeusNvramDevice(std::shared_ptr<ZeusPlatform> platform)
+    : platform_(platform) {
+}
+
+size_t ZeusNvramDevice::getSize() const {
+    return platform_->getSRAMSize();
+}
+
+bool ZeusNvramDevice::read(size_t offset, uint8_t* buffer, size_t length) {
+    if ((offset | length) & 1) {
+        return false;  // SRAM is word addressed
+    }
+    return platform_->readSRAM(static_cast<uint32_t>(offset / 2), buffer, static_cast<uint32_t>(length / 2));
+}
 
+bool ZeusNvramDevice::write(const Block* blocks, size_t count) {
+    std::vector<ZeusPlatform::SRAMBlock> words(count);
+    for (size_t i = 0; i < count; i++) {
+        if ((blocks[i].offset | blocks[i].length) & 1) {
+            return false;
+        }
+        words[i].offset = static_cast<uint32_t>(blocks[i].offset / 2);
+        words[i].buffer = blocks[i].data;
+        words[i].length = static_cast<uint32_t>(blocks[i].length / 2);
+    }
+    return platform_->writeSRAMBlocks(words.data(), words.size());
+}
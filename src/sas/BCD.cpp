@@ -4,6 +4,43 @@
 
 namespace sas {
 
+constexpr size_t BCD::MAX_VALUE_BYTES;
+constexpr uint64_t BCD::MAX_VALUES[BCD::MAX_VALUE_BYTES];
+
+const uint8_t BCD::TO_BCD[100] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+    0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79,
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99
+};
+
+/**
+ * Packed BCD byte to binary 0-99, INVALID for bytes with a nibble above 9
+ */
+struct BCDDecodeTable {
+    static const uint8_t INVALID = 0xFF;
+    uint8_t value[256];
+
+    BCDDecodeTable() {
+        for (int b = 0; b < 256; b++) {
+            int tens = (b >> 4) & 0x0F;
+            int ones = b & 0x0F;
+            value[b] = (tens > 9 || ones > 9) ? INVALID : static_cast<uint8_t>(tens * 10 + ones);
+        }
+    }
+};
+
+static const BCDDecodeTable& decodeTable() {
+    static const BCDDecodeTable table;
+    return table;
+}
+
 std::vector<uint8_t> BCD::encode(uint64_t value, size_t numBytes) {
     std::vector<uint8_t> result(numBytes, 0);
     encodeTo(value, result.data(), numBytes);
@@ -17,22 +54,29 @@ bool BCD::encodeTo(uint64_t value, uint8_t* buffer, size_t numBytes) {
 
     // Check if value fits in requested number of bytes
     if (value > maxValue(numBytes)) {
-        // Value too large, truncate or return false
         return false;
     }
 
-    // Convert from least significant byte to most significant
-    for (size_t i = 0; i < numBytes; i++) {
-        size_t bufferIndex = numBytes - 1 - i;  // Fill from right to left
-
-        // Get last two decimal digits
-        uint8_t ones = value % 10;
-        value /= 10;
-        uint8_t tens = value % 10;
-        value /= 10;
+    // Fill from right to left, 8 digits (4 bytes) per chunk so the digit
+    // pair loop runs on 32-bit values. Meters up to 4 bytes never need the
+    // 64-bit split.
+    size_t index = numBytes;
+    while (index > 0) {
+        uint32_t chunk;
+        if (value < 100000000ULL) {
+            chunk = static_cast<uint32_t>(value);
+            value = 0;
+        } else {
+            chunk = static_cast<uint32_t>(value % 100000000ULL);
+            value /= 100000000ULL;
+        }
 
-        // Pack into BCD byte (tens in high nibble, ones in low nibble)
-        buffer[bufferIndex] = (tens << 4) | ones;
+        for (int pair = 0; pair < 4 && index > 0; pair++) {
+            // chunk / 100 for any 32-bit chunk (0x51EB851F = ceil(2^37 / 100))
+            uint32_t rest = static_cast<uint32_t>((static_cast<uint64_t>(chunk) * 0x51EB851FULL) >> 37);
+            buffer[--index] = TO_BCD[chunk - rest * 100];
+            chunk = rest;
+        }
     }
 
     return true;
@@ -43,25 +87,19 @@ uint64_t BCD::decode(const uint8_t* bcdData, size_t numBytes) {
         return 0;
     }
 
+    const BCDDecodeTable& table = decodeTable();
     uint64_t result = 0;
 
     // Process from most significant byte to least significant
     for (size_t i = 0; i < numBytes; i++) {
-        uint8_t bcdByte = bcdData[i];
+        uint8_t pair = table.value[bcdData[i]];
 
-        // Extract high nibble (tens) and low nibble (ones)
-        uint8_t tens = (bcdByte >> 4) & 0x0F;
-        uint8_t ones = bcdByte & 0x0F;
-
-        // Validate nibbles
-        if (tens > 9 || ones > 9) {
-            // Invalid BCD, treat as 0
-            tens = 0;
-            ones = 0;
+        // Invalid BCD, treat as 0
+        if (pair == BCDDecodeTable::INVALID) {
+            pair = 0;
         }
 
-        // Accumulate result
-        result = result * 100 + (tens * 10) + ones;
+        result = result * 100 + pair;
     }
 
     return result;
@@ -84,21 +122,6 @@ bool BCD::isValid(const uint8_t* bcdData, size_t numBytes) {
     return true;
 }
 
-uint64_t BCD::maxValue(size_t numBytes) {
-    if (numBytes == 0) {
-        return 0;
-    }
-
-    // Each byte holds 2 decimal digits (0-99)
-    // Maximum value = 10^(2*numBytes) - 1
-
-    uint64_t result = 1;
-    for (size_t i = 0; i < numBytes * 2; i++) {
-        result *= 10;
-    }
-    return result - 1;
-}
-
 size_t BCD::minBytes(uint64_t value) {
     if (value == 0) {
         return 1;  // At least 1 byte
@@ -121,10 +144,7 @@ uint8_t BCD::toBCD(uint8_t value) {
         value = 99;  // Clamp to valid range
     }
 
-    uint8_t tens = value / 10;
-    uint8_t ones = value % 10;
-
-    return (tens << 4) | ones;
+    return TO_BCD[value];
 }
 
 uint8_t BCD::fromBCD(uint8_t bcd) {
@@ -1,5 +1,6 @@
 #include "sas/CRC16.h"
 #include <cstring>
+#include <cstdint>
 
 
 namespace sas {
@@ -14,14 +15,7 @@ namespace sas {
  * The magic number 010201 octal (0x1081 hex) is derived from the CRC polynomial
  * x^16+x^12+x^5+1
  */
-
-uint16_t CRC16::calculate(const uint8_t* data, size_t length) {
-    if (data == nullptr || length == 0) {
-        return 0;
-    }
-
-    uint16_t crcval = 0;
-
+static uint16_t updateNibble(uint16_t crcval, const uint8_t* data, size_t length) {
     // Process each byte
     for (size_t i = 0; i < length; i++) {
         uint8_t byte_val = data[i];
@@ -38,6 +32,149 @@ uint16_t CRC16::calculate(const uint8_t* data, size_t length) {
     return crcval & 0xFFFF;
 }
 
+/**
+ * Lookup tables derived from the nibble algorithm
+ *
+ * table[0][b] is the CRC of the single byte b, so one byte updates the CRC as
+ *   crc = (crc >> 8) ^ table[0][(crc ^ b) & 0xFF]
+ * table[k][b] is table[0][b] advanced over k further zero bytes, which lets
+ * slicing-by-N fold N bytes with N independent lookups.
+ */
+struct CRC16Tables {
+    uint16_t table[8][256];
+
+    CRC16Tables() {
+        for (int b = 0; b < 256; b++) {
+            uint8_t byte_val = static_cast<uint8_t>(b);
+            table[0][b] = updateNibble(0, &byte_val, 1);
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int b = 0; b < 256; b++) {
+                uint16_t prev = table[k - 1][b];
+                table[k][b] = (prev >> 8) ^ table[0][prev & 0xFF];
+            }
+        }
+    }
+};
+
+static const CRC16Tables& crcTables() {
+    static const CRC16Tables tables;
+    return tables;
+}
+
+static uint16_t updateTable(uint16_t crc, const uint8_t* data, size_t length) {
+    const uint16_t* t0 = crcTables().table[0];
+    for (size_t i = 0; i < length; i++) {
+        crc = (crc >> 8) ^ t0[(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+uint16_t CRC16::calculate(const uint8_t* data, size_t length) {
+#if EGM_CRC16_SLICES == 8
+    return calculateSliced8(data, length);
+#elif EGM_CRC16_SLICES == 4
+    return calculateSliced4(data, length);
+#elif EGM_CRC16_SLICES == 1
+    return calculateTable(data, length);
+#else
+    return calculateNibble(data, length);
+#endif
+}
+
+uint16_t CRC16::calculateNibble(const uint8_t* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return 0;
+    }
+    return updateNibble(0, data, length);
+}
+
+uint16_t CRC16::calculateTable(const uint8_t* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return 0;
+    }
+    return updateTable(0, data, length);
+}
+
+uint16_t CRC16::calculateSliced4(const uint8_t* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return 0;
+    }
+
+    const CRC16Tables& t = crcTables();
+    uint16_t crc = 0;
+
+    // The CRC overlaps the first two bytes of each block; the rest are
+    // looked up independently of the running CRC
+    while (length >= 4) {
+        uint16_t c = crc ^ static_cast<uint16_t>(data[0] | (data[1] << 8));
+        crc = t.table[3][c & 0xFF] ^ t.table[2][c >> 8]
+            ^ t.table[1][data[2]] ^ t.table[0][data[3]];
+        data += 4;
+        length -= 4;
+    }
+
+    return updateTable(crc, data, length);
+}
+
+uint16_t CRC16::calculateSliced8(const uint8_t* data, size_t length) {
+    if (data == nullptr || length == 0) {
+        return 0;
+    }
+
+    const CRC16Tables& t = crcTables();
+    uint16_t crc = 0;
+
+    while (length >= 8) {
+        uint16_t c = crc ^ static_cast<uint16_t>(data[0] | (data[1] << 8));
+        crc = t.table[7][c & 0xFF] ^ t.table[6][c >> 8]
+            ^ t.table[5][data[2]] ^ t.table[4][data[3]]
+            ^ t.table[3][data[4]] ^ t.table[2][data[5]]
+            ^ t.table[1][data[6]] ^ t.table[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+
+    return updateTable(crc, data, length);
+}
+
+void CRC16::calculateMany(const uint8_t* const* data, const size_t* lengths,
+                          size_t count, uint16_t* crcs) {
+    const uint16_t* t0 = crcTables().table[0];
+    const size_t LANES = 4;
+
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        uint16_t crc[LANES] = { 0, 0, 0, 0 };
+        size_t common = SIZE_MAX;
+        for (size_t lane = 0; lane < LANES; lane++) {
+            size_t length = data[i + lane] ? lengths[i + lane] : 0;
+            if (length < common) {
+                common = length;
+            }
+        }
+
+        // Four independent CRC chains per iteration
+        for (size_t pos = 0; pos < common; pos++) {
+            crc[0] = (crc[0] >> 8) ^ t0[(crc[0] ^ data[i][pos]) & 0xFF];
+            crc[1] = (crc[1] >> 8) ^ t0[(crc[1] ^ data[i + 1][pos]) & 0xFF];
+            crc[2] = (crc[2] >> 8) ^ t0[(crc[2] ^ data[i + 2][pos]) & 0xFF];
+            crc[3] = (crc[3] >> 8) ^ t0[(crc[3] ^ data[i + 3][pos]) & 0xFF];
+        }
+
+        for (size_t lane = 0; lane < LANES; lane++) {
+            const uint8_t* buffer = data[i + lane];
+            crcs[i + lane] = buffer
+                ? updateTable(crc[lane], buffer + common, lengths[i + lane] - common)
+                : 0;
+        }
+    }
+
+    for (; i < count; i++) {
+        crcs[i] = calculate(data[i], lengths[i]);
+    }
+}
+
 bool CRC16::verify(const uint8_t* data, size_t length) {
     if (data == nullptr || length < 3) {  // Minimum: 1 byte data + 2 bytes CRC
         return false;
@@ -0,0 +1,154 @@
+#include "sas/CommandMetrics.h"
+#include "sas/CommandTable.h"
+#include <cstdio>
+
+
+namespace sas {
+
+// Histogram bucket bounds exported, in microseconds. Powers of two are
+// bucket boundaries of LatencyHistogram, so the cumulative counts are exact.
+static const uint64_t EXPORTED_BOUNDS[] = {
+    16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576
+};
+
+CommandMetrics::CommandMetrics() {
+    for (int command = 0; command < 256; command++) {
+        commands_[command].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+CommandMetrics::~CommandMetrics() {
+    for (int command = 0; command < 256; command++) {
+        delete commands_[command].load(std::memory_order_relaxed);
+    }
+}
+
+CommandMetrics::Command& CommandMetrics::slot(uint8_t command) {
+    Command* existing = commands_[command].load(std::memory_order_acquire);
+    if (existing) {
+        return *existing;
+    }
+
+    // Published with release, so a scraper never sees a half-built slot
+    Command* created = new Command();
+    if (!commands_[command].compare_exchange_strong(existing, created, std::memory_order_acq_rel)) {
+        delete created;
+        return *existing;
+    }
+    return *created;
+}
+
+void CommandMetrics::recordPoll(uint8_t command, uint64_t handleMicros, bool responded, uint64_t transmitMicros) {
+    Command& metrics = slot(command);
+    metrics.polls.fetch_add(1, std::memory_order_relaxed);
+    metrics.handle.record(handleMicros);
+    if (responded) {
+        metrics.responses.fetch_add(1, std::memory_order_relaxed);
+        metrics.transmit.record(transmitMicros);
+    }
+}
+
+void CommandMetrics::recordCRCError(uint8_t command) {
+    slot(command).crcErrors.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CommandMetrics::reset() {
+    for (int command = 0; command < 256; command++) {
+        Command* metrics = commands_[command].load(std::memory_order_acquire);
+        if (metrics) {
+            metrics->polls.store(0, std::memory_order_relaxed);
+            metrics->responses.store(0, std::memory_order_relaxed);
+            metrics->crcErrors.store(0, std::memory_order_relaxed);
+            metrics->handle.reset();
+            metrics->transmit.reset();
+        }
+    }
+}
+
+// {address="1",command="0x1A",name="Send Current Credits"
+static void writeLabels(std::ostream& out, uint8_t address, int command) {
+    char code[8];
+    snprintf(code, sizeof(code), "0x%02X", command);
+    out << "{address=\"" << static_cast<int>(address) << "\",command=\"" << code << "\",name=\"";
+    for (const char* c = getCommandDescriptor(static_cast<uint8_t>(command)).name; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << "\"";
+}
+
+static void writeCounter(const std::vector<CommandMetrics::Source>& sources, std::ostream& out,
+                         const char* name, const char* help,
+                         const std::atomic<uint64_t> CommandMetrics::Command::*counter) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " counter\n";
+    for (const CommandMetrics::Source& source : sources) {
+        for (int command = 0; command < 256; command++) {
+            const CommandMetrics::Command* metrics = source.metrics->get(static_cast<uint8_t>(command));
+            if (!metrics) {
+                continue;
+            }
+            out << name;
+            writeLabels(out, source.address, command);
+            out << "} " << (metrics->*counter).load(std::memory_order_relaxed) << "\n";
+        }
+    }
+}
+
+static void writeHistogram(const std::vector<CommandMetrics::Source>& sources, std::ostream& out,
+                           const char* name, const char* help,
+                           const utils::LatencyHistogram CommandMetrics::Command::*histogram) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " histogram\n";
+    char bound[32];
+    for (const CommandMetrics::Source& source : sources) {
+        for (int command = 0; command < 256; command++) {
+            const CommandMetrics::Command* metrics = source.metrics->get(static_cast<uint8_t>(command));
+            if (!metrics) {
+                continue;
+            }
+            utils::LatencyHistogram::Snapshot snap = (metrics->*histogram).snapshot();
+
+            uint64_t cumulative = 0;
+            int bucket = 0;
+            for (uint64_t limit : EXPORTED_BOUNDS) {
+                while (bucket < utils::LatencyHistogram::BUCKETS
+                       && utils::LatencyHistogram::upperBound(bucket) <= limit) {
+                    cumulative += snap.counts[bucket++];
+                }
+                snprintf(bound, sizeof(bound), "%.6f", limit / 1e6);
+                out << name << "_bucket";
+                writeLabels(out, source.address, command);
+                out << ",le=\"" << bound << "\"} " << cumulative << "\n";
+            }
+            out << name << "_bucket";
+            writeLabels(out, source.address, command);
+            out << ",le=\"+Inf\"} " << snap.count << "\n";
+
+            snprintf(bound, sizeof(bound), "%.6f", snap.sumMicros / 1e6);
+            out << name << "_sum";
+            writeLabels(out, source.address, command);
+            out << "} " << bound << "\n";
+            out << name << "_count";
+            writeLabels(out, source.address, command);
+            out << "} " << snap.count << "\n";
+        }
+    }
+}
+
+void CommandMetrics::writePrometheus(const std::vector<Source>& sources, std::ostream& out) {
+    writeCounter(sources, out, "sas_polls_total",
+                 "Polls handled by command (general polls: 0x80)", &Command::polls);
+    writeCounter(sources, out, "sas_responses_total",
+                 "Polls answered by command", &Command::responses);
+    writeCounter(sources, out, "sas_crc_errors_total",
+                 "Polls dropped for a bad CRC by command", &Command::crcErrors);
+    writeHistogram(sources, out, "sas_handle_seconds",
+                   "Time from a complete poll to its handler returning", &Command::handle);
+    writeHistogram(sources, out, "sas_transmit_seconds",
+                   "Time from the handler returning to the response written", &Command::transmit);
+}
+
+} // namespace sas
@@ -0,0 +1,311 @@
+#include "sas/CommandTable.h"
+#include "sas/commands/MeterCommands.h"
+#include "sas/commands/EnableCommands.h"
+#include "sas/commands/DateTimeCommands.h"
+#include "sas/commands/ConfigCommands.h"
+#include "sas/commands/TITOCommands.h"
+#include "sas/commands/AFTCommands.h"
+
+
+namespace sas {
+
+using namespace commands;
+
+namespace {
+
+// Adapters from the individual handler signatures to CommandHandler.
+// Instantiated at compile time, so each table entry is a direct call.
+
+template <Message (*Fn)(simulator::Machine*)>
+Message noData(simulator::Machine* machine, const Message&) {
+    return Fn(machine);
+}
+
+template <Message (*Fn)(simulator::Machine*, const MessageData&)>
+Message withData(simulator::Machine* machine, const Message& poll) {
+    return Fn(machine, poll.data);
+}
+
+template <Message (*Fn)(simulator::Machine*, uint8_t)>
+Message withCommand(simulator::Machine* machine, const Message& poll) {
+    return Fn(machine, poll.command);
+}
+
+template <Message (*Fn)(simulator::Machine*, uint8_t, const MessageData&)>
+Message withCommandAndData(simulator::Machine* machine, const Message& poll) {
+    return Fn(machine, poll.command, poll.data);
+}
+
+constexpr uint8_t VAR = CommandDescriptor::VARIABLE_LENGTH;
+
+// One entry per command code: { handler, poll length, flags, name }
+// Poll length counts [cmd][data][CRC] (address already stripped by S7Lite)
+constexpr CommandDescriptor COMMAND_TABLE[] = {
+    /* 0x00 */ { noData<ConfigCommands::handleSendGameNumber>,                                   1, CommandFlags::NONE,          "Send Game Number" },
+    /* 0x01 */ { noData<EnableCommands::handleEnableGame>,                                       1, CommandFlags::NONE,          "Enable Game" },
+    /* 0x02 */ { noData<EnableCommands::handleDisableGame>,                                      1, CommandFlags::NONE,          "Disable Game" },
+    /* 0x03 */ { noData<EnableCommands::handleEnableBillAcceptor>,                               1, CommandFlags::NONE,          "Enable Bill Acceptor" },
+    /* 0x04 */ { noData<EnableCommands::handleDisableBillAcceptor>,                              1, CommandFlags::NONE,          "Disable Bill Acceptor" },
+    /* 0x05 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x06 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x07 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x08 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x09 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x0A */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x0B */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x0C */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x0D */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x0E */ { nullptr,                                                                        4, CommandFlags::HAS_CRC,       "Enable/Disable Real-Time Event Reporting" },
+    /* 0x0F */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send ROM Signature" },
+    /* 0x10 */ { noData<MeterCommands::handleSendCancelledCredits>,                              1, CommandFlags::NONE,          "Send Cancelled Credits" },
+    /* 0x11 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Total Coin In" },
+    /* 0x12 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Total Coin Out" },
+    /* 0x13 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Total Drop" },
+    /* 0x14 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Total Jackpot" },
+    /* 0x15 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Games Played" },
+    /* 0x16 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Games Won" },
+    /* 0x17 */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Games Lost" },
+    /* 0x18 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send Meters" },
+    /* 0x19 */ { noData<MeterCommands::handleSendTotalCoinInAndMeters>,                          1, CommandFlags::NONE,          "Send Total Coin In and Associated Meters" },
+    /* 0x1A */ { noData<MeterCommands::handleSendCurrentCredits>,                                1, CommandFlags::NONE,          "Send Current Credits" },
+    /* 0x1B */ { noData<DateTimeCommands::handleSendDateTime>,                                   1, CommandFlags::NONE,          "Send Date/Time" },
+    /* 0x1C */ { noData<MeterCommands::handleSendGamingMachineMeters>,                           1, CommandFlags::NONE,          "Send Gaming Machine Meters 1-8" },
+    /* 0x1D */ { noData<AFTCommands::handleSendAFTRegistrationMeters>,                           1, CommandFlags::NONE,          "Send AFT Registration Meters" },
+    /* 0x1E */ { noData<MeterCommands::handleSendBillMeters>,                                    1, CommandFlags::NONE,          "Send Bill Meters" },
+    /* 0x1F */ { withCommand<MeterCommands::handleSendMeters>,                                   1, CommandFlags::NONE,          "Send Game Configuration" },
+    /* 0x20 */ { noData<MeterCommands::handleSendTotalBills>,                                    1, CommandFlags::NONE,          "Send Total Bills" },
+    /* 0x21 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send EEPROM Data" },
+    /* 0x22 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x23 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x24 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x25 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x26 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x27 */ { noData<AFTCommands::handleSendNonCashablePromoCredits>,                         1, CommandFlags::NONE,          "Send Non-Cashable Electronic Promotion Credits" },
+    /* 0x28 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x29 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x2A */ { noData<MeterCommands::handleSendTrueCoinIn>,                                    1, CommandFlags::NONE,          "Send True Coin In" },
+    /* 0x2B */ { noData<MeterCommands::handleSendTrueCoinOut>,                                   1, CommandFlags::NONE,          "Send True Coin Out" },
+    /* 0x2C */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x2D */ { withData<MeterCommands::handleSendHandpayCancelledCredits>,                     5, CommandFlags::HAS_CRC,       "Send Handpay Cancelled Credits" },
+    /* 0x2E */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send Machine ID" },
+    /* 0x2F */ { withData<MeterCommands::handleSendSelectedMetersForGameN>,                    VAR, CommandFlags::HAS_CRC,       "Send Selected Meters for Game N" },
+    /* 0x30 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x31 */ { noData<MeterCommands::handleSend$1Bills>,                                       1, CommandFlags::NONE,          "Send $1 Bills" },
+    /* 0x32 */ { noData<MeterCommands::handleSend$2Bills>,                                       1, CommandFlags::NONE,          "Send $2 Bills" },
+    /* 0x33 */ { noData<MeterCommands::handleSend$5Bills>,                                       1, CommandFlags::NONE,          "Send $5 Bills" },
+    /* 0x34 */ { noData<MeterCommands::handleSend$10Bills>,                                      1, CommandFlags::NONE,          "Send $10 Bills" },
+    /* 0x35 */ { noData<MeterCommands::handleSend$20Bills>,                                      1, CommandFlags::NONE,          "Send $20 Bills" },
+    /* 0x36 */ { noData<MeterCommands::handleSend$50Bills>,                                      1, CommandFlags::NONE,          "Send $50 Bills" },
+    /* 0x37 */ { noData<MeterCommands::handleSend$100Bills>,                                     1, CommandFlags::NONE,          "Send $100 Bills" },
+    /* 0x38 */ { noData<MeterCommands::handleSend$500Bills>,                                     1, CommandFlags::NONE,          "Send $500 Bills" },
+    /* 0x39 */ { noData<MeterCommands::handleSend$1000Bills>,                                    1, CommandFlags::NONE,          "Send $1000 Bills" },
+    /* 0x3A */ { noData<MeterCommands::handleSend$200Bills>,                                     1, CommandFlags::NONE,          "Send $200 Bills" },
+    /* 0x3B */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x3C */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x3D */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x3E */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x3F */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x40 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x41 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x42 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x43 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x44 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x45 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x46 */ { noData<MeterCommands::handleSendBillsAcceptedCredits>,                          1, CommandFlags::NONE,          "Send Bills Accepted Credits" },
+    /* 0x47 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x48 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x49 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x4A */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x4B */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x4C */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send System Validation" },
+    /* 0x4D */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x4E */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x4F */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x50 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x51 */ { noData<ConfigCommands::handleSendNumberOfGames>,                                1, CommandFlags::NONE,          "Send Number of Games Implemented" },
+    /* 0x52 */ { withData<MeterCommands::handleSendSelectedGameMeters>,                          5, CommandFlags::HAS_CRC,       "Send Selected Game Meters" },
+    /* 0x53 */ { withData<ConfigCommands::handleSendGameNConfiguration>,                         5, CommandFlags::HAS_CRC,       "Send Game N Configuration" },
+    /* 0x54 */ { noData<ConfigCommands::handleSendMachineID>,                                    1, CommandFlags::NONE,          "Send Machine ID and Serial Number" },
+    /* 0x55 */ { noData<ConfigCommands::handleSendSelectedGameNumber>,                           1, CommandFlags::NONE,          "Send Selected Game Number" },
+    /* 0x56 */ { noData<ConfigCommands::handleSendEnabledGameNumbers>,                           1, CommandFlags::NONE,          "Send Enabled Game Numbers" },
+    /* 0x57 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x58 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x59 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x5A */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x5B */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x5C */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x5D */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x5E */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x5F */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send Game Denomination" },
+    /* 0x60 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x61 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x62 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x63 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x64 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x65 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x66 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x67 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x68 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x69 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x6A */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x6B */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x6C */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x6D */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send Restricted Amount" },
+    /* 0x6E */ { nullptr,                                                                        1, CommandFlags::NONE,          "Send Non-Restricted Amount" },
+    /* 0x6F */ { withCommandAndData<MeterCommands::handleSendSelectedMetersForGameNExtended>,  VAR, CommandFlags::HAS_CRC,       "Send Selected Meters for Game N (Extended)" },
+    /* 0x70 */ { withData<AFTCommands::handleRegisterLock>,                                      1, CommandFlags::NONE,          "AFT Register Lock" },
+    /* 0x71 */ { withData<AFTCommands::handleLockStatus>,                                        1, CommandFlags::NONE,          "AFT Request Lock" },
+    /* 0x72 */ { withData<AFTCommands::handleTransferFunds>,                                   VAR, CommandFlags::HAS_CRC,       "AFT Transfer Funds" },
+    /* 0x73 */ { withData<AFTCommands::handleUnlock>,                                          VAR, CommandFlags::HAS_CRC,       "AFT Register Unlock" },
+    /* 0x74 */ { noData<AFTCommands::handleInterrogateStatus>,                                   8, CommandFlags::HAS_CRC,       "AFT Interrogate Status" },
+    /* 0x75 */ { nullptr,                                                                      VAR, CommandFlags::HAS_CRC,       "Set AFT Receipt Data" },
+    /* 0x76 */ { nullptr,                                                                      VAR, CommandFlags::HAS_CRC,       "Set Custom AFT Ticket Data" },
+    /* 0x77 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x78 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x79 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x7A */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0x7B */ { noData<TITOCommands::handleSendValidationInfo>,                               VAR, CommandFlags::HAS_CRC,       "Send Validation Info" },
+    /* 0x7C */ { noData<TITOCommands::handleSendEnhancedValidation>,                           VAR, CommandFlags::HAS_CRC,       "Send Enhanced Validation" },
+    /* 0x7D */ { withData<TITOCommands::handleRedeemTicket>,                                   VAR, CommandFlags::HAS_CRC,       "Redeem Ticket" },
+    /* 0x7E */ { noData<TITOCommands::handleSendTicketInfo>,                                   VAR, CommandFlags::HAS_CRC,       "Send Ticket Info" },
+    /* 0x7F */ { noData<TITOCommands::handleSendTicketValidationData>,                         VAR, CommandFlags::HAS_CRC,       "Send Ticket Validation Data" },
+    /* 0x80 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x81 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x82 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x83 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x84 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x85 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x86 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x87 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x88 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x89 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x8A */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x8B */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x8C */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x8D */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x8E */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x8F */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x90 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x91 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x92 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x93 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x94 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x95 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x96 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x97 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x98 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x99 */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x9A */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x9B */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x9C */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x9D */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x9E */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0x9F */ { nullptr,                                                                        1, CommandFlags::GENERAL_POLL,  "General Poll" },
+    /* 0xA0 */ { withData<ConfigCommands::handleEnableDisableGameN>,                             5, CommandFlags::HAS_CRC,       "Enable/Disable Game N" },
+    /* 0xA1 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA2 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA3 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA4 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA5 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA6 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA7 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA8 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xA9 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xAA */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xAB */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xAC */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xAD */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xAE */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xAF */ { withCommandAndData<MeterCommands::handleSendSelectedMetersForGameNExtended>,  VAR, CommandFlags::HAS_CRC,       "Send Selected Meters for Game N (Extended)" },
+    /* 0xB0 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB1 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB2 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB3 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB4 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB5 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB6 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB7 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB8 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xB9 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xBA */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xBB */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xBC */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xBD */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xBE */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xBF */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC0 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC1 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC2 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC3 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC4 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC5 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC6 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC7 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC8 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xC9 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xCA */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xCB */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xCC */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xCD */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xCE */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xCF */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD0 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD1 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD2 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD3 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD4 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD5 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD6 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD7 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD8 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xD9 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xDA */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xDB */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xDC */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xDD */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xDE */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xDF */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE0 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE1 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE2 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE3 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE4 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE5 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE6 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE7 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE8 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xE9 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xEA */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xEB */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xEC */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xED */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xEE */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xEF */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF0 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF1 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF2 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF3 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF4 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF5 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF6 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF7 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF8 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xF9 */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xFA */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xFB */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xFC */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xFD */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xFE */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" },
+    /* 0xFF */ { nullptr,                                                                        1, CommandFlags::NONE,          "Unknown Command" }
+};
+
+static_assert(sizeof(COMMAND_TABLE) / sizeof(COMMAND_TABLE[0]) == 256,
+              "Command table must have exactly one entry per command code");
+
+} // anonymous namespace
+
+const CommandDescriptor& getCommandDescriptor(uint8_t command) {
+    return COMMAND_TABLE[command];
+}
+
+} // namespace sas
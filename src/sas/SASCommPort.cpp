@@ -1,15 +1,13 @@
 #include "sas/SASCommPort.h"
 #include "sas/CRC16.h"
-#include "sas/commands/MeterCommands.h"
-#include "sas/commands/EnableCommands.h"
+#include "sas/CommandTable.h"
+#include "sas/SASConstants.h"
 #include "sas/commands/ExceptionCommands.h"
-#include "sas/commands/DateTimeCommands.h"
-#include "sas/commands/ConfigCommands.h"
 #include "simulator/Machine.h"
-#include "sas/commands/TITOCommands.h"
-#include "sas/commands/AFTCommands.h"
-#include "sas/commands/ProgressiveCommands.h"
+#include "simulator/MachineEvents.h"
 #include "utils/Logger.h"
+#include "utils/Trace.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -17,23 +15,96 @@
 
 namespace sas {
 
+constexpr int SASCommPort::READ_TIMEOUT_MS;
+
 SASCommPort::SASCommPort(simulator::Machine* machine,
                          std::shared_ptr<io::CommChannel> channel,
                          uint8_t address)
     : io::MachineCommPort(machine, channel),
       address_(address),
-      running_(false) {
+      running_(false),
+      realTimeEvents_(false),
+      messagesReceived_(0),
+      messagesSent_(0),
+      crcErrors_(0),
+      framingErrors_(0),
+      generalPolls_(0),
+      longPolls_(0) {
 
     if (address_ < 1 || address_ > 127) {
         address_ = 1;  // Default to address 1
     }
+
+    subscribeEvents();
 }
 
 SASCommPort::~SASCommPort() {
     stop();
+    unsubscribeEvents();
 }
 
-bool SASCommPort::start() {
+void SASCommPort::subscribeEvents() {
+    if (!machine_ || !machine_->getEventService()) {
+        return;
+    }
+    eventService_ = machine_->getEventService();
+
+    // The EventService is shared by every hosted EGM: only take this machine's
+    // events. Game start/end are only reported in real-time mode; a bill is
+    // reported either way, with its data in real-time mode.
+    subscriptions_.push_back(eventService_->subscribe<simulator::GamePlayedEvent>(
+        [this](const simulator::GamePlayedEvent& e) {
+            if (e.machine != machine_ || !realTimeEvents_) {
+                return;
+            }
+            uint8_t data[io::ExceptionQueue::MAX_DATA];
+            size_t length = commands::ExceptionCommands::encodeGameStarted(data,
+                static_cast<uint64_t>(e.credits),
+                static_cast<uint64_t>(machine_->getMeter(SASConstants::METER_COIN_IN)),
+                0,
+                static_cast<uint8_t>(machine_->getProgressiveGroup()));
+            queueException(Exception::GAME_HAS_STARTED, data, length);
+        }));
+
+    subscriptions_.push_back(eventService_->subscribe<simulator::GameEndedEvent>(
+        [this](const simulator::GameEndedEvent& e) {
+            if (e.machine != machine_ || !realTimeEvents_) {
+                return;
+            }
+            uint8_t data[io::ExceptionQueue::MAX_DATA];
+            size_t length = commands::ExceptionCommands::encodeGameEnded(data,
+                static_cast<uint64_t>(e.winCredits));
+            queueException(Exception::GAME_HAS_ENDED, data, length);
+        }));
+
+    subscriptions_.push_back(eventService_->subscribe<simulator::BillAcceptedEvent>(
+        [this](const simulator::BillAcceptedEvent& e) {
+            if (e.machine != machine_) {
+                return;
+            }
+            if (!realTimeEvents_) {
+                queueException(Exception::BILL_ACCEPTED);
+                return;
+            }
+            uint8_t data[io::ExceptionQueue::MAX_DATA];
+            size_t length = commands::ExceptionCommands::encodeBillAccepted(data,
+                commands::ExceptionCommands::BILL_COUNTRY_CODE, e.denominationCode,
+                static_cast<uint64_t>(e.billsAccepted));
+            queueException(Exception::BILL_ACCEPTED, data, length);
+        }));
+}
+
+void SASCommPort::unsubscribeEvents() {
+    if (!eventService_) {
+        return;
+    }
+    for (int id : subscriptions_) {
+        eventService_->unsubscribe(id);
+    }
+    subscriptions_.clear();
+}
+
+bool SASCommPort::attach() {
     if (running_) {
         return true;  // Already running
     }
@@ -44,21 +115,33 @@ bool SASCommPort::start() {
 
     // Open channel if not already open
     if (!channel_->isOpen()) {
-        utils::Logger::log("[SAS] Opening serial channel...");
+        LOG(SAS, INFO, "[SAS] Opening serial channel...");
         if (!channel_->open()) {
-            utils::Logger::log("[SAS] ERROR: Failed to open serial channel!");
+            LOG(SAS, ERROR, "[SAS] ERROR: Failed to open serial channel!");
             return false;
         }
-        utils::Logger::log("[SAS] Serial channel opened successfully");
+        LOG(SAS, INFO, "[SAS] Serial channel opened successfully");
     } else {
-        utils::Logger::log("[SAS] Serial channel already open");
+        LOG(SAS, INFO, "[SAS] Serial channel already open");
     }
 
-    // Start receive thread
-    utils::Logger::log("[SAS] Starting receive thread...");
     running_ = true;
+    return true;
+}
+
+bool SASCommPort::start() {
+    if (running_) {
+        return true;  // Already running (own thread or attached to a pool)
+    }
+
+    if (!attach()) {
+        return false;
+    }
+
+    // Start receive thread
+    LOG(SAS, INFO, "[SAS] Starting receive thread...");
     receiveThread_ = std::thread(&SASCommPort::receiveThread, this);
-    utils::Logger::log("[SAS] Receive thread started, waiting for data...");
+    LOG(SAS, INFO, "[SAS] Receive thread started, waiting for data...");
 
     return true;
 }
@@ -102,135 +185,134 @@ bool SASCommPort::sendMessage(const Message& msg) {
     }
 
     // Debug: Log the Message BEFORE serialize
+    LOG(SAS, TRACE, "[SAS TX PRE-SERIALIZE] Message: addr=0x" << std::hex << (int)msg.address
+        << " cmd=0x" << (int)msg.command << std::dec
+        << " data_size=" << msg.data.size());
+
+    // Serialize message in place (includes CRC calculation)
+    uint8_t buffer[Message::MAX_SERIALIZED_SIZE];
+    size_t length = 0;
     {
-        std::stringstream ss;
-        ss << "[SAS TX PRE-SERIALIZE] Message: addr=0x" << std::hex << (int)msg.address
-           << " cmd=0x" << (int)msg.command << std::dec
-           << " data_size=" << msg.data.size();
-        utils::Logger::log(ss.str());
+        TRACE_SPAN_ARG("sas.serialize", msg.command);
+        length = msg.serializeTo(buffer, sizeof(buffer));
+    }
+    if (length == 0) {
+        return false;  // Nothing valid to send
     }
-
-    // Serialize message (includes CRC calculation)
-    std::vector<uint8_t> buffer = msg.serialize();
 
     // Debug: Log what we're sending
-    utils::Logger::logHexVector("[SAS TX] Sending response: ", buffer);
+    LOG_HEX(SAS, DEBUG, "[SAS TX] Sending response: ", buffer, length);
 
     // Send to channel
-    bool success = sendRaw(buffer.data(), buffer.size());
+    bool success = sendRaw(buffer, length);
 
     if (success) {
-        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-        stats_.messagesSent++;
+        messagesSent_.fetch_add(1, std::memory_order_relaxed);
     }
 
     return success;
 }
 
 SASCommPort::Statistics SASCommPort::getStatistics() const {
-    std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-    return stats_;
+    Statistics stats;
+    stats.messagesReceived = messagesReceived_.load(std::memory_order_relaxed);
+    stats.messagesSent = messagesSent_.load(std::memory_order_relaxed);
+    stats.crcErrors = crcErrors_.load(std::memory_order_relaxed);
+    stats.framingErrors = framingErrors_.load(std::memory_order_relaxed);
+    stats.generalPolls = generalPolls_.load(std::memory_order_relaxed);
+    stats.longPolls = longPolls_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 void SASCommPort::resetStatistics() {
-    std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-    stats_ = Statistics();
+    messagesReceived_.store(0, std::memory_order_relaxed);
+    messagesSent_.store(0, std::memory_order_relaxed);
+    crcErrors_.store(0, std::memory_order_relaxed);
+    framingErrors_.store(0, std::memory_order_relaxed);
+    generalPolls_.store(0, std::memory_order_relaxed);
+    longPolls_.store(0, std::memory_order_relaxed);
+    metrics_.reset();
 }
 
 void SASCommPort::receiveThread() {
-    static int readAttempts = 0;
-    utils::Logger::log("[SAS] Receive thread running, waiting for polls...");
+    int readAttempts = 0;
+    utils::Trace::setThreadName("sas-receive");
+    LOG(SAS, INFO, "[SAS] Receive thread running, waiting for polls...");
 
     while (running_) {
-        // Read ONE poll at a time from the channel
-        Message msg = readMessage(std::chrono::milliseconds(READ_TIMEOUT_MS));
-
-        if (msg.command == 0) {
+        if (serviceOnce(std::chrono::milliseconds(READ_TIMEOUT_MS)) == 0) {
             // No message or timeout
             readAttempts++;
             if (readAttempts % 100 == 0) {
-                utils::Logger::log("[SAS] Still waiting... (" + std::to_string(readAttempts) + " attempts)");
+                LOG(SAS, DEBUG, "[SAS] Still waiting... (" << readAttempts << " attempts)");
             }
             continue;
         }
         readAttempts = 0;  // Reset counter when we get data
+    }
+}
 
-        // Print what we received
-        {
-            std::stringstream ss;
-            ss << "\n===== RECEIVED POLL =====";
-            utils::Logger::log(ss.str());
-        }
-        {
-            std::stringstream ss;
-            ss << "Address: 0x" << std::hex << (int)msg.address << std::dec;
-            utils::Logger::log(ss.str());
-        }
-        {
-            std::stringstream ss;
-            ss << "Command: 0x" << std::hex << (int)msg.command << std::dec;
-            utils::Logger::log(ss.str());
-        }
-        utils::Logger::log("Data bytes: " + std::to_string(msg.data.size()));
-        if (!msg.data.empty()) {
-            std::stringstream ss;
-            ss << "Data: ";
-            for (size_t i = 0; i < msg.data.size(); i++) {
-                char hex[4];
-                snprintf(hex, sizeof(hex), "%02X ", msg.data[i]);
-                ss << hex;
-                if ((i + 1) % 16 == 0 && (i + 1) < msg.data.size()) {
-                    utils::Logger::log(ss.str());
-                    ss.str("");
-                    ss << "      ";
-                }
-            }
-            if (!ss.str().empty()) {
-                utils::Logger::log(ss.str());
-            }
-        }
+size_t SASCommPort::serviceOnce(std::chrono::milliseconds timeout) {
+    size_t handled = 0;
 
-        // Update statistics
-        {
-            std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-            stats_.messagesReceived++;
+    // Answer every poll already received; only the first read may wait
+    Message msg = readMessage(timeout);
+    while (msg.command != 0) {
+        handleMessage(msg, std::chrono::steady_clock::now());
+        handled++;
+        msg = readMessage(std::chrono::milliseconds(0));
+    }
 
-            if (isGeneralPoll(msg.command)) {
-                stats_.generalPolls++;
-            } else {
-                stats_.longPolls++;
-            }
-        }
+    return handled;
+}
 
-        // Send response to keep master happy
-        Message response = processMessage(msg);
-        if (response.command != 0) {
-            std::stringstream ss;
-            ss << "Sending response: 0x" << std::hex << (int)response.command << std::dec;
-            utils::Logger::log(ss.str());
-            sendMessage(response);
-        } else {
-            utils::Logger::log("No response (NULL ACK)");
+void SASCommPort::handleMessage(const Message& msg, std::chrono::steady_clock::time_point receivedAt) {
+    TRACE_SPAN_ARG("sas.poll", msg.command);
+
+    // Print what we received
+    if (LOG_ENABLED(SAS, DEBUG)) {
+        LOG(SAS, DEBUG, "\n===== RECEIVED POLL =====");
+        LOG(SAS, DEBUG, "Address: 0x" << std::hex << (int)msg.address << std::dec);
+        LOG(SAS, DEBUG, "Command: 0x" << std::hex << (int)msg.command << std::dec);
+        LOG(SAS, DEBUG, "Data bytes: " << msg.data.size());
+        if (!msg.data.empty()) {
+            LOG_HEX(SAS, DEBUG, "Data: ", msg.data.data(), msg.data.size());
         }
+    }
 
-        utils::Logger::log("==============================\n");
+    // Update statistics
+    bool generalPoll = getCommandDescriptor(msg.command).isGeneralPoll();
+    messagesReceived_.fetch_add(1, std::memory_order_relaxed);
+    (generalPoll ? generalPolls_ : longPolls_).fetch_add(1, std::memory_order_relaxed);
+
+    // Send response to keep master happy
+    Message response = processMessage(msg);
+    auto handledAt = std::chrono::steady_clock::now();
+    bool responded = false;
+    if (response.command != 0) {
+        LOG(SAS, DEBUG, "Sending response: 0x" << std::hex << (int)response.command << std::dec);
+        responded = sendMessage(response);
+    } else {
+        LOG(SAS, DEBUG, "No response (NULL ACK)");
     }
+    auto writtenAt = std::chrono::steady_clock::now();
+
+    metrics_.recordPoll(generalPoll ? 0x80 : msg.command,
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(handledAt - receivedAt).count()),
+        responded,
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(writtenAt - handledAt).count()));
+
+    LOG(SAS, DEBUG, "==============================\n");
 }
 
 Message SASCommPort::processMessage(const Message& msg) {
-    // Debug 0xA0 routing
-    if (msg.command == 0xA0) {
-        bool isGenPoll = isGeneralPoll(msg.command);
-        std::stringstream ss;
-        ss << "[SAS DEBUG] 0xA0 routing: isGeneralPoll()=" << (isGenPoll ? "TRUE" : "FALSE");
-        utils::Logger::log(ss.str());
-    }
+    TRACE_SPAN("sas.dispatch");
 
-    if (isGeneralPoll(msg.command)) {
-        utils::Logger::log("[SAS] Routing to handleGeneralPoll()");
+    if (getCommandDescriptor(msg.command).isGeneralPoll()) {
+        LOG(SAS, TRACE, "[SAS] Routing to handleGeneralPoll()");
         return handleGeneralPoll(msg);
     } else {
-        utils::Logger::log("[SAS] Routing to handleLongPoll()");
+        LOG(SAS, TRACE, "[SAS] Routing to handleLongPoll()");
         return handleLongPoll(msg);
     }
 }
@@ -238,20 +320,19 @@ Message SASCommPort::processMessage(const Message& msg) {
 Message SASCommPort::handleGeneralPoll(const Message& msg) {
     Message response;
 
-    // Check if we have pending exceptions
-    if (!hasExceptions()) {
+    // Next exception, highest priority first (wait-free)
+    uint8_t exceptionCode = 0;
+    uint8_t data[io::ExceptionQueue::MAX_DATA];
+    size_t length = 0;
+    if (!popException(exceptionCode, data, length)) {
         // No exceptions, no response (NULL response)
         return response;
     }
 
-    // Get next exception from queue
-    uint8_t exceptionCode = 0;
-    {
-        std::lock_guard<std::recursive_mutex> lock(exceptionMutex_);
-        if (!exceptionQueue_.empty()) {
-            exceptionCode = exceptionQueue_.front().code;
-            exceptionQueue_.pop();
-        }
+    // Real-time mode: [FF][exception][event data], so the host needs no
+    // follow-up meter polls
+    if (realTimeEvents_) {
+        return commands::ExceptionCommands::buildRealTimeEventResponse(address_, exceptionCode, data, length);
     }
 
     // Build exception response
@@ -266,251 +347,42 @@ Message SASCommPort::handleLongPoll(const Message& msg) {
     Message response;
     response.address = address_;
 
-    // Route command to appropriate handler
-    switch (msg.command) {
-        // Enable/Disable commands
-        case LongPoll::ENABLE_GAME:
-            response = commands::EnableCommands::handleEnableGame(machine_);
-            break;
-
-        case LongPoll::DISABLE_GAME:
-            response = commands::EnableCommands::handleDisableGame(machine_);
-            break;
-
-        case LongPoll::ENABLE_BILL_ACCEPTOR:
-            response = commands::EnableCommands::handleEnableBillAcceptor(machine_);
-            break;
-
-        case LongPoll::DISABLE_BILL_ACCEPTOR:
-            response = commands::EnableCommands::handleDisableBillAcceptor(machine_);
-            break;
-
-        // Meter commands (0x10-0x1F)
-        case LongPoll::SEND_TOTAL_COIN_IN:
-        case LongPoll::SEND_TOTAL_COIN_OUT:
-        case LongPoll::SEND_TOTAL_DROP:
-        case LongPoll::SEND_TOTAL_JACKPOT:
-        case LongPoll::SEND_GAMES_PLAYED:
-        case LongPoll::SEND_GAMES_WON:
-        case LongPoll::SEND_GAMES_LOST:
-        case LongPoll::SEND_GAME_CONFIG:
-            response = commands::MeterCommands::handleSendMeters(machine_, msg.command);
-            break;
-
-        // 0x19: Send Total Coin In and Associated Meters (fixed format)
-        case LongPoll::SEND_SELECTED_METERS:
-            response = commands::MeterCommands::handleSendTotalCoinInAndMeters(machine_);
-            break;
-
-        // 0x20: Send Total Bills
-        case LongPoll::SEND_TOTAL_BILLS:
-            response = commands::MeterCommands::handleSendTotalBills(machine_);
-            break;
-
-        // Phase 1 - Basic Meters (Simple 4-byte BCD responses)
-        case 0x10:  // Send Cancelled Credits
-            response = commands::MeterCommands::handleSendCancelledCredits(machine_);
-            break;
-
-        case 0x1A:  // Send Current Credits
-            response = commands::MeterCommands::handleSendCurrentCredits(machine_);
-            break;
-
-        case 0x1C:  // Send Gaming Machine Meters 1-8
-            response = commands::MeterCommands::handleSendGamingMachineMeters(machine_);
-            break;
-
-        case 0x1E:  // Send Bill Meters
-            response = commands::MeterCommands::handleSendBillMeters(machine_);
-            break;
-
-        case 0x2A:  // Send True Coin In
-            response = commands::MeterCommands::handleSendTrueCoinIn(machine_);
-            break;
-
-        case 0x2B:  // Send True Coin Out
-            response = commands::MeterCommands::handleSendTrueCoinOut(machine_);
-            break;
-
-        case 0x2D:  // Send Handpay Cancelled Credits
-            response = commands::MeterCommands::handleSendHandpayCancelledCredits(machine_, msg.data);
-            break;
-
-        case 0x2F:  // Send Selected Meters for Game N
-            response = commands::MeterCommands::handleSendSelectedMetersForGameN(machine_, msg.data);
-            break;
-
-        // Bill Denomination Meters
-        case 0x31:  // Send $1 Bills
-            response = commands::MeterCommands::handleSend$1Bills(machine_);
-            break;
-
-        case 0x32:  // Send $2 Bills
-            response = commands::MeterCommands::handleSend$2Bills(machine_);
-            break;
-
-        case 0x33:  // Send $5 Bills
-            response = commands::MeterCommands::handleSend$5Bills(machine_);
-            break;
-
-        case 0x34:  // Send $10 Bills
-            response = commands::MeterCommands::handleSend$10Bills(machine_);
-            break;
-
-        case 0x35:  // Send $20 Bills
-            response = commands::MeterCommands::handleSend$20Bills(machine_);
-            break;
-
-        case 0x36:  // Send $50 Bills
-            response = commands::MeterCommands::handleSend$50Bills(machine_);
-            break;
-
-        case 0x37:  // Send $100 Bills
-            response = commands::MeterCommands::handleSend$100Bills(machine_);
-            break;
-
-        case 0x38:  // Send $500 Bills
-            response = commands::MeterCommands::handleSend$500Bills(machine_);
-            break;
-
-        case 0x39:  // Send $1000 Bills
-            response = commands::MeterCommands::handleSend$1000Bills(machine_);
-            break;
-
-        case 0x3A:  // Send $200 Bills
-            response = commands::MeterCommands::handleSend$200Bills(machine_);
-            break;
-
-        case 0x46:  // Send Bills Accepted Credits
-            response = commands::MeterCommands::handleSendBillsAcceptedCredits(machine_);
-            break;
-
-        // AFT Meters
-        case 0x1D:  // Send AFT Registration Meters
-            response = commands::AFTCommands::handleSendAFTRegistrationMeters(machine_);
-            break;
-
-        case 0x27:  // Send Non-Cashable Electronic Promotion Credits
-            response = commands::AFTCommands::handleSendNonCashablePromoCredits(machine_);
-            break;
-
-        // Game number query
-        case LongPoll::SEND_GAME_NUMBER:
-            response.command = msg.command;
-            // Get first enabled game number, or 1 if no games
-            {
-                auto games = machine_->getGames();
-                int gameNum = games.empty() ? 1 : games[0]->getGameNumber();
-                response.data.push_back(static_cast<uint8_t>(gameNum));
-            }
-            break;
-
-        // Date/Time commands
-        case LongPoll::SEND_DATE_TIME:
-            response = commands::DateTimeCommands::handleSendDateTime(machine_);
-            break;
-
-        // Machine ID and Serial Number
-        case LongPoll::SEND_MACHINE_ID_AND_SERIAL:
-            response = commands::ConfigCommands::handleSendMachineID(machine_);
-            break;
-
-        // Game Configuration Commands
-        case 0x51:  // Send Number of Games Implemented
-            response = commands::ConfigCommands::handleSendNumberOfGames(machine_);
-            break;
-
-        case 0x52:  // Send Selected Game Meters
-            response = commands::MeterCommands::handleSendSelectedGameMeters(machine_, msg.data);
-            break;
-
-        case 0x53:  // Send Game N Configuration
-            response = commands::ConfigCommands::handleSendGameNConfiguration(machine_, msg.data);
-            break;
-
-        case 0x55:  // Send Selected Game Number
-            response = commands::ConfigCommands::handleSendSelectedGameNumber(machine_);
-            break;
-
-        case 0x56:  // Send Enabled Game Numbers
-            response = commands::ConfigCommands::handleSendEnabledGameNumbers(machine_);
-            break;
-
-        case 0xA0:  // Enable/Disable Game N
-            response = commands::ConfigCommands::handleEnableDisableGameN(machine_, msg.data);
-            break;
-
-        // Variable-length meter commands with size bytes
-        case 0x6F:  // Send Selected Meters for Game N (Extended)
-        case 0xAF:  // Send Selected Meters for Game N (Alternate poll value)
-            utils::Logger::log("[SAS] Matched case 0x6F/0xAF, calling handler");
-            response = commands::MeterCommands::handleSendSelectedMetersForGameNExtended(machine_, msg.command, msg.data);
-            break;
-
-        // TITO (Ticket In/Ticket Out) commands
-        case LongPoll::SEND_VALIDATION_INFO:
-            response = commands::TITOCommands::handleSendValidationInfo(machine_);
-            break;
-
-        case LongPoll::SEND_ENHANCED_VALIDATION:
-            response = commands::TITOCommands::handleSendEnhancedValidation(machine_);
-            break;
-
-        case LongPoll::REDEEM_TICKET:
-            response = commands::TITOCommands::handleRedeemTicket(machine_, msg.data);
-            break;
-
-        case LongPoll::SEND_TICKET_INFO:
-            response = commands::TITOCommands::handleSendTicketInfo(machine_);
-            break;
-
-        case LongPoll::SEND_TICKET_VALIDATION_DATA:
-            response = commands::TITOCommands::handleSendTicketValidationData(machine_);
-            break;
-
-        // AFT (Account Funds Transfer) commands
-        case LongPoll::AFT_REGISTER_LOCK:
-            response = commands::AFTCommands::handleRegisterLock(machine_, msg.data);
-            break;
-
-        case LongPoll::AFT_REQUEST_LOCK:
-            response = commands::AFTCommands::handleLockStatus(machine_, msg.data);
-            break;
-
-        case LongPoll::AFT_TRANSFER_FUNDS:
-            response = commands::AFTCommands::handleTransferFunds(machine_, msg.data);
-            break;
-
-        case LongPoll::AFT_REGISTER_UNLOCK:
-            response = commands::AFTCommands::handleUnlock(machine_, msg.data);
-            break;
-
-        case LongPoll::AFT_INTERROGATE_STATUS:
-            response = commands::AFTCommands::handleInterrogateStatus(machine_);
-            break;
-
-        // Progressive Jackpot commands (0x80+)
-        case 0x80:  // SEND_PROGRESSIVE_AMOUNT
-            response = commands::ProgressiveCommands::handleSendProgressiveAmount(machine_, msg.data);
-            break;
+    // Real-time event reporting is port state, not machine state
+    if (msg.command == LongPoll::ENABLE_REAL_TIME_EVENTS) {
+        return handleEnableRealTimeEvents(msg);
+    }
 
-        case 0x84:  // SEND_PROGRESSIVE_WIN
-            response = commands::ProgressiveCommands::handleSendProgressiveWin(machine_, msg.data);
-            break;
+    // Route command to its handler via the command table
+    const CommandDescriptor& desc = getCommandDescriptor(msg.command);
+    if (!desc.handler) {
+        // Unsupported command - no response (NAK)
+        return response;
+    }
 
-        case 0x85:  // SEND_PROGRESSIVE_LEVELS
-            response = commands::ProgressiveCommands::handleSendProgressiveLevels(machine_);
-            break;
+    // Handlers do not know which EGM they answer for; the port does
+    {
+        TRACE_SPAN_ARG("sas.handler", msg.command);
+        response = desc.handler(machine_, msg);
+    }
+    response.address = address_;
+    return response;
+}
 
-        case 0x86:  // SEND_PROGRESSIVE_BROADCAST
-            response = commands::ProgressiveCommands::handleSendProgressiveBroadcast(machine_);
-            break;
+Message SASCommPort::handleEnableRealTimeEvents(const Message& msg) {
+    Message response;
+    if (msg.data.size() < 1 || msg.data[0] > 1) {
+        return response;  // Bad enable byte - no response (NAK)
+    }
 
-        default:
-            // Unsupported command - no response (NAK)
-            break;
+    bool enable = (msg.data[0] == 1);
+    if (realTimeEvents_.exchange(enable) != enable) {
+        LOG(SAS, INFO, "[SAS] Real-time event reporting " << (enable ? "enabled" : "disabled")
+            << " on address " << static_cast<int>(address_));
     }
 
+    // ACK: address and command echoed
+    response.address = address_;
+    response.command = msg.command;
     return response;
 }
 
@@ -521,57 +393,86 @@ Message SASCommPort::readMessage(std::chrono::milliseconds timeout) {
         return msg;
     }
 
-    uint8_t buffer[MAX_MESSAGE_SIZE];
+    // Receive until the parser has a complete poll. Bytes of a partial poll
+    // stay in the parser for the next call.
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    uint64_t junkBefore = frameParser_.getJunkBytes();
+    const uint8_t* frame = nullptr;
+    size_t frameLength = 0;
+    bool gotFrame = false;
+    bool received = false;
+    frameParser_.setAddress(address_);
+    for (;;) {
+        SASFrameParser::FrameStatus status = frameParser_.nextFrame(frame, frameLength);
+        if (status == SASFrameParser::FRAME_OK) {
+            gotFrame = true;
+            break;
+        }
+        if (status == SASFrameParser::FRAME_BAD_CRC) {
+            // The EGM ignores a poll with a bad CRC; the host retries
+            crcErrors_.fetch_add(1, std::memory_order_relaxed);
+            metrics_.recordCRCError(frame[0]);
+            LOG_HEX(SAS, DEBUG, "[SAS] Ignoring poll with bad CRC: ", frame, frameLength);
+            continue;
+        }
 
-    // Read with accumulating timeout - SASSerialPort will loop calling GetBuffer
-    // to accumulate all bytes as they arrive over the timeout period
-    int bytesRead = channel_->read(buffer, MAX_MESSAGE_SIZE, timeout);
+        // A host sends a poll's bytes back to back; after a gap the partial
+        // poll is never completed, and would swallow the next one
+        auto now = std::chrono::steady_clock::now();
+        if (frameParser_.needsReset()
+            && now - lastByteAt_ >= std::chrono::milliseconds(SASFrameParser::INTER_BYTE_GAP_MS)) {
+            LOG(UART, DEBUG, "[SAS] Dropping " << frameParser_.pending()
+                << " bytes of a partial poll after an inter-byte gap");
+            frameParser_.reset();
+        }
 
-    if (bytesRead <= 0) {
-        // Timeout or error - no data available
-        return msg;
+        if ((received && now >= deadline) || !running_) {
+            break;  // Timeout - no complete poll
+        }
+
+        // Receive at least once, even with a zero timeout (pool workers)
+        auto remaining = (now < deadline)
+            ? std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)
+            : std::chrono::milliseconds(0);
+        if (frameParser_.needsReset()) {
+            // Wake up in time to drop a partial poll the host abandoned
+            remaining = std::min(remaining, std::chrono::milliseconds(SASFrameParser::INTER_BYTE_GAP_MS));
+        }
+        int bytesRead = channel_->receive(frameParser_.ring(), remaining);
+        received = true;
+        if (bytesRead < 0) {
+            break;  // Channel error
+        }
+        if (bytesRead > 0) {
+            lastByteAt_ = std::chrono::steady_clock::now();
+        }
     }
 
-    // IMPORTANT: S7Lite API strips the address byte!
-    // Buffer format: cmd only (NO CRC on simple polls!)
-    // Minimum: 1 byte (just the command)
-    if (bytesRead < 1) {
-        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-        stats_.framingErrors++;
+    // Junk skipped while resynchronizing counts as a framing error
+    if (frameParser_.getJunkBytes() != junkBefore) {
+        framingErrors_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (!gotFrame) {
         return msg;
     }
 
-    // Extract command (address was stripped by S7Lite API)
+    // IMPORTANT: S7Lite API strips the address byte!
+    // Frame format: [cmd][data...][CRC if the command carries one]
     // We'll use the configured address from emulator
     msg.address = address_;  // Use our configured address
-    msg.command = buffer[0];
+    msg.command = frame[0];
 
     // If there are additional bytes beyond the command, store them as data
     // (Some polls like 0x74 have parameters)
-    if (bytesRead > 1) {
+    if (frameLength > 1) {
         // Many SAS commands include a 2-byte CRC that needs to be stripped
-        // We need to check if this command includes CRC in the input
-        bool hasCRC = false;
-        switch (msg.command) {
-            // Variable-length commands with CRC
-            case 0x6F: case 0xAF:  // Send Selected Meters for Game N (Extended)
-            case 0x72: case 0x73: case 0x74: case 0x75: case 0x76:  // AFT commands
-            case 0x7B: case 0x7C: case 0x7D: case 0x7E: case 0x7F:  // Extended commands
-            // Fixed-length long polls with CRC
-            case 0xA0:  // Enable/Disable Game N
-            case 0x53:  // Send Game N Configuration
-            case 0x52:  // Send Selected Game Meters
-                hasCRC = true;
-                break;
-            default:
-                hasCRC = false;
-                break;
-        }
+        bool hasCRC = getCommandDescriptor(msg.command).hasCRC();
 
         // Strip CRC (last 2 bytes) if this command includes it
-        int dataEnd = hasCRC ? (bytesRead - 2) : bytesRead;
+        size_t dataEnd = (hasCRC && frameLength >= 2) ? (frameLength - 2) : frameLength;
         if (dataEnd > 1) {
-            msg.data.assign(buffer + 1, buffer + dataEnd);
+            msg.data.assign(frame + 1, frame + dataEnd);
         }
     }
 
@@ -1,51 +1,117 @@
 #include "sas/SASDaemon.h"
 #include "sas/SASCommands.h"
+#include "sas/CommandTable.h"
+#include "sas/CRC16.h"
+#include "sas/BCD.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <thread>
 
 
 namespace sas {
 
-SASDaemon::SASDaemon(simulator::Machine* machine, SASCommPort* port)
-    : machine_(machine),
-      port_(port),
+constexpr size_t SASDaemon::MAX_RESPONSE_SIZE;
+constexpr int SASDaemon::MAX_CONSECUTIVE_TIMEOUTS;
+constexpr int SASDaemon::DEFAULT_GENERAL_POLL_INTERVAL_MS;
+constexpr int SASDaemon::DEFAULT_LONG_POLL_INTERVAL_MS;
+constexpr int SASDaemon::DEFAULT_POLL_TIMEOUT_MS;
+constexpr int SASDaemon::BACKOFF_STEP_MS;
+constexpr int SASDaemon::MAX_BACKOFF_MS;
+
+// LOAD mode poll kinds, in PollMix order
+enum LoadStep {
+    STEP_GENERAL_POLL = 0,
+    STEP_METER_SWEEP,
+    STEP_AFT_STORM,
+    STEP_METER_BURST,
+    STEP_COUNT
+};
+
+// Send Selected Meters for Game N (Extended)
+static const uint8_t SELECTED_METERS_EXTENDED = 0x6F;
+
+// Single meter polls visited by the meter sweep, one per step
+static const uint8_t METER_SWEEP[] = {
+    LongPoll::SEND_TOTAL_COIN_IN,
+    LongPoll::SEND_TOTAL_COIN_OUT,
+    LongPoll::SEND_TOTAL_DROP,
+    LongPoll::SEND_TOTAL_JACKPOT,
+    LongPoll::SEND_GAMES_PLAYED,
+    LongPoll::SEND_GAMES_WON,
+    LongPoll::SEND_GAMES_LOST,
+    LongPoll::SEND_SELECTED_METERS,
+    LongPoll::SEND_CURRENT_HOPPER_LEVEL
+};
+static const size_t METER_SWEEP_LENGTH = sizeof(METER_SWEEP) / sizeof(METER_SWEEP[0]);
+
+SASDaemon::SASDaemon(std::shared_ptr<io::CommChannel> channel, uint8_t address)
+    : channel_(channel),
+      address_(address),
       running_(false),
       mode_(Mode::OFFLINE),
       generalPollInterval_(std::chrono::milliseconds(DEFAULT_GENERAL_POLL_INTERVAL_MS)),
       longPollInterval_(std::chrono::milliseconds(DEFAULT_LONG_POLL_INTERVAL_MS)),
       pollTimeout_(std::chrono::milliseconds(DEFAULT_POLL_TIMEOUT_MS)),
-      lastLongPoll_(std::chrono::steady_clock::now()),
-      currentLongPollIndex_(0),
+      longPollWeight_(0),
+      longPollSequence_(0),
+      backoff_(0),
+      sweepIndex_(0),
+      transactionNumber_(0),
       connected_(false),
       consecutiveTimeouts_(0) {
+    for (int step = 0; step < STEP_COUNT; step++) {
+        mixCredit_[step] = 0;
+    }
+
+    // Default online rotation: meters, progressive levels and the clock
+    addLongPoll(LongPoll::SEND_TOTAL_COIN_IN);
+    addLongPoll(LongPoll::SEND_TOTAL_COIN_OUT);
+    addLongPoll(LongPoll::SEND_GAMES_PLAYED);
+    addLongPoll(LongPoll::SEND_GAMES_WON);
+    addLongPoll(LongPoll::SEND_PROGRESSIVE_LEVELS);
+    addLongPoll(LongPoll::SEND_DATE_TIME);
 }
 
 SASDaemon::~SASDaemon() {
     stop();
 }
 
-bool SASDaemon::start() {
+bool SASDaemon::start(Mode mode) {
     if (running_) {
         return true;  // Already running
     }
 
-    if (!machine_ || !port_) {
+    if (!channel_ || address_ < 1 || address_ > 127) {
         return false;  // Invalid configuration
     }
 
-    // Start SAS port
-    if (!port_->start()) {
-        return false;  // Failed to start port
+    // Open the host end of the line
+    if (!channel_->isOpen() && !channel_->open()) {
+        return false;
     }
 
-    // Reset statistics
-    {
-        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-        stats_ = Statistics();
+    resetStatistics();
+
+    // Fresh schedule: first slot at once, every long poll due in the order added
+    auto now = std::chrono::steady_clock::now();
+    nextSlot_ = std::chrono::steady_clock::time_point();
+    nextLongPoll_ = now;
+    backoff_ = std::chrono::microseconds(0);
+    std::vector<ScheduledLongPoll> entries;
+    while (!longPolls_.empty()) {
+        entries.push_back(longPolls_.top());
+        longPolls_.pop();
+    }
+    for (ScheduledLongPoll& entry : entries) {
+        entry.due = now;
+        longPolls_.push(entry);
     }
 
     // Start polling thread
     running_ = true;
-    mode_ = Mode::DISCOVERY;
+    mode_ = (mode == Mode::LOAD) ? Mode::LOAD : Mode::DISCOVERY;
     pollingThread_ = std::unique_ptr<std::thread>(new std::thread(&SASDaemon::pollingThread, this));
 
     return true;
@@ -80,6 +146,39 @@ SASDaemon::Statistics SASDaemon::getStatistics() const {
 void SASDaemon::resetStatistics() {
     std::lock_guard<std::recursive_mutex> lock(statsMutex_);
     stats_ = Statistics();
+    for (int command = 0; command < 256; command++) {
+        latency_[command].reset();
+    }
+    slotJitter_.reset();
+}
+
+void SASDaemon::setPollMix(const PollMix& mix) {
+    if (!running_) {
+        mix_ = mix;
+    }
+}
+
+void SASDaemon::addLongPoll(uint8_t command, unsigned weight) {
+    if (running_ || weight == 0) {
+        return;
+    }
+    ScheduledLongPoll entry;
+    entry.due = std::chrono::steady_clock::now();
+    entry.sequence = longPollSequence_++;
+    entry.command = command;
+    entry.weight = weight;
+    longPolls_.push(entry);
+    longPollWeight_ += weight;
+}
+
+void SASDaemon::clearLongPolls() {
+    if (running_) {
+        return;
+    }
+    while (!longPolls_.empty()) {
+        longPolls_.pop();
+    }
+    longPollWeight_ = 0;
 }
 
 void SASDaemon::setGeneralPollInterval(std::chrono::milliseconds interval) {
@@ -107,6 +206,10 @@ void SASDaemon::pollingThread() {
                 runOnline();
                 break;
 
+            case Mode::LOAD:
+                runLoad();
+                break;
+
             case Mode::OFFLINE:
                 // Wait and check connection
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
@@ -117,132 +220,300 @@ void SASDaemon::pollingThread() {
 }
 
 void SASDaemon::runDiscovery() {
-    // Discovery mode - query machine capabilities and configuration
+    // Discovery mode - query machine capabilities and configuration, one
+    // poll per slot
 
     // Step 1: Send enable game command
+    waitForSlot();
     doLongPoll(LongPoll::ENABLE_GAME);
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
     // Step 2: Query game configuration
     queryGameConfiguration();
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
     // Step 3: Query initial meters
     queryMeters();
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
     // Step 4: Query progressive levels
     queryProgressives();
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
-    // Discovery complete - switch to online mode
-    connected_ = true;
-    mode_ = Mode::ONLINE;
+    // Discovery complete - switch to online mode (unless we went offline)
+    if (mode_ == Mode::DISCOVERY) {
+        connected_ = true;
+        mode_ = Mode::ONLINE;
+    }
 }
 
 void SASDaemon::runOnline() {
-    // Online mode - continuous polling
+    // Online mode - one poll slot: a general poll, then the long poll due
+    waitForSlot();
 
     // Send general poll to check for exceptions
     bool hasException = doGeneralPoll();
 
-    if (hasException) {
-        // Exception received, send another general poll immediately
-        // to drain the exception queue
-        return;
+    // Drain the exception queue with further general polls while the slot
+    // has room for them
+    while (hasException && running_ && mode_ == Mode::ONLINE
+           && std::chrono::steady_clock::now() + generalPollTimeout() < nextSlot_) {
+        hasException = doGeneralPoll();
+    }
+
+    // Long polls wait until the EGM has nothing more to report
+    if (!hasException && mode_ == Mode::ONLINE) {
+        doScheduledLongPoll();
     }
+}
 
-    // Check if it's time for a long poll cycle
+void SASDaemon::waitForSlot() {
+    auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        generalPollInterval_ + backoff_);
     auto now = std::chrono::steady_clock::now();
-    auto timeSinceLastLongPoll = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - lastLongPoll_);
-
-    if (timeSinceLastLongPoll >= longPollInterval_) {
-        // Time for a long poll
-        switch (currentLongPollIndex_) {
-            case 0:
-                // Query meters
-                doLongPoll(LongPoll::SEND_TOTAL_COIN_IN);
-                break;
-            case 1:
-                doLongPoll(LongPoll::SEND_TOTAL_COIN_OUT);
-                break;
-            case 2:
-                doLongPoll(LongPoll::SEND_GAMES_PLAYED);
-                break;
-            case 3:
-                doLongPoll(LongPoll::SEND_GAMES_WON);
-                break;
-            case 4:
-                // Query progressive levels
-                doLongPoll(LongPoll::SEND_PROGRESSIVE_LEVELS);
-                break;
-            case 5:
-                // Query date/time
-                doLongPoll(LongPoll::SEND_DATE_TIME);
-                break;
-            default:
-                currentLongPollIndex_ = 0;
-                break;
+    if (nextSlot_ == std::chrono::steady_clock::time_point()) {
+        nextSlot_ = now;
+    }
+    if (now < nextSlot_) {
+        std::this_thread::sleep_until(nextSlot_);
+        now = std::chrono::steady_clock::now();
+    }
+
+    // A slot missed entirely restarts the schedule from now instead of
+    // sending the missed polls back to back
+    auto late = now - nextSlot_;
+    bool overrun = (late >= interval);
+    if (overrun) {
+        nextSlot_ = now + interval;
+    } else {
+        slotJitter_.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(late).count()));
+        nextSlot_ += interval;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+    stats_.slots++;
+    if (overrun) {
+        stats_.overruns++;
+    }
+}
+
+void SASDaemon::adaptBackoff(bool slow) {
+    if (mode_ == Mode::LOAD) {
+        return;  // Load runs back to back, without slots
+    }
+
+    std::chrono::microseconds backoff = backoff_;
+    if (slow) {
+        backoff = std::max(backoff * 2, std::chrono::microseconds(std::chrono::milliseconds(BACKOFF_STEP_MS)));
+        backoff = std::min(backoff, std::chrono::microseconds(std::chrono::milliseconds(MAX_BACKOFF_MS)));
+    } else {
+        backoff = backoff * 3 / 4;
+        if (backoff < std::chrono::milliseconds(1)) {
+            backoff = std::chrono::microseconds(0);
         }
+    }
+    if (backoff == backoff_) {
+        return;
+    }
 
-        currentLongPollIndex_ = (currentLongPollIndex_ + 1) % 6;
-        lastLongPoll_ = now;
+    std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+    if (backoff > backoff_) {
+        stats_.backoffs++;
     }
+    backoff_ = backoff;
+    stats_.backoffMs = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(backoff_).count());
+}
 
-    // Sleep for general poll interval
-    std::this_thread::sleep_for(generalPollInterval_);
+std::chrono::milliseconds SASDaemon::generalPollTimeout() const {
+    return std::min(pollTimeout_, generalPollInterval_ / 2);
 }
 
-bool SASDaemon::doGeneralPoll() {
-    // Send general poll (0x80 + address)
-    Message pollMsg;
-    pollMsg.address = port_->getPollAddress();
-    pollMsg.command = 0x80 + port_->getPollAddress();  // General poll base address
+void SASDaemon::doScheduledLongPoll() {
+    auto now = std::chrono::steady_clock::now();
+    if (longPolls_.empty() || now < nextLongPoll_ || longPolls_.top().due > now) {
+        return;
+    }
 
-    // Send and wait for response
-    bool success = port_->sendMessage(pollMsg);
+    ScheduledLongPoll entry = longPolls_.top();
+    longPolls_.pop();
+    doLongPoll(entry.command);
 
-    {
+    // Weight w of W: due again W/w long poll intervals later
+    entry.due += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        longPollInterval_ * longPollWeight_) / entry.weight;
+    entry.sequence = longPollSequence_++;
+    longPolls_.push(entry);
+
+    nextLongPoll_ += longPollInterval_;
+    if (nextLongPoll_ <= now) {
+        nextLongPoll_ = now + longPollInterval_;  // Fell behind: no catching up
+    }
+}
+
+void SASDaemon::runLoad() {
+    // Smooth weighted round robin: every step each kind earns its weight,
+    // the richest kind is sent and pays the total back. The sequence is
+    // deterministic and spreads each kind evenly over the run.
+    const unsigned weights[STEP_COUNT] = {
+        mix_.generalPolls, mix_.meterSweeps, mix_.aftTransfers, mix_.meterBursts
+    };
+    int total = 0;
+    int chosen = -1;
+    for (int step = 0; step < STEP_COUNT; step++) {
+        total += static_cast<int>(weights[step]);
+        mixCredit_[step] += static_cast<int>(weights[step]);
+        if (weights[step] > 0 && (chosen < 0 || mixCredit_[step] > mixCredit_[chosen])) {
+            chosen = step;
+        }
+    }
+    if (chosen < 0) {
+        std::this_thread::sleep_for(generalPollInterval_);  // Empty mix
+        return;
+    }
+    mixCredit_[chosen] -= total;
+
+    unsigned burst = mix_.burstLength > 0 ? mix_.burstLength : 1;
+    switch (chosen) {
+        case STEP_GENERAL_POLL:
+            doGeneralPoll();
+            break;
+        case STEP_METER_SWEEP:
+            doLongPoll(METER_SWEEP[sweepIndex_]);
+            sweepIndex_ = (sweepIndex_ + 1) % METER_SWEEP_LENGTH;
+            break;
+        case STEP_AFT_STORM:
+            for (unsigned i = 0; i < burst && running_; i++) {
+                doAftTransfer();
+            }
+            break;
+        case STEP_METER_BURST:
+            for (unsigned i = 0; i < burst && running_; i++) {
+                doMeterBurstPoll();
+            }
+            break;
+    }
+}
+
+size_t SASDaemon::buildPoll(uint8_t command, const uint8_t* data, size_t dataLength, uint8_t* poll) const {
+    poll[0] = command;
+    if (dataLength > 0) {
+        memcpy(poll + 1, data, dataLength);
+    }
+    size_t length = 1 + dataLength;
+    if (getCommandDescriptor(command).hasCRC()) {
+        // The EGM's UART strips the address, but the CRC still covers it
+        uint8_t message[1 + MAX_RESPONSE_SIZE];
+        message[0] = address_;
+        memcpy(message + 1, poll, length);
+        uint16_t crc = CRC16::calculate(message, length + 1);
+        poll[length++] = static_cast<uint8_t>(crc & 0xFF);
+        poll[length++] = static_cast<uint8_t>(crc >> 8);
+    }
+    return length;
+}
+
+size_t SASDaemon::transact(const uint8_t* poll, size_t length, uint8_t latencyCommand,
+                           std::chrono::milliseconds timeout, uint8_t* response) {
+    // Drop a late response to an earlier poll, so it is not taken for this one
+    while (channel_->read(response, static_cast<int>(MAX_RESPONSE_SIZE), std::chrono::milliseconds(0)) > 0) {
+    }
+
+    auto sent = std::chrono::steady_clock::now();
+    if (channel_->write(poll, static_cast<int>(length)) != static_cast<int>(length)) {
         std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-        stats_.totalPolls++;
-        stats_.generalPolls++;
+        stats_.errors++;
+        return 0;
     }
 
-    if (!success) {
-        consecutiveTimeouts_++;
-        {
+    // Read until the bytes so far form a response with a good CRC
+    auto deadline = sent + timeout;
+    size_t received = 0;
+    bool complete = false;
+    while (!complete && received < MAX_RESPONSE_SIZE) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+        int bytesRead = channel_->read(response + received, static_cast<int>(MAX_RESPONSE_SIZE - received),
+                                       std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)
+                                           + std::chrono::milliseconds(1));
+        if (bytesRead < 0) {
             std::lock_guard<std::recursive_mutex> lock(statsMutex_);
-            stats_.timeouts++;
+            stats_.errors++;
+            return 0;
         }
+        received += static_cast<size_t>(bytesRead);
+        complete = (received >= 4 && CRC16::verify(response, received));
+    }
+    auto answered = std::chrono::steady_clock::now();
 
-        if (consecutiveTimeouts_ >= MAX_CONSECUTIVE_TIMEOUTS) {
-            // Lost connection
-            connected_ = false;
-            mode_ = Mode::OFFLINE;
+    if (!complete) {
+        if (received > 0) {
+            std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+            stats_.crcErrors++;
+            LOG_HEX(SAS, DEBUG, "[Master] Response with bad CRC: ", response, received);
         }
-
-        return false;
+        return 0;
+    }
+    if (response[0] != address_) {
+        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+        stats_.errors++;
+        return 0;
     }
 
-    // Reset timeout counter on success
+    auto roundTrip = std::chrono::duration_cast<std::chrono::microseconds>(answered - sent);
+    latency_[latencyCommand].record(static_cast<uint64_t>(roundTrip.count()));
+    adaptBackoff(roundTrip > timeout / 2);
+    {
+        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+        stats_.responses++;
+    }
     consecutiveTimeouts_ = 0;
     connected_ = true;
+    return received;
+}
 
-    // Check if we received an exception
-    // The port handles exception responses internally
-    // We just need to check if there was data
-    return false;  // Simplified - in real implementation would check response
+void SASDaemon::noResponse() {
+    // A load generator keeps going; a monitoring master drops the link
+    consecutiveTimeouts_++;
+    if (mode_ != Mode::LOAD && consecutiveTimeouts_ >= MAX_CONSECUTIVE_TIMEOUTS) {
+        // Lost connection
+        connected_ = false;
+        mode_ = Mode::OFFLINE;
+    }
 }
 
-bool SASDaemon::doLongPoll(uint8_t command, const std::vector<uint8_t>& data) {
-    // Send long poll command
-    Message pollMsg;
-    pollMsg.address = port_->getPollAddress();
-    pollMsg.command = command;
-    pollMsg.data = data;
+bool SASDaemon::doGeneralPoll() {
+    // General poll: 0x80 + address, no data and no CRC
+    uint8_t poll[1] = { static_cast<uint8_t>(0x80 | address_) };
+    uint8_t response[MAX_RESPONSE_SIZE];
 
-    bool success = port_->sendMessage(pollMsg);
+    {
+        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+        stats_.totalPolls++;
+        stats_.generalPolls++;
+    }
+
+    size_t length = transact(poll, sizeof(poll), 0x80, generalPollTimeout(), response);
+    if (length == 0) {
+        // Nothing to report (the EGM stays silent)
+        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+        stats_.idlePolls++;
+        return false;
+    }
+
+    // [address][exception][CRC], or [address][FF][exception][data][CRC] in real-time mode
+    uint8_t exceptionCode = response[1];
+    if (exceptionCode == LongPoll::SEND_REAL_TIME_EVENT && length >= 5) {
+        exceptionCode = response[2];
+    }
+    processException(exceptionCode);
+    return true;
+}
+
+bool SASDaemon::doLongPoll(uint8_t command, const std::vector<uint8_t>& data) {
+    uint8_t poll[MAX_RESPONSE_SIZE];
+    uint8_t response[MAX_RESPONSE_SIZE];
+    size_t dataLength = std::min(data.size(), MAX_RESPONSE_SIZE - 3);
+    size_t pollLength = buildPoll(command, data.data(), dataLength, poll);
 
     {
         std::lock_guard<std::recursive_mutex> lock(statsMutex_);
@@ -250,86 +521,182 @@ bool SASDaemon::doLongPoll(uint8_t command, const std::vector<uint8_t>& data) {
         stats_.longPolls++;
     }
 
-    if (!success) {
-        consecutiveTimeouts_++;
+    size_t length = transact(poll, pollLength, command, pollTimeout_, response);
+    if (length == 0) {
         {
             std::lock_guard<std::recursive_mutex> lock(statsMutex_);
             stats_.timeouts++;
         }
-
-        if (consecutiveTimeouts_ >= MAX_CONSECUTIVE_TIMEOUTS) {
-            connected_ = false;
-            mode_ = Mode::OFFLINE;
-        }
+        adaptBackoff(true);
+        noResponse();
         return false;
     }
 
-    consecutiveTimeouts_ = 0;
-    connected_ = true;
+    if (response[1] != command) {
+        std::lock_guard<std::recursive_mutex> lock(statsMutex_);
+        stats_.errors++;
+        return false;
+    }
     return true;
 }
 
+bool SASDaemon::doAftTransfer() {
+    // 0x72: [length][transfer code][transaction index][transfer type]
+    //       [cashable (5 BCD)][restricted (5 BCD)][non-restricted (5 BCD)]
+    //       [transfer flags][asset number (4)][registration key (20)]
+    //       [transaction ID length][transaction ID][expiration (4 BCD)][pool ID (2)]
+    //       [receipt data length]
+    char transactionID[12];
+    int idLength = snprintf(transactionID, sizeof(transactionID), "LG%08u", transactionNumber_++);
+
+    std::vector<uint8_t> data;
+    data.push_back(0);                      // Length, patched below
+    data.push_back(0x00);                   // Full transfer
+    data.push_back(0x00);                   // Transaction index 0 (new transfer)
+    data.push_back(0x00);                   // In-house transfer to gaming machine
+    uint8_t amount[5];
+    BCD::encodeTo(1, amount, sizeof(amount));           // One cent, cashable
+    data.insert(data.end(), amount, amount + sizeof(amount));
+    BCD::encodeTo(0, amount, sizeof(amount));
+    data.insert(data.end(), amount, amount + sizeof(amount));
+    data.insert(data.end(), amount, amount + sizeof(amount));
+    data.push_back(0x00);                   // Transfer flags
+    data.insert(data.end(), 4 + 20, 0x00);  // Asset number, registration key
+    data.push_back(static_cast<uint8_t>(idLength));
+    data.insert(data.end(), transactionID, transactionID + idLength);
+    data.insert(data.end(), 4 + 2 + 1, 0x00);           // Expiration, pool ID, receipt length
+    data[0] = static_cast<uint8_t>(data.size() - 1);
+
+    return doLongPoll(LongPoll::AFT_TRANSFER_FUNDS, data);
+}
+
+bool SASDaemon::doMeterBurstPoll() {
+    // 0x6F: [length][game number (2 BCD)][meter code (2, LSB first)]...
+    static const uint8_t METERS[] = { 0x00, 0x05, 0x0C, 0x0D, 0x0F, 0x1C, 0x1F, 0x40 };
+    std::vector<uint8_t> data;
+    data.push_back(0);                      // Length, patched below
+    data.push_back(0x00);                   // Game 0000: the machine
+    data.push_back(0x00);
+    for (uint8_t meter : METERS) {
+        data.push_back(meter);
+        data.push_back(0x00);
+    }
+    data[0] = static_cast<uint8_t>(data.size() - 1);
+
+    return doLongPoll(SELECTED_METERS_EXTENDED, data);
+}
+
 void SASDaemon::processException(uint8_t exceptionCode) {
     {
         std::lock_guard<std::recursive_mutex> lock(statsMutex_);
         stats_.exceptionsReceived++;
     }
 
-    // Exception codes indicate various events:
-    // 0x11 - Door opened
-    // 0x51 - Handpay pending
-    // 0x60 - Game started
-    // etc.
+    LOG(SAS, DEBUG, "[Master] Address " << (int)address_ << " reported exception 0x"
+        << std::hex << (int)exceptionCode << std::dec);
+}
 
-    // In a real implementation, would process specific exceptions
-    // and trigger appropriate actions or notifications
+void SASDaemon::printReport(const std::vector<std::shared_ptr<SASDaemon>>& daemons,
+                            double seconds, std::ostream& out) {
+    Statistics total;
+    utils::LatencyHistogram::Snapshot jitter;
+    utils::LatencyHistogram::Snapshot latency[256];
+    for (const auto& daemon : daemons) {
+        Statistics stats = daemon->getStatistics();
+        total.totalPolls += stats.totalPolls;
+        total.generalPolls += stats.generalPolls;
+        total.longPolls += stats.longPolls;
+        total.responses += stats.responses;
+        total.idlePolls += stats.idlePolls;
+        total.exceptionsReceived += stats.exceptionsReceived;
+        total.timeouts += stats.timeouts;
+        total.crcErrors += stats.crcErrors;
+        total.errors += stats.errors;
+        total.slots += stats.slots;
+        total.overruns += stats.overruns;
+        total.backoffs += stats.backoffs;
+        total.backoffMs = std::max(total.backoffMs, stats.backoffMs);
+        jitter += daemon->getSlotJitter().snapshot();
+        for (int command = 0; command < 256; command++) {
+            latency[command] += daemon->getLatency(static_cast<uint8_t>(command)).snapshot();
+        }
+    }
+
+    out << daemons.size() << " EGM(s), " << total.totalPolls << " polls in " << seconds << " s ("
+        << static_cast<uint64_t>(seconds > 0 ? total.totalPolls / seconds : 0) << " polls/s)" << std::endl;
+    out << "  responses " << total.responses << ", idle general polls " << total.idlePolls
+        << ", exceptions " << total.exceptionsReceived << ", timeouts " << total.timeouts
+        << ", CRC errors " << total.crcErrors << ", other errors " << total.errors << std::endl;
+    if (total.slots > 0) {
+        out << "  poll slots " << total.slots << ", overruns " << total.overruns
+            << ", slot start jitter p50/p99/max " << jitter.percentile(0.50) << "/"
+            << jitter.percentile(0.99) << "/" << jitter.maxMicros << " us, backoffs " << total.backoffs
+            << " (now up to " << total.backoffMs << " ms)" << std::endl;
+    }
+
+    char line[160];
+    snprintf(line, sizeof(line), "  %-4s %-44s %10s %8s %8s %8s %8s %8s",
+             "Cmd", "Name (round trip, us)", "Count", "Mean", "p50", "p90", "p99", "Max");
+    out << line << std::endl;
+    for (int command = 0; command < 256; command++) {
+        const utils::LatencyHistogram::Snapshot& snap = latency[command];
+        if (snap.count == 0) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "  %02X   %-44.44s %10llu %8llu %8llu %8llu %8llu %8llu",
+                 command, getCommandDescriptor(static_cast<uint8_t>(command)).name,
+                 static_cast<unsigned long long>(snap.count),
+                 static_cast<unsigned long long>(snap.meanMicros()),
+                 static_cast<unsigned long long>(snap.percentile(0.50)),
+                 static_cast<unsigned long long>(snap.percentile(0.90)),
+                 static_cast<unsigned long long>(snap.percentile(0.99)),
+                 static_cast<unsigned long long>(snap.maxMicros));
+        out << line << std::endl;
+    }
 }
 
 void SASDaemon::queryGameConfiguration() {
     // Query game configuration and capabilities
+    waitForSlot();
     doLongPoll(LongPoll::SEND_GAME_CONFIG);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
 
+    waitForSlot();
     doLongPoll(LongPoll::SEND_GAME_NUMBER);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
 }
 
 void SASDaemon::queryMeters() {
     // Query all important meters
-    doLongPoll(LongPoll::SEND_TOTAL_COIN_IN);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    doLongPoll(LongPoll::SEND_TOTAL_COIN_OUT);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    doLongPoll(LongPoll::SEND_TOTAL_DROP);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    doLongPoll(LongPoll::SEND_TOTAL_JACKPOT);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    doLongPoll(LongPoll::SEND_GAMES_PLAYED);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    doLongPoll(LongPoll::SEND_GAMES_WON);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
-
-    doLongPoll(LongPoll::SEND_GAMES_LOST);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    static const uint8_t METERS[] = {
+        LongPoll::SEND_TOTAL_COIN_IN,
+        LongPoll::SEND_TOTAL_COIN_OUT,
+        LongPoll::SEND_TOTAL_DROP,
+        LongPoll::SEND_TOTAL_JACKPOT,
+        LongPoll::SEND_GAMES_PLAYED,
+        LongPoll::SEND_GAMES_WON,
+        LongPoll::SEND_GAMES_LOST
+    };
+    for (uint8_t meter : METERS) {
+        if (!running_) {
+            return;
+        }
+        waitForSlot();
+        doLongPoll(meter);
+    }
 }
 
 void SASDaemon::queryProgressives() {
     // Query progressive jackpot levels
+    waitForSlot();
     doLongPoll(LongPoll::SEND_PROGRESSIVE_LEVELS);
-    std::this_thread::sleep_for(std::chrono::milliseconds(20));
 }
 
 void SASDaemon::checkConnection() {
-    // Try to start port and enter discovery mode
-    if (port_->start()) {
+    // Reopen the line and run discovery again on a fresh schedule
+    if (channel_->isOpen() || channel_->open()) {
+        consecutiveTimeouts_ = 0;
+        nextSlot_ = std::chrono::steady_clock::time_point();
         mode_ = Mode::DISCOVERY;
     }
 }
 
 } // namespace sas
-
@@ -0,0 +1,174 @@
+#include "sas/SASFrameParser.h"
+#include "sas/CommandTable.h"
+#include "sas/CRC16.h"
+#include "utils/Logger.h"
+#include "utils/Trace.h"
+#include <cstring>
+
+
+namespace sas {
+
+static_assert(io::ByteRing::CAPACITY >= SASFrameParser::MAX_FRAME_SIZE,
+              "Receive ring must hold at least one maximum-size frame");
+
+constexpr size_t SASFrameParser::MAX_FRAME_SIZE;
+constexpr int SASFrameParser::INTER_BYTE_GAP_MS;
+
+SASFrameParser::SASFrameParser()
+    : address_(0),
+      checkCRC_(false),
+      resyncing_(false),
+      junkBytes_(0),
+      frameCount_(0) {
+}
+
+SASFrameParser::SASFrameParser(FrameCallback callback)
+    : callback_(callback),
+      address_(0),
+      checkCRC_(false),
+      resyncing_(false),
+      junkBytes_(0),
+      frameCount_(0) {
+}
+
+void SASFrameParser::setAddress(uint8_t address) {
+    address_ = address;
+    checkCRC_ = true;
+}
+
+size_t SASFrameParser::feed(const uint8_t* data, size_t length) {
+    size_t frames = 0;
+    size_t offset = 0;
+
+    // Interleave appending and framing so chunks larger than the ring work
+    while (offset < length || !ring_.empty()) {
+        offset += ring_.push(data + offset, length - offset);
+
+        const uint8_t* frame = nullptr;
+        size_t frameLength = 0;
+        bool progressed = false;
+        while (nextFrame(frame, frameLength) != FRAME_NONE) {
+            progressed = true;
+            frames++;
+            if (callback_) {
+                callback_(frame, frameLength);
+            }
+        }
+
+        if (!progressed && (offset >= length || ring_.full())) {
+            break;  // Waiting for more bytes
+        }
+    }
+
+    return frames;
+}
+
+SASFrameParser::FrameStatus SASFrameParser::nextFrame(const uint8_t*& frame, size_t& length) {
+    utils::TraceSpan span("sas.parse");
+
+    size_t junk = 0;
+    for (;;) {
+        // A poll never starts with 0x00. While resyncing, a byte that would
+        // start a poll without a CRC cannot be told from a data byte.
+        while (junk < ring_.size()
+               && (ring_[junk] == 0x00 || (resyncing_ && !getCommandDescriptor(ring_[junk]).hasCRC()))) {
+            junk++;
+        }
+
+        // A length byte no host sends was corrupted on the wire; waiting for
+        // that many bytes would swallow the polls that follow
+        if (ring_.size() >= junk + 2
+            && getCommandDescriptor(ring_[junk]).isVariableLength()
+            && !isPlausibleLength(ring_[junk], ring_[junk + 1])) {
+            junk++;
+            resyncing_ = checkCRC_;
+            continue;
+        }
+        break;
+    }
+
+    if (junk > 0) {
+        ring_.discard(junk);
+        junkBytes_ += junk;
+        LOG(UART, DEBUG, "[SAS FRAME] Skipped " << junk << " junk bytes");
+    }
+
+    size_t frameLength = frontFrameLength();
+    if (frameLength == 0 || ring_.size() < frameLength) {
+        span.cancel();
+        return FRAME_NONE;  // Need more bytes
+    }
+
+    ring_.peek(frame_, frameLength);
+    span.setArg(frame_[0]);
+    frame = frame_;
+    length = frameLength;
+
+    // A bad CRC may mean the frame started at the wrong byte: drop only
+    // its first byte and rescan from the next one
+    if (checkCRC_ && !checkCRC(address_, frame_, frameLength)) {
+        ring_.discard(1);
+        junkBytes_++;
+        resyncing_ = true;
+        return FRAME_BAD_CRC;
+    }
+
+    ring_.discard(frameLength);
+    frameCount_++;
+    resyncing_ = false;
+
+    LOG(UART, TRACE, "[SAS FRAME] cmd=0x" << std::hex << (int)frame_[0] << std::dec
+        << " length=" << frameLength << ", " << ring_.size() << " bytes pending");
+
+    return FRAME_OK;
+}
+
+bool SASFrameParser::checkCRC(uint8_t address, const uint8_t* frame, size_t length) {
+    if (length < 3 || !getCommandDescriptor(frame[0]).hasCRC()) {
+        return true;
+    }
+
+    uint8_t message[1 + MAX_FRAME_SIZE];
+    size_t covered = length - 2;
+    message[0] = address;
+    memcpy(message + 1, frame, covered);
+    uint16_t stored = static_cast<uint16_t>(frame[covered] | (frame[covered + 1] << 8));
+    return stored == CRC16::calculate(message, covered + 1);
+}
+
+void SASFrameParser::reset() {
+    junkBytes_ += ring_.size();
+    ring_.clear();
+    resyncing_ = false;
+}
+
+bool SASFrameParser::isPlausibleLength(uint8_t command, uint8_t length) {
+    switch (command) {
+        case 0x2F:                      // Game number, 1 to 10 meter codes
+            return length >= 2 + 1 && length <= 2 + 10;
+        case 0x6F:
+        case 0xAF:                      // Game number, 1 to 12 two-byte meter codes
+            return length >= 2 + 2 && length <= 2 + 12 * 2 && (length % 2) == 0;
+        default:
+            return true;                // Bounded only by the length byte
+    }
+}
+
+size_t SASFrameParser::frontFrameLength() const {
+    if (ring_.empty()) {
+        return 0;
+    }
+
+    const CommandDescriptor& desc = getCommandDescriptor(ring_[0]);
+    if (!desc.isVariableLength()) {
+        return desc.pollLength;
+    }
+
+    // [cmd][length][data (length bytes)][CRC 2]
+    if (ring_.size() < 2) {
+        return 0;
+    }
+    return 1 + 1 + ring_[1] + 2;
+}
+
+} // namespace sas
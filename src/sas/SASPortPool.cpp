@@ -0,0 +1,138 @@
+#include "sas/SASPortPool.h"
+#include "utils/Logger.h"
+#include "utils/Trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+
+
+namespace sas {
+
+constexpr int SASPortPool::POLL_TIMEOUT_MS;
+constexpr int SASPortPool::UNPOLLABLE_INTERVAL_MS;
+
+SASPortPool::SASPortPool(size_t workerCount)
+    : requestedWorkers_(workerCount),
+      workerCount_(0),
+      running_(false) {
+}
+
+SASPortPool::~SASPortPool() {
+    stop();
+}
+
+void SASPortPool::addPort(std::shared_ptr<SASCommPort> port) {
+    if (!port || running_) {
+        return;
+    }
+    ports_.push_back(port);
+}
+
+bool SASPortPool::start() {
+    if (running_) {
+        return true;
+    }
+
+    // Attach before starting workers so every channel fd is valid
+    size_t attached = 0;
+    for (auto& port : ports_) {
+        if (port->attach()) {
+            attached++;
+        } else {
+            LOG(SAS, ERROR, "[SAS POOL] Failed to attach " << port->getName());
+        }
+    }
+    if (attached == 0) {
+        return false;
+    }
+
+    workerCount_ = std::max<size_t>(1, std::min(requestedWorkers_, ports_.size()));
+    running_ = true;
+    for (size_t i = 0; i < workerCount_; i++) {
+        workers_.push_back(std::thread(&SASPortPool::workerThread, this, i));
+    }
+
+    LOG(SAS, INFO, "[SAS POOL] " << attached << " ports on " << workerCount_ << " worker threads");
+    return true;
+}
+
+void SASPortPool::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    for (auto& port : ports_) {
+        port->stop();
+    }
+}
+
+void SASPortPool::workerThread(size_t index) {
+    utils::Trace::setThreadName("sas-pool-worker");
+
+    // Partition: this worker owns every port at index % workers == index
+    std::vector<SASCommPort*> polled;
+    std::vector<struct pollfd> fds;
+    std::vector<SASCommPort*> unpollable;
+
+    for (size_t i = index; i < ports_.size(); i += workerCount_) {
+        SASCommPort* port = ports_[i].get();
+        if (!port->isRunning()) {
+            continue;  // Failed to attach
+        }
+
+        int fd = port->getChannel() ? port->getChannel()->getReadFd() : -1;
+        if (fd >= 0) {
+            struct pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            fds.push_back(pfd);
+            polled.push_back(port);
+        } else {
+            unpollable.push_back(port);
+        }
+    }
+
+    LOG(SAS, DEBUG, "[SAS POOL] Worker " << index << ": " << polled.size()
+        << " polled ports, " << unpollable.size() << " unpollable");
+
+    int timeout = unpollable.empty() ? POLL_TIMEOUT_MS : UNPOLLABLE_INTERVAL_MS;
+
+    while (running_) {
+        int ready = poll(fds.empty() ? nullptr : fds.data(), fds.size(), timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG(SAS, ERROR, "[SAS POOL] poll failed: " << strerror(errno));
+            break;
+        }
+
+        for (size_t i = 0; ready > 0 && i < fds.size(); i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            if (fds[i].revents & POLLNVAL) {
+                LOG(SAS, ERROR, "[SAS POOL] " << polled[i]->getName() << " channel closed");
+                fds[i].fd = -1;     // poll() ignores negative fds
+                continue;
+            }
+            polled[i]->serviceOnce(std::chrono::milliseconds(0));
+        }
+
+        for (auto port : unpollable) {
+            port->serviceOnce(std::chrono::milliseconds(0));
+        }
+    }
+}
+
+} // namespace sas
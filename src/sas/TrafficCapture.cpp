@@ -0,0 +1,327 @@
+#include "sas/TrafficCapture.h"
+#include "sas/CommandTable.h"
+#include "sas/CRC16.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace sas {
+
+constexpr uint32_t TrafficCapture::MAGIC;
+constexpr uint16_t TrafficCapture::FORMAT_VERSION;
+constexpr size_t TrafficCapture::HEADER_SIZE;
+constexpr size_t TrafficCapture::RECORD_HEADER_SIZE;
+constexpr uint8_t TrafficCapture::FLAG_WAKEUP;
+constexpr uint8_t TrafficCapture::FLAG_CRC_OK;
+constexpr uint8_t TrafficCapture::FLAG_CRC_BAD;
+constexpr size_t TrafficCapture::FLUSH_BYTES;
+constexpr int TrafficCapture::FLUSH_INTERVAL_MS;
+
+static void putLE(uint8_t* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint64_t getLE(const uint8_t* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+static bool writeAll(int fd, const uint8_t* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(fd, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+TrafficCapture::TrafficCapture(const std::string& path, uint8_t address)
+    : path_(path),
+      address_(address),
+      fd_(-1),
+      recordCount_(0) {
+}
+
+TrafficCapture::~TrafficCapture() {
+    close();
+}
+
+bool TrafficCapture::open(const std::vector<uint8_t>& state) {
+    close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int fd = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG(SAS, ERROR, "[Capture] Could not create " << path_ << ": " << strerror(errno));
+        return false;
+    }
+
+    uint64_t startedAt = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    uint8_t header[HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    putLE(header + 0, MAGIC, 4);
+    putLE(header + 4, FORMAT_VERSION, 2);
+    putLE(header + 6, HEADER_SIZE, 2);
+    header[8] = address_;
+    putLE(header + 12, state.size(), 4);
+    putLE(header + 16, startedAt, 8);
+    if (!writeAll(fd, header, sizeof(header)) || !writeAll(fd, state.data(), state.size())) {
+        LOG(SAS, ERROR, "[Capture] Could not write " << path_ << ": " << strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    start_ = std::chrono::steady_clock::now();
+    lastFlush_ = start_;
+    buffer_.clear();
+    buffer_.reserve(FLUSH_BYTES + RECORD_HEADER_SIZE + SASFrameParser::MAX_FRAME_SIZE);
+    recordCount_ = 0;
+    LOG(SAS, INFO, "[Capture] Recording address " << (int)address_ << " to " << path_);
+    return true;
+}
+
+void TrafficCapture::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return;
+    }
+    writeBuffered();
+    ::close(fd_);
+    fd_ = -1;
+    LOG(SAS, INFO, "[Capture] " << path_ << " closed (" << recordCount_ << " records)");
+}
+
+void TrafficCapture::recordPoll(const uint8_t* frame, size_t length) {
+    append(POLL, pollFlags(address_, frame, length), frame, length);
+}
+
+void TrafficCapture::recordResponse(const uint8_t* bytes, size_t length) {
+    append(RESPONSE, responseFlags(bytes, length), bytes, length);
+}
+
+void TrafficCapture::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        writeBuffered();
+    }
+}
+
+uint64_t TrafficCapture::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recordCount_;
+}
+
+uint8_t TrafficCapture::pollFlags(uint8_t address, const uint8_t* frame, size_t length) {
+    if (length == 0 || !getCommandDescriptor(frame[0]).hasCRC() || length < 3) {
+        return FLAG_WAKEUP;
+    }
+    return FLAG_WAKEUP | (SASFrameParser::checkCRC(address, frame, length) ? FLAG_CRC_OK : FLAG_CRC_BAD);
+}
+
+uint8_t TrafficCapture::responseFlags(const uint8_t* bytes, size_t length) {
+    if (length < 4) {
+        return 0;
+    }
+    return CRC16::verify(bytes, length) ? FLAG_CRC_OK : FLAG_CRC_BAD;
+}
+
+void TrafficCapture::append(uint8_t direction, uint8_t flags, const uint8_t* bytes, size_t length) {
+    auto now = std::chrono::steady_clock::now();
+    uint64_t micros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - start_).count());
+    length = std::min(length, static_cast<size_t>(0xFFFF));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return;
+    }
+
+    uint8_t header[RECORD_HEADER_SIZE];
+    putLE(header + 0, micros, 8);
+    header[8] = direction;
+    header[9] = flags;
+    putLE(header + 10, length, 2);
+    buffer_.insert(buffer_.end(), header, header + RECORD_HEADER_SIZE);
+    buffer_.insert(buffer_.end(), bytes, bytes + length);
+    recordCount_++;
+
+    if (buffer_.size() >= FLUSH_BYTES
+        || now - lastFlush_ >= std::chrono::milliseconds(FLUSH_INTERVAL_MS)) {
+        writeBuffered();
+        lastFlush_ = now;
+    }
+}
+
+bool TrafficCapture::writeBuffered() {
+    if (buffer_.empty()) {
+        return true;
+    }
+    bool ok = writeAll(fd_, buffer_.data(), buffer_.size());
+    if (!ok) {
+        LOG(SAS, ERROR, "[Capture] Write to " << path_ << " failed: " << strerror(errno));
+    }
+    buffer_.clear();
+    return ok;
+}
+
+bool TrafficCapture::load(const std::string& path, Info& info, std::vector<Record>& records) {
+    records.clear();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG(SAS, ERROR, "[Capture] Could not open " << path << ": " << strerror(errno));
+        return false;
+    }
+
+    std::vector<uint8_t> file;
+    uint8_t chunk[64 * 1024];
+    for (;;) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        file.insert(file.end(), chunk, chunk + n);
+    }
+    ::close(fd);
+
+    const uint8_t* bytes = file.data();
+    size_t headerSize = (file.size() >= HEADER_SIZE) ? static_cast<size_t>(getLE(bytes + 6, 2)) : 0;
+    size_t stateSize = (file.size() >= HEADER_SIZE) ? static_cast<size_t>(getLE(bytes + 12, 4)) : 0;
+    const char* problem = nullptr;
+    if (file.size() < HEADER_SIZE || getLE(bytes, 4) != MAGIC) {
+        problem = "bad magic";
+    } else if (getLE(bytes + 4, 2) != FORMAT_VERSION || headerSize != HEADER_SIZE) {
+        problem = "unsupported format version";
+    } else if (file.size() < HEADER_SIZE + stateSize) {
+        problem = "truncated state";
+    }
+    if (problem) {
+        LOG(SAS, ERROR, "[Capture] Rejecting " << path << ": " << problem);
+        return false;
+    }
+
+    info.address = bytes[8];
+    info.startedAt = getLE(bytes + 16, 8);
+    info.state.assign(bytes + HEADER_SIZE, bytes + HEADER_SIZE + stateSize);
+
+    size_t offset = HEADER_SIZE + stateSize;
+    while (offset + RECORD_HEADER_SIZE <= file.size()) {
+        size_t length = static_cast<size_t>(getLE(bytes + offset + 10, 2));
+        if (offset + RECORD_HEADER_SIZE + length > file.size()) {
+            break;
+        }
+        Record record;
+        record.micros = getLE(bytes + offset, 8);
+        record.direction = bytes[offset + 8];
+        record.flags = bytes[offset + 9];
+        record.bytes.assign(bytes + offset + RECORD_HEADER_SIZE, bytes + offset + RECORD_HEADER_SIZE + length);
+        records.push_back(std::move(record));
+        offset += RECORD_HEADER_SIZE + length;
+    }
+    if (offset != file.size()) {
+        LOG(SAS, WARN, "[Capture] " << path << ": dropped " << (file.size() - offset)
+            << " bytes of a torn last record");
+    }
+    return true;
+}
+
+RecordingChannel::RecordingChannel(std::shared_ptr<io::CommChannel> channel,
+                                   std::shared_ptr<TrafficCapture> capture)
+    : channel_(channel),
+      capture_(capture),
+      parser_([this](const uint8_t* frame, size_t length) {
+          capture_->recordPoll(frame, length);
+      }) {
+    // Frame exactly as the port does, rescanning after bad CRCs
+    parser_.setAddress(capture_->getAddress());
+}
+
+bool RecordingChannel::open() {
+    return channel_->open();
+}
+
+void RecordingChannel::close() {
+    channel_->close();
+    capture_->flush();
+}
+
+bool RecordingChannel::isOpen() const {
+    return channel_->isOpen();
+}
+
+int RecordingChannel::read(uint8_t* buffer, int maxBytes,
+                           std::chrono::milliseconds timeout) {
+    int bytesRead = channel_->read(buffer, maxBytes, timeout);
+    if (bytesRead > 0) {
+        recordReceived(buffer, static_cast<size_t>(bytesRead));
+    }
+    return bytesRead;
+}
+
+int RecordingChannel::receive(io::ByteRing& ring, std::chrono::milliseconds timeout) {
+    size_t before = ring.size();
+    int appended = channel_->receive(ring, timeout);
+    if (appended > 0) {
+        // The new bytes are the last ones in the ring
+        uint8_t bytes[io::ByteRing::CAPACITY];
+        for (int i = 0; i < appended; i++) {
+            bytes[i] = ring[before + static_cast<size_t>(i)];
+        }
+        recordReceived(bytes, static_cast<size_t>(appended));
+    }
+    return appended;
+}
+
+int RecordingChannel::getReadFd() const {
+    return channel_->getReadFd();
+}
+
+int RecordingChannel::write(const uint8_t* buffer, int numBytes) {
+    int written = channel_->write(buffer, numBytes);
+    if (written > 0) {
+        capture_->recordResponse(buffer, static_cast<size_t>(written));
+    }
+    return written;
+}
+
+void RecordingChannel::flush() {
+    channel_->flush();
+    capture_->flush();
+}
+
+std::string RecordingChannel::getName() const {
+    return channel_->getName();
+}
+
+void RecordingChannel::recordReceived(const uint8_t* bytes, size_t length) {
+    auto now = std::chrono::steady_clock::now();
+    if (parser_.needsReset()
+        && now - lastByteAt_ >= std::chrono::milliseconds(SASFrameParser::INTER_BYTE_GAP_MS)) {
+        parser_.reset();
+    }
+    lastByteAt_ = now;
+    parser_.feed(bytes, length);
+}
+
+} // namespace sas
@@ -0,0 +1,166 @@
+#include "sas/TrafficReplay.h"
+#include "sas/SASCommPort.h"
+#include "io/CommChannel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+
+namespace sas {
+
+constexpr size_t TrafficReplay::MAX_REPORTED_MISMATCHES;
+
+TrafficReplay::TrafficReplay(simulator::Machine* machine, uint8_t address)
+    : machine_(machine),
+      address_(address) {
+}
+
+TrafficReplay::Report TrafficReplay::run(const std::vector<TrafficCapture::Record>& records, bool realTime) {
+    Report report;
+
+    // Host end writes the polls, the port answers on the EGM end
+    auto host = std::make_shared<io::PipedCommChannel>("replay-host");
+    auto egm = std::make_shared<io::PipedCommChannel>("replay-egm");
+    host->connectTo(egm);
+    egm->connectTo(host);
+    host->open();
+
+    SASCommPort port(machine_, egm, address_);
+    if (!port.attach()) {
+        return report;
+    }
+
+    std::vector<uint64_t> replayed;
+    std::vector<uint64_t> recorded;
+    replayed.reserve(records.size());
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+    uint8_t buffer[Message::MAX_SERIALIZED_SIZE];
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < records.size(); i++) {
+        const TrafficCapture::Record& poll = records[i];
+        if (poll.direction != TrafficCapture::POLL) {
+            continue;  // Responses are consumed with their poll
+        }
+        bool gapBefore = (i == 0)
+            || poll.micros - records[i - 1].micros >= static_cast<uint64_t>(SASFrameParser::INTER_BYTE_GAP_MS) * 1000;
+
+        // Everything the EGM wrote before the next poll answers this one
+        expected.clear();
+        size_t next = i + 1;
+        for (; next < records.size() && records[next].direction == TrafficCapture::RESPONSE; next++) {
+            expected.insert(expected.end(), records[next].bytes.begin(), records[next].bytes.end());
+        }
+        if (next > i + 1) {
+            recorded.push_back(records[i + 1].micros - poll.micros);
+        }
+
+        if (realTime) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds(poll.micros));
+        }
+
+        if (gapBefore && !realTime) {
+            port.resetFraming();
+        }
+
+        auto sent = std::chrono::steady_clock::now();
+        host->write(poll.bytes.data(), static_cast<int>(poll.bytes.size()));
+        port.serviceOnce(std::chrono::milliseconds(0));
+
+        // The port answered synchronously, so its output is already queued
+        actual.clear();
+        int bytesRead;
+        do {
+            bytesRead = host->read(buffer, sizeof(buffer), std::chrono::milliseconds(0));
+            if (bytesRead > 0) {
+                actual.insert(actual.end(), buffer, buffer + bytesRead);
+            }
+        } while (bytesRead == static_cast<int>(sizeof(buffer)));
+        auto answered = std::chrono::steady_clock::now();
+        replayed.push_back(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(answered - sent).count()));
+
+        report.polls++;
+        if (poll.flags & TrafficCapture::FLAG_CRC_BAD) {
+            report.crcErrors++;
+        }
+        if (actual == expected) {
+            report.matched++;
+        } else {
+            report.mismatched++;
+            if (report.mismatches.size() < MAX_REPORTED_MISMATCHES) {
+                Mismatch mismatch;
+                mismatch.poll = report.polls - 1;
+                mismatch.micros = poll.micros;
+                mismatch.request = poll.bytes;
+                mismatch.expected = expected;
+                mismatch.actual = actual;
+                report.mismatches.push_back(std::move(mismatch));
+            }
+        }
+    }
+    report.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    port.stop();
+    host->close();
+
+    report.replayed = percentiles(replayed);
+    report.recorded = percentiles(recorded);
+    return report;
+}
+
+TrafficReplay::Latency TrafficReplay::percentiles(std::vector<uint64_t>& samples) {
+    Latency latency;
+    if (samples.empty()) {
+        return latency;
+    }
+
+    // Nearest rank
+    std::sort(samples.begin(), samples.end());
+    size_t last = samples.size() - 1;
+    latency.p50 = samples[last * 50 / 100];
+    latency.p90 = samples[last * 90 / 100];
+    latency.p99 = samples[last * 99 / 100];
+    latency.max = samples[last];
+    return latency;
+}
+
+static void printHex(std::ostream& out, const char* label, const std::vector<uint8_t>& bytes) {
+    out << "    " << label;
+    char hex[4];
+    for (uint8_t byte : bytes) {
+        snprintf(hex, sizeof(hex), " %02X", byte);
+        out << hex;
+    }
+    if (bytes.empty()) {
+        out << " (none)";
+    }
+    out << std::endl;
+}
+
+void TrafficReplay::printReport(const Report& report, std::ostream& out) {
+    out << "Replayed " << report.polls << " polls in " << report.elapsedSeconds << " s: "
+        << report.matched << " matched, " << report.mismatched << " differ";
+    if (report.crcErrors > 0) {
+        out << " (" << report.crcErrors << " recorded with a bad CRC)";
+    }
+    out << std::endl;
+    out << "Response time (us)   p50 " << report.replayed.p50 << "  p90 " << report.replayed.p90
+        << "  p99 " << report.replayed.p99 << "  max " << report.replayed.max << std::endl;
+    out << "Recorded on the line p50 " << report.recorded.p50 << "  p90 " << report.recorded.p90
+        << "  p99 " << report.recorded.p99 << "  max " << report.recorded.max << std::endl;
+
+    for (const Mismatch& mismatch : report.mismatches) {
+        out << "  Poll " << mismatch.poll << " at " << mismatch.micros << " us:" << std::endl;
+        printHex(out, "poll:    ", mismatch.request);
+        printHex(out, "recorded:", mismatch.expected);
+        printHex(out, "replayed:", mismatch.actual);
+    }
+    if (report.mismatched > report.mismatches.size()) {
+        out << "  ... " << (report.mismatched - report.mismatches.size()) << " more" << std::endl;
+    }
+}
+
+} // namespace sas
@@ -3,137 +3,142 @@
 #include "sas/SASConstants.h"
 #include "utils/Logger.h"
 #include "config/EGMConfig.h"
+#include "simulator/NvramStore.h"
 #include <cstring>
+#include <ctime>
 
 
 namespace sas {
 namespace commands {
 
-// Static storage for AFT state
-static bool aftRegistered = false;
-static std::vector<uint8_t> currentLockCode(2, 0);
-static uint8_t currentLockStatus = AFTCommands::LOCK_AVAILABLE;
-static uint8_t currentTransferStatus = AFTCommands::TRANSFER_PENDING;
-static uint64_t lastTransferAmount = 0;
-static std::vector<uint8_t> lastTransactionID(4, 0);
-static uint8_t lastTransferType = 0;
-
-// Additional AFT state for 0x74 response (loaded from egm-config.json)
-static uint64_t assetNumber = 0;                    // Loaded from config: machineInfo.assetNumber
-static uint8_t gameLockStatus = 0xFF;               // 0xFF = Not locked (runtime state)
-static uint8_t availableTransfers = 0x00;           // Bitmask of available transfer types (runtime state)
-static uint8_t hostCashoutStatus = 0;               // Loaded from config: aft.hostCashoutStatus
-static uint8_t aftStatus = 0;                       // Loaded from config: aft.aftStatusFlags
-static uint8_t maxBufferIndex = 0;                  // Loaded from config: aft.maxBufferIndex
-static uint64_t currentRestrictedAmount = 0;        // Restricted promo credits (cents) - runtime state
-static uint64_t currentNonRestrictedAmount = 0;     // Non-restricted promo credits (cents) - runtime state
-static uint64_t gameTransferLimit = 0;              // Loaded from config: aft.transferLimit
-static uint32_t restrictedExpiration = 0;           // Expiration timestamp (0 = no expiration) - runtime state
-static uint16_t restrictedPoolID = 0;               // Loaded from config: aft.restrictedPoolID
-static bool configLoaded = false;                   // Track if config has been loaded
-
 // Helper function to load AFT configuration from JSON
-static void loadAFTConfig() {
-    if (configLoaded) {
+static void loadAFTConfig(AFTState& state, const simulator::Machine* machine) {
+    if (state.configLoaded) {
         return;
     }
 
-    assetNumber = config::EGMConfig::getInt("machineInfo.assetNumber", 1000000);
-    hostCashoutStatus = static_cast<uint8_t>(config::EGMConfig::getInt("aft.hostCashoutStatus", 1));
-    aftStatus = static_cast<uint8_t>(config::EGMConfig::getInt("aft.aftStatusFlags", 0xB1));
-    maxBufferIndex = static_cast<uint8_t>(config::EGMConfig::getInt("aft.maxBufferIndex", 100));
-    gameTransferLimit = config::EGMConfig::getInt("aft.transferLimit", 100000);
-    restrictedPoolID = static_cast<uint16_t>(config::EGMConfig::getInt("aft.restrictedPoolID", 0));
-
-    configLoaded = true;
-    utils::Logger::log("[AFT] Configuration loaded from egm-config.json");
-    utils::Logger::log("[AFT]   Asset Number: " + std::to_string(assetNumber));
-    utils::Logger::log("[AFT]   Host Cashout Status: " + std::to_string(hostCashoutStatus));
-    utils::Logger::log("[AFT]   AFT Status Flags: 0x" +
-        [](uint8_t val) {
+    // Hosted EGMs carry their own asset number; fall back to the config one
+    state.assetNumber = (machine->getAssetNumber() > 0)
+        ? static_cast<uint64_t>(machine->getAssetNumber())
+        : config::EGMConfig::getInt("machineInfo.assetNumber", 1000000);
+    state.hostCashoutStatus = static_cast<uint8_t>(config::EGMConfig::getInt("aft.hostCashoutStatus", 1));
+    state.aftStatus = static_cast<uint8_t>(config::EGMConfig::getInt("aft.aftStatusFlags", 0xB1));
+    state.maxBufferIndex = static_cast<uint8_t>(config::EGMConfig::getInt("aft.maxBufferIndex", 100));
+    state.gameTransferLimit = config::EGMConfig::getInt("aft.transferLimit", 100000);
+    state.restrictedPoolID = static_cast<uint16_t>(config::EGMConfig::getInt("aft.restrictedPoolID", 0));
+
+    // Restore the last transfer from NVRAM so a host retrying it after a
+    // restart still gets TRANSACTION_ID_NOT_UNIQUE instead of a second transfer
+    std::shared_ptr<simulator::NvramStore> nvram = machine->getNvramStore();
+    if (nvram) {
+        std::vector<simulator::NvramStore::AftTransaction> log = nvram->getAftTransactions();
+        if (!log.empty()) {
+            const simulator::NvramStore::AftTransaction& last = log.back();
+            memcpy(state.lastTransactionID.data(), last.transactionId, state.lastTransactionID.size());
+            state.lastTransferAmount = last.cashableCents + last.restrictedCents + last.nonRestrictedCents;
+            state.lastTransferType = last.transferType;
+            state.currentTransferStatus = last.transferStatus;
+        }
+    }
+
+    state.configLoaded = true;
+    LOG(AFT, INFO, "[AFT] Configuration loaded from egm-config.json");
+    LOG(AFT, DEBUG, "[AFT]   Asset Number: " << state.assetNumber);
+    LOG(AFT, DEBUG, "[AFT]   Host Cashout Status: " << (int)state.hostCashoutStatus);
+    LOG(AFT, DEBUG, "[AFT]   AFT Status Flags: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(aftStatus));
-    utils::Logger::log("[AFT]   Max Buffer Index: " + std::to_string(maxBufferIndex));
-    utils::Logger::log("[AFT]   Transfer Limit: " + std::to_string(gameTransferLimit));
-    utils::Logger::log("[AFT]   Restricted Pool ID: " + std::to_string(restrictedPoolID));
+        }(state.aftStatus));
+    LOG(AFT, DEBUG, "[AFT]   Max Buffer Index: " << (int)state.maxBufferIndex);
+    LOG(AFT, DEBUG, "[AFT]   Transfer Limit: " << state.gameTransferLimit);
+    LOG(AFT, DEBUG, "[AFT]   Restricted Pool ID: " << state.restrictedPoolID);
+}
+
+// The machine owns its AFT state; only its SAS servicing thread uses it
+static AFTState& getAFTState(simulator::Machine* machine) {
+    AFTState& state = machine->getAFTState();
+
+    // Load AFT configuration from JSON on first use
+    loadAFTConfig(state, machine);
+    return state;
 }
 
 Message AFTCommands::handleRegisterLock(simulator::Machine* machine,
-                                        const std::vector<uint8_t>& data) {
+                                        const MessageData& data) {
     if (!machine || data.size() < 2) {
         return Message();
     }
 
+    AFTState& state = getAFTState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::AFT_REGISTER_LOCK;
 
     // Extract lock code (first 2 bytes)
-    std::vector<uint8_t> lockCode(data.begin(), data.begin() + 2);
+    LockCode lockCode = {{data[0], data[1]}};
 
     // Register and establish lock
     if (validateLockCode(lockCode)) {
-        aftRegistered = true;
-        currentLockCode = lockCode;
-        currentLockStatus = LOCK_ESTABLISHED;
+        state.aftRegistered = true;
+        state.currentLockCode = lockCode;
+        state.currentLockStatus = LOCK_ESTABLISHED;
 
         // Update 0x74 state: game is now locked
-        gameLockStatus = 0x01;  // Locked with code (non-0xFF means locked)
-        availableTransfers = 0x33;  // In-house, Bonus, Debit available (bits 0,1,4,5)
+        state.gameLockStatus = 0x01;  // Locked with code (non-0xFF means locked)
+        state.availableTransfers = 0x33;  // In-house, Bonus, Debit available (bits 0,1,4,5)
 
         // Response includes lock status
-        response.data.push_back(currentLockStatus);
+        response.data.push_back(state.currentLockStatus);
 
         // Asset number (4 bytes BCD) - use dynamic asset number
-        std::vector<uint8_t> assetNumberBCD = BCD::encode(assetNumber, 4);
-        response.data.insert(response.data.end(), assetNumberBCD.begin(), assetNumberBCD.end());
+        response.data.appendBCD(state.assetNumber, 4);
 
         // Registration code (optional, 1 byte) - 0x00 = successful
         response.data.push_back(0x00);
 
-        utils::Logger::log("[0x70] AFT Registration successful - Game locked");
+        LOG(AFT, DEBUG, "[0x70] AFT Registration successful - Game locked");
     } else {
         // Lock forbidden
-        currentLockStatus = LOCK_FORBIDDEN;
-        gameLockStatus = 0xFF;  // Not locked
-        availableTransfers = 0x00;  // No transfers available
-        response.data.push_back(currentLockStatus);
+        state.currentLockStatus = LOCK_FORBIDDEN;
+        state.gameLockStatus = 0xFF;  // Not locked
+        state.availableTransfers = 0x00;  // No transfers available
+        response.data.push_back(state.currentLockStatus);
 
-        utils::Logger::log("[0x70] AFT Registration failed - Lock forbidden");
+        LOG(AFT, DEBUG, "[0x70] AFT Registration failed - Lock forbidden");
     }
 
     return response;
 }
 
 Message AFTCommands::handleLockStatus(simulator::Machine* machine,
-                                      const std::vector<uint8_t>& data) {
+                                      const MessageData& data) {
     if (!machine || data.size() < 2) {
         return Message();
     }
 
+    AFTState& state = getAFTState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::AFT_INTERROGATE_STATUS;
 
     // Extract lock code
-    std::vector<uint8_t> lockCode(data.begin(), data.begin() + 2);
+    LockCode lockCode = {{data[0], data[1]}};
 
     // Verify lock code matches
-    if (aftRegistered && lockCode == currentLockCode) {
+    if (state.aftRegistered && lockCode == state.currentLockCode) {
         // Return current status
-        response.data.push_back(currentLockStatus);
-        response.data.push_back(currentTransferStatus);
+        response.data.push_back(state.currentLockStatus);
+        response.data.push_back(state.currentTransferStatus);
 
         // Asset number
-        std::vector<uint8_t> assetNumber = BCD::encode(1, 4);
-        response.data.insert(response.data.end(), assetNumber.begin(), assetNumber.end());
+        response.data.appendBCD(state.assetNumber, 4);
 
-        // Current cashable amount (5 bytes BCD)
-        uint64_t credits = machine->getCredits();
-        std::vector<uint8_t> creditsBCD = BCD::encode(credits, 5);
-        response.data.insert(response.data.end(), creditsBCD.begin(), creditsBCD.end());
+        // Current cashable amount (5 bytes BCD, cents)
+        response.data.appendBCD(static_cast<uint64_t>(machine->getCashableAmount().value()), 5);
     } else {
         // Invalid lock code
         response.data.push_back(LOCK_FORBIDDEN);
@@ -144,20 +149,22 @@ Message AFTCommands::handleLockStatus(simulator::Machine* machine,
 }
 
 Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
-                                         const std::vector<uint8_t>& data) {
+                                         const MessageData& data) {
     if (!machine || data.size() < 15) {
         // Need: 1 byte transfer code + 5 bytes amount + 4 bytes transaction ID + others
         return Message();
     }
 
+    AFTState& state = getAFTState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::AFT_TRANSFER_FUNDS;
 
     // Check if registered
-    if (!aftRegistered) {
+    if (!state.aftRegistered) {
         return buildStatusResponse(1, LongPoll::AFT_TRANSFER_FUNDS,
-                                  GAME_NOT_REGISTERED, 0, std::vector<uint8_t>(4, 0));
+                                  GAME_NOT_REGISTERED, 0, TransactionID(), state.lastTransferType);
     }
 
     // Extract transfer data
@@ -168,18 +175,18 @@ Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
     uint64_t amount = BCD::decode(data.data() + 1, 5);
 
     // Extract transaction ID (4 bytes)
-    std::vector<uint8_t> transactionID(data.begin() + 6, data.begin() + 10);
+    TransactionID transactionID = {{data[6], data[7], data[8], data[9]}};
 
     // Validate amount
     if (amount == 0) {
         return buildStatusResponse(1, LongPoll::AFT_TRANSFER_FUNDS,
-                                  NOT_VALID_AMOUNT, 0, transactionID);
+                                  NOT_VALID_AMOUNT, 0, transactionID, state.lastTransferType);
     }
 
     // Check for duplicate transaction ID
-    if (transactionID == lastTransactionID && amount == lastTransferAmount) {
+    if (transactionID == state.lastTransactionID && amount == state.lastTransferAmount) {
         return buildStatusResponse(1, LongPoll::AFT_TRANSFER_FUNDS,
-                                  TRANSACTION_ID_NOT_UNIQUE, 0, transactionID);
+                                  TRANSACTION_ID_NOT_UNIQUE, 0, transactionID, state.lastTransferType);
     }
 
     bool success = false;
@@ -194,7 +201,7 @@ Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
                 transferStatus = FULL_TRANSFER_SUCCESSFUL;
                 machine->incrementMeter(SASConstants::METER_AFT_IN, amount);
                 // Cashable amount is reflected in machine credits (already done)
-                utils::Logger::log("[0x72] AFT Transfer IN: $" + std::to_string(amount / 100.0));
+                LOG(AFT, DEBUG, "[0x72] AFT Transfer IN: $" << (amount / 100.0));
             } else {
                 transferStatus = GAMING_MACHINE_UNABLE;
             }
@@ -206,9 +213,9 @@ Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
             if (success) {
                 transferStatus = FULL_TRANSFER_SUCCESSFUL;
                 machine->incrementMeter(SASConstants::METER_AFT_IN, amount);
-                currentNonRestrictedAmount += amount;  // Track as non-restricted promo
-                utils::Logger::log("[0x72] AFT Bonus Transfer: $" + std::to_string(amount / 100.0) +
-                                  " (Non-Restricted: $" + std::to_string(currentNonRestrictedAmount / 100.0) + ")");
+                state.currentNonRestrictedAmount += amount;  // Track as non-restricted promo
+                LOG(AFT, DEBUG, "[0x72] AFT Bonus Transfer: $" << (amount / 100.0)
+                    << " (Non-Restricted: $" << (state.currentNonRestrictedAmount / 100.0) << ")");
             } else {
                 transferStatus = GAMING_MACHINE_UNABLE;
             }
@@ -221,11 +228,11 @@ Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
                 transferStatus = FULL_TRANSFER_SUCCESSFUL;
                 machine->incrementMeter(SASConstants::METER_AFT_OUT, amount);
                 // Deduct from non-restricted first, then cashable
-                if (currentNonRestrictedAmount > 0) {
-                    uint64_t deductFromPromo = std::min(currentNonRestrictedAmount, amount);
-                    currentNonRestrictedAmount -= deductFromPromo;
+                if (state.currentNonRestrictedAmount > 0) {
+                    uint64_t deductFromPromo = std::min(state.currentNonRestrictedAmount, amount);
+                    state.currentNonRestrictedAmount -= deductFromPromo;
                 }
-                utils::Logger::log("[0x72] AFT Transfer OUT: $" + std::to_string(amount / 100.0));
+                LOG(AFT, DEBUG, "[0x72] AFT Transfer OUT: $" << (amount / 100.0));
             } else {
                 transferStatus = GAMING_MACHINE_UNABLE;
             }
@@ -234,10 +241,10 @@ Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
         case TRANSFER_TO_PRINTER:
             // Print ticket for amount
             // Similar to cashout but prints instead of electronic transfer
-            if (machine->getCredits() >= static_cast<int64_t>(amount)) {
+            if (machine->getCashableAmount() >= simulator::Cents(static_cast<int64_t>(amount))) {
                 // Would call TITOCommands::printTicket here
                 transferStatus = FULL_TRANSFER_SUCCESSFUL;
-                utils::Logger::log("[0x72] AFT Print Ticket: $" + std::to_string(amount / 100.0));
+                LOG(AFT, DEBUG, "[0x72] AFT Print Ticket: $" << (amount / 100.0));
             } else {
                 transferStatus = GAMING_MACHINE_UNABLE;
             }
@@ -249,40 +256,62 @@ Message AFTCommands::handleTransferFunds(simulator::Machine* machine,
     }
 
     // Store transaction info
-    lastTransactionID = transactionID;
-    lastTransferAmount = amount;
-    lastTransferType = transferType;
-    currentTransferStatus = transferStatus;
+    state.lastTransactionID = transactionID;
+    state.lastTransferAmount = amount;
+    state.lastTransferType = transferType;
+    state.currentTransferStatus = transferStatus;
+
+    // Log the transfer and its meter changes to NVRAM before acknowledging
+    std::shared_ptr<simulator::NvramStore> nvram = machine->getNvramStore();
+    if (nvram) {
+        simulator::NvramStore::AftTransaction record;
+        memset(&record, 0, sizeof(record));
+        record.time = static_cast<int64_t>(time(nullptr));
+        if (transferType == BONUS_TO_GAMING_MACHINE) {
+            record.nonRestrictedCents = amount;
+        } else {
+            record.cashableCents = amount;
+        }
+        record.transferType = transferType;
+        record.transferStatus = transferStatus;
+        record.transactionIdLength = static_cast<uint8_t>(transactionID.size());
+        memcpy(record.transactionId, transactionID.data(), transactionID.size());
+        if (!nvram->appendAftTransaction(record)) {
+            LOG(AFT, ERROR, "[0x72] ERROR: Transfer not logged to NVRAM");
+        }
+    }
 
     return buildStatusResponse(1, LongPoll::AFT_TRANSFER_FUNDS,
-                              transferStatus, amount, transactionID);
+                              transferStatus, amount, transactionID, state.lastTransferType);
 }
 
 Message AFTCommands::handleUnlock(simulator::Machine* machine,
-                                  const std::vector<uint8_t>& data) {
+                                  const MessageData& data) {
     if (!machine || data.size() < 2) {
         return Message();
     }
 
+    AFTState& state = getAFTState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::AFT_REGISTER_UNLOCK;
 
     // Extract lock code
-    std::vector<uint8_t> lockCode(data.begin(), data.begin() + 2);
+    LockCode lockCode = {{data[0], data[1]}};
 
     // Verify and unlock
-    if (aftRegistered && lockCode == currentLockCode) {
-        aftRegistered = false;
-        currentLockStatus = LOCK_AVAILABLE;
-        currentTransferStatus = TRANSFER_PENDING;
-        currentLockCode = std::vector<uint8_t>(2, 0);
+    if (state.aftRegistered && lockCode == state.currentLockCode) {
+        state.aftRegistered = false;
+        state.currentLockStatus = LOCK_AVAILABLE;
+        state.currentTransferStatus = TRANSFER_PENDING;
+        state.currentLockCode.fill(0);
 
         // Update 0x74 state: game is now unlocked
-        gameLockStatus = 0xFF;  // Not locked
-        availableTransfers = 0x00;  // No transfers available when unlocked
+        state.gameLockStatus = 0xFF;  // Not locked
+        state.availableTransfers = 0x00;  // No transfers available when unlocked
 
-        utils::Logger::log("[0x73] AFT Unlock successful - Game unlocked");
+        LOG(AFT, DEBUG, "[0x73] AFT Unlock successful - Game unlocked");
 
         // Response: unlock successful
         response.data.push_back(LOCK_AVAILABLE);
@@ -299,8 +328,7 @@ Message AFTCommands::handleInterrogateStatus(simulator::Machine* machine) {
         return Message();
     }
 
-    // Load AFT configuration from JSON on first call
-    loadAFTConfig();
+    AFTState& state = getAFTState(machine);
 
     // 0x74: AFT Gaming Machine Lock and Status Request
     // Based on real EGM response format
@@ -317,20 +345,19 @@ Message AFTCommands::handleInterrogateStatus(simulator::Machine* machine) {
     response.data.push_back(35);
 
     // Asset Number (4 bytes BCD) - use dynamic state
-    std::vector<uint8_t> assetNumberBCD = BCD::encode(assetNumber, 4);
-    response.data.insert(response.data.end(), assetNumberBCD.begin(), assetNumberBCD.end());
+    response.data.appendBCD(state.assetNumber, 4);
 
     // Game Lock Status (1 byte) - use dynamic state
     // 0xFF = Not locked, 0x00 = Game locked by other host, 0x01-0xFE = Locked with code
-    response.data.push_back(gameLockStatus);
+    response.data.push_back(state.gameLockStatus);
 
     // Available Transfers (1 byte) - use dynamic state
     // Bitmask: Bit 0=In-house, Bit 1=Bonus, Bit 2=Debit, etc.
-    response.data.push_back(availableTransfers);
+    response.data.push_back(state.availableTransfers);
 
     // Host Cashout Status (1 byte) - use dynamic state
     // 0x00 = Not controllable, 0x01 = Controllable by host
-    response.data.push_back(hostCashoutStatus);
+    response.data.push_back(state.hostCashoutStatus);
 
     // AFT Status (1 byte) - use dynamic state
     // Bit 0: Printer available (1)
@@ -340,74 +367,66 @@ Message AFTCommands::handleInterrogateStatus(simulator::Machine* machine) {
     // Bit 5: Bonus transfers enabled (1)
     // Bit 6: Reserved (0)
     // Bit 7: Any AFT enabled (1)
-    response.data.push_back(aftStatus);
+    response.data.push_back(state.aftStatus);
 
     // Max Buffer Index (1 byte) - use dynamic state
-    response.data.push_back(maxBufferIndex);
+    response.data.push_back(state.maxBufferIndex);
 
-    // Current Cashable Amount (5 bytes BCD) - use current credits from machine
-    uint64_t credits = machine->getCredits();
-    std::vector<uint8_t> cashableBCD = BCD::encode(credits, 5);
-    response.data.insert(response.data.end(), cashableBCD.begin(), cashableBCD.end());
+    // Current Cashable Amount (5 bytes BCD, cents) - use current credits from machine
+    uint64_t credits = static_cast<uint64_t>(machine->getCashableAmount().value());
+    response.data.appendBCD(credits, 5);
 
     // Current Restricted Amount (5 bytes BCD) - use dynamic state
-    std::vector<uint8_t> restrictedBCD = BCD::encode(currentRestrictedAmount, 5);
-    response.data.insert(response.data.end(), restrictedBCD.begin(), restrictedBCD.end());
+    response.data.appendBCD(state.currentRestrictedAmount, 5);
 
     // Current Non-Restricted Amount (5 bytes BCD) - use dynamic state
-    std::vector<uint8_t> nonRestrictedBCD = BCD::encode(currentNonRestrictedAmount, 5);
-    response.data.insert(response.data.end(), nonRestrictedBCD.begin(), nonRestrictedBCD.end());
+    response.data.appendBCD(state.currentNonRestrictedAmount, 5);
 
     // Game Transfer Limit (5 bytes BCD) - use dynamic state
-    std::vector<uint8_t> transferLimitBCD = BCD::encode(gameTransferLimit, 5);
-    response.data.insert(response.data.end(), transferLimitBCD.begin(), transferLimitBCD.end());
+    response.data.appendBCD(state.gameTransferLimit, 5);
 
     // Restricted Expiration (4 bytes) - use dynamic state
     // Format: MMDDYYYY in BCD, or 0x00000000 = no expiration
-    response.data.push_back((restrictedExpiration >> 24) & 0xFF);
-    response.data.push_back((restrictedExpiration >> 16) & 0xFF);
-    response.data.push_back((restrictedExpiration >> 8) & 0xFF);
-    response.data.push_back(restrictedExpiration & 0xFF);
+    response.data.push_back((state.restrictedExpiration >> 24) & 0xFF);
+    response.data.push_back((state.restrictedExpiration >> 16) & 0xFF);
+    response.data.push_back((state.restrictedExpiration >> 8) & 0xFF);
+    response.data.push_back(state.restrictedExpiration & 0xFF);
 
     // Restricted Pool ID (2 bytes) - use dynamic state
-    response.data.push_back((restrictedPoolID >> 8) & 0xFF);
-    response.data.push_back(restrictedPoolID & 0xFF);
+    response.data.push_back((state.restrictedPoolID >> 8) & 0xFF);
+    response.data.push_back(state.restrictedPoolID & 0xFF);
 
-    utils::Logger::log("[0x74] AFT Lock and Status Response:");
-    utils::Logger::log("  Asset Number: " + std::to_string(assetNumber));
-    utils::Logger::log("  Game Lock Status: 0x" +
-        [](uint8_t val) {
+    LOG(AFT, DEBUG, "[0x74] AFT Lock and Status Response:");
+    LOG(AFT, DEBUG, "  Asset Number: " << state.assetNumber);
+    LOG(AFT, DEBUG, "  Game Lock Status: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(gameLockStatus) + (gameLockStatus == 0xFF ? " (Not locked)" : " (Locked)"));
-    utils::Logger::log("  Available Transfers: 0x" +
-        [](uint8_t val) {
+        }(state.gameLockStatus) << (state.gameLockStatus == 0xFF ? " (Not locked)" : " (Locked)"));
+    LOG(AFT, DEBUG, "  Available Transfers: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(availableTransfers));
-    utils::Logger::log("  Host Cashout Status: 0x" +
-        [](uint8_t val) {
+        }(state.availableTransfers));
+    LOG(AFT, DEBUG, "  Host Cashout Status: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(hostCashoutStatus) + (hostCashoutStatus == 0x01 ? " (Controllable)" : " (Not controllable)"));
-    utils::Logger::log("  AFT Status: 0xB1 (Printer, InHouse, Bonus, Any enabled)");
-    utils::Logger::log("  Max Buffer Index: " + std::to_string(maxBufferIndex));
-    utils::Logger::log("  Current Cashable: " + std::to_string(credits));
-    utils::Logger::log("  Current Restricted: " + std::to_string(currentRestrictedAmount));
-    utils::Logger::log("  Current Non-Restricted: " + std::to_string(currentNonRestrictedAmount));
-    utils::Logger::log("  Transfer Limit: " + std::to_string(gameTransferLimit));
+        }(state.hostCashoutStatus) << (state.hostCashoutStatus == 0x01 ? " (Controllable)" : " (Not controllable)"));
+    LOG(AFT, DEBUG, "  AFT Status: 0xB1 (Printer, InHouse, Bonus, Any enabled)");
+    LOG(AFT, DEBUG, "  Max Buffer Index: " << (int)state.maxBufferIndex);
+    LOG(AFT, DEBUG, "  Current Cashable: " << credits);
+    LOG(AFT, DEBUG, "  Current Restricted: " << state.currentRestrictedAmount);
+    LOG(AFT, DEBUG, "  Current Non-Restricted: " << state.currentNonRestrictedAmount);
+    LOG(AFT, DEBUG, "  Transfer Limit: " << state.gameTransferLimit);
 
     return response;
 }
 
-bool AFTCommands::validateLockCode(const std::vector<uint8_t>& lockCode) {
-    if (lockCode.size() != 2) {
-        return false;
-    }
-
+bool AFTCommands::validateLockCode(const LockCode& lockCode) {
     // Lock code 0x0000 is not valid
     if (lockCode[0] == 0 && lockCode[1] == 0) {
         return false;
@@ -422,7 +441,8 @@ Message AFTCommands::buildStatusResponse(uint8_t address,
                                          uint8_t command,
                                          uint8_t transferStatus,
                                          uint64_t amount,
-                                         const std::vector<uint8_t>& transactionID) {
+                                         const TransactionID& transactionID,
+                                         uint8_t transferType) {
     Message response;
     response.address = address;
     response.command = command;
@@ -431,27 +451,24 @@ Message AFTCommands::buildStatusResponse(uint8_t address,
     response.data.push_back(transferStatus);
 
     // Transfer amount (5 bytes BCD)
-    std::vector<uint8_t> amountBCD = BCD::encode(amount, 5);
-    response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+    response.data.appendBCD(amount, 5);
 
     // Transaction ID (4 bytes)
     response.data.insert(response.data.end(), transactionID.begin(), transactionID.end());
 
     // Transfer type (1 byte)
-    response.data.push_back(lastTransferType);
+    response.data.push_back(transferType);
 
     // Cashable amount on machine (5 bytes BCD)
     // This would be current credits, but we don't have machine reference here
     // Use last known amount
-    std::vector<uint8_t> cashableBCD = BCD::encode(0, 5);
-    response.data.insert(response.data.end(), cashableBCD.begin(), cashableBCD.end());
+    response.data.appendBCD(0, 5);
 
     // Restricted amount (5 bytes BCD) - typically 0 for non-restricted transfers
-    std::vector<uint8_t> restrictedBCD = BCD::encode(0, 5);
-    response.data.insert(response.data.end(), restrictedBCD.begin(), restrictedBCD.end());
+    response.data.appendBCD(0, 5);
 
     // Non-restricted amount (5 bytes BCD) - same as cashable
-    response.data.insert(response.data.end(), cashableBCD.begin(), cashableBCD.end());
+    response.data.appendBCD(0, 5);
 
     return response;
 }
@@ -462,7 +479,7 @@ bool AFTCommands::executeTransferToMachine(simulator::Machine* machine, uint64_t
     }
 
     // Add credits to machine
-    machine->addCredits(static_cast<int64_t>(amount));
+    machine->addCredits(simulator::Cents(static_cast<int64_t>(amount)));
     return true;
 }
 
@@ -472,12 +489,13 @@ bool AFTCommands::executeTransferFromMachine(simulator::Machine* machine, uint64
     }
 
     // Check if machine has sufficient credits
-    if (machine->getCredits() < static_cast<int64_t>(amount)) {
+    simulator::Cents transfer(static_cast<int64_t>(amount));
+    if (machine->getCashableAmount() < transfer) {
         return false;  // Insufficient funds
     }
 
     // Deduct credits from machine
-    machine->addCredits(-static_cast<int64_t>(amount));
+    machine->addCredits(-transfer);
     return true;
 }
 
@@ -497,25 +515,21 @@ Message AFTCommands::handleSendAFTRegistrationMeters(simulator::Machine* machine
 
     // Promo Credit In (AFT Restricted To Game)
     uint64_t promoCredIn = machine->getMeter(SASConstants::METER_AFT_REST_IN);
-    std::vector<uint8_t> promoCredInBCD = BCD::encode(promoCredIn, 4);
-    response.data.insert(response.data.end(), promoCredInBCD.begin(), promoCredInBCD.end());
+    response.data.appendBCD(promoCredIn, 4);
 
     // Non-Cash Credit In (AFT NonRestricted To Game)
     uint64_t nonCashCredIn = machine->getMeter(SASConstants::METER_AFT_NONREST_IN);
-    std::vector<uint8_t> nonCashCredInBCD = BCD::encode(nonCashCredIn, 4);
-    response.data.insert(response.data.end(), nonCashCredInBCD.begin(), nonCashCredInBCD.end());
+    response.data.appendBCD(nonCashCredIn, 4);
 
     // Transferred Credits (AFT Cashable To Host)
     uint64_t transferredCred = machine->getMeter(SASConstants::METER_AFT_CASHABLE_OUT);
-    std::vector<uint8_t> transferredCredBCD = BCD::encode(transferredCred, 4);
-    response.data.insert(response.data.end(), transferredCredBCD.begin(), transferredCredBCD.end());
+    response.data.appendBCD(transferredCred, 4);
 
     // Cashable Credits (AFT Cashable To Game)
     uint64_t cashableCred = machine->getMeter(SASConstants::METER_AFT_CASHABLE_IN);
-    std::vector<uint8_t> cashableCredBCD = BCD::encode(cashableCred, 4);
-    response.data.insert(response.data.end(), cashableCredBCD.begin(), cashableCredBCD.end());
+    response.data.appendBCD(cashableCred, 4);
 
-    utils::Logger::log("[0x1D] AFT Registration Meters response built");
+    LOG(AFT, DEBUG, "[0x1D] AFT Registration Meters response built");
     return response;
 }
 
@@ -533,8 +547,7 @@ Message AFTCommands::handleSendNonCashablePromoCredits(simulator::Machine* machi
     response.command = 0x27;
 
     uint64_t ncepCredits = machine->getMeter(SASConstants::METER_NCEP_CREDITS);
-    std::vector<uint8_t> ncepBCD = BCD::encode(ncepCredits, 4);
-    response.data = ncepBCD;
+    response.data.appendBCD(ncepCredits, 4);
 
     return response;
 }
@@ -8,6 +8,23 @@
 namespace sas {
 namespace commands {
 
+Message ConfigCommands::handleSendGameNumber(simulator::Machine* machine) {
+    if (!machine) {
+        return Message();
+    }
+
+    Message response;
+    response.address = 1;
+    response.command = LongPoll::SEND_GAME_NUMBER;
+
+    // Get first enabled game number, or 1 if no games
+    const auto& games = machine->getGames();
+    int gameNum = games.empty() ? 1 : games[0]->getGameNumber();
+    response.data.push_back(static_cast<uint8_t>(gameNum));
+
+    return response;
+}
+
 Message ConfigCommands::handleSendMachineID(simulator::Machine* machine) {
     if (!machine) {
         return Message();
@@ -54,16 +71,16 @@ Message ConfigCommands::handleSendMachineID(simulator::Machine* machine) {
         response.data.push_back(static_cast<uint8_t>(c));
     }
 
-    utils::Logger::log("[0x54] Machine ID Response:");
-    utils::Logger::log("  SAS Version: " + sasVersion);
-    utils::Logger::log("  Serial: " + serialNumber);
-    utils::Logger::log("  Length byte: 0x" +
-        [](uint8_t val) {
+    LOG(CONFIG, DEBUG, "[0x54] Machine ID Response:");
+    LOG(CONFIG, DEBUG, "  SAS Version: " << sasVersion);
+    LOG(CONFIG, DEBUG, "  Serial: " << serialNumber);
+    LOG(CONFIG, DEBUG, "  Length byte: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
         }(lengthByte));
-    utils::Logger::log("  Total data bytes: " + std::to_string(response.data.size()));
+    LOG(CONFIG, DEBUG, "  Total data bytes: " << response.data.size());
 
     return response;
 }
@@ -82,14 +99,13 @@ Message ConfigCommands::handleSendNumberOfGames(simulator::Machine* machine) {
     response.command = 0x51;
 
     // Get total number of games (sub-games) implemented
-    auto games = machine->getGames();
+    const auto& games = machine->getGames();
     int numGames = static_cast<int>(games.size());
 
     // Encode as 2-byte BCD (max 99 games)
-    std::vector<uint8_t> numGamesBCD = BCD::encode(numGames, 2);
-    response.data = numGamesBCD;
+    response.data.appendBCD(numGames, 2);
 
-    utils::Logger::log("[0x51] Number of Games: " + std::to_string(numGames));
+    LOG(CONFIG, DEBUG, "[0x51] Number of Games: " << numGames);
     return response;
 }
 
@@ -107,7 +123,7 @@ Message ConfigCommands::handleSendSelectedGameNumber(simulator::Machine* machine
     response.command = 0x55;
 
     // Get currently selected game number
-    auto games = machine->getGames();
+    const auto& games = machine->getGames();
     int selectedGame = 0;  // Default to game 0 (main EGM)
 
     if (!games.empty()) {
@@ -116,14 +132,13 @@ Message ConfigCommands::handleSendSelectedGameNumber(simulator::Machine* machine
     }
 
     // Encode as 2-byte BCD
-    std::vector<uint8_t> selectedGameBCD = BCD::encode(selectedGame, 2);
-    response.data = selectedGameBCD;
+    response.data.appendBCD(selectedGame, 2);
 
-    utils::Logger::log("[0x55] Selected Game Number: " + std::to_string(selectedGame));
+    LOG(CONFIG, DEBUG, "[0x55] Selected Game Number: " << selectedGame);
     return response;
 }
 
-Message ConfigCommands::handleSendGameNConfiguration(simulator::Machine* machine, const std::vector<uint8_t>& data) {
+Message ConfigCommands::handleSendGameNConfiguration(simulator::Machine* machine, const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -137,14 +152,14 @@ Message ConfigCommands::handleSendGameNConfiguration(simulator::Machine* machine
 
     // Parse game number from input data
     if (data.size() < 2) {
-        utils::Logger::log("[0x53] ERROR: Insufficient data for game number");
+        LOG(CONFIG, ERROR, "[0x53] ERROR: Insufficient data for game number");
         return Message();
     }
 
     // Decode BCD game number (2 bytes)
     uint64_t gameNumber = BCD::decode(data.data(), 2);
 
-    utils::Logger::log("[0x53] Send Game N Configuration for game " + std::to_string(gameNumber));
+    LOG(CONFIG, DEBUG, "[0x53] Send Game N Configuration for game " << gameNumber);
 
     Message response;
     response.address = 1;
@@ -169,14 +184,13 @@ Message ConfigCommands::handleSendGameNConfiguration(simulator::Machine* machine
     response.data.push_back(0x00);
 
     // Get game denomination from first game (or default to penny)
-    auto games = machine->getGames();
-    double denom = 0.01;  // Default penny
+    const auto& games = machine->getGames();
+    int denomCode = 1;  // Default penny
     if (!games.empty() && gameNumber < games.size()) {
-        denom = games[gameNumber]->getDenom();
+        denomCode = games[gameNumber]->getDenomCode();
     }
 
     // Denomination code (1 byte)
-    int denomCode = SASConstants::DENOMINATIONS.getDenomCodeByDenomination(denom);
     response.data.push_back(static_cast<uint8_t>(denomCode));
 
     // Max Bet (1 byte - credits)
@@ -202,7 +216,7 @@ Message ConfigCommands::handleSendGameNConfiguration(simulator::Machine* machine
     response.data.push_back(0x95);
     response.data.push_back(0x00);
 
-    utils::Logger::log("[0x53] Response data size: " + std::to_string(response.data.size()) + " bytes (expecting 23: 1 length + 22 data)");
+    LOG(CONFIG, DEBUG, "[0x53] Response data size: " << response.data.size() << " bytes (expecting 23: 1 length + 22 data)");
 
     return response;
 }
@@ -221,10 +235,10 @@ Message ConfigCommands::handleSendEnabledGameNumbers(simulator::Machine* machine
     response.command = 0x56;
 
     // Get all enabled games
-    auto games = machine->getGames();
+    const auto& games = machine->getGames();
     uint8_t numGames = static_cast<uint8_t>(games.size());
 
-    utils::Logger::log("[0x56] Send Enabled Game Numbers: " + std::to_string(numGames) + " games");
+    LOG(CONFIG, DEBUG, "[0x56] Send Enabled Game Numbers: " << (int)numGames << " games");
 
     // Calculate length byte (1 byte for count + 2 bytes per game)
     uint8_t lengthByte = 1 + (numGames * 2);
@@ -236,19 +250,18 @@ Message ConfigCommands::handleSendEnabledGameNumbers(simulator::Machine* machine
     // Add each game number (2 bytes BCD each)
     for (const auto& game : games) {
         int gameNum = game->getGameNumber();
-        std::vector<uint8_t> gameNumBCD = BCD::encode(gameNum, 2);
-        response.data.insert(response.data.end(), gameNumBCD.begin(), gameNumBCD.end());
+        response.data.appendBCD(gameNum, 2);
 
-        utils::Logger::log("[0x56]   Game " + std::to_string(gameNum) + " enabled");
+        LOG(CONFIG, DEBUG, "[0x56]   Game " << gameNum << " enabled");
     }
 
-    utils::Logger::log("[0x56] Response data size: " + std::to_string(response.data.size()) +
-                      " bytes (1 length + 1 count + " + std::to_string(numGames * 2) + " game data)");
+    LOG(CONFIG, DEBUG, "[0x56] Response data size: " << response.data.size()
+        << " bytes (1 length + 1 count + " << (numGames * 2) << " game data)");
 
     return response;
 }
 
-Message ConfigCommands::handleEnableDisableGameN(simulator::Machine* machine, const std::vector<uint8_t>& data) {
+Message ConfigCommands::handleEnableDisableGameN(simulator::Machine* machine, const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -260,14 +273,14 @@ Message ConfigCommands::handleEnableDisableGameN(simulator::Machine* machine, co
 
     // Parse game number from input data
     if (data.size() < 2) {
-        utils::Logger::log("[0xA0] ERROR: Insufficient data for game number");
+        LOG(CONFIG, ERROR, "[0xA0] ERROR: Insufficient data for game number");
         return Message();
     }
 
     // Decode BCD game number (2 bytes)
     uint64_t gameNumber = BCD::decode(data.data(), 2);
 
-    utils::Logger::log("[0xA0] Enable/Disable Game N for game " + std::to_string(gameNumber));
+    LOG(CONFIG, DEBUG, "[0xA0] Enable/Disable Game N for game " << gameNumber);
 
     Message response;
     response.address = 1;
@@ -317,25 +330,25 @@ Message ConfigCommands::handleEnableDisableGameN(simulator::Machine* machine, co
     response.data.push_back(0x00);
     response.data.push_back(0x00);
 
-    utils::Logger::log("[0xA0] Gaming Machine Capabilities:");
-    utils::Logger::log("  Flags1: 0x" +
-        [](uint8_t val) {
+    LOG(CONFIG, DEBUG, "[0xA0] Gaming Machine Capabilities:");
+    LOG(CONFIG, DEBUG, "  Flags1: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(flags1) + " (Jackpot Mult, AFT Bonus, Legacy Bonus, Validation, Ticket Redemption)");
-    utils::Logger::log("  Flags2: 0x" +
-        [](uint8_t val) {
+        }(flags1) << " (Jackpot Mult, AFT Bonus, Legacy Bonus, Validation, Ticket Redemption)");
+    LOG(CONFIG, DEBUG, "  Flags2: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(flags2) + " (SAS4 Meters, Tickets to Drop, Extended Meters, AFT, Multi-Denom)");
-    utils::Logger::log("  Flags3: 0x" +
-        [](uint8_t val) {
+        }(flags2) << " (SAS4 Meters, Tickets to Drop, Extended Meters, AFT, Multi-Denom)");
+    LOG(CONFIG, DEBUG, "  Flags3: 0x"
+        << [](uint8_t val) {
             char buf[3];
             snprintf(buf, sizeof(buf), "%02X", val);
             return std::string(buf);
-        }(flags3) + " (40ms polling, Multi-level progressive)");
+        }(flags3) << " (40ms polling, Multi-level progressive)");
 
     return response;
 }
@@ -16,14 +16,13 @@ Message DateTimeCommands::handleSendDateTime(simulator::Machine* machine) {
     response.command = LongPoll::SEND_DATE_TIME;
 
     // Get current date/time in BCD format
-    std::vector<uint8_t> dateTimeBCD = getCurrentDateTimeBCD();
-    response.data = dateTimeBCD;
+    appendCurrentDateTimeBCD(response.data);
 
     return response;
 }
 
 Message DateTimeCommands::handleSetDateTime(simulator::Machine* machine,
-                                           const std::vector<uint8_t>& data) {
+                                           const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -40,16 +39,15 @@ Message DateTimeCommands::handleSetDateTime(simulator::Machine* machine,
     return response;
 }
 
-std::vector<uint8_t> DateTimeCommands::getCurrentDateTimeBCD() {
-    std::vector<uint8_t> result;
-
+void DateTimeCommands::appendCurrentDateTimeBCD(MessageData& result) {
     // Get current system time
     time_t now = time(nullptr);
     struct tm* timeinfo = localtime(&now);
 
     if (!timeinfo) {
         // Error - return zeros
-        return std::vector<uint8_t>(9, 0);
+        result.appendSpace(9);
+        return;
     }
 
     // SAS Date/Time format (9 bytes total):
@@ -70,8 +68,7 @@ std::vector<uint8_t> DateTimeCommands::getCurrentDateTimeBCD() {
 
     // Year (YYYY) - 2 bytes BCD
     int year = timeinfo->tm_year + 1900;  // tm_year is years since 1900
-    std::vector<uint8_t> yearBCD = BCD::encode(year, 2);
-    result.insert(result.end(), yearBCD.begin(), yearBCD.end());
+    result.appendBCD(year, 2);
 
     // Hour (00-23)
     uint8_t hour = timeinfo->tm_hour;
@@ -84,8 +81,6 @@ std::vector<uint8_t> DateTimeCommands::getCurrentDateTimeBCD() {
     // Second (00-59)
     uint8_t second = timeinfo->tm_sec;
     result.push_back(BCD::toBCD(second));
-
-    return result;
 }
 
 } // namespace commands
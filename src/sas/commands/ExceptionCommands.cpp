@@ -1,9 +1,12 @@
 #include "sas/commands/ExceptionCommands.h"
+#include "sas/BCD.h"
 
 
 namespace sas {
 namespace commands {
 
+constexpr uint8_t ExceptionCommands::BILL_COUNTRY_CODE;
+
 Message ExceptionCommands::handleGeneralPoll(io::MachineCommPort* port) {
     if (!port || !port->hasExceptions()) {
         // No exceptions - return empty response (NAK)
@@ -84,6 +87,43 @@ void ExceptionCommands::queueRAMError(io::MachineCommPort* port) {
     }
 }
 
+size_t ExceptionCommands::encodeGameStarted(uint8_t* data, uint64_t creditsWagered, uint64_t coinInMeter,
+                                            uint8_t wagerType, uint8_t progressiveGroup) {
+    encodeMeterBCD(creditsWagered, data, 2);
+    encodeMeterBCD(coinInMeter, data + 2, 4);
+    data[6] = wagerType;
+    data[7] = progressiveGroup;
+    return 8;
+}
+
+size_t ExceptionCommands::encodeGameEnded(uint8_t* data, uint64_t gameWin) {
+    encodeMeterBCD(gameWin, data, 4);
+    return 4;
+}
+
+size_t ExceptionCommands::encodeBillAccepted(uint8_t* data, uint8_t countryCode, uint8_t denominationCode,
+                                             uint64_t billCount) {
+    data[0] = BCD::toBCD(countryCode);
+    data[1] = BCD::toBCD(denominationCode);
+    encodeMeterBCD(billCount, data + 2, 4);
+    return 6;
+}
+
+Message ExceptionCommands::buildRealTimeEventResponse(uint8_t address, uint8_t exceptionCode,
+                                                      const uint8_t* data, size_t length) {
+    Message response;
+    response.address = address;
+    response.command = LongPoll::SEND_REAL_TIME_EVENT;
+    response.data.push_back(exceptionCode);
+    response.data.append(data, length);
+    return response;
+}
+
+void ExceptionCommands::encodeMeterBCD(uint64_t value, uint8_t* data, size_t numBytes) {
+    // Meters roll over at the field width, like the meter long polls
+    BCD::encodeTo(value % (BCD::maxValue(numBytes) + 1), data, numBytes);
+}
+
 Message ExceptionCommands::buildExceptionResponse(uint8_t address, uint8_t exceptionCode) {
     Message response;
     response.address = address;
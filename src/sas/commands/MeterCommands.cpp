@@ -122,36 +122,31 @@ Message MeterCommands::handleSendTotalCoinInAndMeters(simulator::Machine* machin
 
     // Coin In (4 bytes BCD)
     uint64_t coinIn = machine->getMeter(SASConstants::METER_COIN_IN);
-    utils::Logger::log("[0x19] CoinIn meter value: " + std::to_string(coinIn));
-    std::vector<uint8_t> coinInBCD = BCD::encode(coinIn, 4);
-    response.data.insert(response.data.end(), coinInBCD.begin(), coinInBCD.end());
+    LOG(METERS, DEBUG, "[0x19] CoinIn meter value: " << coinIn);
+    response.data.appendBCD(coinIn, 4);
 
     // Coin Out (4 bytes BCD)
     uint64_t coinOut = machine->getMeter(SASConstants::METER_COIN_OUT);
-    utils::Logger::log("[0x19] CoinOut meter value: " + std::to_string(coinOut));
-    std::vector<uint8_t> coinOutBCD = BCD::encode(coinOut, 4);
-    response.data.insert(response.data.end(), coinOutBCD.begin(), coinOutBCD.end());
+    LOG(METERS, DEBUG, "[0x19] CoinOut meter value: " << coinOut);
+    response.data.appendBCD(coinOut, 4);
 
     // Total Drop (4 bytes BCD) - use TOT_DROP meter (0x0F)
     uint64_t totalDrop = machine->getMeter(SASConstants::METER_TOT_DROP);
-    utils::Logger::log("[0x19] TotalDrop meter value: " + std::to_string(totalDrop));
-    std::vector<uint8_t> totalDropBCD = BCD::encode(totalDrop, 4);
-    response.data.insert(response.data.end(), totalDropBCD.begin(), totalDropBCD.end());
+    LOG(METERS, DEBUG, "[0x19] TotalDrop meter value: " << totalDrop);
+    response.data.appendBCD(totalDrop, 4);
 
     // Jackpot (4 bytes BCD)
     uint64_t jackpot = machine->getMeter(SASConstants::METER_JACKPOT);
-    utils::Logger::log("[0x19] Jackpot meter value: " + std::to_string(jackpot));
-    std::vector<uint8_t> jackpotBCD = BCD::encode(jackpot, 4);
-    response.data.insert(response.data.end(), jackpotBCD.begin(), jackpotBCD.end());
+    LOG(METERS, DEBUG, "[0x19] Jackpot meter value: " << jackpot);
+    response.data.appendBCD(jackpot, 4);
 
     // Games Played (4 bytes BCD)
     uint64_t gamesPlayed = machine->getMeter(SASConstants::METER_GAMES_PLAYED);
-    utils::Logger::log("[0x19] GamesPlayed meter value: " + std::to_string(gamesPlayed));
-    std::vector<uint8_t> gamesPlayedBCD = BCD::encode(gamesPlayed, 4);
-    response.data.insert(response.data.end(), gamesPlayedBCD.begin(), gamesPlayedBCD.end());
+    LOG(METERS, DEBUG, "[0x19] GamesPlayed meter value: " << gamesPlayed);
+    response.data.appendBCD(gamesPlayed, 4);
 
-    utils::Logger::log("[0x19] Response has " + std::to_string(response.data.size()) + " bytes of data (expecting 20)");
-    utils::Logger::log("[0x19] Expected: 01 19 00 45 20 40 00 86 14 80 00 41 30 78 00 63 44 94 00 00 20 62 D5 CE");
+    LOG(METERS, DEBUG, "[0x19] Response has " << response.data.size() << " bytes of data (expecting 20)");
+    LOG(METERS, DEBUG, "[0x19] Expected: 01 19 00 45 20 40 00 86 14 80 00 41 30 78 00 63 44 94 00 00 20 62 D5 CE");
 
     return response;
 }
@@ -177,12 +172,16 @@ Message MeterCommands::handleSendSelectedMeters(simulator::Machine* machine,
         return Message();
     }
 
-    std::vector<uint64_t> meterValues;
+    Message response;
+    response.address = 1;
+    response.command = LongPoll::SEND_SELECTED_METERS;
+
+    // Each meter is 4 bytes BCD
     for (uint8_t code : meterCodes) {
-        meterValues.push_back(machine->getMeter(code));
+        response.data.appendBCD(machine->getMeter(code), 4);
     }
 
-    return buildMultiMeterResponse(1, LongPoll::SEND_SELECTED_METERS, meterValues);
+    return response;
 }
 
 Message MeterCommands::handleSendGameConfiguration(simulator::Machine* machine) {
@@ -213,10 +212,10 @@ Message MeterCommands::handleSendGameConfiguration(simulator::Machine* machine)
     response.command = LongPoll::SEND_GAME_CONFIG;
 
     // Get current game configuration
-    auto games = machine->getGames();
-    double denom = 0.01;  // Default penny
+    const auto& games = machine->getGames();
+    int denomCode = 1;  // Default penny
     if (!games.empty()) {
-        denom = games[0]->getDenom();
+        denomCode = games[0]->getDenomCode();
     }
 
     // Game ID (2 bytes ASCII - use "01" for testing)
@@ -229,7 +228,6 @@ Message MeterCommands::handleSendGameConfiguration(simulator::Machine* machine)
     response.data.push_back(0x00);
 
     // Denomination code (1 byte)
-    int denomCode = SASConstants::DENOMINATIONS.getDenomCodeByDenomination(denom);
     response.data.push_back(static_cast<uint8_t>(denomCode));
 
     // Max Bet (1 byte - credits)
@@ -255,12 +253,12 @@ Message MeterCommands::handleSendGameConfiguration(simulator::Machine* machine)
     response.data.push_back(0x95);
     response.data.push_back(0x00);
 
-    utils::Logger::log("[0x1F] Game Configuration Response:");
-    utils::Logger::log("  Game ID: 01");
-    utils::Logger::log("  Denomination: " + std::to_string(denom));
-    utils::Logger::log("  Max Bet: " + std::to_string(maxBet));
-    utils::Logger::log("  Base Percent: 95.00%");
-    utils::Logger::log("  Total data bytes: " + std::to_string(response.data.size()) + " (expecting 22)");
+    LOG(METERS, DEBUG, "[0x1F] Game Configuration Response:");
+    LOG(METERS, DEBUG, "  Game ID: 01");
+    LOG(METERS, DEBUG, "  Denomination: " << simulator::denomination::valueOf(denomCode) << " (code " << denomCode << ")");
+    LOG(METERS, DEBUG, "  Max Bet: " << maxBet);
+    LOG(METERS, DEBUG, "  Base Percent: 95.00%");
+    LOG(METERS, DEBUG, "  Total data bytes: " << response.data.size() << " (expecting 22)");
 
     return response;
 }
@@ -272,22 +270,20 @@ Message MeterCommands::buildMeterResponse(uint8_t address, uint8_t command,
     response.command = command;
 
     // SAS meters are 4 bytes (8 BCD digits) = 0-99,999,999
-    std::vector<uint8_t> bcdValue = BCD::encode(meterValue, 4);
-    response.data = bcdValue;
+    response.data.appendBCD(meterValue, 4);
 
     return response;
 }
 
 Message MeterCommands::buildMultiMeterResponse(uint8_t address, uint8_t command,
-                                              const std::vector<uint64_t>& meterValues) {
+                                              const uint64_t* meterValues, size_t count) {
     Message response;
     response.address = address;
     response.command = command;
 
     // Each meter is 4 bytes BCD
-    for (uint64_t value : meterValues) {
-        std::vector<uint8_t> bcdValue = BCD::encode(value, 4);
-        response.data.insert(response.data.end(), bcdValue.begin(), bcdValue.end());
+    for (size_t i = 0; i < count; i++) {
+        response.data.appendBCD(meterValues[i], 4);
     }
 
     return response;
@@ -449,16 +445,25 @@ Message MeterCommands::handleSendBillMeters(simulator::Machine* machine) {
     // Response format (28 bytes total):
     // [Address][0x1E][$1(4)][$5(4)][$10(4)][$20(4)][$50(4)][$100(4)][CRC(2)]
 
-    std::vector<uint64_t> billMeters = {
-        machine->getMeter(SASConstants::METER_1_BILLS_ACCEPTED),
-        machine->getMeter(SASConstants::METER_5_BILLS_ACCEPTED),
-        machine->getMeter(SASConstants::METER_10_BILLS_ACCEPTED),
-        machine->getMeter(SASConstants::METER_20_BILLS_ACCEPTED),
-        machine->getMeter(SASConstants::METER_50_BILLS_ACCEPTED),
-        machine->getMeter(SASConstants::METER_100_BILLS_ACCEPTED)
+    static const int billMeterCodes[] = {
+        SASConstants::METER_1_BILLS_ACCEPTED,
+        SASConstants::METER_5_BILLS_ACCEPTED,
+        SASConstants::METER_10_BILLS_ACCEPTED,
+        SASConstants::METER_20_BILLS_ACCEPTED,
+        SASConstants::METER_50_BILLS_ACCEPTED,
+        SASConstants::METER_100_BILLS_ACCEPTED
     };
+    const size_t count = sizeof(billMeterCodes) / sizeof(billMeterCodes[0]);
+
+    // One snapshot so the six meters are mutually consistent
+    int64_t values[count];
+    machine->getMeters(billMeterCodes, values);
 
-    return buildMultiMeterResponse(1, 0x1E, billMeters);
+    uint64_t billMeters[count];
+    for (size_t i = 0; i < count; i++) {
+        billMeters[i] = values[i];
+    }
+    return buildMultiMeterResponse(1, 0x1E, billMeters, count);
 }
 
 Message MeterCommands::handleSendGamingMachineMeters(simulator::Machine* machine) {
@@ -471,21 +476,30 @@ Message MeterCommands::handleSendGamingMachineMeters(simulator::Machine* machine
     // [Address][0x1C][CoinIn(4)][CoinOut(4)][TotalDrop(4)][Jackpot(4)]
     //                [GamesPlayed(4)][GamesWon(4)][SlotDoor(4)][PowerReset(4)][CRC(2)]
 
-    std::vector<uint64_t> machineMeters = {
-        machine->getMeter(SASConstants::METER_COIN_IN),         // Coin In
-        machine->getMeter(SASConstants::METER_COIN_OUT),         // Coin Out
-        machine->getMeter(SASConstants::METER_TOT_DROP),  // Total Drop
-        machine->getMeter(SASConstants::METER_JACKPOT),         // Jackpot
-        machine->getMeter(SASConstants::METER_GAMES_PLAYED),         // Games Played
-        machine->getMeter(SASConstants::METER_GAMES_WON),         // Games Won
-        machine->getMeter(SASConstants::METER_ACTUAL_SLOT_DOOR),  // Slot Door
-        0  // Power Reset meter (TODO: implement power reset tracking)
+    static const int machineMeterCodes[] = {
+        SASConstants::METER_COIN_IN,            // Coin In
+        SASConstants::METER_COIN_OUT,           // Coin Out
+        SASConstants::METER_TOT_DROP,           // Total Drop
+        SASConstants::METER_JACKPOT,            // Jackpot
+        SASConstants::METER_GAMES_PLAYED,       // Games Played
+        SASConstants::METER_GAMES_WON,          // Games Won
+        SASConstants::METER_ACTUAL_SLOT_DOOR    // Slot Door
     };
+    const size_t count = sizeof(machineMeterCodes) / sizeof(machineMeterCodes[0]);
+
+    int64_t values[count];
+    machine->getMeters(machineMeterCodes, values);
 
-    return buildMultiMeterResponse(1, 0x1C, machineMeters);
+    uint64_t machineMeters[count + 1];
+    for (size_t i = 0; i < count; i++) {
+        machineMeters[i] = values[i];
+    }
+    machineMeters[count] = 0;  // Power Reset meter (TODO: implement power reset tracking)
+
+    return buildMultiMeterResponse(1, 0x1C, machineMeters, count + 1);
 }
 
-Message MeterCommands::handleSendSelectedGameMeters(simulator::Machine* machine, const std::vector<uint8_t>& data) {
+Message MeterCommands::handleSendSelectedGameMeters(simulator::Machine* machine, const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -497,14 +511,14 @@ Message MeterCommands::handleSendSelectedGameMeters(simulator::Machine* machine,
 
     // Parse game number from input data
     if (data.size() < 2) {
-        utils::Logger::log("[0x52] ERROR: Insufficient data for game number");
+        LOG(METERS, ERROR, "[0x52] ERROR: Insufficient data for game number");
         return Message();
     }
 
     // Decode BCD game number (2 bytes)
     uint64_t gameNumber = BCD::decode(data.data(), 2);
 
-    utils::Logger::log("[0x52] Send Selected Game Meters for game " + std::to_string(gameNumber));
+    LOG(METERS, DEBUG, "[0x52] Send Selected Game Meters for game " << gameNumber);
 
     Message response;
     response.address = 1;
@@ -514,154 +528,105 @@ Message MeterCommands::handleSendSelectedGameMeters(simulator::Machine* machine,
     response.data.push_back(data[0]);
     response.data.push_back(data[1]);
 
-    // Get meters based on game number
-    // Game 0 = EGM (main game), uses gCI, gCO, gJP, gGS
-    // Game 1+ = Sub-games, uses SUBGAME_METER_* constants
-
-    uint64_t coinIn = 0;
-    uint64_t coinOut = 0;
-    uint64_t jackpot = 0;
-    uint64_t gamesPlayed = 0;
-
-    if (gameNumber == 0) {
-        // Main EGM game meters
-        coinIn = machine->getMeter(SASConstants::METER_COIN_IN);
-        coinOut = machine->getMeter(SASConstants::METER_COIN_OUT);
-        jackpot = machine->getMeter(SASConstants::METER_JACKPOT);
-        gamesPlayed = machine->getMeter(SASConstants::METER_GAMES_PLAYED);
-    } else {
-        // Sub-game meters
-        // Note: In a full implementation, you'd select the sub-game and get its specific meters
-        // For now, use the sub-game meter constants (same as main game in simplified implementation)
-        // Subgame meters use the same METER_* codes as main game for now (simplified implementation)
-        coinIn = machine->getMeter(SASConstants::METER_COIN_IN);
-        coinOut = machine->getMeter(SASConstants::METER_COIN_OUT);
-        jackpot = machine->getMeter(SASConstants::METER_JACKPOT);
-        gamesPlayed = machine->getMeter(SASConstants::METER_GAMES_PLAYED);
+    // Game 0 = EGM (machine totals), game 1+ = that game's meter block
+    static const int gameMeterCodes[] = {
+        SASConstants::METER_COIN_IN,
+        SASConstants::METER_COIN_OUT,
+        SASConstants::METER_JACKPOT,
+        SASConstants::METER_GAMES_PLAYED
+    };
+
+    int64_t values[4];
+    if (!machine->getGameMeters(static_cast<int>(gameNumber), gameMeterCodes, 4, values)) {
+        LOG(METERS, WARN, "[0x52] Game " << gameNumber << " not configured, no response");
+        return Message();
     }
 
+    uint64_t coinIn = values[0];
+    uint64_t coinOut = values[1];
+    uint64_t jackpot = values[2];
+    uint64_t gamesPlayed = values[3];
+
     // Coin In (4 bytes BCD)
-    std::vector<uint8_t> coinInBCD = BCD::encode(coinIn, 4);
-    response.data.insert(response.data.end(), coinInBCD.begin(), coinInBCD.end());
+    response.data.appendBCD(coinIn, 4);
 
     // Coin Out (4 bytes BCD)
-    std::vector<uint8_t> coinOutBCD = BCD::encode(coinOut, 4);
-    response.data.insert(response.data.end(), coinOutBCD.begin(), coinOutBCD.end());
+    response.data.appendBCD(coinOut, 4);
 
     // Jackpot (4 bytes BCD)
-    std::vector<uint8_t> jackpotBCD = BCD::encode(jackpot, 4);
-    response.data.insert(response.data.end(), jackpotBCD.begin(), jackpotBCD.end());
+    response.data.appendBCD(jackpot, 4);
 
     // Games Played (4 bytes BCD)
-    std::vector<uint8_t> gamesPlayedBCD = BCD::encode(gamesPlayed, 4);
-    response.data.insert(response.data.end(), gamesPlayedBCD.begin(), gamesPlayedBCD.end());
+    response.data.appendBCD(gamesPlayed, 4);
 
-    utils::Logger::log("[0x52] Response data size: " + std::to_string(response.data.size()) + " bytes (expecting 18: 2 game# + 16 meters)");
+    LOG(METERS, DEBUG, "[0x52] Response data size: " << response.data.size() << " bytes (expecting 18: 2 game# + 16 meters)");
 
     return response;
 }
 
-Message MeterCommands::handleSendSelectedMetersForGameN(simulator::Machine* machine, const std::vector<uint8_t>& data) {
+Message MeterCommands::handleSendSelectedMetersForGameN(simulator::Machine* machine, const MessageData& data) {
     if (!machine) {
         return Message();
     }
 
     // 0x2F: Send Selected Meters for Game N
-    // Input: [Game Number (2 BCD)][Meter Code 1]...[Meter Code N]
+    // Input: [Length][Game Number (2 BCD)][Meter Code 1]...[Meter Code N]
     // Response: [Addr][0x2F][Length][Game Number (2)][Code1][Value1(4)]...[CRC]
 
-    // Parse game number from first 2 bytes
-    if (data.size() < 2) {
-        utils::Logger::log("[0x2F] ERROR: Insufficient data for game number");
+    // Parse game number (skip length byte)
+    if (data.size() < 3) {
+        LOG(METERS, ERROR, "[0x2F] ERROR: Insufficient data for game number");
         return Message();
     }
 
-    uint64_t gameNumber = BCD::decode(data.data(), 2);
+    uint64_t gameNumber = BCD::decode(data.data() + 1, 2);
 
-    // Extract meter codes (everything after game number)
-    std::vector<uint8_t> meterCodes;
-    for (size_t i = 2; i < data.size(); i++) {
-        meterCodes.push_back(data[i]);
-    }
+    // Meter codes are everything after game number
+    const uint8_t* meterCodes = data.data() + 3;
+    size_t numMeterCodes = data.size() - 3;
 
-    utils::Logger::log("[0x2F] Send Selected Meters for Game " + std::to_string(gameNumber) +
-                      ", " + std::to_string(meterCodes.size()) + " meter codes requested");
+    LOG(METERS, DEBUG, "[0x2F] Send Selected Meters for Game " << gameNumber
+        << ", " << numMeterCodes << " meter codes requested");
+
+    if (!machine->hasGameMeters(static_cast<int>(gameNumber))) {
+        LOG(METERS, WARN, "[0x2F] Game " << gameNumber << " not configured, no response");
+        return Message();
+    }
 
     Message response;
     response.address = 1;
     response.command = 0x2F;
 
-    // We'll build the response data first, then calculate length
-    std::vector<uint8_t> responseData;
+    // Length byte placeholder - patched once the data is built
+    response.data.push_back(0);
 
     // Echo back game number (2 bytes BCD)
-    responseData.push_back(data[0]);
-    responseData.push_back(data[1]);
+    response.data.push_back(data[1]);
+    response.data.push_back(data[2]);
 
     // For each requested meter code, add code + value
-    for (uint8_t meterCode : meterCodes) {
-        // Add meter code
-        responseData.push_back(meterCode);
-
-        // Get meter value based on code
-        // This is a simplified mapping - full implementation would use SASPollMessage meter mapping
-        uint64_t meterValue = 0;
+    for (size_t i = 0; i < numMeterCodes; i++) {
+        uint8_t meterCode = meterCodes[i];
 
-        // Map common SAS meter codes to internal meter numbers
-        switch (meterCode) {
-            case 0x00:  // Total Coin In
-                meterValue = machine->getMeter(SASConstants::METER_COIN_IN);
-                break;
-            case 0x01:  // Total Coin Out
-                meterValue = machine->getMeter(SASConstants::METER_COIN_OUT);
-                break;
-            case 0x02:  // Total Drop
-                meterValue = machine->getMeter(SASConstants::METER_TOT_DROP);
-                break;
-            case 0x03:  // Total Jackpot
-                meterValue = machine->getMeter(SASConstants::METER_JACKPOT);
-                break;
-            case 0x04:  // Games Played
-                meterValue = machine->getMeter(SASConstants::METER_GAMES_PLAYED);
-                break;
-            case 0x05:  // Games Won
-                meterValue = machine->getMeter(SASConstants::METER_GAMES_WON);
-                break;
-            case 0x0C:  // Current Credits
-                meterValue = machine->getMeter(SASConstants::METER_CURRENT_CRD);
-                break;
-            default:
-                // Unknown meter code - return 0
-                utils::Logger::log("[0x2F]   Meter code 0x" +
-                    [](uint8_t val) {
-                        char buf[3];
-                        snprintf(buf, sizeof(buf), "%02X", val);
-                        return std::string(buf);
-                    }(meterCode) + " not implemented, returning 0");
-                meterValue = 0;
-                break;
-        }
+        // Add meter code
+        response.data.push_back(meterCode);
 
         // Add meter value (4 bytes BCD for standard meters)
         // Note: Some TITO meters use 5 bytes, but we'll use 4 for simplicity
-        std::vector<uint8_t> valueBCD = BCD::encode(meterValue, 4);
-        responseData.insert(responseData.end(), valueBCD.begin(), valueBCD.end());
+        response.data.appendBCD(readSelectedMeter(machine, static_cast<int>(gameNumber), meterCode), 4);
     }
 
-    // Calculate length byte (all data following length byte, excluding CRC)
-    uint8_t lengthByte = static_cast<uint8_t>(responseData.size());
-
-    // Build final response: [Length][...responseData...]
-    response.data.push_back(lengthByte);
-    response.data.insert(response.data.end(), responseData.begin(), responseData.end());
+    // Length byte (all data following length byte, excluding CRC)
+    size_t dataLength = response.data.size() - 1;
+    response.data[0] = static_cast<uint8_t>(dataLength);
 
-    utils::Logger::log("[0x2F] Response data size: " + std::to_string(response.data.size()) +
-                      " bytes (1 length + " + std::to_string(responseData.size()) + " data)");
+    LOG(METERS, DEBUG, "[0x2F] Response data size: " << response.data.size()
+        << " bytes (1 length + " << dataLength << " data)");
 
     return response;
 }
 
-Message MeterCommands::handleSendHandpayCancelledCredits(simulator::Machine* machine, const std::vector<uint8_t>& data) {
+Message MeterCommands::handleSendHandpayCancelledCredits(simulator::Machine* machine, const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -671,13 +636,13 @@ Message MeterCommands::handleSendHandpayCancelledCredits(simulator::Machine* mac
     // Response: [Addr][0x2D][Cancelled Credits (4 BCD)][CRC]
 
     if (data.size() < 2) {
-        utils::Logger::log("[0x2D] ERROR: Insufficient data for game number");
+        LOG(METERS, ERROR, "[0x2D] ERROR: Insufficient data for game number");
         return Message();
     }
 
     uint64_t gameNumber = BCD::decode(data.data(), 2);
 
-    utils::Logger::log("[0x2D] Send Handpay Cancelled Credits for game " + std::to_string(gameNumber));
+    LOG(METERS, DEBUG, "[0x2D] Send Handpay Cancelled Credits for game " << gameNumber);
 
     // Get handpay cancelled credits meter (mHCC)
     uint64_t cancelledCredits = machine->getMeter(SASConstants::METER_HANDPAID_CANCELLED_CRD);
@@ -687,7 +652,7 @@ Message MeterCommands::handleSendHandpayCancelledCredits(simulator::Machine* mac
 
 Message MeterCommands::handleSendSelectedMetersForGameNExtended(simulator::Machine* machine,
                                                                 uint8_t command,
-                                                                const std::vector<uint8_t>& data) {
+                                                                const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -704,7 +669,7 @@ Message MeterCommands::handleSendSelectedMetersForGameNExtended(simulator::Machi
 
     // Parse length byte
     if (data.size() < 1) {
-        utils::Logger::log("[0x6F/AF] ERROR: No length byte provided");
+        LOG(METERS, ERROR, "[0x6F/AF] ERROR: No length byte provided");
         return Message();
     }
 
@@ -712,7 +677,7 @@ Message MeterCommands::handleSendSelectedMetersForGameNExtended(simulator::Machi
 
     // Parse game number from input data (2 BCD bytes)
     if (data.size() < 3) {
-        utils::Logger::log("[0x6F/AF] ERROR: Insufficient data for game number");
+        LOG(METERS, ERROR, "[0x6F/AF] ERROR: Insufficient data for game number");
         return Message();
     }
 
@@ -720,120 +685,89 @@ Message MeterCommands::handleSendSelectedMetersForGameNExtended(simulator::Machi
     uint64_t gameNumber = BCD::decode(&data[1], 2);
 
     // Extract meter codes (2 bytes each, little-endian, starting at offset 3)
-    std::vector<uint16_t> meterCodes;
+    const size_t MAX_METERS = 12;
+    uint16_t meterCodes[MAX_METERS];
+    size_t numMeterCodes = 0;
     for (size_t i = 3; i + 1 < data.size(); i += 2) {
         // Read as little-endian: LSB first, MSB second
         uint16_t meterCode = static_cast<uint16_t>(data[i]) | (static_cast<uint16_t>(data[i + 1]) << 8);
-        meterCodes.push_back(meterCode);
+        meterCodes[numMeterCodes++] = meterCode;
 
         // Limit to 12 meters max
-        if (meterCodes.size() >= 12) {
+        if (numMeterCodes >= MAX_METERS) {
             break;
         }
     }
 
-    utils::Logger::log("[0x6F/AF] Game " + std::to_string(gameNumber) +
-                      ", requesting " + std::to_string(meterCodes.size()) + " meters");
+    LOG(METERS, DEBUG, "[0x6F/AF] Game " << gameNumber
+        << ", requesting " << numMeterCodes << " meters");
+
+    if (!machine->hasGameMeters(static_cast<int>(gameNumber))) {
+        LOG(METERS, WARN, "[0x6F/AF] Game " << gameNumber << " not configured, no response");
+        return Message();
+    }
 
     Message response;
     response.address = 1;
     response.command = command;  // Echo back 0x6F or 0xAF
 
-    // Build response data
-    std::vector<uint8_t> responseData;
+    // Length byte placeholder - patched once the data is built
+    response.data.push_back(0);
 
     // Echo back game number (2 bytes BCD)
-    responseData.push_back(data[1]);
-    responseData.push_back(data[2]);
+    response.data.push_back(data[1]);
+    response.data.push_back(data[2]);
 
     // For each requested meter code, add: [Code (2)][Size (1)][Value (4 or 5 BCD)]
-    for (uint16_t meterCode : meterCodes) {
-        // Add meter code (2 bytes, little-endian: LSB first, MSB second)
-        responseData.push_back(static_cast<uint8_t>(meterCode & 0xFF));
-        responseData.push_back(static_cast<uint8_t>(meterCode >> 8));
+    for (size_t i = 0; i < numMeterCodes; i++) {
+        uint16_t meterCode = meterCodes[i];
 
-        // Map SAS meter code to internal meter number and get value
-        // For now, use a simplified mapping - most common meter codes:
-        uint64_t meterValue = 0;
-        uint8_t meterSize = 4;  // Default to 4 bytes BCD
+        // Add meter code (2 bytes, little-endian: LSB first, MSB second)
+        response.data.push_back(static_cast<uint8_t>(meterCode & 0xFF));
+        response.data.push_back(static_cast<uint8_t>(meterCode >> 8));
 
-        // Simple meter code mapping (based on common codes)
+        // TITO meters are 5 bytes BCD, the rest 4
+        uint8_t meterSize = 4;
         switch (meterCode) {
-            case 0x00:  // Coin In
-                meterValue = machine->getMeter(SASConstants::METER_COIN_IN);  // Same code for game 0 and subgames for now
-                break;
-            case 0x0C:  // Current Credits
-                meterValue = machine->getMeter(SASConstants::METER_CURRENT_CRD);
-                break;
-            case 0x1C:  // Coin Out
-                meterValue = machine->getMeter(SASConstants::METER_COIN_OUT);  // Same code for game 0 and subgames for now
-                break;
-            case 0x05:  // Games Played
-                meterValue = machine->getMeter(SASConstants::METER_GAMES_PLAYED);  // Same code for game 0 and subgames for now
-                break;
-            case 0x1F:  // Jackpot
-                meterValue = machine->getMeter(SASConstants::METER_JACKPOT);  // Same code for game 0 and subgames for now
-                break;
-            case 0x40:  // $1 Bills
-                meterValue = machine->getMeter(SASConstants::METER_1_BILLS_ACCEPTED);
-                break;
-            case 0x42:  // $5 Bills
-                meterValue = machine->getMeter(SASConstants::METER_5_BILLS_ACCEPTED);
-                break;
-            case 0x43:  // $10 Bills
-                meterValue = machine->getMeter(SASConstants::METER_10_BILLS_ACCEPTED);
-                break;
-            case 0x44:  // $20 Bills
-                meterValue = machine->getMeter(SASConstants::METER_20_BILLS_ACCEPTED);
-                break;
-            case 0x45:  // $50 Bills
-                meterValue = machine->getMeter(SASConstants::METER_50_BILLS_ACCEPTED);
-                break;
-            case 0x46:  // $100 Bills
-                meterValue = machine->getMeter(SASConstants::METER_100_BILLS_ACCEPTED);
-                break;
-            // TITO meters (5 bytes)
-            case 0x0D:  // Total Ticket Out (count)
-            case 0x0F:  // Total Ticket Out (value)
-            case 0x28:  // Cashable Ticket Out (value)
-            case 0x2A:  // Restricted Promo Ticket Out (value)
-            case 0x2B:  // NonRestricted Promo Ticket Out (value)
-                meterSize = 5;  // TITO meters are 5 bytes BCD
-                meterValue = 0; // Default to 0 for now
+            case 0x0D:  // Total Ticket In (cents)
+            case 0x0F:  // Total Restricted Ticket In (cents)
+            case 0x28:  // Cashable Ticket In (credits)
+            case 0x2A:  // Restricted Promo Ticket In (credits)
+            case 0x2B:  // NonRestricted Promo Ticket In (credits)
+                meterSize = 5;
                 break;
             default:
-                // Unknown meter code - return 0
-                meterValue = 0;
-                utils::Logger::log("[0x6F/AF] WARNING: Unknown meter code 0x" +
-                    [](uint16_t val) {
-                        char buf[5];
-                        snprintf(buf, sizeof(buf), "%04X", val);
-                        return std::string(buf);
-                    }(meterCode));
                 break;
         }
 
-        // Add size byte
-        responseData.push_back(meterSize);
-
-        // Add meter value (BCD encoded)
-        std::vector<uint8_t> valueBCD = BCD::encode(meterValue, meterSize);
-        responseData.insert(responseData.end(), valueBCD.begin(), valueBCD.end());
+        response.data.push_back(meterSize);
+        response.data.appendBCD(readSelectedMeter(machine, static_cast<int>(gameNumber), meterCode), meterSize);
     }
 
-    // Add length byte at the beginning (length = game number + all meter data)
-    uint8_t responseLengthByte = static_cast<uint8_t>(responseData.size());
-    response.data.push_back(responseLengthByte);
-
-    // Add all the response data
-    response.data.insert(response.data.end(), responseData.begin(), responseData.end());
+    // Length byte at the beginning (length = game number + all meter data)
+    response.data[0] = static_cast<uint8_t>(response.data.size() - 1);
 
-    utils::Logger::log("[0x6F/AF] Response: " + std::to_string(meterCodes.size()) +
-                      " meters, total data bytes: " + std::to_string(response.data.size()));
+    LOG(METERS, DEBUG, "[0x6F/AF] Response: " << numMeterCodes
+        << " meters, total data bytes: " << response.data.size());
 
     return response;
 }
 
+uint64_t MeterCommands::readSelectedMeter(simulator::Machine* machine, int gameNumber, int meterCode) {
+    // Same SAS code -> field mapping for every game, so game 0 and game N
+    // answer a code with the same meter (0x1C/0x1F read coin out/jackpot)
+    int field = simulator::GameMeters::fieldOf(meterCode);
+    if (field >= 0) {
+        return machine->getGameMeter(gameNumber, simulator::GameMeters::meterCodeOf(field));
+    }
+
+    if (!machine->hasMeter(meterCode)) {
+        LOG(METERS, DEBUG, "[Meters] Meter code 0x" << std::hex << meterCode << std::dec
+            << " not kept, returning 0");
+    }
+    return machine->getMeter(meterCode);
+}
+
 } // namespace commands
 } // namespace sas
 
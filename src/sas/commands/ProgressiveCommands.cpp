@@ -13,7 +13,7 @@ static std::map<uint8_t, ProgressiveCommands::ProgressiveLevel> progressiveLevel
 static bool progressivesInitialized = false;
 
 Message ProgressiveCommands::handleSendProgressiveAmount(simulator::Machine* machine,
-                                                         const std::vector<uint8_t>& data) {
+                                                         const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -42,14 +42,13 @@ Message ProgressiveCommands::handleSendProgressiveAmount(simulator::Machine* mac
     // Bytes 1-4: Progressive amount (4 bytes BCD)
     response.data.push_back(groupId);
 
-    std::vector<uint8_t> amountBCD = BCD::encode(amount, 4);
-    response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+    response.data.appendBCD(amount, 4);
 
     return response;
 }
 
 Message ProgressiveCommands::handleSendProgressiveWin(simulator::Machine* machine,
-                                                      const std::vector<uint8_t>& data) {
+                                                      const MessageData& data) {
     if (!machine) {
         return Message();
     }
@@ -75,8 +74,7 @@ Message ProgressiveCommands::handleSendProgressiveWin(simulator::Machine* machin
         response.data.push_back(groupId);
 
         // Win amount (5 bytes BCD for larger jackpots)
-        std::vector<uint8_t> amountBCD = BCD::encode(level->currentAmount, 5);
-        response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+        response.data.appendBCD(level->currentAmount, 5);
 
         // Clear win flag (will be reset when acknowledged)
         level->hasWin = false;
@@ -86,8 +84,7 @@ Message ProgressiveCommands::handleSendProgressiveWin(simulator::Machine* machin
     } else {
         // No win - return zeros
         response.data.push_back(groupId);
-        std::vector<uint8_t> zeroBCD = BCD::encode(0, 5);
-        response.data.insert(response.data.end(), zeroBCD.begin(), zeroBCD.end());
+        response.data.appendBCD(0, 5);
     }
 
     return response;
@@ -125,8 +122,7 @@ Message ProgressiveCommands::handleSendProgressiveLevels(simulator::Machine* mac
         response.data.push_back(level.levelId);
 
         // Current amount
-        std::vector<uint8_t> amountBCD = BCD::encode(level.currentAmount, 4);
-        response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+        response.data.appendBCD(level.currentAmount, 4);
     }
 
     return response;
@@ -171,8 +167,7 @@ Message ProgressiveCommands::handleSendProgressiveBroadcast(simulator::Machine*
 
         response.data.push_back(level.levelId);
 
-        std::vector<uint8_t> amountBCD = BCD::encode(level.currentAmount, 4);
-        response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+        response.data.appendBCD(level.currentAmount, 4);
     }
 
     return response;
@@ -261,11 +256,8 @@ uint64_t ProgressiveCommands::awardProgressiveWin(simulator::Machine* machine, u
     // Mark as won
     level->hasWin = true;
 
-    // Add win to machine credits
-    machine->addCredits(static_cast<int64_t>(winAmount));
-
-    // Increment jackpot meter
-    machine->incrementMeter(SASConstants::METER_JACKPOT, winAmount);
+    // Add win to machine credits and the jackpot meter
+    machine->addJackpot(simulator::Cents(static_cast<int64_t>(winAmount)));
 
     // Progressive will be reset when handleSendProgressiveWin is called
 
@@ -292,8 +284,7 @@ Message ProgressiveCommands::buildProgressiveResponse(uint8_t address,
     response.data.push_back(levelId);
 
     // Amount (5 bytes BCD)
-    std::vector<uint8_t> amountBCD = BCD::encode(amount, 5);
-    response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+    response.data.appendBCD(amount, 5);
 
     return response;
 }
@@ -1,36 +1,55 @@
 #include "sas/commands/TITOCommands.h"
 #include "sas/BCD.h"
 #include "sas/SASConstants.h"
+#include "simulator/NvramStore.h"
+#include "utils/Logger.h"
 #include <ctime>
 #include <cstring>
-#include <iostream>
 #include <iomanip>
 
 
 namespace sas {
 namespace commands {
 
-// Static storage for last printed ticket (in a real system, this would be persistent)
-static std::vector<uint8_t> lastValidationNumber(8, 0);
-static uint64_t lastTicketAmount = 0;
-static time_t lastTicketTime = 0;
+// The machine owns its last-ticket state; only its SAS servicing thread uses it
+static TicketState& getTicketState(simulator::Machine* machine) {
+    TicketState& state = machine->getTicketState();
+    if (state.restored) {
+        return state;
+    }
+
+    // First use since startup: pick up the last ticket issued before a restart
+    state.restored = true;
+    std::shared_ptr<simulator::NvramStore> nvram = machine->getNvramStore();
+    if (nvram) {
+        std::vector<simulator::NvramStore::TicketRecord> tickets = nvram->getTickets();
+        if (!tickets.empty()) {
+            const simulator::NvramStore::TicketRecord& last = tickets.back();
+            state.lastValidationNumber.assign(last.validationNumber, last.validationNumber + 8);
+            state.lastTicketAmount = last.amountCents;
+            state.lastTicketTime = static_cast<time_t>(last.time);
+        }
+    }
+    return state;
+}
 
 Message TITOCommands::handleSendValidationInfo(simulator::Machine* machine) {
     if (!machine) {
         return Message();
     }
 
+    TicketState& state = getTicketState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::SEND_VALIDATION_INFO;
 
     // Return last printed ticket validation number
     // Format: 8 bytes validation number + 5 bytes BCD amount
-    response.data = lastValidationNumber;
+    response.data.assign(state.lastValidationNumber.begin(), state.lastValidationNumber.end());
 
     // Add amount in BCD (5 bytes = 10 digits for up to $99,999,999.99)
-    std::vector<uint8_t> amountBCD = BCD::encode(lastTicketAmount, 5);
-    response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+    response.data.appendBCD(state.lastTicketAmount, 5);
 
     return response;
 }
@@ -40,36 +59,36 @@ Message TITOCommands::handleSendEnhancedValidation(simulator::Machine* machine)
         return Message();
     }
 
+    TicketState& state = getTicketState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::SEND_ENHANCED_VALIDATION;
 
     // Enhanced validation includes additional security data
     // Format: 8 bytes validation + 5 bytes amount + additional fields
-    response.data = lastValidationNumber;
+    response.data.assign(state.lastValidationNumber.begin(), state.lastValidationNumber.end());
 
     // Amount
-    std::vector<uint8_t> amountBCD = BCD::encode(lastTicketAmount, 5);
-    response.data.insert(response.data.end(), amountBCD.begin(), amountBCD.end());
+    response.data.appendBCD(state.lastTicketAmount, 5);
 
     // Validation type (0x00 = system validation)
     response.data.push_back(Validation::SYSTEM);
 
     // Expiration date (7 days from print) - MMDDYYYY format
-    time_t expiration = lastTicketTime + (7 * 24 * 60 * 60);  // 7 days
+    time_t expiration = state.lastTicketTime + (7 * 24 * 60 * 60);  // 7 days
     struct tm* exp_tm = localtime(&expiration);
     if (exp_tm) {
         response.data.push_back(BCD::toBCD(exp_tm->tm_mon + 1));  // Month
         response.data.push_back(BCD::toBCD(exp_tm->tm_mday));     // Day
-        std::vector<uint8_t> yearBCD = BCD::encode(exp_tm->tm_year + 1900, 2);
-        response.data.insert(response.data.end(), yearBCD.begin(), yearBCD.end());
+        response.data.appendBCD(exp_tm->tm_year + 1900, 2);
     }
 
     return response;
 }
 
 Message TITOCommands::handleRedeemTicket(simulator::Machine* machine,
-                                        const std::vector<uint8_t>& data) {
+                                        const MessageData& data) {
     // 0x7D is actually "Send Enabled Game Numbers" - master sends location/casino config data
     // Format: [length][hostID 2B][expiration][locationLen][location...][addr1Len][addr1...][addr2Len][addr2...][CRC]
     // Expected response: [addr][7D][status][CRC]
@@ -141,11 +160,11 @@ Message TITOCommands::handleRedeemTicket(simulator::Machine* machine,
     }
 
     // Log the configuration data received
-    std::cout << "[0x7D Config] Host ID: 0x" << std::hex << hostID << std::dec << std::endl;
-    std::cout << "[0x7D Config] Expiration: " << (int)expiration << " days" << std::endl;
-    std::cout << "[0x7D Config] Location: " << location << std::endl;
-    std::cout << "[0x7D Config] Address1: " << address1 << std::endl;
-    std::cout << "[0x7D Config] Address2: " << address2 << std::endl;
+    LOG(SAS, DEBUG, "[0x7D Config] Host ID: 0x" << std::hex << hostID << std::dec);
+    LOG(SAS, DEBUG, "[0x7D Config] Expiration: " << (int)expiration << " days");
+    LOG(SAS, DEBUG, "[0x7D Config] Location: " << location);
+    LOG(SAS, DEBUG, "[0x7D Config] Address1: " << address1);
+    LOG(SAS, DEBUG, "[0x7D Config] Address2: " << address2);
 
     // Build simple ACK response: [addr][cmd][status][CRC]
     // Status byte: 0x01 = acknowledged/accepted
@@ -162,6 +181,8 @@ Message TITOCommands::handleSendTicketInfo(simulator::Machine* machine) {
         return Message();
     }
 
+    TicketState& state = getTicketState(machine);
+
     Message response;
     response.address = 1;
     response.command = LongPoll::SEND_TICKET_INFO;
@@ -171,12 +192,11 @@ Message TITOCommands::handleSendTicketInfo(simulator::Machine* machine) {
     // Byte 1-2: Total value of tickets (2 bytes BCD)
 
     // For simplicity, report last ticket only
-    response.data.push_back(BCD::toBCD(lastTicketAmount > 0 ? 1 : 0));  // 1 ticket if any
+    response.data.push_back(BCD::toBCD(state.lastTicketAmount > 0 ? 1 : 0));  // 1 ticket if any
 
     // Total value (in dollars, 2 bytes BCD)
-    uint64_t dollars = lastTicketAmount / 100;  // Convert cents to dollars
-    std::vector<uint8_t> dollarsBCD = BCD::encode(dollars, 2);
-    response.data.insert(response.data.end(), dollarsBCD.begin(), dollarsBCD.end());
+    uint64_t dollars = state.lastTicketAmount / 100;  // Convert cents to dollars
+    response.data.appendBCD(dollars, 2);
 
     return response;
 }
@@ -216,10 +236,12 @@ std::vector<uint8_t> TITOCommands::printTicket(simulator::Machine* machine, uint
         return std::vector<uint8_t>(8, 0);
     }
 
+    TicketState& state = getTicketState(machine);
+
     // Generate validation number
-    lastValidationNumber = generateValidationNumber();
-    lastTicketAmount = amount;
-    lastTicketTime = time(nullptr);
+    state.lastValidationNumber = generateValidationNumber();
+    state.lastTicketAmount = amount;
+    state.lastTicketTime = time(nullptr);
 
     // In a real system:
     // 1. Send ticket data to printer
@@ -231,24 +253,40 @@ std::vector<uint8_t> TITOCommands::printTicket(simulator::Machine* machine, uint
     machine->incrementMeter(SASConstants::METER_TICKET_OUT, amount);
 
     // Deduct credits from machine
-    machine->addCredits(-static_cast<int64_t>(amount));
+    machine->addCredits(-simulator::Cents(static_cast<int64_t>(amount)));
+
+    // Validation record and the meters above reach NVRAM in one commit
+    std::shared_ptr<simulator::NvramStore> nvram = machine->getNvramStore();
+    if (nvram) {
+        simulator::NvramStore::TicketRecord record;
+        memset(&record, 0, sizeof(record));
+        memcpy(record.validationNumber, state.lastValidationNumber.data(), sizeof(record.validationNumber));
+        record.amountCents = amount;
+        record.time = static_cast<int64_t>(state.lastTicketTime);
+        if (!nvram->appendTicket(record)) {
+            LOG(SAS, ERROR, "[TITO] ERROR: Ticket record not saved to NVRAM");
+        }
+    }
 
-    return lastValidationNumber;
+    return state.lastValidationNumber;
 }
 
-bool TITOCommands::validateTicketRedemption(const std::vector<uint8_t>& validationNumber) {
+bool TITOCommands::validateTicketRedemption(simulator::Machine* machine,
+                                            const std::vector<uint8_t>& validationNumber) {
+    TicketState& state = getTicketState(machine);
+
     if (validationNumber.size() != 8) {
         return false;
     }
 
     // Check if validation number matches last printed ticket
-    if (validationNumber != lastValidationNumber) {
+    if (validationNumber != state.lastValidationNumber) {
         return false;
     }
 
     // Check if ticket is not expired (7 days)
     time_t now = time(nullptr);
-    if (now - lastTicketTime > (7 * 24 * 60 * 60)) {
+    if (now - state.lastTicketTime > (7 * 24 * 60 * 60)) {
         return false;  // Expired
     }
 
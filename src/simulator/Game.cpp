@@ -1,5 +1,4 @@
 #include "simulator/Game.h"
-#include "sas/SASConstants.h"
 
 
 namespace simulator {
@@ -10,22 +9,15 @@ Game::Game(int gameNumber, int denomCode, int maxBet,
       denomCode_(denomCode),
       maxBet_(maxBet),
       gameName_(gameName),
-      paytable_(paytable),
-      coinInMeter_(0.0) {
+      paytable_(paytable) {
 }
 
-double Game::getDenom() const {
-    return sas::SASConstants::DENOMINATIONS.getDenomination(denomCode_);
+Cents Game::getDenom() const {
+    return denomination::valueOf(denomCode_);
 }
 
-double Game::bet(int credits) {
-    double betAmount = getDenom() * credits;
-    coinInMeter_ += betAmount;
-    return betAmount;
-}
-
-void Game::resetCoinInMeter() {
-    coinInMeter_ = 0.0;
+Cents Game::bet(Credits credits) const {
+    return denomination::toCents(credits, denomCode_);
 }
 
 } // namespace simulator
@@ -0,0 +1,210 @@
+#include "simulator/GameMeters.h"
+#include "sas/SASConstants.h"
+
+
+namespace simulator {
+
+constexpr int GameMeters::MAX_GAMES;
+constexpr int GameMeters::MAX_GAME_NUMBER;
+constexpr int GameMeters::DENOM_CODES;
+constexpr uint8_t GameMeters::NO_SLOT;
+
+static_assert(GameMeters::MAX_GAMES < 0xFF, "Slots must fit in uint8_t below NO_SLOT");
+
+GameMeters::GameMeters()
+    : gameCount_(0),
+      sequence_(0) {
+    for (int field = 0; field < FIELD_COUNT; field++) {
+        for (int slot = 0; slot < MAX_GAMES; slot++) {
+            games_[field][slot].store(0, std::memory_order_relaxed);
+        }
+        for (int code = 0; code < DENOM_CODES; code++) {
+            denoms_[field][code].store(0, std::memory_order_relaxed);
+        }
+    }
+    for (int number = 0; number <= MAX_GAME_NUMBER; number++) {
+        slots_[number].store(NO_SLOT, std::memory_order_relaxed);
+    }
+}
+
+int GameMeters::fieldOf(int meterCode) {
+    switch (meterCode) {
+        case sas::SASConstants::METER_COIN_IN:              return COIN_IN;
+        case sas::SASConstants::METER_COIN_OUT:             return COIN_OUT;
+        case sas::SASConstants::METER_JACKPOT:              return JACKPOT;
+        case sas::SASConstants::METER_GAMES_PLAYED:         return GAMES_PLAYED;
+        case sas::SASConstants::METER_GAMES_WON:            return GAMES_WON;
+        case sas::SASConstants::METER_GAMES_LOST:           return GAMES_LOST;
+        // Paytable wins are paid to the credit meter as coin out, and
+        // attendant-paid wins are the jackpot meter
+        case sas::SASConstants::METER_MACH_PAID_PAYTABLE:   return COIN_OUT;
+        case sas::SASConstants::METER_ATT_PAID_PAYTABLE:    return JACKPOT;
+        default:                                            return -1;
+    }
+}
+
+int GameMeters::meterCodeOf(int field) {
+    static const int CODES[FIELD_COUNT] = {
+        sas::SASConstants::METER_COIN_IN,
+        sas::SASConstants::METER_COIN_OUT,
+        sas::SASConstants::METER_JACKPOT,
+        sas::SASConstants::METER_GAMES_PLAYED,
+        sas::SASConstants::METER_GAMES_WON,
+        sas::SASConstants::METER_GAMES_LOST
+    };
+    return (field >= 0 && field < FIELD_COUNT) ? CODES[field] : -1;
+}
+
+int GameMeters::addGame(int gameNumber) {
+    if (gameNumber < 0 || gameNumber > MAX_GAME_NUMBER) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    uint8_t slot = slots_[gameNumber].load(std::memory_order_relaxed);
+    if (slot != NO_SLOT) {
+        return slot;
+    }
+    if (gameCount_ >= MAX_GAMES) {
+        return -1;
+    }
+    slot = static_cast<uint8_t>(gameCount_++);
+    slots_[gameNumber].store(slot, std::memory_order_release);
+    return slot;
+}
+
+int GameMeters::slotOf(int gameNumber) const {
+    if (gameNumber < 0 || gameNumber > MAX_GAME_NUMBER) {
+        return -1;
+    }
+    uint8_t slot = slots_[gameNumber].load(std::memory_order_acquire);
+    return (slot == NO_SLOT) ? -1 : slot;
+}
+
+std::vector<int> GameMeters::getGameNumbers() const {
+    std::vector<int> numbers(MAX_GAMES, -1);
+    int count = 0;
+    for (int number = 0; number <= MAX_GAME_NUMBER; number++) {
+        uint8_t slot = slots_[number].load(std::memory_order_acquire);
+        if (slot != NO_SLOT) {
+            numbers[slot] = number;
+            count++;
+        }
+    }
+    numbers.resize(count);
+    return numbers;
+}
+
+void GameMeters::add(int gameNumber, int denomCode, int meterCode, int64_t amount) {
+    int field = fieldOf(meterCode);
+    int slot = slotOf(gameNumber);
+    bool denomValid = (denomCode >= 0 && denomCode < DENOM_CODES);
+    if (field < 0 || (slot < 0 && !denomValid)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    int64_t gameValue = 0;
+    int64_t denomValue = 0;
+    if (slot >= 0) {
+        std::atomic<int64_t>& cell = games_[field][slot];
+        gameValue = cell.load(std::memory_order_relaxed) + amount;
+        cell.store(gameValue, std::memory_order_relaxed);
+    }
+    if (denomValid) {
+        std::atomic<int64_t>& cell = denoms_[field][denomCode];
+        denomValue = cell.load(std::memory_order_relaxed) + amount;
+        cell.store(denomValue, std::memory_order_relaxed);
+    }
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    if (observer_) {
+        int code = meterCodeOf(field);
+        if (slot >= 0) {
+            observer_(GAME_BLOCK, gameNumber, code, gameValue);
+        }
+        if (denomValid) {
+            observer_(DENOM_BLOCK, denomCode, code, denomValue);
+        }
+    }
+}
+
+void GameMeters::setGame(int gameNumber, int meterCode, int64_t value) {
+    int field = fieldOf(meterCode);
+    if (field < 0) {
+        return;
+    }
+    // Meters are restored before the games are configured
+    int slot = addGame(gameNumber);
+    if (slot < 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    games_[field][slot].store(value, std::memory_order_relaxed);
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    if (observer_) {
+        observer_(GAME_BLOCK, gameNumber, meterCodeOf(field), value);
+    }
+}
+
+void GameMeters::setDenom(int denomCode, int meterCode, int64_t value) {
+    int field = fieldOf(meterCode);
+    if (field < 0 || denomCode < 0 || denomCode >= DENOM_CODES) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    denoms_[field][denomCode].store(value, std::memory_order_relaxed);
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    if (observer_) {
+        observer_(DENOM_BLOCK, denomCode, meterCodeOf(field), value);
+    }
+}
+
+bool GameMeters::getGame(int gameNumber, const int* meterCodes, size_t count, int64_t* values) const {
+    int slot = slotOf(gameNumber);
+    if (slot < 0) {
+        return false;
+    }
+
+    readConsistent([&]() {
+        for (size_t i = 0; i < count; i++) {
+            int field = fieldOf(meterCodes[i]);
+            values[i] = (field >= 0) ? games_[field][slot].load(std::memory_order_relaxed) : 0;
+        }
+    });
+    return true;
+}
+
+int64_t GameMeters::getGame(int gameNumber, int meterCode) const {
+    int field = fieldOf(meterCode);
+    int slot = slotOf(gameNumber);
+    if (field < 0 || slot < 0) {
+        return 0;
+    }
+    return games_[field][slot].load(std::memory_order_acquire);
+}
+
+int64_t GameMeters::getDenom(int denomCode, int meterCode) const {
+    int field = fieldOf(meterCode);
+    if (field < 0 || denomCode < 0 || denomCode >= DENOM_CODES) {
+        return 0;
+    }
+    return denoms_[field][denomCode].load(std::memory_order_acquire);
+}
+
+void GameMeters::setWriteObserver(WriteObserver observer) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    observer_ = observer;
+}
+
+} // namespace simulator
@@ -2,11 +2,14 @@
 #include "simulator/MachineEvents.h"
 #include "sas/SASConstants.h"
 #include "sas/SASCommPort.h"
+#include "sas/commands/AFTCommands.h"
+#include "sas/commands/TITOCommands.h"
 #include "ICardPlatform.h"
+#include "utils/Logger.h"
+#include "utils/Trace.h"
 #include <algorithm>
 #include <stdexcept>
 #include <sstream>
-#include <cmath>
 #include <chrono>
 #include <memory>
 #include <set>
@@ -26,7 +29,7 @@ public:
     virtual void progressivePaid() = 0;
     virtual void start() = 0;
     virtual void stop() = 0;
-    virtual void gameStarted(int credits, double denom) = 0;
+    virtual void gameStarted(int credits, Cents denom) = 0;
     virtual void gameEnded() = 0;
     virtual void doorOpen() = 0;
     virtual void doorClose() = 0;
@@ -36,7 +39,7 @@ public:
     virtual void hopperLow() = 0;
     virtual void setConnected(bool connected) = 0;
     virtual bool isConnected() = 0;
-    virtual void handpayPending(int levelId, double amount) = 0;
+    virtual void handpayPending(int levelId, Cents amount) = 0;
     virtual void resetOldestHandpay() = 0;
     virtual void ramClear() = 0;
     virtual void optionsChanged() = 0;
@@ -47,10 +50,14 @@ protected:
 };
 
 // Machine implementation
+constexpr Cents Machine::DEFAULT_HANDPAY_LIMIT;
+
 Machine::Machine(std::shared_ptr<event::EventService> eventService,
                  std::shared_ptr<ICardPlatform> platform)
     : eventService_(eventService),
       platform_(platform),
+      aftState_(new sas::commands::AFTState()),
+      ticketState_(new sas::commands::TicketState()),
       reportedProgressiveGroup_(1),
       accountingDenomCode_(1),
       progressiveGroup_(1),
@@ -97,30 +104,30 @@ Machine::~Machine() {
 
 void Machine::initializeMeters() {
     using namespace sas;
-    machineMeters_[SASConstants::METER_COIN_IN] = 0;
-    machineMeters_[SASConstants::METER_COIN_OUT] = 0;
-    machineMeters_[SASConstants::METER_JACKPOT] = 0;
-    machineMeters_[SASConstants::METER_HANDPAID_CANCELLED_CRD] = 0;
-    machineMeters_[SASConstants::METER_CANCELLED_CRD] = 0;
-    machineMeters_[SASConstants::METER_GAMES_PLAYED] = 0;
-    machineMeters_[SASConstants::METER_GAMES_WON] = 0;
-    machineMeters_[SASConstants::METER_GAMES_LOST] = 0;
-    machineMeters_[SASConstants::METER_CRD_FR_COIN_ACCEPTOR] = 0;
-    machineMeters_[SASConstants::METER_CRD_PAID_FR_HOPPER] = 0;
-    machineMeters_[SASConstants::METER_CRD_FR_COIN_TO_DROP] = 0;
-    machineMeters_[SASConstants::METER_CRD_FR_BILL_ACCEPTOR] = 0;
-    machineMeters_[SASConstants::METER_CURRENT_CRD] = 0;
-    machineMeters_[SASConstants::METER_TOT_TKT_IN] = 0;
-    machineMeters_[SASConstants::METER_TOT_TKT_OUT] = 0;
-    machineMeters_[SASConstants::METER_TOT_DROP] = 0;
-    machineMeters_[SASConstants::METER_REG_CASHABLE_TKT_IN] = 0;
-    machineMeters_[SASConstants::METER_REST_PROMO_TKT_IN] = 0;
-    machineMeters_[SASConstants::METER_1_BILLS_ACCEPTED] = 0;
-    machineMeters_[SASConstants::METER_5_BILLS_ACCEPTED] = 0;
-    machineMeters_[SASConstants::METER_10_BILLS_ACCEPTED] = 0;
-    machineMeters_[SASConstants::METER_20_BILLS_ACCEPTED] = 0;
-    machineMeters_[SASConstants::METER_50_BILLS_ACCEPTED] = 0;
-    machineMeters_[SASConstants::METER_100_BILLS_ACCEPTED] = 0;
+    meters_.set(SASConstants::METER_COIN_IN, 0);
+    meters_.set(SASConstants::METER_COIN_OUT, 0);
+    meters_.set(SASConstants::METER_JACKPOT, 0);
+    meters_.set(SASConstants::METER_HANDPAID_CANCELLED_CRD, 0);
+    meters_.set(SASConstants::METER_CANCELLED_CRD, 0);
+    meters_.set(SASConstants::METER_GAMES_PLAYED, 0);
+    meters_.set(SASConstants::METER_GAMES_WON, 0);
+    meters_.set(SASConstants::METER_GAMES_LOST, 0);
+    meters_.set(SASConstants::METER_CRD_FR_COIN_ACCEPTOR, 0);
+    meters_.set(SASConstants::METER_CRD_PAID_FR_HOPPER, 0);
+    meters_.set(SASConstants::METER_CRD_FR_COIN_TO_DROP, 0);
+    meters_.set(SASConstants::METER_CRD_FR_BILL_ACCEPTOR, 0);
+    meters_.set(SASConstants::METER_CURRENT_CRD, 0);
+    meters_.set(SASConstants::METER_TOT_TKT_IN, 0);
+    meters_.set(SASConstants::METER_TOT_TKT_OUT, 0);
+    meters_.set(SASConstants::METER_TOT_DROP, 0);
+    meters_.set(SASConstants::METER_REG_CASHABLE_TKT_IN, 0);
+    meters_.set(SASConstants::METER_REST_PROMO_TKT_IN, 0);
+    meters_.set(SASConstants::METER_1_BILLS_ACCEPTED, 0);
+    meters_.set(SASConstants::METER_5_BILLS_ACCEPTED, 0);
+    meters_.set(SASConstants::METER_10_BILLS_ACCEPTED, 0);
+    meters_.set(SASConstants::METER_20_BILLS_ACCEPTED, 0);
+    meters_.set(SASConstants::METER_50_BILLS_ACCEPTED, 0);
+    meters_.set(SASConstants::METER_100_BILLS_ACCEPTED, 0);
 }
 
 void Machine::progressiveWatchdogTask() {
@@ -143,34 +150,72 @@ void Machine::progressiveWatchdogTask() {
 void Machine::clearProgressiveValues() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     for (auto& progressive : progressives_) {
-        setProgressiveValue(progressive.levelId, 0.0, false);
+        setProgressiveValue(progressive.levelId, Cents(0), false);
     }
 }
 
 bool Machine::hasMeter(int meterCode) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    return machineMeters_.find(meterCode) != machineMeters_.end();
+    return meters_.has(meterCode);
 }
 
 int64_t Machine::getMeter(int meterCode) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = machineMeters_.find(meterCode);
-    if (it != machineMeters_.end()) {
-        return it->second;
-    }
-    return 0;
+    TRACE_SPAN_ARG("meter.read", static_cast<uint32_t>(meterCode));
+    return meters_.get(meterCode);
+}
+
+void Machine::getMeters(const int* meterCodes, size_t count, int64_t* values) const {
+    TRACE_SPAN("meter.read");
+    meters_.getMany(meterCodes, count, values);
 }
 
 void Machine::setMeter(int meterCode, int64_t value) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    machineMeters_[meterCode] = value;
+    meters_.set(meterCode, value);
+}
+
+void Machine::setMeters(const int* meterCodes, size_t count, const int64_t* values) {
+    meters_.setMany(meterCodes, count, values);
 }
 
 void Machine::incrementMeter(int meterCode, int64_t amount) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    // TODO: Handle meter rollover
-    // Now safe to call getMeter() since we're using recursive_mutex
-    machineMeters_[meterCode] = getMeter(meterCode) + amount;
+    meters_.add(meterCode, amount);
+}
+
+void Machine::incrementGameMeter(int meterCode, int64_t amount) {
+    // Totals are kept as they change, never summed over the games
+    meters_.add(meterCode, amount);
+    std::shared_ptr<Game> game = currentGame_;
+    if (game) {
+        gameMeters_.add(game->getGameNumber(), game->getDenomCode(), meterCode, amount);
+    }
+}
+
+bool Machine::getGameMeters(int gameNumber, const int* meterCodes, size_t count, int64_t* values) const {
+    TRACE_SPAN_ARG("meter.read", static_cast<uint32_t>(gameNumber));
+    if (gameNumber == 0) {
+        meters_.getMany(meterCodes, count, values);
+        return true;
+    }
+    return gameMeters_.getGame(gameNumber, meterCodes, count, values);
+}
+
+bool Machine::hasGameMeters(int gameNumber) const {
+    return gameNumber == 0 || gameMeters_.slotOf(gameNumber) >= 0;
+}
+
+int64_t Machine::getGameMeter(int gameNumber, int meterCode) const {
+    return (gameNumber == 0) ? getMeter(meterCode) : gameMeters_.getGame(gameNumber, meterCode);
+}
+
+void Machine::setGameMeter(int gameNumber, int meterCode, int64_t value) {
+    gameMeters_.setGame(gameNumber, meterCode, value);
+}
+
+int64_t Machine::getDenomMeter(int denominationCode, int meterCode) const {
+    return gameMeters_.getDenom(denominationCode, meterCode);
+}
+
+void Machine::setDenomMeter(int denominationCode, int meterCode, int64_t value) {
+    gameMeters_.setDenom(denominationCode, meterCode, value);
 }
 
 int64_t Machine::getGamesPlayed() const {
@@ -199,17 +244,17 @@ void Machine::setCurrentGame(std::shared_ptr<Game> game) {
     // }
 }
 
-void Machine::setCurrentGame(int gameNumber, double denomAmount) {
-    auto foundGame = getGame(gameNumber, denomAmount);
+void Machine::setCurrentGame(int gameNumber, Cents denom) {
+    auto foundGame = getGame(gameNumber, denom);
     if (foundGame) {
         setCurrentGame(foundGame);
     }
 }
 
-std::shared_ptr<Game> Machine::getGame(int gameNumber, double denomAmount) {
+std::shared_ptr<Game> Machine::getGame(int gameNumber, Cents denom) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-    int denomCode = getDenomCode(convertDenomToBigDecimal(denomAmount));
+    int denomCode = denomination::codeOf(denom);
     for (auto& game : games_) {
         if (game->getGameNumber() == gameNumber && game->getDenomCode() == denomCode) {
             return game;
@@ -218,20 +263,15 @@ std::shared_ptr<Game> Machine::getGame(int gameNumber, double denomAmount) {
     return nullptr;
 }
 
-double Machine::convertDenomToBigDecimal(double denom) const {
-    // Round to cents
-    int denomCents = static_cast<int>(denom * 100.0);
-    return denomCents / 100.0;
-}
-
-int Machine::getDenomCode(double denom) const {
-    return sas::SASConstants::DENOMINATIONS.getDenomCodeByDenomination(denom);
-}
-
 std::shared_ptr<Game> Machine::addGame(int gameNumber, int denomCode, int maxBet,
                                         const std::string& gameName,
                                         const std::string& paytable) {
     auto game = std::make_shared<Game>(gameNumber, denomCode, maxBet, gameName, paytable);
+    if (gameMeters_.addGame(gameNumber) < 0) {
+        LOG(METERS, WARN, "[Meters] No meter block for game " << gameNumber
+            << " (numbers 0-" << GameMeters::MAX_GAME_NUMBER << ", up to " << GameMeters::MAX_GAMES
+            << " games); its play only counts in the machine totals");
+    }
 
     {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -251,12 +291,14 @@ std::shared_ptr<Game> Machine::addGame(int gameNumber, int denomCode, int maxBet
     return game;
 }
 
-std::shared_ptr<Game> Machine::addGame(int gameNumber, double denom, int maxBet,
+std::shared_ptr<Game> Machine::addGame(int gameNumber, Cents denom, int maxBet,
                                         const std::string& gameName,
                                         const std::string& paytable) {
-    int denomCode = getDenomCode(convertDenomToBigDecimal(denom));
-    if (denomCode == -1) {
-        throw std::invalid_argument("Invalid denomination: " + std::to_string(denom));
+    int denomCode = denomination::codeOf(denom);
+    if (denomCode <= 0) {
+        std::ostringstream message;
+        message << "Invalid denomination: " << denom;
+        throw std::invalid_argument(message.str());
     }
     return addGame(gameNumber, denomCode, maxBet, gameName, paytable);
 }
@@ -270,64 +312,64 @@ int Machine::getCurrentGameIndex() const {
     return -1;
 }
 
-double Machine::getAccountingDenom() const {
-    return sas::SASConstants::DENOMINATIONS.getDenomination(accountingDenomCode_);
+Cents Machine::getAccountingDenom() const {
+    return denomination::valueOf(accountingDenomCode_);
 }
 
-int64_t Machine::toAccountingDenom(double amount) const {
-    return static_cast<int64_t>(amount / getAccountingDenom());
+int64_t Machine::toAccountingDenom(Cents amount) const {
+    return denomination::toCredits(amount, accountingDenomCode_).count();
 }
 
-double Machine::fromAccountingDenom(int64_t amount) const {
-    return getAccountingDenom() * amount;
+Cents Machine::fromAccountingDenom(int64_t credits) const {
+    return denomination::toCents(Credits(credits), accountingDenomCode_);
 }
 
 int64_t Machine::getCredits() const {
     return getMeter(sas::SASConstants::METER_CURRENT_CRD);
 }
 
-double Machine::getCashableAmount() const {
-    return getAccountingDenom() * getCredits();
+Cents Machine::getCashableAmount() const {
+    return fromAccountingDenom(getCredits());
 }
 
 void Machine::addCredits(int64_t credits) {
     incrementMeter(sas::SASConstants::METER_CURRENT_CRD, credits);
 }
 
-void Machine::addCredits(double dollarAmount) {
-    addCredits(static_cast<int64_t>(dollarAmount / getAccountingDenom()));
+void Machine::addCredits(Cents amount) {
+    addCredits(toAccountingDenom(amount));
 }
 
 int64_t Machine::getRestrictedCredits() const {
     return getMeter(sas::SASConstants::METER_CURRENT_REST_CRD);
 }
 
-double Machine::getRestrictedAmount() const {
-    return getAccountingDenom() * getRestrictedCredits();
+Cents Machine::getRestrictedAmount() const {
+    return fromAccountingDenom(getRestrictedCredits());
 }
 
 void Machine::addRestrictedCredits(int64_t credits) {
     incrementMeter(sas::SASConstants::METER_CURRENT_REST_CRD, credits);
 }
 
-void Machine::addRestrictedCredits(double dollarAmount) {
-    addRestrictedCredits(static_cast<int64_t>(dollarAmount / getAccountingDenom()));
+void Machine::addRestrictedCredits(Cents amount) {
+    addRestrictedCredits(toAccountingDenom(amount));
 }
 
 int64_t Machine::getNonRestrictedCredits() const {
     return getMeter(sas::SASConstants::METER_TOTAL_NONREST_PLAYED);
 }
 
-double Machine::getNonRestrictedAmount() const {
-    return getAccountingDenom() * getNonRestrictedCredits();
+Cents Machine::getNonRestrictedAmount() const {
+    return fromAccountingDenom(getNonRestrictedCredits());
 }
 
-void Machine::addNonRestrictedCredits(int credits) {
+void Machine::addNonRestrictedCredits(int64_t credits) {
     incrementMeter(sas::SASConstants::METER_TOTAL_NONREST_PLAYED, credits);
 }
 
-void Machine::addNonRestrictedCredits(double dollarAmount) {
-    addNonRestrictedCredits(static_cast<int>(dollarAmount / getAccountingDenom()));
+void Machine::addNonRestrictedCredits(Cents amount) {
+    addNonRestrictedCredits(toAccountingDenom(amount));
 }
 
 void Machine::addProgressive(int levelId) {
@@ -340,15 +382,15 @@ void Machine::addProgressive(int levelId) {
         }
     }
 
-    LevelValue value(levelId, 0.0);
+    LevelValue value(levelId, Cents(0));
     progressives_.push_back(value);
 }
 
-void Machine::setProgressive(int levelId, float amount) {
-    setProgressiveValue(levelId, static_cast<double>(amount));
+void Machine::setProgressive(int levelId, float dollars) {
+    setProgressiveValue(levelId, Cents::fromDollars(dollars));
 }
 
-void Machine::setProgressiveValue(int levelId, double amount, bool updateTime) {
+void Machine::setProgressiveValue(int levelId, Cents amount, bool updateTime) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
     for (auto& value : progressives_) {
@@ -359,8 +401,7 @@ void Machine::setProgressiveValue(int levelId, double amount, bool updateTime) {
                     now.time_since_epoch()).count();
             }
 
-            double oldValue = value.value;
-            if (std::abs(oldValue - amount) > 0.001) {  // Comparison with tolerance
+            if (value.value != amount) {
                 value.value = amount;
                 eventService_->publish(LevelValueChangedEvent(value));
             }
@@ -369,7 +410,7 @@ void Machine::setProgressiveValue(int levelId, double amount, bool updateTime) {
     }
 }
 
-double Machine::getProgressive(int levelId) const {
+Cents Machine::getProgressive(int levelId) const {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
 
     for (const auto& value : progressives_) {
@@ -377,7 +418,7 @@ double Machine::getProgressive(int levelId) const {
             return value.value;
         }
     }
-    return 0.0;
+    return Cents(0);
 }
 
 std::vector<int> Machine::getProgressiveLevelIds() const {
@@ -393,12 +434,15 @@ std::vector<int> Machine::getProgressiveLevelIds() const {
 void Machine::progressiveHit(int levelId) {
     checkPlayable();
 
-    double win = getProgressive(levelId);
+    Cents win = getProgressive(levelId);
 
     if (roundProgressiveJPToGameDenom_ && currentGame_) {
-        double gameDenom = currentGame_->getDenom();
-        double remainder = std::fmod(win, gameDenom);
-        win = win + (gameDenom - remainder);
+        // Round up to whole game credits
+        Cents gameDenom = currentGame_->getDenom();
+        Cents remainder = win % gameDenom;
+        if (remainder != Cents(0)) {
+            win += gameDenom - remainder;
+        }
     }
 
     eventService_->publish(ProgressiveHitEvent(levelId, win));
@@ -456,16 +500,42 @@ bool Machine::isProgressiveLinkUp() const {
     return (nowMs - lastProgressiveSetTime_) < 5000;
 }
 
-void Machine::addJackpot(double award) {
-    int64_t awardCredits = static_cast<int64_t>(award / getAccountingDenom());
+void Machine::addJackpot(Cents award) {
+    int64_t awardCredits = toAccountingDenom(award);
     addCredits(awardCredits);
-    incrementMeter(sas::SASConstants::METER_JACKPOT, awardCredits);
+    incrementGameMeter(sas::SASConstants::METER_JACKPOT, awardCredits);
 }
 
-void Machine::addCoinOut(double coinOut) {
-    int64_t awardCredits = static_cast<int64_t>(coinOut / getAccountingDenom());
+void Machine::addCoinOut(Cents coinOut) {
+    int64_t awardCredits = toAccountingDenom(coinOut);
     addCredits(awardCredits);
-    incrementMeter(sas::SASConstants::METER_COIN_OUT, awardCredits);
+    incrementGameMeter(sas::SASConstants::METER_COIN_OUT, awardCredits);
+}
+
+void Machine::billAccepted(Cents amount) {
+    addCredits(amount);
+
+    // Bill meters 0x40-0x57 are indexed by SAS bill denomination code (dollars)
+    static const int64_t BILL_VALUES[] = {
+        1, 2, 5, 10, 20, 25, 50, 100, 200, 250, 500, 1000, 2000, 2500, 5000,
+        10000, 20000, 25000, 50000, 100000, 200000, 250000, 500000, 1000000
+    };
+    int denomCode = -1;
+    for (size_t code = 0; code < sizeof(BILL_VALUES) / sizeof(BILL_VALUES[0]); code++) {
+        if (Cents(BILL_VALUES[code] * 100) == amount) {
+            denomCode = static_cast<int>(code);
+            incrementMeter(sas::SASConstants::METER_1_BILLS_ACCEPTED + denomCode, 1);
+            break;
+        }
+    }
+
+    // Update credits from bill acceptor meter
+    incrementMeter(sas::SASConstants::METER_CRD_FR_BILL_ACCEPTOR, toAccountingDenom(amount));
+
+    if (denomCode >= 0) {
+        eventService_->publish(BillAcceptedEvent(this, static_cast<uint8_t>(denomCode),
+            getMeter(sas::SASConstants::METER_1_BILLS_ACCEPTED + denomCode)));
+    }
 }
 
 int64_t Machine::playGameCredit() {
@@ -477,82 +547,73 @@ int64_t Machine::playGameCredit() {
         return 1;
     }
 
-    if (getCreditsByGameDenom() < 1) {
+    if (getCreditsByGameDenom() < Credits(1)) {
         return 0;
     }
 
     if (currentGame_) {
-        addCredits(-1 * static_cast<int64_t>(currentGame_->getDenom() / getAccountingDenom()));
+        addCredits(-currentGame_->getDenom());
     }
 
     return 1;
 }
 
 int64_t Machine::playRestrictedGameCredit() {
-    if (getRestrictedCreditsByGameDenom() < 1) {
+    if (getRestrictedCreditsByGameDenom() < Credits(1)) {
         return 0;
     }
 
     if (currentGame_) {
-        addRestrictedCredits(-1 * static_cast<int64_t>(currentGame_->getDenom() / getAccountingDenom()));
+        addRestrictedCredits(-currentGame_->getDenom());
     }
 
     return 1;
 }
 
 int64_t Machine::playNonRestrictedGameCredit() {
-    if (getNonRestrictedCreditsByGameDenom() < 1) {
+    if (getNonRestrictedCreditsByGameDenom() < Credits(1)) {
         return 0;
     }
 
     if (currentGame_) {
-        addNonRestrictedCredits(-1 * static_cast<int>(currentGame_->getDenom() / getAccountingDenom()));
+        addNonRestrictedCredits(-currentGame_->getDenom());
     }
 
     return 1;
 }
 
-int64_t Machine::getCreditsByGameDenom() const {
+Credits Machine::getCreditsByGameDenom() const {
     if (!currentGame_) {
-        return 0;
+        return Credits(0);
     }
-    return static_cast<int64_t>((getAccountingDenom() * getMeter(sas::SASConstants::METER_CURRENT_CRD)) /
-                                currentGame_->getDenom());
+    return denomination::toCredits(getCashableAmount(), currentGame_->getDenomCode());
 }
 
-int64_t Machine::getRestrictedCreditsByGameDenom() const {
+Credits Machine::getRestrictedCreditsByGameDenom() const {
     if (!currentGame_) {
-        return 0;
+        return Credits(0);
     }
-    return static_cast<int64_t>((getAccountingDenom() * getMeter(sas::SASConstants::METER_CURRENT_REST_CRD)) /
-                                currentGame_->getDenom());
+    return denomination::toCredits(getRestrictedAmount(), currentGame_->getDenomCode());
 }
 
-int64_t Machine::getNonRestrictedCreditsByGameDenom() const {
+Credits Machine::getNonRestrictedCreditsByGameDenom() const {
     if (!currentGame_) {
-        return 0;
+        return Credits(0);
     }
-    return static_cast<int64_t>((getAccountingDenom() * getMeter(sas::SASConstants::METER_TOTAL_NONREST_PLAYED)) /
-                                currentGame_->getDenom());
+    return denomination::toCredits(getNonRestrictedAmount(), currentGame_->getDenomCode());
 }
 
 void Machine::gameStart(int credits) {
     checkPlayable();
     playable_ = false;
-    incrementMeter(sas::SASConstants::METER_GAMES_PLAYED, 1);
+    incrementGameMeter(sas::SASConstants::METER_GAMES_PLAYED, 1);
 
     if (currentGame_) {
-        double amount = currentGame_->bet(credits);
-        incrementMeter(sas::SASConstants::METER_COIN_IN, static_cast<int>(toAccountingDenom(amount)));
-        eventService_->publish(GamePlayedEvent(currentGame_, amount));
+        Cents amount = currentGame_->bet(Credits(credits));
+        incrementGameMeter(sas::SASConstants::METER_COIN_IN, toAccountingDenom(amount));
 
-        // TODO: Implement gameStarted() in SASCommPort to report game start via exception
-        // for (auto& port : ports_) {
-        //     auto sasPort = std::dynamic_pointer_cast<sas::SASCommPort>(port);
-        //     if (sasPort) {
-        //         sasPort->gameStarted(credits, currentGame_->getDenom());
-        //     }
-        // }
+        // SAS ports report it as a real-time game start event
+        publishGameStarted(credits, amount);
     }
 }
 
@@ -562,15 +623,9 @@ void Machine::pokerGameStart(int credits, const std::string& dealtHand) {
     gameStart(credits);
 }
 
-void Machine::gameEnd() {
+void Machine::gameEnd(int64_t winCredits) {
     playable_ = true;
-    // TODO: Implement gameEnded() in SASCommPort to report game end via exception
-    // for (auto& port : ports_) {
-    //     auto sasPort = std::dynamic_pointer_cast<sas::SASCommPort>(port);
-    //     if (sasPort) {
-    //         sasPort->gameEnded();
-    //     }
-    // }
+    publishGameEnded(winCredits);
 }
 
 void Machine::pokerGameEnd(const std::string& finalHand) {
@@ -580,11 +635,11 @@ void Machine::pokerGameEnd(const std::string& finalHand) {
 }
 
 void Machine::GameWon() {
-    incrementMeter(sas::SASConstants::METER_GAMES_WON, 1);
+    incrementGameMeter(sas::SASConstants::METER_GAMES_WON, 1);
 }
 
 void Machine::GameLost() {
-    incrementMeter(sas::SASConstants::METER_GAMES_LOST, 1);
+    incrementGameMeter(sas::SASConstants::METER_GAMES_LOST, 1);
 }
 
 void Machine::bet(int credits) {
@@ -601,8 +656,8 @@ void Machine::betMax() {
 
 void Machine::secondaryWager(int credits) {
     if (currentGame_) {
-        double amount = currentGame_->bet(credits);
-        incrementMeter(sas::SASConstants::METER_COIN_IN, static_cast<int>(toAccountingDenom(amount)));
+        Cents amount = currentGame_->bet(Credits(credits));
+        incrementMeter(sas::SASConstants::METER_COIN_IN, toAccountingDenom(amount));
     }
 }
 
@@ -745,7 +800,7 @@ void Machine::setConnected(bool connected) {
 }
 
 void Machine::awardBonus(int64_t bonusUnits, bool aft) {
-    double amount = fromAccountingDenom(bonusUnits);
+    Cents amount = fromAccountingDenom(bonusUnits);
     eventService_->publish(BonusAwardedEvent(amount, aft));
 
     if (amount >= handpayLimit_) {
@@ -753,7 +808,7 @@ void Machine::awardBonus(int64_t bonusUnits, bool aft) {
     }
 }
 
-void Machine::addPendingHandpay(double amount, int levelId) {
+void Machine::addPendingHandpay(Cents amount, int levelId) {
     auto now = std::chrono::system_clock::now();
     int64_t resetId = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()).count();
@@ -803,7 +858,7 @@ void Machine::handpayReset() {
 }
 
 void Machine::cashoutButtonTriggerHandpay() {
-    double amount = getCashableAmount();
+    Cents amount = getCashableAmount();
     addCredits(-amount);
     addPendingHandpay(amount, 0x80);
 }
@@ -825,15 +880,21 @@ void Machine::setAftLocked(bool locked) {
 void Machine::publishAftTransfer(int64_t cashableAmount, int64_t restrictedAmount,
                                  int64_t nonRestrictedAmount) {
     eventService_->publish(AftTransferEvent(
-        static_cast<double>(cashableAmount) / 100.0,
-        static_cast<double>(restrictedAmount) / 100.0,
-        static_cast<double>(nonRestrictedAmount) / 100.0));
+        Cents(cashableAmount), Cents(restrictedAmount), Cents(nonRestrictedAmount)));
 }
 
 void Machine::publishAftLock(bool lock) {
     eventService_->publish(AftLockEvent(lock));
 }
 
+void Machine::publishGameStarted(int credits, Cents wager) {
+    eventService_->publish(GamePlayedEvent(this, currentGame_, wager, credits));
+}
+
+void Machine::publishGameEnded(int64_t winCredits) {
+    eventService_->publish(GameEndedEvent(this, winCredits));
+}
+
 void Machine::publishEftTransfer() {
     eventService_->publish(EftTransferEvent());
 }
@@ -858,7 +919,7 @@ void Machine::subtractDelayMillis(int64_t amount) {
 void Machine::doRamClear() {
     int64_t credits = getMeter(sas::SASConstants::METER_CURRENT_CRD);
     initializeMeters();
-    addCredits(static_cast<int64_t>(credits));
+    addCredits(credits);
 
     // TODO: Implement ramClear() in SASCommPort to report RAM clear via exception
     // for (auto& port : ports_) {
@@ -942,44 +1003,22 @@ std::shared_ptr<Game> Machine::getGameByGameNumber(int gameNumber) const {
 }
 
 int64_t Machine::getDenomMeter(int denominationCode) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-
-    int64_t meter = 0;
-    for (const auto& game : games_) {
-        if (game->getDenomCode() == denominationCode) {
-            meter += toAccountingDenom(game->getCoinInMeter());
-        }
-    }
-    return meter;
+    return getDenomMeter(denominationCode, sas::SASConstants::METER_COIN_IN);
 }
 
-double Machine::getCoinInMeter() const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-
-    double cim = 0.0;
-    for (const auto& game : games_) {
-        cim += game->getCoinInMeter();
-    }
-    return cim;
+Cents Machine::getCoinInMeter() const {
+    return fromAccountingDenom(getMeter(sas::SASConstants::METER_COIN_IN));
 }
 
-double Machine::getCoinInMeter(int denomCode) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-
-    double cim = 0.0;
-    for (const auto& game : games_) {
-        if (game->getDenomCode() == denomCode) {
-            cim += game->getCoinInMeter();
-        }
-    }
-    return cim;
+Cents Machine::getCoinInMeter(int denomCode) const {
+    return fromAccountingDenom(getDenomMeter(denomCode));
 }
 
 int64_t Machine::getCoinOutMeter() const {
     return getMeter(sas::SASConstants::METER_COIN_OUT);
 }
 
-double Machine::getCoinOutMeterAsCurrency() const {
+Cents Machine::getCoinOutMeterAsCurrency() const {
     return fromAccountingDenom(getCoinOutMeter());
 }
 
@@ -987,7 +1026,7 @@ int64_t Machine::getDropMeter() const {
     return getMeter(sas::SASConstants::METER_CRD_FR_COIN_TO_DROP);
 }
 
-double Machine::getDropMeterAsCurrency() const {
+Cents Machine::getDropMeterAsCurrency() const {
     return fromAccountingDenom(getDropMeter());
 }
 
@@ -995,7 +1034,7 @@ int64_t Machine::getJackpotMeter() const {
     return getMeter(sas::SASConstants::METER_JACKPOT);
 }
 
-double Machine::getJackpotMeterAsCurrency() const {
+Cents Machine::getJackpotMeterAsCurrency() const {
     return fromAccountingDenom(getJackpotMeter());
 }
 
@@ -1047,7 +1086,7 @@ void Machine::autoProcessEvents() {
     eventService_->subscribe<AftTransferEvent>([this](const AftTransferEvent& event) {
         addCredits(event.cashableAmount);
         addRestrictedCredits(event.restrictedAmount);
-        addNonRestrictedCredits(static_cast<int>(event.nonRestrictedAmount));
+        addNonRestrictedCredits(event.nonRestrictedAmount);
         eventService_->publish(AftTransferCreditedEvent());
     });
 
@@ -0,0 +1,122 @@
+#include "simulator/MeterStore.h"
+
+
+namespace simulator {
+
+constexpr int MeterStore::CAPACITY;
+
+MeterStore::MeterStore()
+    : sequence_(0) {
+    for (int i = 0; i < CAPACITY; i++) {
+        values_[i].store(0, std::memory_order_relaxed);
+        present_[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+bool MeterStore::has(int meterCode) const {
+    return isValidCode(meterCode) && present_[meterCode].load(std::memory_order_acquire);
+}
+
+int64_t MeterStore::get(int meterCode) const {
+    if (!isValidCode(meterCode)) {
+        return 0;
+    }
+    return values_[meterCode].load(std::memory_order_acquire);
+}
+
+void MeterStore::set(int meterCode, int64_t value) {
+    if (!isValidCode(meterCode)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    values_[meterCode].store(value, std::memory_order_relaxed);
+    present_[meterCode].store(true, std::memory_order_relaxed);
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    if (observer_) {
+        observer_(meterCode, value);
+    }
+}
+
+void MeterStore::add(int meterCode, int64_t amount) {
+    if (!isValidCode(meterCode)) {
+        return;
+    }
+
+    // TODO: Handle meter rollover
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    int64_t value = values_[meterCode].load(std::memory_order_relaxed) + amount;
+    values_[meterCode].store(value, std::memory_order_relaxed);
+    present_[meterCode].store(true, std::memory_order_relaxed);
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    if (observer_) {
+        observer_(meterCode, value);
+    }
+}
+
+void MeterStore::getMany(const int* meterCodes, size_t count, int64_t* values) const {
+    readConsistent([&]() {
+        for (size_t i = 0; i < count; i++) {
+            values[i] = isValidCode(meterCodes[i])
+                ? values_[meterCodes[i]].load(std::memory_order_relaxed)
+                : 0;
+        }
+    });
+}
+
+void MeterStore::setWriteObserver(WriteObserver observer) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    observer_ = observer;
+}
+
+void MeterStore::setMany(const int* meterCodes, size_t count, const int64_t* values) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < count; i++) {
+        if (isValidCode(meterCodes[i])) {
+            values_[meterCodes[i]].store(values[i], std::memory_order_relaxed);
+            present_[meterCodes[i]].store(true, std::memory_order_relaxed);
+        }
+    }
+    sequence_.fetch_add(1, std::memory_order_release);
+
+    if (observer_) {
+        for (size_t i = 0; i < count; i++) {
+            if (isValidCode(meterCodes[i])) {
+                observer_(meterCodes[i], values[i]);
+            }
+        }
+    }
+}
+
+void MeterStore::getAll(int64_t* values, bool* present) const {
+    readConsistent([&]() {
+        for (int i = 0; i < CAPACITY; i++) {
+            values[i] = values_[i].load(std::memory_order_relaxed);
+            present[i] = present_[i].load(std::memory_order_relaxed);
+        }
+    });
+}
+
+std::map<int, int64_t> MeterStore::snapshot() const {
+    int64_t values[CAPACITY];
+    bool present[CAPACITY];
+    getAll(values, present);
+
+    std::map<int, int64_t> meters;
+    for (int i = 0; i < CAPACITY; i++) {
+        if (present[i]) {
+            meters[i] = values[i];
+        }
+    }
+    return meters;
+}
+
+} // namespace simulator
@@ -0,0 +1,444 @@
+#include "simulator/NvramStore.h"
+#include "simulator/Machine.h"
+#include "sas/CRC16.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <cstddef>
+
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "NvramStore writes its structures to NVRAM as-is and assumes a little-endian target"
+#endif
+
+namespace simulator {
+
+static_assert(sizeof(NvramStore::BankHeader) == 64, "BankHeader layout is part of the NVRAM format");
+static_assert(sizeof(NvramStore::AftTransaction) == 64, "AftTransaction layout is part of the NVRAM format");
+static_assert(sizeof(NvramStore::TicketRecord) == 32, "TicketRecord layout is part of the NVRAM format");
+static_assert(sizeof(NvramStore::GameBlock) == 64, "GameBlock layout is part of the NVRAM format");
+static_assert(sizeof(NvramStore::Image) % 8 == 0, "Image must keep both banks word aligned");
+
+constexpr uint32_t NvramStore::MAGIC;
+constexpr uint16_t NvramStore::LAYOUT_VERSION;
+constexpr int NvramStore::METER_SLOTS;
+constexpr int NvramStore::GAME_SLOTS;
+constexpr int NvramStore::DENOM_SLOTS;
+constexpr size_t NvramStore::AFT_LOG_ENTRIES;
+constexpr size_t NvramStore::TICKET_LOG_ENTRIES;
+constexpr size_t NvramStore::LINE_SIZE;
+constexpr size_t NvramStore::LINE_COUNT;
+constexpr size_t NvramStore::BANK_SIZE;
+constexpr size_t NvramStore::REGION_SIZE;
+
+static uint16_t headerCrc(NvramStore::BankHeader header) {
+    header.headerCrc = 0;
+    return sas::CRC16::calculate(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+}
+
+NvramStore::NvramStore(std::shared_ptr<io::NvramDevice> device, size_t baseOffset)
+    : device_(device),
+      baseOffset_(baseOffset),
+      recovered_(false),
+      machine_(nullptr),
+      intervalMs_(1),
+      currentBank_(1),
+      sequence_(0),
+      running_(false) {
+    memset(&image_, 0, sizeof(image_));
+    memset(&staged_, 0, sizeof(staged_));
+}
+
+NvramStore::~NvramStore() {
+    stop();
+}
+
+bool NvramStore::readBank(int bank, Image& image, uint64_t& sequence) {
+    size_t offset = baseOffset_ + bank * BANK_SIZE;
+    BankHeader header;
+    if (!device_->read(offset, reinterpret_cast<uint8_t*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.magic != MAGIC || header.layoutVersion != LAYOUT_VERSION
+        || header.headerSize != sizeof(BankHeader) || header.imageSize != sizeof(Image)
+        || header.headerCrc != headerCrc(header)) {
+        return false;
+    }
+    if (!device_->read(offset + sizeof(BankHeader), reinterpret_cast<uint8_t*>(&image), sizeof(Image))
+        || header.imageCrc != sas::CRC16::calculate(reinterpret_cast<const uint8_t*>(&image), sizeof(Image))) {
+        return false;
+    }
+    sequence = header.sequence;
+    return true;
+}
+
+bool NvramStore::open() {
+    if (baseOffset_ + REGION_SIZE > device_->getSize()) {
+        LOG(METERS, ERROR, "[NVRAM] ERROR: " << device_->getName() << " holds " << device_->getSize()
+            << " bytes, need " << (baseOffset_ + REGION_SIZE));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
+
+    // Newest valid bank wins; the other one is treated as stale
+    Image bank[2];
+    uint64_t sequence[2] = {0, 0};
+    bool valid[2];
+    for (int i = 0; i < 2; i++) {
+        valid[i] = readBank(i, bank[i], sequence[i]);
+    }
+
+    int current = -1;
+    if (valid[0] && (!valid[1] || sequence[0] > sequence[1])) {
+        current = 0;
+    } else if (valid[1]) {
+        current = 1;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    behind_.set();
+    if (current >= 0) {
+        image_ = bank[current];
+        currentBank_ = current;
+        sequence_ = sequence[current];
+        recovered_ = true;
+        dirty_.reset();
+        LOG(METERS, INFO, "[NVRAM] Recovered bank " << current << " (sequence " << sequence_ << ") from "
+            << device_->getName() << (valid[1 - current] ? "" : "; other bank invalid"));
+        return true;
+    }
+
+    // Blank or unreadable: start from an empty image and write bank 0 now
+    memset(&image_, 0, sizeof(image_));
+    currentBank_ = 1;
+    sequence_ = 0;
+    recovered_ = false;
+    dirty_.set();
+    LOG(METERS, WARN, "[NVRAM] No valid bank on " << device_->getName() << "; formatting");
+    return true;
+}
+
+uint64_t NvramStore::getSequence() const {
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
+    return sequence_;
+}
+
+void NvramStore::markDirty(size_t offset, size_t length) {
+    for (size_t line = offset / LINE_SIZE; line * LINE_SIZE < offset + length; line++) {
+        dirty_.set(line);
+    }
+}
+
+size_t NvramStore::applyMetersTo(Machine* machine) const {
+    if (!machine) {
+        return 0;
+    }
+
+    int codes[METER_SLOTS];
+    int64_t values[METER_SLOTS];
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int code = 0; code < METER_SLOTS; code++) {
+            if (image_.meterPresent[code >> 3] & (1 << (code & 7))) {
+                codes[count] = code;
+                values[count] = image_.meterValues[code];
+                count++;
+            }
+        }
+    }
+    machine->setMeters(codes, count, values);
+
+    GameBlock games[GAME_SLOTS];
+    int64_t denoms[DENOM_SLOTS][GameMeters::FIELD_COUNT];
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        memcpy(games, image_.games, sizeof(games));
+        memcpy(denoms, image_.denomMeters, sizeof(denoms));
+    }
+    for (int field = 0; field < GameMeters::FIELD_COUNT; field++) {
+        int meterCode = GameMeters::meterCodeOf(field);
+        for (const GameBlock& game : games) {
+            if (game.gameNumber != 0) {
+                machine->setGameMeter(static_cast<int>(game.gameNumber), meterCode, game.meters[field]);
+            }
+        }
+        for (int code = 0; code < DENOM_SLOTS; code++) {
+            machine->setDenomMeter(code, meterCode, denoms[code][field]);
+        }
+    }
+    return count;
+}
+
+void NvramStore::setMeter(int meterCode, int64_t value) {
+    if (!MeterStore::isValidCode(meterCode)) {
+        return;
+    }
+
+    uint8_t bit = static_cast<uint8_t>(1 << (meterCode & 7));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!(image_.meterPresent[meterCode >> 3] & bit)) {
+        image_.meterPresent[meterCode >> 3] |= bit;
+        markDirty(offsetof(Image, meterPresent) + (meterCode >> 3), 1);
+    } else if (image_.meterValues[meterCode] == value) {
+        return;
+    }
+    image_.meterValues[meterCode] = value;
+    markDirty(offsetof(Image, meterValues) + meterCode * sizeof(int64_t), sizeof(int64_t));
+}
+
+void NvramStore::setGameMeter(int gameNumber, int meterCode, int64_t value) {
+    int field = GameMeters::fieldOf(meterCode);
+    if (field < 0 || gameNumber <= 0 || gameNumber > GameMeters::MAX_GAME_NUMBER) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int slot = -1;
+    int freeSlot = -1;
+    for (int i = 0; i < GAME_SLOTS && slot < 0; i++) {
+        if (image_.games[i].gameNumber == static_cast<uint32_t>(gameNumber)) {
+            slot = i;
+        } else if (image_.games[i].gameNumber == 0 && freeSlot < 0) {
+            freeSlot = i;
+        }
+    }
+    if (slot < 0) {
+        if (freeSlot < 0) {
+            return;
+        }
+        slot = freeSlot;
+        image_.games[slot].gameNumber = static_cast<uint32_t>(gameNumber);
+        markDirty(offsetof(Image, games) + slot * sizeof(GameBlock), sizeof(GameBlock));
+    } else if (image_.games[slot].meters[field] == value) {
+        return;
+    }
+    image_.games[slot].meters[field] = value;
+    markDirty(offsetof(Image, games) + slot * sizeof(GameBlock) + offsetof(GameBlock, meters)
+              + field * sizeof(int64_t), sizeof(int64_t));
+}
+
+void NvramStore::setDenomMeter(int denomCode, int meterCode, int64_t value) {
+    int field = GameMeters::fieldOf(meterCode);
+    if (field < 0 || denomCode < 0 || denomCode >= DENOM_SLOTS) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (image_.denomMeters[denomCode][field] == value) {
+        return;
+    }
+    image_.denomMeters[denomCode][field] = value;
+    markDirty(offsetof(Image, denomMeters) + (denomCode * GameMeters::FIELD_COUNT + field) * sizeof(int64_t),
+              sizeof(int64_t));
+}
+
+bool NvramStore::start(Machine* machine, int intervalMs) {
+    if (running_ || !machine) {
+        return running_;
+    }
+
+    // Take the machine's current meters (file-loaded or restored from here)
+    int64_t values[METER_SLOTS];
+    bool present[METER_SLOTS];
+    machine->getAllMeters(values, present);
+    for (int code = 0; code < METER_SLOTS; code++) {
+        if (present[code]) {
+            setMeter(code, values[code]);
+        }
+    }
+    std::vector<int> gameNumbers = machine->getMeteredGameNumbers();
+    for (int field = 0; field < GameMeters::FIELD_COUNT; field++) {
+        int meterCode = GameMeters::meterCodeOf(field);
+        for (int gameNumber : gameNumbers) {
+            setGameMeter(gameNumber, meterCode, machine->getGameMeter(gameNumber, meterCode));
+        }
+        for (int code = 0; code < DENOM_SLOTS; code++) {
+            setDenomMeter(code, meterCode, machine->getDenomMeter(code, meterCode));
+        }
+    }
+
+    machine_ = machine;
+    intervalMs_ = intervalMs > 0 ? intervalMs : 1;
+    running_ = true;
+    committer_ = std::thread(&NvramStore::commitThread, this);
+    machine_->setMeterWriteObserver([this](int meterCode, int64_t value) {
+        setMeter(meterCode, value);
+    });
+    machine_->setGameMeterWriteObserver([this](GameMeters::BlockKind kind, int number, int meterCode, int64_t value) {
+        if (kind == GameMeters::GAME_BLOCK) {
+            setGameMeter(number, meterCode, value);
+        } else {
+            setDenomMeter(number, meterCode, value);
+        }
+    });
+
+    LOG(METERS, INFO, "[NVRAM] Keeping meters in " << device_->getName() << " (commit every "
+        << intervalMs_ << " ms, " << BANK_SIZE << "-byte banks at offset " << baseOffset_ << ")");
+    return true;
+}
+
+void NvramStore::stop() {
+    if (!running_) {
+        return;
+    }
+
+    machine_->setMeterWriteObserver(MeterStore::WriteObserver());
+    machine_->setGameMeterWriteObserver(GameMeters::WriteObserver());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        condition_.notify_all();
+    }
+    if (committer_.joinable()) {
+        committer_.join();
+    }
+    commit();
+}
+
+bool NvramStore::appendAftTransaction(const AftTransaction& record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        LogHeader& log = image_.aftHeader;
+        size_t slot = log.next % AFT_LOG_ENTRIES;
+        image_.aft[slot] = record;
+        log.next = static_cast<uint32_t>((slot + 1) % AFT_LOG_ENTRIES);
+        if (log.count < AFT_LOG_ENTRIES) {
+            log.count++;
+        }
+        markDirty(offsetof(Image, aft) + slot * sizeof(AftTransaction), sizeof(AftTransaction));
+        markDirty(offsetof(Image, aftHeader), sizeof(LogHeader));
+    }
+    return commit();
+}
+
+bool NvramStore::appendTicket(const TicketRecord& record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        LogHeader& log = image_.ticketHeader;
+        size_t slot = log.next % TICKET_LOG_ENTRIES;
+        image_.tickets[slot] = record;
+        log.next = static_cast<uint32_t>((slot + 1) % TICKET_LOG_ENTRIES);
+        if (log.count < TICKET_LOG_ENTRIES) {
+            log.count++;
+        }
+        markDirty(offsetof(Image, tickets) + slot * sizeof(TicketRecord), sizeof(TicketRecord));
+        markDirty(offsetof(Image, ticketHeader), sizeof(LogHeader));
+    }
+    return commit();
+}
+
+std::vector<NvramStore::AftTransaction> NvramStore::getAftTransactions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const LogHeader& log = image_.aftHeader;
+    size_t count = std::min<size_t>(log.count, AFT_LOG_ENTRIES);
+    std::vector<AftTransaction> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(image_.aft[(log.next + AFT_LOG_ENTRIES - count + i) % AFT_LOG_ENTRIES]);
+    }
+    return records;
+}
+
+std::vector<NvramStore::TicketRecord> NvramStore::getTickets() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const LogHeader& log = image_.ticketHeader;
+    size_t count = std::min<size_t>(log.count, TICKET_LOG_ENTRIES);
+    std::vector<TicketRecord> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        records.push_back(image_.tickets[(log.next + TICKET_LOG_ENTRIES - count + i) % TICKET_LOG_ENTRIES]);
+    }
+    return records;
+}
+
+bool NvramStore::commit() {
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
+
+    std::bitset<LINE_COUNT> changed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (dirty_.none()) {
+            return true;
+        }
+        changed = dirty_;
+        dirty_.reset();
+        staged_ = image_;
+    }
+
+    int target = 1 - currentBank_;
+    size_t bankOffset = baseOffset_ + target * BANK_SIZE;
+    const uint8_t* image = reinterpret_cast<const uint8_t*>(&staged_);
+
+    // Contiguous runs of lines, clipped to the image
+    std::bitset<LINE_COUNT> lines = changed | behind_;
+    std::vector<io::NvramDevice::Block> blocks;
+    size_t bytes = 0;
+    for (size_t line = 0; line < LINE_COUNT; line++) {
+        if (!lines.test(line)) {
+            continue;
+        }
+        size_t end = line + 1;
+        while (end < LINE_COUNT && lines.test(end)) {
+            end++;
+        }
+        size_t offset = line * LINE_SIZE;
+        size_t length = std::min(end * LINE_SIZE, sizeof(Image)) - offset;
+        io::NvramDevice::Block block = {bankOffset + sizeof(BankHeader) + offset, image + offset, length};
+        blocks.push_back(block);
+        bytes += length;
+        line = end;
+    }
+
+    BankHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.layoutVersion = LAYOUT_VERSION;
+    header.headerSize = sizeof(BankHeader);
+    header.imageSize = sizeof(Image);
+    header.imageCrc = sas::CRC16::calculate(image, sizeof(Image));
+    header.sequence = sequence_ + 1;
+    header.committedAt = static_cast<int64_t>(std::time(nullptr));
+    header.headerCrc = headerCrc(header);
+    io::NvramDevice::Block headerBlock = {bankOffset, reinterpret_cast<const uint8_t*>(&header), sizeof(header)};
+
+    // Image first, header last: the target bank only becomes valid once
+    // everything it describes is in place
+    if (!device_->write(blocks.data(), blocks.size()) || !device_->write(&headerBlock, 1)) {
+        stats_.failures++;
+        behind_.set();          // Target bank is in an unknown state now
+        std::lock_guard<std::mutex> lock(mutex_);
+        dirty_ |= changed;
+        LOG(METERS, ERROR, "[NVRAM] ERROR: Commit " << header.sequence << " to "
+            << device_->getName() << " failed");
+        return false;
+    }
+
+    // The bank just left behind misses exactly what this commit changed
+    currentBank_ = target;
+    sequence_ = header.sequence;
+    behind_ = changed;
+    stats_.commits++;
+    stats_.bytesWritten += bytes + sizeof(header);
+    stats_.rangesWritten += blocks.size() + 1;
+    return true;
+}
+
+NvramStore::Statistics NvramStore::getStatistics() const {
+    std::lock_guard<std::mutex> ioLock(ioMutex_);
+    return stats_;
+}
+
+void NvramStore::commitThread() {
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait_for(lock, std::chrono::milliseconds(intervalMs_));
+        }
+        commit();
+    }
+}
+
+} // namespace simulator
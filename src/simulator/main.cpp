@@ -4,15 +4,28 @@
 #include <chrono>
 #include <csignal>
 #include <atomic>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
 #include "simulator/Machine.h"
 #include "simulator/Game.h"
 #include "simulator/MachineEvents.h"
+#include "simulator/NvramStore.h"
 #include "event/EventService.h"
 #include "sas/SASCommPort.h"
+#include "sas/SASPortPool.h"
 #include "sas/SASConstants.h"
+#include "sas/TrafficCapture.h"
+#include "sas/TrafficReplay.h"
+#include "sas/SASDaemon.h"
 #include "http/HTTPServer.h"
 #include "config/EGMConfig.h"
 #include "config/MeterPersistence.h"
+#include "config/MeterSnapshot.h"
+#include "utils/Logger.h"
+#include "utils/Trace.h"
 #include "version.h"
 
 #ifdef ZEUS_OS
@@ -22,7 +35,10 @@ extern "C" {
 #include <s7lite.h>  // For watchdog functions
 }
 #else
-#include "io/SimulatedPlatform.h"
+#include "ICardPlatform.h"
+#include "io/CommChannel.h"
+#include "io/NvramDevice.h"
+#include "io/PtyCommChannel.h"
 #endif
 
 
@@ -39,7 +55,343 @@ void signalHandler(int signum) {
     g_running = false;
 }
 
-int main() {
+// One hosted EGM: its SAS address, machine and port
+struct HostedEGM {
+    uint8_t address;
+    int64_t assetNumber;
+    std::shared_ptr<Machine> machine;
+    std::shared_ptr<SASCommPort> sasPort;
+};
+
+// Read the "machines" array from egm-config.json (address + optional
+// assetNumber per entry). Without it, host a single EGM at address 1.
+static std::vector<HostedEGM> loadHostedEGMs() {
+    std::vector<HostedEGM> egms;
+
+    auto doc = config::EGMConfig::getDocument();
+    if (doc && doc->HasMember("machines") && (*doc)["machines"].IsArray()) {
+        const auto& machinesArray = (*doc)["machines"];
+        for (rapidjson::SizeType i = 0; i < machinesArray.Size(); i++) {
+            const auto& entry = machinesArray[i];
+            int address = (entry.HasMember("address") && entry["address"].IsInt()) ?
+                entry["address"].GetInt() : 0;
+            if (address < 1 || address > 127) {
+                std::cout << "Warning: ignoring machine with invalid SAS address " << address << std::endl;
+                continue;
+            }
+
+            bool duplicate = false;
+            for (const auto& egm : egms) {
+                duplicate = duplicate || (egm.address == address);
+            }
+            if (duplicate) {
+                std::cout << "Warning: ignoring duplicate SAS address " << address << std::endl;
+                continue;
+            }
+
+            HostedEGM egm;
+            egm.address = static_cast<uint8_t>(address);
+            egm.assetNumber = (entry.HasMember("assetNumber") && entry["assetNumber"].IsInt64()) ?
+                entry["assetNumber"].GetInt64() : 0;
+            egms.push_back(egm);
+        }
+    }
+
+    if (egms.empty()) {
+        HostedEGM egm;
+        egm.address = 1;
+        egm.assetNumber = 0;
+        egms.push_back(egm);
+    }
+
+    return egms;
+}
+
+// Create a machine with the configured games, progressives and test credits.
+// Without persistence (replay) no meters are loaded and nothing is journaled.
+static std::shared_ptr<Machine> createMachine(std::shared_ptr<EventService> eventService,
+                                              std::shared_ptr<ICardPlatform> platform,
+                                              const HostedEGM& egm,
+                                              std::shared_ptr<NvramDevice> nvramDevice,
+                                              size_t index,
+                                              bool verbose,
+                                              bool persistent) {
+    auto machine = std::make_shared<Machine>(eventService, platform);
+    if (egm.assetNumber > 0) {
+        machine->setAssetNumber(egm.assetNumber);
+    }
+
+    // Load meters from persistent storage
+    if (persistent) {
+        if (verbose) std::cout << "Loading persistent meters..." << std::endl;
+        config::MeterPersistence::loadMeters(machine.get(), egm.address);
+    }
+
+    // NVRAM, when present, is newer than any file and takes over from the journal
+    if (persistent && nvramDevice) {
+        auto nvram = std::make_shared<NvramStore>(nvramDevice, index * NvramStore::REGION_SIZE);
+        if (nvram->open()) {
+            if (nvram->wasRecovered()) {
+                size_t restored = nvram->applyMetersTo(machine.get());
+                if (verbose) std::cout << "Restored " << restored << " meters from NVRAM" << std::endl;
+            }
+            nvram->start(machine.get(), static_cast<int>(config::EGMConfig::getInt("nvram.commitIntervalMs", 10)));
+            machine->setNvramStore(nvram);
+        } else {
+            std::cerr << "Warning: NVRAM unusable for address " << (int)egm.address
+                      << ", falling back to the meter journal" << std::endl;
+        }
+    }
+
+    // Journal every meter change until the next full save (0 disables)
+    int journalSyncMs = static_cast<int>(config::EGMConfig::getInt("meterJournalSyncMs", 100));
+    if (persistent && journalSyncMs > 0 && !machine->getNvramStore()) {
+        size_t compactBytes = static_cast<size_t>(config::EGMConfig::getInt("meterJournalCompactKB", 1024)) * 1024;
+        config::MeterPersistence::startJournal(machine.get(), egm.address, journalSyncMs, compactBytes);
+    }
+
+    // Set up accounting denom (1 cent)
+    machine->setAccountingDenomCode(1);
+
+    // Add games from configuration
+    if (verbose) std::cout << "\nAdding games from configuration..." << std::endl;
+    std::shared_ptr<Game> firstGame = nullptr;
+
+    auto doc = config::EGMConfig::getDocument();
+    if (doc && doc->HasMember("games") && (*doc)["games"].IsArray()) {
+        const auto& gamesArray = (*doc)["games"];
+
+        for (rapidjson::SizeType i = 0; i < gamesArray.Size(); i++) {
+            const auto& gameConfig = gamesArray[i];
+
+            // Check if game is enabled (default to true if not specified)
+            bool enabled = !gameConfig.HasMember("enabled") || gameConfig["enabled"].GetBool();
+            if (!enabled) {
+                continue;
+            }
+
+            // Read game configuration
+            int gameNumber = gameConfig["gameNumber"].GetInt();
+            Cents denom = Cents::fromDollars(gameConfig["denomination"].GetDouble());
+            int maxBet = gameConfig["maxBet"].GetInt();
+            std::string gameName = gameConfig.HasMember("gameName") ?
+                gameConfig["gameName"].GetString() : "Slot Game";
+            std::string gameID = gameConfig["gameID"].GetString();
+
+            // Add the game
+            auto game = machine->addGame(gameNumber, denom, maxBet, gameName, gameID);
+            if (verbose) {
+                std::cout << "  Game " << gameNumber << ": " << game->getGameName()
+                          << " ($" << game->getDenom() << " denom)" << std::endl;
+            }
+
+            // Remember first game for default selection
+            if (!firstGame) {
+                firstGame = game;
+            }
+        }
+    }
+
+    // Select first game as current game
+    if (firstGame) {
+        machine->setCurrentGame(firstGame);
+        if (verbose) std::cout << "\nCurrent game: " << machine->getCurrentGame()->getGameName() << std::endl;
+    }
+
+    // Add progressive levels
+    if (verbose) std::cout << "\nAdding progressive levels..." << std::endl;
+    machine->addProgressive(1);
+    machine->addProgressive(2);
+    machine->addProgressive(3);
+    machine->addProgressive(4);
+    machine->setProgressiveValue(1, Cents(10000));     // Mini   $100
+    machine->setProgressiveValue(2, Cents(50000));     // Minor  $500
+    machine->setProgressiveValue(3, Cents(250000));    // Major  $2,500
+    machine->setProgressiveValue(4, Cents(1000000));   // Grand  $10,000
+    if (verbose) {
+        std::cout << "  Level 1 (Mini):  $" << machine->getProgressive(1) << std::endl;
+        std::cout << "  Level 2 (Minor): $" << machine->getProgressive(2) << std::endl;
+        std::cout << "  Level 3 (Major): $" << machine->getProgressive(3) << std::endl;
+        std::cout << "  Level 4 (Grand): $" << machine->getProgressive(4) << std::endl;
+    }
+
+    // Add initial credits for testing
+    if (verbose) std::cout << "\nAdding $100 in credits..." << std::flush;
+    machine->addCredits(Cents(10000));
+    if (verbose) {
+        std::cout << " Done!" << std::endl;
+        std::cout << "Current credits: " << machine->getCredits()
+                  << " ($" << machine->getCashableAmount() << ")" << std::flush;
+        std::cout << std::endl;
+    }
+
+    return machine;
+}
+
+// Capture file of one EGM: sasCapture.path, with the address appended when
+// several EGMs are hosted
+static std::string getCapturePath(uint8_t address, bool multiEGM) {
+    std::string path = config::EGMConfig::getString("sasCapture.path", "sas-capture.bin");
+    if (!multiEGM) {
+        return path;
+    }
+    size_t dot = path.rfind('.');
+    std::string suffix = "-" + std::to_string(address);
+    return (dot == std::string::npos) ? path + suffix : path.substr(0, dot) + suffix + path.substr(dot);
+}
+
+// Replay a SAS capture against a fresh machine (no persistence) started from
+// the capture's meters, print the report and fail if any response differs
+static int replayCapture(const std::string& path, bool realTime) {
+    TrafficCapture::Info info;
+    std::vector<TrafficCapture::Record> records;
+    if (!TrafficCapture::load(path, info, records)) {
+        std::cerr << "Could not read SAS capture " << path << std::endl;
+        return 1;
+    }
+    std::cout << "Replaying " << path << " (address " << (int)info.address << ", "
+              << records.size() << " records, " << (realTime ? "recorded timing" : "as fast as possible")
+              << ")" << std::endl;
+
+    auto eventService = std::make_shared<EventService>();
+#ifdef ZEUS_OS
+    auto platform = std::make_shared<ZeusPlatform>();
+#else
+    auto platform = std::make_shared<SimulatedPlatform>();
+#endif
+    HostedEGM egm;
+    egm.address = info.address;
+    egm.assetNumber = 0;
+    for (const auto& hosted : loadHostedEGMs()) {
+        if (hosted.address == info.address) {
+            egm.assetNumber = hosted.assetNumber;
+        }
+    }
+    auto machine = createMachine(eventService, platform, egm, nullptr, 0, false, false);
+
+    config::MeterSnapshot snapshot;
+    if (info.state.empty()) {
+        std::cout << "Capture has no meter snapshot - replaying from configured defaults" << std::endl;
+    } else if (snapshot.load(info.state)) {
+        snapshot.applyTo(machine.get());
+    } else {
+        std::cerr << "Warning: capture's meter snapshot is unusable - replaying from configured defaults" << std::endl;
+    }
+
+    TrafficReplay replay(machine.get(), info.address);
+    TrafficReplay::Report report = replay.run(records, realTime);
+    machine->stop();
+    utils::Logger::shutdown();
+
+    TrafficReplay::printReport(report, std::cout);
+    return report.mismatched == 0 ? 0 : 2;
+}
+
+// Act as SAS master: drive loadGenerator.egms in-process machines over piped
+// channels, or the emulators behind the given tty devices ("<device>[@address]"),
+// with the configured poll mix (or, with loadGenerator.mode "online", the normal
+// 40 ms polling cadence), then print per-command latency. Fails on any CRC or
+// protocol error.
+static int runLoadGenerator(const std::vector<std::string>& devices, int seconds) {
+    SASDaemon::PollMix mix;
+    mix.generalPolls = static_cast<unsigned>(config::EGMConfig::getInt("loadGenerator.mix.generalPolls", mix.generalPolls));
+    mix.meterSweeps = static_cast<unsigned>(config::EGMConfig::getInt("loadGenerator.mix.meterSweeps", mix.meterSweeps));
+    mix.aftTransfers = static_cast<unsigned>(config::EGMConfig::getInt("loadGenerator.mix.aftTransfers", mix.aftTransfers));
+    mix.meterBursts = static_cast<unsigned>(config::EGMConfig::getInt("loadGenerator.mix.meterBursts", mix.meterBursts));
+    mix.burstLength = static_cast<unsigned>(config::EGMConfig::getInt("loadGenerator.mix.burstLength", mix.burstLength));
+    std::chrono::milliseconds pollTimeout(config::EGMConfig::getInt("loadGenerator.pollTimeoutMs", 20));
+    bool online = (config::EGMConfig::getString("loadGenerator.mode", "mix") == "online");
+
+    auto eventService = std::make_shared<EventService>();
+#ifdef ZEUS_OS
+    auto platform = std::make_shared<ZeusPlatform>();
+#else
+    auto platform = std::make_shared<SimulatedPlatform>();
+#endif
+    std::vector<HostedEGM> egms;
+    std::vector<std::shared_ptr<SASDaemon>> daemons;
+
+    if (devices.empty()) {
+        int count = static_cast<int>(config::EGMConfig::getInt("loadGenerator.egms", 1));
+        count = std::max(1, std::min(count, 127));
+        for (int i = 0; i < count; i++) {
+            HostedEGM egm;
+            egm.address = static_cast<uint8_t>(i + 1);
+            egm.assetNumber = 0;
+            egm.machine = createMachine(eventService, platform, egm, nullptr, 0, false, false);
+
+            auto host = std::make_shared<PipedCommChannel>("load-host-" + std::to_string(i + 1));
+            auto egmEnd = std::make_shared<PipedCommChannel>("load-egm-" + std::to_string(i + 1));
+            host->connectTo(egmEnd);
+            egmEnd->connectTo(host);
+            egm.sasPort = std::make_shared<SASCommPort>(egm.machine.get(), egmEnd, egm.address);
+            egm.sasPort->start();
+            egms.push_back(egm);
+            daemons.push_back(std::make_shared<SASDaemon>(host, egm.address));
+        }
+        std::cout << "Load test: " << egms.size() << " in-process EGM(s)";
+    } else {
+#ifdef ZEUS_OS
+        std::cerr << "--load-pty is only available in the simulated build" << std::endl;
+        return 1;
+#else
+        for (size_t i = 0; i < devices.size(); i++) {
+            std::string device = devices[i];
+            int address = 1;
+            size_t at = device.rfind('@');
+            if (at != std::string::npos) {
+                address = std::atoi(device.c_str() + at + 1);
+                device = device.substr(0, at);
+            }
+            if (address < 1 || address > 127) {
+                std::cerr << "Invalid SAS address for " << device << std::endl;
+                return 1;
+            }
+            auto channel = std::make_shared<PtyCommChannel>("LOAD" + std::to_string(i), device);
+            daemons.push_back(std::make_shared<SASDaemon>(channel, static_cast<uint8_t>(address)));
+        }
+        std::cout << "Load test: " << devices.size() << " external EGM(s)";
+#endif
+    }
+    std::cout << ", " << seconds << " s, poll timeout " << pollTimeout.count() << " ms, "
+              << (online ? "online cadence" : "poll mix") << std::endl;
+
+    for (const auto& daemon : daemons) {
+        daemon->setPollMix(mix);
+        daemon->setPollTimeout(pollTimeout);
+        if (!daemon->start(online ? SASDaemon::Mode::DISCOVERY : SASDaemon::Mode::LOAD)) {
+            std::cerr << "Could not open the line to address " << (int)daemon->getAddress() << std::endl;
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::seconds(seconds);
+    while (g_running && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    for (const auto& daemon : daemons) {
+        daemon->stop();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& egm : egms) {
+        egm.sasPort->stop();
+        egm.machine->stop();
+    }
+    utils::Logger::shutdown();
+
+    SASDaemon::printReport(daemons, elapsed, std::cout);
+
+    uint64_t failures = 0;
+    for (const auto& daemon : daemons) {
+        SASDaemon::Statistics stats = daemon->getStatistics();
+        failures += stats.crcErrors + stats.errors;
+    }
+    return failures == 0 ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
     std::cout << "EGM Emulator - SAS Slave Device" << std::endl;
     std::cout << "Version " << VERSION_STRING << "." << BUILD_NUMBER << std::endl;
     std::cout << "===============================" << std::endl;
@@ -50,6 +402,43 @@ int main() {
         std::cout << "Warning: Could not load egm-config.json, using defaults" << std::endl;
     }
 
+    // egm_simulator --replay <capture> [--fast]
+    if (argc >= 3 && std::strcmp(argv[1], "--replay") == 0) {
+        bool fast = (argc >= 4 && std::strcmp(argv[3], "--fast") == 0);
+        return replayCapture(argv[2], !fast);
+    }
+
+    // egm_simulator --load [seconds] | --load-pty <device>[@address][,...] [seconds]
+    if (argc >= 2 && (std::strcmp(argv[1], "--load") == 0 || std::strcmp(argv[1], "--load-pty") == 0)) {
+        std::vector<std::string> devices;
+        int next = 2;
+        if (std::strcmp(argv[1], "--load-pty") == 0) {
+            if (argc < 3) {
+                std::cerr << "Usage: egm_simulator --load-pty <device>[@address][,...] [seconds]" << std::endl;
+                return 1;
+            }
+            std::string list = argv[2];
+            size_t begin = 0;
+            while (begin <= list.size()) {
+                size_t comma = list.find(',', begin);
+                std::string device = list.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin);
+                if (!device.empty()) {
+                    devices.push_back(device);
+                }
+                if (comma == std::string::npos) {
+                    break;
+                }
+                begin = comma + 1;
+            }
+            next = 3;
+        }
+        int seconds = (argc > next) ? std::atoi(argv[next])
+                                    : static_cast<int>(config::EGMConfig::getInt("loadGenerator.seconds", 10));
+        std::signal(SIGINT, signalHandler);
+        std::signal(SIGTERM, signalHandler);
+        return runLoadGenerator(devices, std::max(1, seconds));
+    }
+
     // Install signal handler for graceful shutdown
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
@@ -85,111 +474,118 @@ int main() {
         auto platform = std::make_shared<SimulatedPlatform>();
         std::cout << "Platform: Simulated" << std::endl;
 
-        // Create simulated serial channel
-        auto channel = std::make_shared<CommChannel>();
+        // Create simulated serial channel (pty - master connects to the slave device)
+        auto channel = platform->createSASPort();
 #endif
 
-        // Create machine
-        auto machine = std::make_shared<Machine>(eventService, platform);
-
-        // Load meters from persistent storage
-        std::cout << "Loading persistent meters..." << std::endl;
-        config::MeterPersistence::loadMeters(machine.get());
-
-        // Set up accounting denom (1 cent)
-        machine->setAccountingDenomCode(1);
-
-        // Add games from configuration
-        std::cout << "\nAdding games from configuration..." << std::endl;
-        std::shared_ptr<Game> firstGame = nullptr;
-
-        auto doc = config::EGMConfig::getDocument();
-        if (doc && doc->HasMember("games") && (*doc)["games"].IsArray()) {
-            const auto& gamesArray = (*doc)["games"];
+        // Hosted EGMs: one machine and SAS port per configured address
+        std::vector<HostedEGM> egms = loadHostedEGMs();
+#ifdef ZEUS_OS
+        // The S7Lite UART strips the address byte, so one UART serves one EGM
+        if (egms.size() > 1) {
+            std::cout << "Warning: Zeus UART hosts a single EGM - using address "
+                      << (int)egms[0].address << " only" << std::endl;
+            egms.resize(1);
+        }
+#endif
+        bool multiEGM = egms.size() > 1;
+        if (multiEGM) {
+            std::cout << "\nHosting " << egms.size() << " EGMs" << std::endl;
+        }
 
-            for (rapidjson::SizeType i = 0; i < gamesArray.Size(); i++) {
-                const auto& gameConfig = gamesArray[i];
+        // Span tracing from startup (otherwise started with POST /api/trace)
+        if (config::EGMConfig::getBool("trace.enabled", false)) {
+            utils::Trace::setEnabled(true);
+            std::cout << "Tracing enabled (GET /api/trace for Chrome trace JSON)" << std::endl;
+        }
 
-                // Check if game is enabled (default to true if not specified)
-                bool enabled = !gameConfig.HasMember("enabled") || gameConfig["enabled"].GetBool();
-                if (!enabled) {
-                    continue;
-                }
+        // Battery-backed SRAM on Zeus, a mapped file elsewhere; one region per EGM
+        std::shared_ptr<NvramDevice> nvramDevice;
+        if (config::EGMConfig::getBool("nvram.enabled", false)) {
+#ifdef ZEUS_OS
+            if (platform->initialize()) {
+                nvramDevice = std::make_shared<ZeusNvramDevice>(platform);
+            }
+#else
+            auto file = std::make_shared<FileNvramDevice>(config::EGMConfig::getString("nvram.path", "nvram.bin"),
+                                                          egms.size() * NvramStore::REGION_SIZE);
+            if (file->open()) {
+                nvramDevice = file;
+            }
+#endif
+            if (nvramDevice) {
+                std::cout << "NVRAM: " << nvramDevice->getName() << " (" << nvramDevice->getSize()
+                          << " bytes)" << std::endl;
+            } else {
+                std::cerr << "Warning: NVRAM enabled but not available" << std::endl;
+            }
+        }
 
-                // Read game configuration
-                int gameNumber = gameConfig["gameNumber"].GetInt();
-                double denom = gameConfig["denomination"].GetDouble();
-                int maxBet = gameConfig["maxBet"].GetInt();
-                std::string gameName = gameConfig.HasMember("gameName") ?
-                    gameConfig["gameName"].GetString() : "Slot Game";
-                std::string gameID = gameConfig["gameID"].GetString();
+        for (size_t i = 0; i < egms.size(); i++) {
+            HostedEGM& egm = egms[i];
+            egm.machine = createMachine(eventService, platform, egm, nvramDevice, i, i == 0, true);
 
-                // Add the game
-                auto game = machine->addGame(gameNumber, denom, maxBet, gameName, gameID);
-                std::cout << "  Game " << gameNumber << ": " << game->getGameName()
-                          << " ($" << game->getDenom() << " denom)" << std::endl;
+            // Create SAS communication port (SLAVE - responds to polls)
+            std::shared_ptr<CommChannel> egmChannel = (i == 0) ? channel : platform->createSASPort();
 
-                // Remember first game for default selection
-                if (!firstGame) {
-                    firstGame = game;
+            // Record every poll and response, starting from the current meters
+            if (config::EGMConfig::getBool("sasCapture.enabled", false)) {
+                auto capture = std::make_shared<TrafficCapture>(getCapturePath(egm.address, multiEGM), egm.address);
+                if (capture->open(config::MeterSnapshot::encode(*egm.machine, 0))) {
+                    std::cout << "Recording SAS traffic to " << capture->getPath() << std::endl;
+                    egmChannel = std::make_shared<RecordingChannel>(egmChannel, capture);
                 }
             }
+            egm.sasPort = std::make_shared<SASCommPort>(egm.machine.get(), egmChannel, egm.address);
         }
+        auto machine = egms[0].machine;
+        auto sasPort = egms[0].sasPort;
+        std::cout << "\nInitializing SAS communication (Slave Mode)... Created!" << std::endl;
 
-        // Select first game as current game
-        if (firstGame) {
-            machine->setCurrentGame(firstGame);
-            std::cout << "\nCurrent game: " << machine->getCurrentGame()->getGameName() << std::endl;
-        }
-
-        // Add progressive levels
-        std::cout << "\nAdding progressive levels..." << std::endl;
-        machine->addProgressive(1);
-        machine->addProgressive(2);
-        machine->addProgressive(3);
-        machine->addProgressive(4);
-        machine->setProgressiveValue(1, 100.00);   // Mini
-        machine->setProgressiveValue(2, 500.00);   // Minor
-        machine->setProgressiveValue(3, 2500.00);  // Major
-        machine->setProgressiveValue(4, 10000.00); // Grand
-        std::cout << "  Level 1 (Mini):  $" << machine->getProgressive(1) << std::endl;
-        std::cout << "  Level 2 (Minor): $" << machine->getProgressive(2) << std::endl;
-        std::cout << "  Level 3 (Major): $" << machine->getProgressive(3) << std::endl;
-        std::cout << "  Level 4 (Grand): $" << machine->getProgressive(4) << std::endl;
-
-        // Add initial credits for testing
-        std::cout << "\nAdding $100 in credits..." << std::flush;
-        machine->addCredits(100.0);
-        std::cout << " Done!" << std::endl;
-        std::cout << "Current credits: " << machine->getCredits()
-                  << " ($" << machine->getCashableAmount() << ")" << std::flush;
-        std::cout << std::endl;
-
-        // Create SAS communication port (SLAVE - responds to polls)
-        std::cout << "\nInitializing SAS communication (Slave Mode)..." << std::flush;
-        auto sasPort = std::make_shared<SASCommPort>(machine.get(), channel, 1);
-        std::cout << " Created!" << std::endl;
-
-        // Start SAS port (will listen for polls from master)
+        // Start SAS ports (will listen for polls from master). A single EGM
+        // keeps its own receive thread; several share a small worker pool.
         std::cout << "Starting SAS port..." << std::flush;
-        if (!sasPort->start()) {
+        SASPortPool portPool(static_cast<size_t>(config::EGMConfig::getInt("sasWorkerThreads", 2)));
+        bool sasStarted = false;
+        if (multiEGM) {
+            for (const auto& egm : egms) {
+                portPool.addPort(egm.sasPort);
+            }
+            sasStarted = portPool.start();
+        } else {
+            sasStarted = sasPort->start();
+        }
+        if (!sasStarted) {
             std::cerr << "Failed to start SAS communication port!" << std::endl;
             return 1;
         }
         std::cout << " Started!" << std::endl;
-        std::cout << "SAS Port started - Address: " << (int)sasPort->getAddress() << std::endl;
+        for (const auto& egm : egms) {
+            std::cout << "SAS Port started - Address: " << (int)egm.address
+                      << " (" << egm.sasPort->getChannel()->getName() << ")" << std::endl;
+        }
+        if (multiEGM) {
+            std::cout << "SAS worker threads: " << portPool.getWorkerCount() << std::endl;
+        }
         std::cout << "Listening for SAS polls from master device..." << std::endl;
 
-        // Start machine
+        // Start machines
         std::cout << "Starting machine..." << std::flush;
-        machine->start();
+        for (const auto& egm : egms) {
+            egm.machine->start();
+        }
         std::cout << " Started!" << std::endl;
         std::cout << "\nMachine started and ready!" << std::endl;
         std::cout << "Machine playable: " << (machine->isPlayable() ? "Yes" : "No") << std::endl;
 
         // Start HTTP server for web GUI
         std::cout << "\nStarting HTTP server for GUI..." << std::flush;
-        HTTPServer httpServer(machine.get(), 8080);
+        HTTPServer httpServer(machine.get(), 8080,
+                              static_cast<size_t>(config::EGMConfig::getInt("httpWorkerThreads", 2)));
+        for (const auto& egm : egms) {
+            httpServer.addMachine(egm.address, egm.machine.get(), egm.sasPort.get());
+        }
+        httpServer.setStreamIntervalMs(config::EGMConfig::getInt("httpStreamIntervalMs", 50));
         httpServer.start();
         std::cout << " Started!" << std::endl;
         std::cout << "HTTP Server listening on port 8080" << std::endl;
@@ -211,11 +607,11 @@ int main() {
             uint64_t longPolls = 0;
             uint64_t crcErrors = 0;
             uint64_t framingErrors = 0;
-            double credits = 0;
+            Cents credits;
             uint64_t gamesPlayed = 0;
             int64_t gamesWon = 0;
-            double coinIn = 0;
-            double coinOut = 0;
+            Cents coinIn;
+            Cents coinOut;
         } lastStats;
 
         while (g_running) {
@@ -231,12 +627,22 @@ int main() {
                 S7LITE_Watchdog_Kick();
 #endif
 
-                auto stats = sasPort->getStatistics();
-                double credits = machine->getCashableAmount();
+                // SAS statistics summed over every hosted EGM
+                SASCommPort::Statistics stats;
+                for (const auto& egm : egms) {
+                    auto portStats = egm.sasPort->getStatistics();
+                    stats.messagesReceived += portStats.messagesReceived;
+                    stats.messagesSent += portStats.messagesSent;
+                    stats.crcErrors += portStats.crcErrors;
+                    stats.framingErrors += portStats.framingErrors;
+                    stats.generalPolls += portStats.generalPolls;
+                    stats.longPolls += portStats.longPolls;
+                }
+                Cents credits = machine->getCashableAmount();
                 uint64_t gamesPlayed = machine->getGamesPlayed();
                 int64_t gamesWon = machine->getMeter(SASConstants::METER_GAMES_WON);
-                double coinIn = machine->getCoinInMeter();
-                double coinOut = machine->getCoinOutMeter();
+                Cents coinIn = machine->getCoinInMeter();
+                Cents coinOut = machine->getCoinOutMeterAsCurrency();
 
                 // Only print if any value has changed
                 bool changed = (stats.messagesReceived != lastStats.messagesReceived ||
@@ -291,15 +697,28 @@ int main() {
 
         // Save meters to persistent storage before shutdown
         std::cout << "Saving persistent meters..." << std::endl;
-        config::MeterPersistence::saveMeters(machine.get());
+        for (const auto& egm : egms) {
+            config::MeterPersistence::saveMeters(egm.machine.get(), egm.address);
+            config::MeterPersistence::exportMeters(egm.machine.get(), egm.address);
+        }
 
         httpServer.stop();
-        sasPort->stop();
-        machine->stop();
+        portPool.stop();
+        for (const auto& egm : egms) {
+            egm.sasPort->stop();
+            egm.machine->stop();
+            config::MeterPersistence::stopJournal(egm.address);
+            if (egm.machine->getNvramStore()) {
+                egm.machine->getNvramStore()->stop();
+            }
+        }
         std::cout << "HTTP Server stopped" << std::endl;
         std::cout << "SAS Port stopped" << std::endl;
         std::cout << "Machine stopped" << std::endl;
 
+        // Drain queued log records before the final banner
+        utils::Logger::shutdown();
+
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,395 @@
+#include "utils/Logger.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+
+namespace utils {
+
+// ODR definitions for static constexpr members
+constexpr size_t Logger::RING_CAPACITY;
+constexpr size_t Logger::RECORD_PAYLOAD_SIZE;
+
+// Runtime level per category (default INFO; overridden from egm-config.json "logging")
+std::atomic<int> Logger::categoryLevels_[static_cast<size_t>(LogCategory::COUNT)] = {
+    {LogLevel::INFO}, {LogLevel::INFO}, {LogLevel::INFO}, {LogLevel::INFO}, {LogLevel::INFO}
+};
+
+namespace {
+
+constexpr int IDLE_SLEEP_MS = 5;    // Drain thread poll interval when the ring is empty
+
+enum RecordKind : uint8_t {
+    RECORD_LINE = 0,    // [ts] text
+    RECORD_PART = 1,    // text (no timestamp)
+    RECORD_HEX = 2      // [ts] prefix XX XX ... (payload = prefix + raw bytes)
+};
+
+/**
+ * Preformatted binary log record - no heap allocation on the producer side
+ */
+struct LogRecord {
+    int64_t timestampMs;
+    uint8_t kind;
+    uint8_t bytesPerLine;
+    bool truncated;
+    uint16_t prefixLength;      // HEX only: leading payload bytes that are the prefix
+    uint16_t length;            // Payload bytes used
+    char payload[Logger::RECORD_PAYLOAD_SIZE];
+};
+
+/**
+ * Bounded MPSC ring (Vyukov sequence-per-slot scheme)
+ *
+ * Producers claim a slot with a CAS on enqueuePos_ and publish it by bumping
+ * the slot sequence. The single drain thread consumes in order.
+ */
+class LogBackend {
+public:
+    static LogBackend& instance() {
+        static LogBackend backend;
+        return backend;
+    }
+
+    ~LogBackend() {
+        stop();
+    }
+
+    void push(uint8_t kind, const char* text, size_t textLength, bool truncated = false,
+              const uint8_t* data = nullptr, size_t dataLength = 0, size_t bytesPerLine = 16) {
+        int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        // Counted before the running_ check (both seq_cst), so stop() either
+        // sees this producer in flight or the producer sees running_ false
+        ProducerGuard guard(producers_);
+        if (!running_.load()) {
+            // Drain thread stopped (shutdown) - write synchronously
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            LogRecord record;
+            fill(record, ts, kind, text, textLength, truncated, data, dataLength, bytesPerLine);
+            std::string out;
+            format(record, out);
+            fwrite(out.data(), 1, out.size(), stdout);
+            fflush(stdout);
+            return;
+        }
+
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &slots_[pos & MASK];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Ring full - drop, never block the caller
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(slot->record, ts, kind, text, textLength, truncated, data, dataLength, bytesPerLine);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void flush() {
+        if (!running_.load(std::memory_order_acquire)) {
+            return;
+        }
+        size_t target = enqueuePos_.load(std::memory_order_acquire);
+        while (drainedPos_.load(std::memory_order_acquire) < target &&
+               running_.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        if (drainThread_.joinable()) {
+            drainThread_.join();
+        }
+        // Producers that passed the running_ check publish into the ring;
+        // wait for them, then write anything published after the last pass
+        while (producers_.load() != 0) {
+            std::this_thread::yield();
+        }
+        drain();
+    }
+
+    uint64_t droppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t MASK = Logger::RING_CAPACITY - 1;
+    static_assert((Logger::RING_CAPACITY & MASK) == 0, "Logger ring capacity must be a power of 2");
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    // Marks a push() in flight for its whole duration
+    struct ProducerGuard {
+        explicit ProducerGuard(std::atomic<int>& count) : count_(count) { count_.fetch_add(1); }
+        ~ProducerGuard() { count_.fetch_sub(1, std::memory_order_release); }
+        std::atomic<int>& count_;
+    };
+
+    LogBackend()
+        : slots_(new Slot[Logger::RING_CAPACITY]),
+          enqueuePos_(0),
+          dequeuePos_(0),
+          drainedPos_(0),
+          dropped_(0),
+          reportedDropped_(0),
+          running_(true),
+          producers_(0) {
+        for (size_t i = 0; i < Logger::RING_CAPACITY; i++) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        drainThread_ = std::thread(&LogBackend::drainLoop, this);
+    }
+
+    LogBackend(const LogBackend&) = delete;
+    LogBackend& operator=(const LogBackend&) = delete;
+
+    static void fill(LogRecord& record, int64_t ts, uint8_t kind, const char* text, size_t textLength,
+                     bool truncated, const uint8_t* data, size_t dataLength, size_t bytesPerLine) {
+        record.timestampMs = ts;
+        record.kind = kind;
+        record.bytesPerLine = static_cast<uint8_t>(bytesPerLine == 0 || bytesPerLine > 255 ? 16 : bytesPerLine);
+        record.truncated = truncated;
+
+        if (textLength > Logger::RECORD_PAYLOAD_SIZE) {
+            textLength = Logger::RECORD_PAYLOAD_SIZE;
+            record.truncated = true;
+        }
+        memcpy(record.payload, text, textLength);
+        record.prefixLength = static_cast<uint16_t>(textLength);
+
+        size_t copyLength = 0;
+        if (data && dataLength > 0) {
+            copyLength = dataLength;
+            if (textLength + copyLength > Logger::RECORD_PAYLOAD_SIZE) {
+                copyLength = Logger::RECORD_PAYLOAD_SIZE - textLength;
+                record.truncated = true;
+            }
+            memcpy(record.payload + textLength, data, copyLength);
+        }
+        record.length = static_cast<uint16_t>(textLength + copyLength);
+    }
+
+    static void appendTimestamp(int64_t ts, std::string& out) {
+        char buf[32];
+        int n = snprintf(buf, sizeof(buf), "[%lld] ", static_cast<long long>(ts));
+        out.append(buf, n);
+    }
+
+    static void format(const LogRecord& record, std::string& out) {
+        switch (record.kind) {
+            case RECORD_PART:
+                out.append(record.payload, record.length);
+                break;
+
+            case RECORD_HEX: {
+                char ts[32];
+                int tsLength = snprintf(ts, sizeof(ts), "[%lld] ", static_cast<long long>(record.timestampMs));
+                out.append(ts, tsLength);
+                out.append(record.payload, record.prefixLength);
+
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(record.payload + record.prefixLength);
+                size_t count = record.length - record.prefixLength;
+                for (size_t i = 0; i < count; i++) {
+                    char hex[4];
+                    snprintf(hex, sizeof(hex), "%02X ", bytes[i]);
+                    out.append(hex, 3);
+                    if ((i + 1) % record.bytesPerLine == 0 && (i + 1) < count) {
+                        out.push_back('\n');
+                        out.append(ts, tsLength);
+                        out.append(record.prefixLength, ' ');
+                    }
+                }
+                break;
+            }
+
+            case RECORD_LINE:
+            default:
+                appendTimestamp(record.timestampMs, out);
+                out.append(record.payload, record.length);
+                break;
+        }
+
+        if (record.truncated) {
+            out.append(" [truncated]");
+        }
+        out.push_back('\n');
+    }
+
+    // Consume everything currently published; returns number of records written
+    size_t drain() {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        size_t count = 0;
+
+        uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped_) {
+            int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            appendTimestamp(ts, batch_);
+            batch_.append("[Logger] " + std::to_string(dropped - reportedDropped_) +
+                          " messages dropped (ring full)\n");
+            reportedDropped_ = dropped;
+        }
+
+        for (;;) {
+            Slot& slot = slots_[dequeuePos_ & MASK];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            if (seq != dequeuePos_ + 1) {
+                break;  // Empty (or producer still filling this slot)
+            }
+
+            format(slot.record, batch_);
+            slot.sequence.store(dequeuePos_ + Logger::RING_CAPACITY, std::memory_order_release);
+            dequeuePos_++;
+            count++;
+        }
+
+        if (!batch_.empty()) {
+            fwrite(batch_.data(), 1, batch_.size(), stdout);
+            fflush(stdout);
+            batch_.clear();
+        }
+
+        drainedPos_.store(dequeuePos_, std::memory_order_release);
+        return count;
+    }
+
+    void drainLoop() {
+        while (running_.load(std::memory_order_acquire)) {
+            if (drain() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_MS));
+            }
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> enqueuePos_;
+    size_t dequeuePos_;                     // Drain thread only (under writeMutex_)
+    std::atomic<size_t> drainedPos_;
+    std::atomic<uint64_t> dropped_;
+    uint64_t reportedDropped_;              // Drain thread only (under writeMutex_)
+    std::atomic<bool> running_;
+    std::atomic<int> producers_;            // push() calls in flight
+    std::mutex writeMutex_;                 // Serializes drain passes and synchronous writes
+    std::string batch_;
+    std::thread drainThread_;
+};
+
+} // anonymous namespace
+
+void Logger::log(const std::string& message) {
+    LogBackend::instance().push(RECORD_LINE, message.data(), message.size());
+}
+
+void Logger::log(const LogStream& stream) {
+    LogBackend::instance().push(RECORD_LINE, stream.data(), stream.size(), stream.truncated());
+}
+
+void Logger::logPart(const std::string& message) {
+    LogBackend::instance().push(RECORD_PART, message.data(), message.size());
+}
+
+void Logger::logHex(const std::string& prefix, const uint8_t* data, size_t length, size_t bytesPerLine) {
+    LogBackend::instance().push(RECORD_HEX, prefix.data(), prefix.size(), false, data, length, bytesPerLine);
+}
+
+void Logger::logHex(const char* prefix, const uint8_t* data, size_t length, size_t bytesPerLine) {
+    LogBackend::instance().push(RECORD_HEX, prefix, strlen(prefix), false, data, length, bytesPerLine);
+}
+
+void Logger::flush() {
+    LogBackend::instance().flush();
+}
+
+void Logger::shutdown() {
+    LogBackend::instance().stop();
+}
+
+uint64_t Logger::getDroppedCount() {
+    return LogBackend::instance().droppedCount();
+}
+
+void Logger::setCategoryLevel(LogCategory category, int level) {
+    if (category >= LogCategory::COUNT) {
+        return;
+    }
+    if (level < LogLevel::TRACE) level = LogLevel::TRACE;
+    if (level > LogLevel::OFF) level = LogLevel::OFF;
+    categoryLevels_[static_cast<size_t>(category)].store(level, std::memory_order_relaxed);
+}
+
+bool Logger::setCategoryLevel(const std::string& categoryName, const std::string& levelName) {
+    int level = -1;
+    for (int i = LogLevel::TRACE; i <= LogLevel::OFF; i++) {
+        if (strcasecmp(levelName.c_str(), getLevelName(i)) == 0) {
+            level = i;
+            break;
+        }
+    }
+    if (level < 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(LogCategory::COUNT); i++) {
+        LogCategory category = static_cast<LogCategory>(i);
+        if (strcasecmp(categoryName.c_str(), getCategoryName(category)) == 0) {
+            setCategoryLevel(category, level);
+            return true;
+        }
+    }
+    return false;
+}
+
+int Logger::getCategoryLevel(LogCategory category) {
+    if (category >= LogCategory::COUNT) {
+        return LogLevel::OFF;
+    }
+    return categoryLevels_[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+const char* Logger::getCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::SAS:      return "SAS";
+        case LogCategory::UART:     return "UART";
+        case LogCategory::METERS:   return "METERS";
+        case LogCategory::AFT:      return "AFT";
+        case LogCategory::CONFIG:   return "CONFIG";
+        default:                    return "UNKNOWN";
+    }
+}
+
+const char* Logger::getLevelName(int level) {
+    switch (level) {
+        case LogLevel::TRACE:   return "TRACE";
+        case LogLevel::DEBUG:   return "DEBUG";
+        case LogLevel::INFO:    return "INFO";
+        case LogLevel::WARN:    return "WARN";
+        case LogLevel::ERROR:   return "ERROR";
+        case LogLevel::OFF:     return "OFF";
+        default:                return "UNKNOWN";
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,231 @@
+#include "utils/Trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+
+namespace utils {
+
+constexpr size_t Trace::CAPACITY;
+constexpr uint32_t Trace::NO_ARG;
+
+static_assert((Trace::CAPACITY & (Trace::CAPACITY - 1)) == 0, "Trace::CAPACITY must be a power of 2");
+
+std::atomic<bool> Trace::enabled_(false);
+
+namespace {
+
+// One recorded event; end 0 marks an instant. Fields are atomics so the
+// dump can read a ring while its thread writes (torn events are dropped).
+struct TraceEvent {
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> begin;
+    std::atomic<uint64_t> end;
+    std::atomic<uint32_t> arg;
+};
+
+struct ThreadRing {
+    std::atomic<uint64_t> head;             // Events ever written (single writer)
+    std::atomic<uint64_t> floor;            // Events before this were cleared
+    std::atomic<const char*> threadName;
+    std::atomic<uint32_t> tid;
+    std::atomic<bool> owned;                // A live thread writes this ring
+    TraceEvent events[Trace::CAPACITY];
+
+    ThreadRing() : head(0), floor(0), threadName(nullptr), tid(0), owned(false) {}
+};
+
+// Every ring ever created; rings are never freed, only reused
+std::mutex ringsMutex;
+std::vector<ThreadRing*> rings;
+
+thread_local ThreadRing* threadRing = nullptr;
+thread_local const char* threadName = nullptr;
+
+// Hands the calling thread's ring back when the thread exits
+struct RingRelease {
+    ~RingRelease() {
+        if (threadRing) {
+            threadRing->owned.store(false, std::memory_order_release);
+            threadRing = nullptr;
+        }
+    }
+};
+
+ThreadRing* acquireRing() {
+    static thread_local RingRelease release;
+    (void)release;
+
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    ThreadRing* ring = nullptr;
+    for (ThreadRing* candidate : rings) {
+        if (!candidate->owned.load(std::memory_order_acquire)) {
+            ring = candidate;
+            break;
+        }
+    }
+    if (!ring) {
+        ring = new ThreadRing();
+        rings.push_back(ring);
+    }
+
+    // A reused ring starts empty for its new thread
+    ring->floor.store(ring->head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    ring->threadName.store(threadName, std::memory_order_relaxed);
+    ring->tid.store(static_cast<uint32_t>(syscall(SYS_gettid)), std::memory_order_relaxed);
+    ring->owned.store(true, std::memory_order_release);
+    threadRing = ring;
+    return ring;
+}
+
+inline ThreadRing* currentRing() {
+    return threadRing ? threadRing : acquireRing();
+}
+
+void append(const char* name, uint64_t beginNs, uint64_t endNs, uint32_t arg) {
+    ThreadRing* ring = currentRing();
+    uint64_t index = ring->head.load(std::memory_order_relaxed);
+    TraceEvent& event = ring->events[index & (Trace::CAPACITY - 1)];
+    event.name.store(name, std::memory_order_relaxed);
+    event.begin.store(beginNs, std::memory_order_relaxed);
+    event.end.store(endNs, std::memory_order_relaxed);
+    event.arg.store(arg, std::memory_order_relaxed);
+    ring->head.store(index + 1, std::memory_order_release);
+}
+
+struct CopiedEvent {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t arg;
+};
+
+void writeName(std::ostream& out, const char* name) {
+    out << '"';
+    for (const char* c = name; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Trace::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Trace::clear() {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    for (ThreadRing* ring : rings) {
+        ring->floor.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Trace::setThreadName(const char* name) {
+    // A thread gets its ring on its first event; until then only remember
+    // the name, so naming a thread that never records costs no ring
+    threadName = name;
+    if (threadRing) {
+        threadRing->threadName.store(name, std::memory_order_relaxed);
+    }
+}
+
+void Trace::record(const char* name, uint64_t beginNs, uint64_t endNs, uint32_t arg) {
+    append(name, beginNs, endNs, arg);
+}
+
+void Trace::instant(const char* name, uint32_t arg) {
+    append(name, now(), 0, arg);
+}
+
+void Trace::writeChromeTrace(std::ostream& out) {
+    std::vector<ThreadRing*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        snapshot = rings;
+    }
+
+    // Timestamps relative to the oldest event kept, in microseconds
+    std::vector<std::vector<CopiedEvent>> copies(snapshot.size());
+    uint64_t origin = 0;
+    for (size_t r = 0; r < snapshot.size(); r++) {
+        ThreadRing* ring = snapshot[r];
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t first = ring->floor.load(std::memory_order_relaxed);
+        if (head > CAPACITY && first < head - CAPACITY) {
+            first = head - CAPACITY;
+        }
+
+        std::vector<CopiedEvent>& copy = copies[r];
+        copy.reserve(static_cast<size_t>(head - first));
+        for (uint64_t i = first; i < head; i++) {
+            const TraceEvent& event = ring->events[i & (CAPACITY - 1)];
+            CopiedEvent copied;
+            copied.name = event.name.load(std::memory_order_relaxed);
+            copied.begin = event.begin.load(std::memory_order_relaxed);
+            copied.end = event.end.load(std::memory_order_relaxed);
+            copied.arg = event.arg.load(std::memory_order_relaxed);
+            copy.push_back(copied);
+        }
+
+        // The writer may have reused slots while we copied: the event at
+        // newHead - CAPACITY (and any older) can be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t newHead = ring->head.load(std::memory_order_relaxed);
+        if (newHead + 1 > CAPACITY && newHead + 1 - CAPACITY > first) {
+            size_t torn = static_cast<size_t>(std::min(newHead + 1 - CAPACITY - first,
+                                                       static_cast<uint64_t>(copy.size())));
+            copy.erase(copy.begin(), copy.begin() + static_cast<std::ptrdiff_t>(torn));
+        }
+
+        for (const CopiedEvent& event : copy) {
+            if (origin == 0 || event.begin < origin) {
+                origin = event.begin;
+            }
+        }
+    }
+
+    int pid = static_cast<int>(getpid());
+    char number[32];
+    bool first = true;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (size_t r = 0; r < snapshot.size(); r++) {
+        uint32_t tid = snapshot[r]->tid.load(std::memory_order_relaxed);
+        const char* name = snapshot[r]->threadName.load(std::memory_order_relaxed);
+        if (name && !copies[r].empty()) {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                << ",\"tid\":" << tid << ",\"args\":{\"name\":";
+            writeName(out, name);
+            out << "}}";
+            first = false;
+        }
+
+        for (const CopiedEvent& event : copies[r]) {
+            out << (first ? "" : ",") << "\n{\"name\":";
+            writeName(out, event.name ? event.name : "?");
+            snprintf(number, sizeof(number), "%.3f", (event.begin - origin) / 1000.0);
+            out << ",\"cat\":\"egm\",\"pid\":" << pid << ",\"tid\":" << tid << ",\"ts\":" << number;
+            if (event.end == 0) {
+                out << ",\"ph\":\"i\",\"s\":\"t\"";
+            } else {
+                snprintf(number, sizeof(number), "%.3f", (event.end - event.begin) / 1000.0);
+                out << ",\"ph\":\"X\",\"dur\":" << number;
+            }
+            if (event.arg != NO_ARG) {
+                snprintf(number, sizeof(number), "0x%02X", event.arg);
+                out << ",\"args\":{\"arg\":\"" << number << "\"}";
+            }
+            out << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+}
+
+} // namespace utils
@@ -0,0 +1,136 @@
+#include "TestCheck.h"
+#include "sas/BCD.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using sas::BCD;
+
+// Per-digit reference encoder (the pre-table implementation)
+static void referenceEncode(uint64_t value, uint8_t* buffer, size_t numBytes) {
+    for (size_t i = numBytes; i > 0; i--) {
+        uint8_t low = static_cast<uint8_t>(value % 10);
+        value /= 10;
+        uint8_t high = static_cast<uint8_t>(value % 10);
+        value /= 10;
+        buffer[i - 1] = static_cast<uint8_t>((high << 4) | low);
+    }
+}
+
+static uint64_t powerOf10(size_t exponent) {
+    uint64_t result = 1;
+    for (size_t i = 0; i < exponent; i++) {
+        result *= 10;
+    }
+    return result;
+}
+
+// Encode against the reference and decode back; false on the first mismatch
+static bool roundTrip(uint64_t value, size_t numBytes) {
+    uint8_t encoded[10];
+    uint8_t expected[10];
+    if (!BCD::encodeTo(value, encoded, numBytes)) {
+        CHECK(BCD::encodeTo(value, encoded, numBytes));
+        std::cerr << "    value " << value << ", " << numBytes << " bytes" << std::endl;
+        return false;
+    }
+    referenceEncode(value, expected, numBytes);
+    bool ok = std::memcmp(encoded, expected, numBytes) == 0
+              && BCD::isValid(encoded, numBytes)
+              && BCD::decode(encoded, numBytes) == value;
+    if (!ok) {
+        CHECK_EQ(BCD::decode(encoded, numBytes), value);
+        CHECK(std::memcmp(encoded, expected, numBytes) == 0);
+        std::cerr << "    value " << value << ", " << numBytes << " bytes" << std::endl;
+    }
+    return ok;
+}
+
+// Values around every digit boundary and around multiples of 100 inside
+// the 8-digit chunks, where the reciprocal multiply for /100 would be off
+// by one if its constant were too small
+static void testBoundaries() {
+    for (size_t numBytes = 1; numBytes <= 10; numBytes++) {
+        uint64_t max = BCD::maxValue(numBytes);
+        std::vector<uint64_t> values = {0, 1, 9, 10, 11, 99, 100, 101, max, max - 1};
+        for (size_t digits = 1; digits < 2 * numBytes && digits < 20; digits++) {
+            uint64_t p = powerOf10(digits);
+            values.push_back(p - 1);
+            values.push_back(p);
+            values.push_back(p + 1);
+        }
+        for (uint64_t chunk : {99999999ULL, 99999900ULL, 99999899ULL, 12345600ULL, 12345699ULL, 1ULL}) {
+            for (uint64_t high = 0; high < 3; high++) {
+                values.push_back(high * 100000000ULL + chunk);
+                values.push_back(high * 10000000000000000ULL + chunk);
+            }
+        }
+
+        for (uint64_t value : values) {
+            if (value <= max) {
+                roundTrip(value, numBytes);
+            }
+        }
+
+        // One past the maximum does not fit and leaves the buffer alone
+        if (numBytes < 10) {
+            uint8_t buffer[10];
+            std::memset(buffer, 0xAA, sizeof(buffer));
+            CHECK(!BCD::encodeTo(max + 1, buffer, numBytes));
+            CHECK_EQ(static_cast<int>(buffer[0]), 0xAA);
+        }
+    }
+
+    // 10 bytes hold every uint64_t
+    CHECK_EQ(BCD::maxValue(10), UINT64_MAX);
+    roundTrip(UINT64_MAX, 10);
+    roundTrip(UINT64_MAX - 1, 10);
+    roundTrip(10000000000000000000ULL, 10);
+}
+
+// Every value of the first 1,000,000 and every multiple of 100 +-1 up to
+// the chunk size, in 4 bytes; seeded random values in every width
+static void testRanges() {
+    for (uint64_t value = 0; value < 1000000; value++) {
+        if (!roundTrip(value, 4)) {
+            return;
+        }
+    }
+    for (uint64_t value = 100; value < 100000000ULL; value += 997 * 100) {
+        if (!roundTrip(value - 1, 4) || !roundTrip(value, 4) || !roundTrip(value + 1, 4)) {
+            return;
+        }
+    }
+
+    uint64_t state = 5;
+    for (int i = 0; i < 200000; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t numBytes = 1 + static_cast<size_t>((state >> 60) % 10);
+        uint64_t value = state;
+        if (numBytes < 10) {
+            value %= BCD::maxValue(numBytes) + 1;
+        }
+        if (!roundTrip(value, numBytes)) {
+            return;
+        }
+    }
+}
+
+static void testSingleBytes() {
+    for (uint8_t value = 0; value < 100; value++) {
+        CHECK_EQ(static_cast<int>(BCD::fromBCD(BCD::toBCD(value))), static_cast<int>(value));
+    }
+    const uint8_t invalid[] = {0x1A};
+    CHECK(!BCD::isValid(invalid, 1));
+    CHECK_EQ(BCD::minBytes(0), 1u);
+    CHECK_EQ(BCD::minBytes(99), 1u);
+    CHECK_EQ(BCD::minBytes(100), 2u);
+    CHECK_EQ(BCD::minBytes(UINT64_MAX), 10u);
+}
+
+int main() {
+    testBoundaries();
+    testRanges();
+    testSingleBytes();
+    return testResult();
+}
@@ -0,0 +1,94 @@
+#include "TestCheck.h"
+#include "sas/CRC16.h"
+#include <cstdint>
+#include <vector>
+
+using sas::CRC16;
+
+// Deterministic byte source so a failure reproduces
+static uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// SAS uses CRC-16/KERMIT: check value of "123456789" is 0x2189
+static void testKnownValue() {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    CHECK_EQ(CRC16::calculateNibble(check, sizeof(check)), 0x2189);
+    CHECK_EQ(CRC16::calculate(check, sizeof(check)), 0x2189);
+    CHECK_EQ(CRC16::calculate(check, 0), 0);
+}
+
+// Every implementation returns the nibble reference, for every length and
+// start alignment (the sliced loops have head/body/tail paths)
+static void testImplementationsAgree() {
+    uint32_t state = 9;
+    std::vector<uint8_t> buffer(512 + 8);
+    for (int i = 0; i < 200000; i++) {
+        size_t length = nextRandom(state) % 300;
+        size_t offset = nextRandom(state) % 8;
+        for (size_t b = 0; b < length; b++) {
+            buffer[offset + b] = static_cast<uint8_t>(nextRandom(state));
+        }
+        const uint8_t* data = buffer.data() + offset;
+
+        uint16_t reference = CRC16::calculateNibble(data, length);
+        uint16_t table = CRC16::calculateTable(data, length);
+        uint16_t sliced4 = CRC16::calculateSliced4(data, length);
+        uint16_t sliced8 = CRC16::calculateSliced8(data, length);
+        uint16_t selected = CRC16::calculate(data, length);
+        if (table != reference || sliced4 != reference || sliced8 != reference || selected != reference) {
+            CHECK_EQ(table, reference);
+            CHECK_EQ(sliced4, reference);
+            CHECK_EQ(sliced8, reference);
+            CHECK_EQ(selected, reference);
+            return;
+        }
+    }
+}
+
+// calculateMany() matches one calculate() per buffer, for batch sizes
+// around its group of four
+static void testCalculateMany() {
+    uint32_t state = 77;
+    for (int round = 0; round < 5000; round++) {
+        size_t count = nextRandom(state) % 11;
+        std::vector<std::vector<uint8_t>> buffers(count);
+        std::vector<const uint8_t*> pointers(count);
+        std::vector<size_t> lengths(count);
+        for (size_t i = 0; i < count; i++) {
+            buffers[i].resize(nextRandom(state) % 64);
+            for (uint8_t& byte : buffers[i]) {
+                byte = static_cast<uint8_t>(nextRandom(state));
+            }
+            pointers[i] = buffers[i].data();
+            lengths[i] = buffers[i].size();
+        }
+
+        std::vector<uint16_t> crcs(count + 1, 0xBEEF);
+        CRC16::calculateMany(pointers.data(), lengths.data(), count, crcs.data());
+        for (size_t i = 0; i < count; i++) {
+            CHECK_EQ(crcs[i], CRC16::calculateNibble(pointers[i], lengths[i]));
+        }
+        CHECK_EQ(crcs[count], 0xBEEF);     // Nothing written past count
+    }
+}
+
+// append() and verify() round-trip, and verify() catches a flipped bit
+static void testAppendVerify() {
+    const uint8_t data[] = {0x01, 0x2F, 0x05, 0x00, 0x00, 0x00, 0x01, 0x02};
+    uint8_t message[sizeof(data) + 2];
+    CHECK_EQ(CRC16::append(data, sizeof(data), message), sizeof(message));
+    CHECK(CRC16::verify(message, sizeof(message)));
+    CHECK_EQ(CRC16::extract(message, sizeof(message)), CRC16::calculate(data, sizeof(data)));
+    message[3] ^= 0x10;
+    CHECK(!CRC16::verify(message, sizeof(message)));
+}
+
+int main() {
+    testKnownValue();
+    testImplementationsAgree();
+    testCalculateMany();
+    testAppendVerify();
+    return testResult();
+}
@@ -0,0 +1,111 @@
+#include "TestCheck.h"
+#include "sas/SASCommands.h"
+#include "sas/commands/MeterCommands.h"
+#include "event/EventService.h"
+#include "simulator/Machine.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace sas;
+
+// Heap allocations made while counting is on
+static std::atomic<bool> counting(false);
+static std::atomic<int> allocations(0);
+
+void* operator new(size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* p = std::malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// 0x6F request for game 0: [Length][Game (2 BCD)][Code (2, LSB first)]...
+static MessageData gameMetersRequest(size_t meterCount) {
+    MessageData request;
+    request.push_back(static_cast<uint8_t>(2 + meterCount * 2));
+    request.push_back(0x00);
+    request.push_back(0x00);
+    for (size_t i = 0; i < meterCount; i++) {
+        request.push_back(static_cast<uint8_t>(i));
+        request.push_back(0x00);
+    }
+    return request;
+}
+
+// Building a response and serializing it must not touch the heap
+static void testNoAllocation(simulator::Machine* machine) {
+    uint8_t buffer[Message::MAX_SERIALIZED_SIZE];
+    MessageData request = gameMetersRequest(12);
+
+    counting = true;
+    Message msg;
+    msg.address = 1;
+    msg.command = 0x1A;
+    msg.data.appendBCD(12345678, 4);
+    size_t plainLength = msg.serializeTo(buffer, sizeof(buffer));
+
+    Message response = commands::MeterCommands::handleSendSelectedMetersForGameNExtended(machine, 0x6F, request);
+    size_t responseLength = response.serializeTo(buffer, sizeof(buffer));
+    counting = false;
+
+    CHECK_EQ(allocations.load(), 0);
+    CHECK_EQ(plainLength, 8u);
+    CHECK(responseLength > 0);
+    CHECK(!response.data.overflowed());
+}
+
+// A response cut off at CAPACITY is not sent (it would carry a valid CRC)
+static void testOverflowNotSerialized(simulator::Machine* machine) {
+    uint8_t buffer[Message::MAX_SERIALIZED_SIZE];
+
+    Message msg;
+    msg.address = 1;
+    msg.command = 0x2F;
+    for (size_t i = 0; i < MessageData::CAPACITY + 1; i++) {
+        msg.data.push_back(static_cast<uint8_t>(i));
+    }
+    CHECK(msg.data.overflowed());
+    CHECK_EQ(msg.serializeTo(buffer, sizeof(buffer)), 0u);
+
+    // 0x2F answers 5 bytes per code: 60 codes do not fit
+    MessageData request;
+    request.push_back(62);
+    request.push_back(0x00);
+    request.push_back(0x00);
+    for (uint8_t code = 0; code < 60; code++) {
+        request.push_back(code);
+    }
+    Message response = commands::MeterCommands::handleSendSelectedMetersForGameN(machine, request);
+    CHECK(response.data.overflowed());
+    CHECK_EQ(response.serializeTo(buffer, sizeof(buffer)), 0u);
+
+    // Exactly CAPACITY bytes still go out
+    Message full;
+    full.address = 1;
+    full.command = 0x2F;
+    full.data.appendSpace(MessageData::CAPACITY);
+    CHECK(!full.data.overflowed());
+    CHECK_EQ(full.serializeTo(buffer, sizeof(buffer)), Message::MAX_SERIALIZED_SIZE);
+}
+
+int main() {
+    auto eventService = std::make_shared<event::EventService>();
+    simulator::Machine machine(eventService, nullptr);
+
+    testNoAllocation(&machine);
+    testOverflowNotSerialized(&machine);
+    return testResult();
+}
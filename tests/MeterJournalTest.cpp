@@ -0,0 +1,146 @@
+#include "TestCheck.h"
+#include "config/MeterJournal.h"
+#include "event/EventService.h"
+#include "sas/SASConstants.h"
+#include "simulator/Game.h"
+#include "simulator/Machine.h"
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using config::MeterJournal;
+using sas::SASConstants;
+
+static const int METER = SASConstants::METER_COIN_IN;
+
+static off_t fileSize(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_size : -1;
+}
+
+static void setFileSizeLimit(rlim_t bytes) {
+    struct rlimit limit;
+    getrlimit(RLIMIT_FSIZE, &limit);
+    limit.rlim_cur = bytes;
+    setrlimit(RLIMIT_FSIZE, &limit);
+}
+
+// A commit that fails part way must leave no torn record and lose nothing:
+// the file size limit makes write() stop in the middle of a record
+static void testFailedCommitIsRetried(const std::string& path) {
+    simulator::Machine machine(std::make_shared<event::EventService>(), nullptr);
+    MeterJournal journal(&machine, 1, path, 60000, 0);
+    journal.addMeter(METER);
+    CHECK(journal.start(0));
+
+    for (int i = 0; i < 4; i++) {
+        machine.incrementMeter(METER, 1);
+    }
+    CHECK(journal.sync());
+    CHECK_EQ(fileSize(path), static_cast<off_t>(4 * MeterJournal::RECORD_SIZE));
+
+    for (int i = 0; i < 10; i++) {
+        machine.incrementMeter(METER, 1);
+    }
+    rlim_t saved = RLIM_INFINITY;
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_FSIZE, &limit) == 0) {
+        saved = limit.rlim_cur;
+    }
+    setFileSizeLimit(7 * MeterJournal::RECORD_SIZE + 5);
+    CHECK(!journal.sync());
+    CHECK_EQ(fileSize(path), static_cast<off_t>(4 * MeterJournal::RECORD_SIZE));
+    setFileSizeLimit(saved);
+
+    machine.incrementMeter(METER, 1);
+    CHECK(journal.sync());
+    journal.stop();
+    CHECK_EQ(fileSize(path), static_cast<off_t>(15 * MeterJournal::RECORD_SIZE));
+
+    // Every record replays, in order, up to the final value
+    uint64_t lastSequence = 0;
+    off_t validLength = 0;
+    simulator::Machine restored(std::make_shared<event::EventService>(), nullptr);
+    CHECK_EQ(MeterJournal::replay(path, &restored, 0, lastSequence, validLength), 15L);
+    CHECK_EQ(lastSequence, 15ull);
+    CHECK_EQ(validLength, static_cast<off_t>(15 * MeterJournal::RECORD_SIZE));
+    CHECK_EQ(restored.getMeter(METER), machine.getMeter(METER));
+}
+
+// Replay stops at a torn tail and start() cuts it off before appending
+static void testTornTail(const std::string& path) {
+    {
+        FILE* file = fopen(path.c_str(), "ab");
+        const char garbage[7] = {0x4A, 0x4D, 1, 2, 3, 4, 5};
+        fwrite(garbage, 1, sizeof(garbage), file);
+        fclose(file);
+    }
+    uint64_t lastSequence = 0;
+    off_t validLength = 0;
+    CHECK_EQ(MeterJournal::replay(path, nullptr, 10, lastSequence, validLength), 5L);
+    CHECK_EQ(lastSequence, 15ull);
+
+    simulator::Machine machine(std::make_shared<event::EventService>(), nullptr);
+    MeterJournal journal(&machine, 1, path, 60000, 0);
+    journal.addMeter(METER);
+    CHECK(journal.start(0));
+    machine.incrementMeter(METER, 1);
+    journal.stop();
+    CHECK_EQ(MeterJournal::replay(path, nullptr, 0, lastSequence, validLength), 16L);
+    CHECK_EQ(lastSequence, 16ull);
+}
+
+// Per-game and per-denomination meters replay along with the totals
+static void testGameBlocks(const std::string& path) {
+    simulator::Machine machine(std::make_shared<event::EventService>(), nullptr);
+    std::shared_ptr<simulator::Game> first = machine.addGame(12, 0x01, 5, "First", "");
+    std::shared_ptr<simulator::Game> second = machine.addGame(34, 0x02, 5, "Second", "");
+    MeterJournal journal(&machine, 1, path, 60000, 0);
+    journal.addMeter(SASConstants::METER_GAMES_WON);
+    CHECK(journal.start(0));
+
+    machine.setCurrentGame(first);
+    machine.GameWon();
+    machine.GameWon();
+    machine.GameLost();
+    machine.setCurrentGame(second);
+    machine.GameWon();
+    journal.stop();
+
+    uint64_t lastSequence = 0;
+    off_t validLength = 0;
+    simulator::Machine restored(std::make_shared<event::EventService>(), nullptr);
+    CHECK_EQ(MeterJournal::replay(path, &restored, 0, lastSequence, validLength), 11L);
+    CHECK_EQ(restored.getMeter(SASConstants::METER_GAMES_WON), 3);
+    CHECK_EQ(restored.getGameMeter(12, SASConstants::METER_GAMES_WON), 2);
+    CHECK_EQ(restored.getGameMeter(12, SASConstants::METER_GAMES_LOST), 1);
+    CHECK_EQ(restored.getGameMeter(34, SASConstants::METER_GAMES_WON), 1);
+    CHECK_EQ(restored.getDenomMeter(0x01, SASConstants::METER_GAMES_WON), 2);
+    CHECK_EQ(restored.getDenomMeter(0x01, SASConstants::METER_GAMES_LOST), 1);
+    CHECK_EQ(restored.getDenomMeter(0x02, SASConstants::METER_GAMES_WON), 1);
+}
+
+int main() {
+    // Exceeding the file size limit must fail write(), not kill the test
+    signal(SIGXFSZ, SIG_IGN);
+
+    char directory[] = "/tmp/MeterJournalTest.XXXXXX";
+    if (!mkdtemp(directory)) {
+        std::cerr << "Could not create a temp directory" << std::endl;
+        return 1;
+    }
+    std::string path = std::string(directory) + "/meters.journal";
+
+    testFailedCommitIsRetried(path);
+    testTornTail(path);
+    unlink(path.c_str());
+    testGameBlocks(path);
+
+    unlink(path.c_str());
+    rmdir(directory);
+    return testResult();
+}
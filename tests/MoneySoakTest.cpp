@@ -0,0 +1,126 @@
+#include "TestCheck.h"
+#include "event/EventService.h"
+#include "sas/SASConstants.h"
+#include "simulator/Game.h"
+#include "simulator/Machine.h"
+#include "simulator/Money.h"
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using sas::SASConstants;
+using simulator::Cents;
+using simulator::Credits;
+
+/**
+ * Soak test: play millions of games across several games and
+ * denominations and check that the integer money paths never drift. Every
+ * bet, win, jackpot and bill is also summed here in plain int64 cents, and
+ * the machine's meters must match those sums exactly, with the per-game
+ * and per-denomination blocks adding up to the totals.
+ *
+ * Usage: MoneySoakTest [games] (default 10M; CTest label "soak")
+ */
+
+namespace {
+
+struct Reference {
+    int64_t coinIn = 0;
+    int64_t coinOut = 0;
+    int64_t jackpot = 0;
+    int64_t billsIn = 0;
+    int64_t played = 0;
+    int64_t won = 0;
+    int64_t lost = 0;
+};
+
+const int GAME_METERS[] = {
+    SASConstants::METER_COIN_IN, SASConstants::METER_COIN_OUT, SASConstants::METER_JACKPOT,
+    SASConstants::METER_GAMES_PLAYED, SASConstants::METER_GAMES_WON, SASConstants::METER_GAMES_LOST,
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long games = (argc > 1) ? std::atol(argv[1]) : 10000000;
+
+    simulator::Machine machine(std::make_shared<event::EventService>(), nullptr);
+    machine.setAccountingDenomCode(1);      // Meters in cents, as main() configures
+
+    // Three games, two of them sharing a game number at different denominations
+    std::vector<std::shared_ptr<simulator::Game>> table = {
+        machine.addGame(1, 0x01, 5, "Penny", ""),       // 1 cent
+        machine.addGame(2, 0x05, 3, "Quarter", ""),     // 25 cents
+        machine.addGame(2, 0x01, 5, "Penny 2", ""),
+    };
+    const int denomCodes[] = {0x01, 0x05};
+
+    Reference reference;
+    uint64_t state = 88172645463325252ULL;
+    for (long i = 0; i < games; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t random = static_cast<uint32_t>(state >> 32);
+
+        const std::shared_ptr<simulator::Game>& game = table[random % table.size()];
+        machine.setCurrentGame(game);
+        int64_t denomCents = simulator::denomination::valueOf(game->getDenomCode()).value();
+        int bet = 1 + static_cast<int>((random >> 8) % game->getMaxBet());
+
+        // Top up with a $20 bill when the bet is not covered
+        if (machine.getCashableAmount() < game->bet(Credits(bet))) {
+            machine.billAccepted(Cents(2000));
+            reference.billsIn += 2000;
+        }
+
+        machine.addCredits(-game->bet(Credits(bet)));
+        machine.gameStart(bet);
+        reference.coinIn += bet * denomCents;
+        reference.played++;
+
+        int outcome = static_cast<int>((random >> 16) % 1000);
+        int64_t winCredits = 0;
+        if (outcome < 400) {
+            winCredits = bet * (2 + (random >> 26) % 9);
+            machine.addCoinOut(game->bet(Credits(winCredits)));
+            machine.GameWon();
+            reference.coinOut += winCredits * denomCents;
+            reference.won++;
+        } else {
+            if (outcome == 999) {
+                machine.addJackpot(game->bet(Credits(1000)));
+                reference.jackpot += 1000 * denomCents;
+            }
+            machine.GameLost();
+            reference.lost++;
+        }
+        machine.gameEnd(winCredits);
+    }
+
+    // Totals against the reference sums
+    CHECK_EQ(machine.getMeter(SASConstants::METER_COIN_IN), reference.coinIn);
+    CHECK_EQ(machine.getMeter(SASConstants::METER_COIN_OUT), reference.coinOut);
+    CHECK_EQ(machine.getMeter(SASConstants::METER_JACKPOT), reference.jackpot);
+    CHECK_EQ(machine.getMeter(SASConstants::METER_GAMES_PLAYED), reference.played);
+    CHECK_EQ(machine.getMeter(SASConstants::METER_GAMES_WON), reference.won);
+    CHECK_EQ(machine.getMeter(SASConstants::METER_GAMES_LOST), reference.lost);
+    CHECK_EQ(reference.played, reference.won + reference.lost);
+    CHECK_EQ(machine.getCredits(),
+             reference.billsIn - reference.coinIn + reference.coinOut + reference.jackpot);
+    CHECK(machine.getCashableAmount() == Cents(machine.getCredits()));
+
+    // Per-game and per-denomination blocks add up to the totals
+    for (int meterCode : GAME_METERS) {
+        int64_t total = machine.getMeter(meterCode);
+        CHECK_EQ(machine.getGameMeter(1, meterCode) + machine.getGameMeter(2, meterCode), total);
+        int64_t denomTotal = 0;
+        for (int code : denomCodes) {
+            denomTotal += machine.getDenomMeter(code, meterCode);
+        }
+        CHECK_EQ(denomTotal, total);
+    }
+
+    std::cout << games << " games, coin in " << Cents(reference.coinIn) << ", coin out "
+              << Cents(reference.coinOut) << ", credits " << machine.getCashableAmount() << std::endl;
+    return testResult();
+}
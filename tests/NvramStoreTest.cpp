@@ -0,0 +1,71 @@
+#include "TestCheck.h"
+#include "event/EventService.h"
+#include "io/NvramDevice.h"
+#include "sas/SASConstants.h"
+#include "simulator/Game.h"
+#include "simulator/Machine.h"
+#include "simulator/NvramStore.h"
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using sas::SASConstants;
+using simulator::NvramStore;
+
+// Meters, game blocks and denomination blocks survive a restart
+static void testRestore(const std::string& path) {
+    {
+        auto device = std::make_shared<io::FileNvramDevice>(path, NvramStore::REGION_SIZE);
+        CHECK(device->open());
+        NvramStore store(device, 0);
+        CHECK(store.open());
+        CHECK(!store.wasRecovered());
+
+        simulator::Machine machine(std::make_shared<event::EventService>(), nullptr);
+        std::shared_ptr<simulator::Game> first = machine.addGame(12, 0x01, 5, "First", "");
+        std::shared_ptr<simulator::Game> second = machine.addGame(34, 0x02, 5, "Second", "");
+        machine.setGameMeter(34, SASConstants::METER_COIN_IN, 500);   // Restored before start()
+        CHECK(store.start(&machine, 60000));
+
+        machine.setCurrentGame(first);
+        machine.GameWon();
+        machine.GameWon();
+        machine.GameLost();
+        machine.setCurrentGame(second);
+        machine.GameWon();
+        store.stop();
+    }
+
+    auto device = std::make_shared<io::FileNvramDevice>(path, NvramStore::REGION_SIZE);
+    CHECK(device->open());
+    NvramStore store(device, 0);
+    CHECK(store.open());
+    CHECK(store.wasRecovered());
+
+    simulator::Machine restored(std::make_shared<event::EventService>(), nullptr);
+    store.applyMetersTo(&restored);
+    CHECK_EQ(restored.getMeter(SASConstants::METER_GAMES_WON), 3);
+    CHECK_EQ(restored.getMeter(SASConstants::METER_GAMES_LOST), 1);
+    CHECK_EQ(restored.getGameMeter(12, SASConstants::METER_GAMES_WON), 2);
+    CHECK_EQ(restored.getGameMeter(12, SASConstants::METER_GAMES_LOST), 1);
+    CHECK_EQ(restored.getGameMeter(34, SASConstants::METER_GAMES_WON), 1);
+    CHECK_EQ(restored.getGameMeter(34, SASConstants::METER_COIN_IN), 500);
+    CHECK_EQ(restored.getDenomMeter(0x01, SASConstants::METER_GAMES_WON), 2);
+    CHECK_EQ(restored.getDenomMeter(0x02, SASConstants::METER_GAMES_WON), 1);
+}
+
+int main() {
+    char directory[] = "/tmp/NvramStoreTest.XXXXXX";
+    if (!mkdtemp(directory)) {
+        std::cerr << "Could not create a temp directory" << std::endl;
+        return 1;
+    }
+    std::string path = std::string(directory) + "/nvram.bin";
+
+    testRestore(path);
+
+    unlink(path.c_str());
+    rmdir(directory);
+    return testResult();
+}
@@ -0,0 +1,263 @@
+#include "TestCheck.h"
+#include "sas/SASFrameParser.h"
+#include "sas/CRC16.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using sas::SASFrameParser;
+
+typedef std::vector<uint8_t> Bytes;
+
+static const uint8_t ADDRESS = 1;
+
+// Append the CRC the host sends (it also covers the address byte)
+static Bytes withCRC(Bytes frame) {
+    Bytes message(1, ADDRESS);
+    message.insert(message.end(), frame.begin(), frame.end());
+    uint16_t crc = sas::CRC16::calculate(message.data(), message.size());
+    frame.push_back(static_cast<uint8_t>(crc & 0xFF));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    return frame;
+}
+
+static Bytes concat(const std::vector<Bytes>& parts) {
+    Bytes out;
+    for (const Bytes& part : parts) {
+        out.insert(out.end(), part.begin(), part.end());
+    }
+    return out;
+}
+
+static const Bytes POLL_1A = {0x1A};                                                // No CRC
+static const Bytes POLL_2D = withCRC({0x2D, 0x00, 0x01});                           // Fixed length
+static const Bytes POLL_2F = withCRC({0x2F, 0x05, 0x00, 0x00, 0x00, 0x01, 0x02});   // Variable length
+static const Bytes POLL_6F = withCRC({0x6F, 0x06, 0x00, 0x01, 0x00, 0x00, 0x05, 0x00});
+
+struct Frame {
+    SASFrameParser::FrameStatus status;
+    Bytes bytes;
+};
+
+// Deterministic generator (the fuzz test must fail the same way every run)
+class Random {
+public:
+    explicit Random(uint32_t seed) : state_(seed) {}
+    uint32_t next() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return state_ >> 8;
+    }
+    uint32_t below(uint32_t bound) { return next() % bound; }
+
+private:
+    uint32_t state_;
+};
+
+// Parser with the CRC check on, fed through the pull interface
+class Harness {
+public:
+    Harness() { parser.setAddress(ADDRESS); }
+
+    void feed(const Bytes& bytes, size_t chunk = 0) {
+        size_t step = chunk ? chunk : bytes.size();
+        for (size_t offset = 0; offset < bytes.size(); offset += step) {
+            size_t count = std::min(step, bytes.size() - offset);
+            parser.ring().push(bytes.data() + offset, count);
+            drain();
+        }
+    }
+
+    void feedRandomChunks(const Bytes& bytes, Random& random) {
+        size_t offset = 0;
+        while (offset < bytes.size()) {
+            size_t count = std::min<size_t>(1 + random.below(8), bytes.size() - offset);
+            parser.ring().push(bytes.data() + offset, count);
+            drain();
+            offset += count;
+        }
+    }
+
+    std::vector<Bytes> okFrames() const {
+        std::vector<Bytes> ok;
+        for (const Frame& frame : frames) {
+            if (frame.status == SASFrameParser::FRAME_OK) {
+                ok.push_back(frame.bytes);
+            }
+        }
+        return ok;
+    }
+
+    SASFrameParser parser;
+    std::vector<Frame> frames;
+
+private:
+    void drain() {
+        const uint8_t* frame = nullptr;
+        size_t length = 0;
+        SASFrameParser::FrameStatus status;
+        while ((status = parser.nextFrame(frame, length)) != SASFrameParser::FRAME_NONE) {
+            Frame copy;
+            copy.status = status;
+            copy.bytes.assign(frame, frame + length);
+            frames.push_back(copy);
+        }
+    }
+};
+
+// Frames split across reads come out whole, in order
+static void testSplitFrames() {
+    const std::vector<Bytes> polls = {POLL_1A, POLL_2F, POLL_2D, POLL_6F, POLL_1A};
+    Bytes stream = concat(polls);
+
+    Harness byteAtATime;
+    byteAtATime.feed(stream, 1);
+    CHECK(byteAtATime.okFrames() == polls);
+    CHECK_EQ(byteAtATime.frames.size(), polls.size());
+    CHECK_EQ(byteAtATime.parser.getJunkBytes(), 0u);
+    CHECK_EQ(byteAtATime.parser.pending(), 0u);
+
+    Random random(1);
+    for (int run = 0; run < 100; run++) {
+        Harness chunked;
+        chunked.feedRandomChunks(stream, random);
+        CHECK(chunked.okFrames() == polls);
+    }
+
+    // feed() emits the same frames through the callback
+    std::vector<Bytes> emitted;
+    SASFrameParser parser([&emitted](const uint8_t* frame, size_t length) {
+        emitted.push_back(Bytes(frame, frame + length));
+    });
+    CHECK_EQ(parser.feed(stream.data(), stream.size()), polls.size());
+    CHECK(emitted == polls);
+}
+
+// Junk before a poll is skipped
+static void testGarbagePrefix() {
+    Harness zeros;
+    zeros.feed(concat({Bytes(5, 0x00), POLL_2F}));
+    CHECK(zeros.okFrames() == std::vector<Bytes>({POLL_2F}));
+    CHECK_EQ(zeros.parser.getJunkBytes(), 5u);
+
+    // A 0x2F length byte no host sends must not swallow the next poll
+    Harness badLength;
+    badLength.feed(concat({Bytes({0x2F, 0xFF}), POLL_2D, POLL_6F}));
+    CHECK(badLength.okFrames() == std::vector<Bytes>({POLL_2D, POLL_6F}));
+
+    Harness oddLength;
+    oddLength.feed(concat({Bytes({0x6F, 0x05}), POLL_6F}));
+    CHECK(oddLength.okFrames() == std::vector<Bytes>({POLL_6F}));
+}
+
+// A frame failing its CRC is reported and framing recovers at the next poll
+static void testCorruptedCRC() {
+    Bytes bad = POLL_2F;
+    bad.back() ^= 0x5A;
+
+    Harness harness;
+    harness.feed(concat({bad, POLL_2D}));
+    CHECK(!harness.frames.empty() && harness.frames.front().status == SASFrameParser::FRAME_BAD_CRC);
+    CHECK(harness.okFrames() == std::vector<Bytes>({POLL_2D}));
+    CHECK_EQ(harness.parser.pending(), 0u);
+
+    // Same bytes split one at a time
+    Harness split;
+    split.feed(concat({bad, POLL_6F}), 1);
+    CHECK(split.okFrames() == std::vector<Bytes>({POLL_6F}));
+
+    // A corrupted data byte (length unchanged) behaves the same
+    Bytes badData = POLL_6F;
+    badData[4] ^= 0x01;
+    Harness data;
+    data.feed(concat({badData, POLL_2F}));
+    CHECK(data.okFrames() == std::vector<Bytes>({POLL_2F}));
+}
+
+// After a bad frame only CRC-checked polls are trusted until one passes
+// or an inter-byte gap resets the parser
+static void testResyncState() {
+    Bytes bad = POLL_2F;
+    bad.back() ^= 0xFF;
+
+    Harness harness;
+    harness.feed(concat({bad, POLL_1A, POLL_2D}));
+    CHECK(harness.okFrames() == std::vector<Bytes>({POLL_2D}));
+
+    // Resync ended with the good CRC: CRC-less polls count again
+    harness.feed(POLL_1A);
+    CHECK(harness.okFrames() == std::vector<Bytes>({POLL_2D, POLL_1A}));
+
+    // A gap ends resyncing as well
+    Harness gap;
+    gap.feed(bad);
+    CHECK(gap.parser.needsReset());
+    gap.parser.reset();
+    CHECK(!gap.parser.needsReset());
+    gap.feed(POLL_1A);
+    CHECK(gap.okFrames() == std::vector<Bytes>({POLL_1A}));
+
+    // A truncated poll is dropped by the gap, not glued to the next one
+    Harness truncated;
+    truncated.feed(Bytes(POLL_6F.begin(), POLL_6F.begin() + 5));
+    CHECK(truncated.okFrames().empty());
+    truncated.parser.reset();
+    truncated.feed(POLL_2F);
+    CHECK(truncated.okFrames() == std::vector<Bytes>({POLL_2F}));
+}
+
+// Random garbage, truncated and corrupted polls, each ended by a gap:
+// the poll after every gap must come out intact
+static void testFuzz() {
+    const std::vector<Bytes> polls = {POLL_1A, POLL_2D, POLL_2F, POLL_6F};
+    Random random(2024);
+    Harness harness;
+
+    for (int i = 0; i < 20000; i++) {
+        harness.frames.clear();
+
+        Bytes noise;
+        switch (random.below(3)) {
+            case 0:     // Line noise
+                for (uint32_t n = random.below(24); n > 0; n--) {
+                    noise.push_back(static_cast<uint8_t>(random.next()));
+                }
+                break;
+            case 1: {   // Truncated poll
+                const Bytes& poll = polls[random.below(polls.size())];
+                noise.assign(poll.begin(), poll.begin() + random.below(poll.size()));
+                break;
+            }
+            default: {  // Poll with one corrupted byte
+                noise = polls[1 + random.below(polls.size() - 1)];
+                noise[random.below(noise.size())] ^= static_cast<uint8_t>(1 + random.below(255));
+                break;
+            }
+        }
+
+        harness.feedRandomChunks(noise, random);
+        harness.parser.reset();
+
+        // Whatever the noise framed, the poll after the gap is exactly one frame
+        size_t noiseFrames = harness.okFrames().size();
+        const Bytes& poll = polls[random.below(polls.size())];
+        harness.feedRandomChunks(poll, random);
+        std::vector<Bytes> ok = harness.okFrames();
+        CHECK_EQ(ok.size(), noiseFrames + 1);
+        CHECK(!ok.empty() && ok.back() == poll);
+        CHECK_EQ(harness.parser.pending(), 0u);
+
+        // Every accepted CRC-carrying frame passed its CRC
+        for (const Bytes& frame : ok) {
+            CHECK(SASFrameParser::checkCRC(ADDRESS, frame.data(), frame.size()));
+        }
+    }
+}
+
+int main() {
+    testSplitFrames();
+    testGarbagePrefix();
+    testCorruptedCRC();
+    testResyncState();
+    testFuzz();
+    return testResult();
+}
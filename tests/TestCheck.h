@@ -0,0 +1,56 @@
+#ifndef TESTS_TESTCHECK_H
+#define TESTS_TESTCHECK_H
+
+#include <iostream>
+
+/**
+ * Minimal checks for the unit tests: each test is one executable that
+ * reports every failed CHECK and exits non-zero if any failed (CTest
+ * treats that as a failure).
+ *
+ * Example:
+ *     CHECK_EQ(BCD::decode(bytes, 4), 1234u);
+ *     return testResult();
+ */
+
+namespace test {
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void fail(const char* file, int line, const char* expression) {
+    std::cerr << file << ":" << line << ": CHECK failed: " << expression << std::endl;
+    failureCount()++;
+}
+
+} // namespace test
+
+#define CHECK(cond)                                                                         \
+    do {                                                                                    \
+        if (!(cond)) {                                                                      \
+            test::fail(__FILE__, __LINE__, #cond);                                          \
+        }                                                                                   \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                          \
+    do {                                                                                    \
+        if (!((actual) == (expected))) {                                                    \
+            test::fail(__FILE__, __LINE__, #actual " == " #expected);                       \
+            std::cerr << "    actual:   " << (actual) << "\n"                               \
+                      << "    expected: " << (expected) << std::endl;                       \
+        }                                                                                   \
+    } while (0)
+
+// Exit code for main(): 0 when every check passed
+inline int testResult() {
+    if (test::failureCount() > 0) {
+        std::cerr << test::failureCount() << " check(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+#endif // TESTS_TESTCHECK_H